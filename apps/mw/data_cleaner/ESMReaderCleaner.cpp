@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2010, 2011, 2022  Dirk Stolle
+    Copyright (C) 2010, 2011, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -60,6 +60,37 @@ ESMReaderCleaner::~ESMReaderCleaner()
   IconSet.clear();
 }
 
+bool ESMReaderCleaner::isRelevantRecord(const uint32_t recordName) const
+{
+  switch(recordName)
+  {
+    case cACTI:
+    case cALCH:
+    case cAPPA:
+    case cARMO:
+    case cBODY:
+    case cBOOK:
+    case cCLOT:
+    case cCONT:
+    case cCREA:
+    case cDOOR:
+    case cINGR:
+    case cLIGH:
+    case cLOCK:
+    case cMISC:
+    case cNPC_:
+    case cPROB:
+    case cREPA:
+    case cSTAT:
+    case cWEAP:
+         return true;
+    default:
+         // Unknown record types are passed on, so that processNextRecord()
+         // can reject them.
+         return !isKnownRecordType(recordName);
+  }
+}
+
 int ESMReaderCleaner::processNextRecord(std::istream& in_File)
 {
   uint32_t RecordName = 0; // normally should be 4 char, but char is not eligible for switch
@@ -133,11 +164,6 @@ int ESMReaderCleaner::processNextRecord(std::istream& in_File)
          }
          return -1;
          break;
-    case cBSGN:
-    case cCELL:
-    case cCLAS:
-         return ESMReader::skipRecord(in_File);
-         break;
     case cCLOT:
          baseRec = new ClothingRecord;
          if (baseRec->loadFromStream(in_File))
@@ -169,9 +195,6 @@ int ESMReaderCleaner::processNextRecord(std::istream& in_File)
          }
          return -1;
          break;
-    case cDIAL:
-         return ESMReader::skipRecord(in_File);
-         break;
     case cDOOR:
          baseRec = new DoorRecord;
          if (baseRec->loadFromStream(in_File))
@@ -182,13 +205,6 @@ int ESMReaderCleaner::processNextRecord(std::istream& in_File)
          }
          return -1;
          break;
-    case cENCH:
-    case cFACT:
-    case cGLOB:
-    case cGMST:
-    case cINFO:
-         return ESMReader::skipRecord(in_File);
-         break;
     case cINGR:
          baseRec = new IngredientRecord;
          if (baseRec->loadFromStream(in_File))
@@ -200,11 +216,6 @@ int ESMReaderCleaner::processNextRecord(std::istream& in_File)
          }
          return -1;
          break;
-    case cLAND:
-    case cLEVC:
-    case cLEVI:
-         return ESMReader::skipRecord(in_File);
-         break;
     case cLIGH:
          baseRec = new LightRecord;
          if (baseRec->loadFromStream(in_File))
@@ -227,10 +238,6 @@ int ESMReaderCleaner::processNextRecord(std::istream& in_File)
          }
          return -1;
          break;
-    case cLTEX:
-    case cMGEF:
-         return ESMReader::skipRecord(in_File);
-         break;
     case cMISC:
          baseRec = new MiscItemRecord;
          if (baseRec->loadFromStream(in_File))
@@ -254,9 +261,6 @@ int ESMReaderCleaner::processNextRecord(std::istream& in_File)
          }
          return -1;
          break;
-    case cPGRD:
-         return ESMReader::skipRecord(in_File);
-         break;
     case cPROB:
          baseRec = new ProbeRecord;
          if (baseRec->loadFromStream(in_File))
@@ -268,10 +272,6 @@ int ESMReaderCleaner::processNextRecord(std::istream& in_File)
          }
          return -1;
          break;
-    case cRACE:
-    case cREGN:
-         return ESMReader::skipRecord(in_File);
-         break;
     case cREPA:
          baseRec = new RepairItemRecord;
          if (baseRec->loadFromStream(in_File))
@@ -283,14 +283,6 @@ int ESMReaderCleaner::processNextRecord(std::istream& in_File)
          }
          return -1;
          break;
-    case cSCPT:
-    case cSKIL:
-    case cSNDG:
-    case cSOUN:
-    case cSPEL:
-    case cSSCR:
-         return ESMReader::skipRecord(in_File);
-         break;
     case cSTAT:
          baseRec = new StaticRecord;
          if (baseRec->loadFromStream(in_File))
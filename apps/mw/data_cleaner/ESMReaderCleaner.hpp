@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2010, 2011, 2012  Dirk Stolle
+    Copyright (C) 2010, 2011, 2012, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -48,6 +48,16 @@ class ESMReaderCleaner: public ESMReader
     /* the list of icons */
     std::set<std::string, ci_less> IconSet;
   protected:
+    /* checks whether records of the given type can contain paths to meshes or
+       icons, i.e. whether readESM() shall pass them to processNextRecord()
+       Unknown record types are passed on, too, so that processNextRecord()
+       reports them as errors.
+
+       parameters:
+           recordName - type of the record, e.g. cSTAT
+    */
+    virtual bool isRelevantRecord(const uint32_t recordName) const override;
+
     /* tries to read the next record from a stream and returns the number of
        relevant records that were read (usually one). If an error occurred,
        -1 is returned. If the record was skipped or contained no relevant data,
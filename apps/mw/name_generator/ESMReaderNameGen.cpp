@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2023  Dirk Stolle
+    Copyright (C) 2023, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -26,6 +26,11 @@
 namespace MWTP
 {
 
+bool ESMReaderNameGen::isRelevantRecord(const uint32_t recordName) const
+{
+  return (recordName == cNPC_) || (recordName == cRACE);
+}
+
 int ESMReaderNameGen::processNextRecord(std::istream& input)
 {
   // Normally should be 4 chars, but char array is not eligible for switch.
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2023  Dirk Stolle
+    Copyright (C) 2023, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -29,6 +29,13 @@ namespace MWTP
 class ESMReaderNameGen: public ESMReader
 {
   protected:
+    /** \brief Checks whether records of a type shall be read by readESM().
+     *
+     * \param recordName  type of the record, e.g. cSTAT
+     * \return Returns true, if the record type is relevant for the name generator.
+     */
+    virtual bool isRelevantRecord(const uint32_t recordName) const override;
+
     /** \brief Tries to read the next record from a stream.
      *
      * \param input  the input stream the record shall be read from
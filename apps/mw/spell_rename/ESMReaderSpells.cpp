@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2011, 2012, 2021  Dirk Stolle
+    Copyright (C) 2011, 2012, 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -29,6 +29,14 @@
 namespace MWTP
 {
 
+bool ESMReaderSpells::isRelevantRecord(const uint32_t recordName) const
+{
+  // Unknown record types are passed on, so that processNextRecord() can
+  // reject them.
+  return (recordName == cGMST) || (recordName == cMGEF) || (recordName == cSPEL)
+      || !isKnownRecordType(recordName);
+}
+
 int ESMReaderSpells::processNextRecord(std::istream& input)
 {
   // Normally should be 4 chars, but char array is not eligible for switch.
@@ -43,46 +51,6 @@ int ESMReaderSpells::processNextRecord(std::istream& input)
          return MagicEffects::get().readNextRecord(input);
     case cSPEL:
          return Spells::get().readNextRecord(input);
-    case cACTI:
-    case cALCH:
-    case cAPPA:
-    case cARMO:
-    case cBODY:
-    case cBOOK:
-    case cBSGN:
-    case cCELL:
-    case cCLAS:
-    case cCLOT:
-    case cCONT:
-    case cCREA:
-    case cDIAL:
-    case cDOOR:
-    case cENCH:
-    case cFACT:
-    case cGLOB:
-    case cINFO:
-    case cINGR:
-    case cLAND:
-    case cLEVC:
-    case cLEVI:
-    case cLIGH:
-    case cLOCK:
-    case cLTEX:
-    case cMISC:
-    case cNPC_:
-    case cPGRD:
-    case cPROB:
-    case cRACE:
-    case cREGN:
-    case cREPA:
-    case cSCPT:
-    case cSKIL:
-    case cSNDG:
-    case cSOUN:
-    case cSSCR:
-    case cSTAT:
-    case cWEAP:
-         return ESMReader::skipRecord(input);
     default:
          std::cout << "ProcessRecords: ERROR: Unknown record type found: \""
                    << IntTo4Char(RecordName) << "\".\n"
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2022, 2023, 2025  Dirk Stolle
+    Copyright (C) 2022, 2023, 2025, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -76,7 +76,7 @@ int CheckHashes::run()
   {
     const auto& directory = directory_blocks[i];
     // Check hash of directory.
-    const auto expected_dir_hash = calculateDirectoryHash(directory.name);
+    const auto expected_dir_hash = calculateDirectoryNameHash(directory.name);
     if (directory_records[i].nameHash != expected_dir_hash)
     {
       all_hashes_good = false;
@@ -91,7 +91,7 @@ int CheckHashes::run()
     // Check hashes of all files in the directory.
     for (const BSAFileRecord& file: directory.files)
     {
-      const auto expected = calculateHash(file.fileName);
+      const auto expected = calculateFileNameHash(file.fileName);
       if (file.nameHash != expected)
       {
         all_hashes_good = false;
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2021, 2022  Dirk Stolle
+    Copyright (C) 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -30,6 +30,7 @@
 #include "Help.hpp"
 #include "Info.hpp"
 #include "List.hpp"
+#include "Pack.hpp"
 
 namespace SRTP::bsa_cli::CommandFactory
 {
@@ -60,6 +61,8 @@ std::unique_ptr<Command> createCommand(const Operation op)
          return std::unique_ptr<Command>(new CheckHashes());
     case Operation::Help:
          return std::unique_ptr<Command>(new Help());
+    case Operation::Pack:
+         return std::unique_ptr<Command>(new Pack());
     default:
          return nullptr;
   }
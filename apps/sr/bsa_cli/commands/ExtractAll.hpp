@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2021, 2022  Dirk Stolle
+    Copyright (C) 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -65,6 +65,7 @@ class ExtractAll: public Command
   private:
     std::string bsaFileName; /**< name of the BSA file */
     std::string outputDirectoryName; /**< destination for extraction */
+    unsigned int threadCount; /**< number of threads to use for extraction */
 };
 
 } // namespace
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2021, 2022, 2023, 2025  Dirk Stolle
+    Copyright (C) 2021, 2022, 2023, 2025, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -20,9 +20,11 @@
 
 #include "ExtractDirectory.hpp"
 #include <iostream>
+#include "../../../../lib/base/DirectoryFunctions.hpp"
 #include "../../../../lib/base/FileFunctions.hpp"
 #include "../../../../lib/sr/ReturnCodes.hpp"
 #include "../../../../lib/sr/bsa/BSA.hpp"
+#include "ParallelExtraction.hpp"
 
 namespace SRTP::bsa_cli
 {
@@ -30,7 +32,8 @@ namespace SRTP::bsa_cli
 ExtractDirectory::ExtractDirectory()
 : bsaFileName(std::string()),
   archiveDirectoryName(std::string()),
-  outputDirectoryName(std::string())
+  outputDirectoryName(std::string()),
+  threadCount(1)
 {
 }
 
@@ -42,12 +45,39 @@ int ExtractDirectory::parseArguments(int argc, char** argv)
     return SRTP::rcInvalidParameter;
   }
 
+  bool threadOptionSeen = false;
   for(int i = 2; i < argc; ++i)
   {
     if (argv[i] != nullptr)
     {
       const std::string param = std::string(argv[i]);
-      if (bsaFileName.empty())
+      if (param == "--threads")
+      {
+        if (threadOptionSeen)
+        {
+          std::cerr << "Error: The option " << param
+                    << " was specified more than once.\n";
+          return SRTP::rcInvalidParameter;
+        }
+        if ((i + 1 >= argc) || (argv[i + 1] == nullptr))
+        {
+          std::cerr << "Error: The option " << param
+                    << " has to be followed by the number of threads.\n";
+          return SRTP::rcInvalidParameter;
+        }
+        const auto count = parseThreadCount(argv[i + 1]);
+        if (!count.has_value())
+        {
+          std::cerr << "Error: \"" << argv[i + 1] << "\" is not a valid "
+                    << "number of threads. It has to be a number between 1 and "
+                    << maximum_thread_count << ".\n";
+          return SRTP::rcInvalidParameter;
+        }
+        threadCount = count.value();
+        threadOptionSeen = true;
+        ++i; // skip next argument, because it was already processed
+      }
+      else if (bsaFileName.empty())
       {
         if (!FileExists(param))
         {
@@ -107,7 +137,8 @@ int ExtractDirectory::parseArguments(int argc, char** argv)
 int ExtractDirectory::run()
 {
   BSA bsa;
-  if (!bsa.open(bsaFileName))
+  const auto mode = threadCount > 1 ? BSA::OpenMode::MemoryMapped : BSA::OpenMode::Stream;
+  if (!bsa.open(bsaFileName, mode))
     return SRTP::rcFileError;
   // Some BSA files do not contain information about directory and file names.
   // These are useless for us.
@@ -122,6 +153,27 @@ int ExtractDirectory::run()
   if (!bsa.grabAllStructureData())
     return SRTP::rcFileError;
   uint32_t extractedFiles = 0;
+  if (threadCount > 1)
+  {
+    const auto directoryIndex = bsa.getIndexOfDirectory(archiveDirectoryName);
+    if (!directoryIndex.has_value())
+    {
+      std::cerr << "Error: Archive has no directory named \""
+                << archiveDirectoryName << "\", thus it cannot be extracted!\n";
+      return SRTP::rcFileError;
+    }
+    if (!createDirectoryRecursive(outputDirectoryName))
+    {
+      std::cerr << "Error: Could not create destination directory \""
+                << outputDirectoryName << "\".\n";
+      return SRTP::rcFileError;
+    }
+    std::vector<ExtractionJob> jobs;
+    addDirectoryJobs(bsa, directoryIndex.value(), outputDirectoryName, jobs);
+    if (extractParallel(bsa, jobs, threadCount, extractedFiles))
+      return 0;
+    return SRTP::rcFileError;
+  }
   if (bsa.extractDirectory(archiveDirectoryName, outputDirectoryName, extractedFiles))
     return 0;
   return SRTP::rcFileError;
@@ -145,8 +197,11 @@ std::string ExtractDirectory::helpLong(const std::string_view binaryName) const
   return std::string(binaryName).append(" extract-directory\n")
       .append("Extracts a single directory from an archive.\n\n")
       .append("Usage:\n    ")
-      .append(binaryName).append(" extract-directory BSA_FILE ARCHIVE_DIRECTORY EXTRACT_DESTINATION\n\n")
-      .append("Options:\n    BSA_FILE            - Set path to the BSA file to operate on to BSA_FILE.\n")
+      .append(binaryName).append(" extract-directory [--threads N] BSA_FILE ARCHIVE_DIRECTORY EXTRACT_DESTINATION\n\n")
+      .append("Options:\n    --threads N         - Use N threads to extract the files. Default is one\n")
+      .append("                          thread. N must be between 1 and ")
+      .append(std::to_string(maximum_thread_count)).append(".\n")
+      .append("    BSA_FILE            - Set path to the BSA file to operate on to BSA_FILE.\n")
       .append("                          The BSA_FILE must be given.\n")
       .append("    ARCHIVE_DIRECTORY   - full path of the directory from the archive to\n")
       .append("                          extract. This option must be present.\n")
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2021, 2022  Dirk Stolle
+    Copyright (C) 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -66,6 +66,7 @@ class ExtractDirectory: public Command
     std::string bsaFileName; /**< name of the BSA file */
     std::string archiveDirectoryName; /**< name of the directory inside the BSA */
     std::string outputDirectoryName; /**< destination for extraction */
+    unsigned int threadCount; /**< number of threads to use for extraction */
 };
 
 } // namespace
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2021, 2022  Dirk Stolle
+    Copyright (C) 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -47,6 +47,8 @@ std::optional<Operation> parseOperation(const std::string_view op)
     return Operation::DirectoryMetadata;
   if (op == "check-hashes")
     return Operation::CheckHashes;
+  if (op == "pack")
+    return Operation::Pack;
 
   return std::nullopt;
 }
@@ -77,6 +79,8 @@ std::string operationToString(const Operation op)
          return "directory-metadata";
     case Operation::CheckHashes:
          return "check-hashes";
+    case Operation::Pack:
+         return "pack";
     default:
          return "";
   }
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2021, 2022  Dirk Stolle
+    Copyright (C) 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -41,7 +41,8 @@ enum class Operation
   FileMetadata,
   Help,
   Info,
-  List
+  List,
+  Pack
 };
 
 /** \brief Parses a string containing an operation into an enumeration.
@@ -64,7 +65,7 @@ std::string operationToString(const Operation op);
  * \remarks There is no real reflection in C++, so we use this instead.
  * \return Returns an array containing all possible operations.
  */
-constexpr std::array<Operation, 11> allOperations()
+constexpr std::array<Operation, 12> allOperations()
 {
   return {
     Operation::CheckHashes,
@@ -77,7 +78,8 @@ constexpr std::array<Operation, 11> allOperations()
     Operation::FileMetadata,
     Operation::Help,
     Operation::Info,
-    Operation::List
+    Operation::List,
+    Operation::Pack
   };
 }
 
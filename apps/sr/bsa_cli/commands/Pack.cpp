@@ -0,0 +1,234 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "Pack.hpp"
+#include <filesystem>
+#include <iostream>
+#include "../../../../lib/base/DirectoryFunctions.hpp"
+#include "../../../../lib/base/FileFunctions.hpp"
+#include "../../../../lib/sr/ReturnCodes.hpp"
+#include "../../../../lib/sr/bsa/BSAWriter.hpp"
+#include "ParallelExtraction.hpp"
+
+namespace SRTP::bsa_cli
+{
+
+Pack::Pack()
+: sourceDirectoryName(std::string()),
+  bsaFileName(std::string()),
+  version(104),
+  compressed(true),
+  threadCount(1)
+{
+}
+
+int Pack::parseArguments(int argc, char** argv)
+{
+  if (argv == nullptr)
+  {
+    std::cerr << "Error: Parameter array pointer is NULL.\n";
+    return SRTP::rcInvalidParameter;
+  }
+
+  bool versionOptionSeen = false;
+  bool compressionOptionSeen = false;
+  bool threadOptionSeen = false;
+  for(int i = 2; i < argc; ++i)
+  {
+    if (argv[i] != nullptr)
+    {
+      const std::string param = std::string(argv[i]);
+      if (param == "--version")
+      {
+        if (versionOptionSeen)
+        {
+          std::cerr << "Error: The option " << param
+                    << " was specified more than once.\n";
+          return SRTP::rcInvalidParameter;
+        }
+        if ((i + 1 >= argc) || (argv[i + 1] == nullptr))
+        {
+          std::cerr << "Error: The option " << param
+                    << " has to be followed by the BSA version.\n";
+          return SRTP::rcInvalidParameter;
+        }
+        const std::string value = std::string(argv[i + 1]);
+        if (value == "104")
+          version = 104;
+        else if (value == "105")
+          version = 105;
+        else
+        {
+          std::cerr << "Error: \"" << value << "\" is not a supported BSA "
+                    << "version. Supported versions are 104 and 105.\n";
+          return SRTP::rcInvalidParameter;
+        }
+        versionOptionSeen = true;
+        ++i; // skip next argument, because it was already processed
+      }
+      else if (param == "--uncompressed")
+      {
+        if (compressionOptionSeen)
+        {
+          std::cerr << "Error: The option " << param
+                    << " was specified more than once.\n";
+          return SRTP::rcInvalidParameter;
+        }
+        compressed = false;
+        compressionOptionSeen = true;
+      }
+      else if (param == "--threads")
+      {
+        if (threadOptionSeen)
+        {
+          std::cerr << "Error: The option " << param
+                    << " was specified more than once.\n";
+          return SRTP::rcInvalidParameter;
+        }
+        if ((i + 1 >= argc) || (argv[i + 1] == nullptr))
+        {
+          std::cerr << "Error: The option " << param
+                    << " has to be followed by the number of threads.\n";
+          return SRTP::rcInvalidParameter;
+        }
+        const auto count = parseThreadCount(argv[i + 1]);
+        if (!count.has_value())
+        {
+          std::cerr << "Error: \"" << argv[i + 1] << "\" is not a valid "
+                    << "number of threads. It has to be a number between 1 and "
+                    << maximum_thread_count << ".\n";
+          return SRTP::rcInvalidParameter;
+        }
+        threadCount = count.value();
+        threadOptionSeen = true;
+        ++i; // skip next argument, because it was already processed
+      }
+      else if (sourceDirectoryName.empty())
+      {
+        if (!directoryExists(param))
+        {
+          std::cerr << "Error: The directory " << param << " does not exist!\n";
+          return SRTP::rcInvalidParameter;
+        }
+        sourceDirectoryName = param;
+      }
+      else if (bsaFileName.empty())
+      {
+        if (FileExists(param) || directoryExists(param))
+        {
+          std::cerr << "Error: The destination " << param << " already exists!\n";
+          return SRTP::rcInvalidParameter;
+        }
+        bsaFileName = param;
+      }
+      else
+      {
+        // unknown or wrong parameter
+        std::cerr << "Invalid parameter given: \"" << param << "\".\n"
+                  << "Use --help to get a list of valid parameters.\n";
+        return SRTP::rcInvalidParameter;
+      }
+    }
+    else
+    {
+      std::cerr << "Error: Parameter at index " << i << " is NULL.\n";
+      return SRTP::rcInvalidParameter;
+    }
+  }
+  if (sourceDirectoryName.empty())
+  {
+    std::cerr << "Error: A source directory has to be specified after the "
+              << "command!\n";
+    return SRTP::rcInvalidParameter;
+  }
+  if (bsaFileName.empty())
+  {
+    std::cerr << "Error: A BSA file name has to be specified for the new archive!\n";
+    return SRTP::rcInvalidParameter;
+  }
+
+  return 0;
+}
+
+int Pack::run()
+{
+  BSAWriter writer(version, compressed, threadCount);
+  if (!writer.addDirectoryTree(sourceDirectoryName))
+    return SRTP::rcFileError;
+  if (writer.fileCount() == 0)
+  {
+    std::cerr << "Error: The directory " << sourceDirectoryName
+              << " does not contain any files!\n";
+    return SRTP::rcFileError;
+  }
+  if (!writer.write(bsaFileName))
+  {
+    // Do not leave an incomplete archive behind.
+    std::error_code error;
+    std::filesystem::remove(bsaFileName, error);
+    return SRTP::rcFileError;
+  }
+
+  std::cout << "Packed " << writer.fileCount() << " file(s) into "
+            << bsaFileName << ".\n";
+  return 0;
+}
+
+std::string Pack::helpShort() const
+{
+  return "Creates a new archive from the files in a directory.";
+}
+
+std::string Pack::helpLong(const std::string_view binaryName) const
+{
+  #if defined(_WIN32)
+  const auto source = "D:\\MyStuff\\data";
+  const auto archive = "D:\\MyStuff\\archive.bsa";
+  #else
+  const auto source = "/home/user/data";
+  const auto archive = "/home/user/archive.bsa";
+  #endif
+  return std::string(binaryName).append(" pack\n")
+      .append("Creates a new archive from all files in a directory.\n\n")
+      .append("Usage:\n    ")
+      .append(binaryName).append(" pack [--version V] [--uncompressed] [--threads N]\n")
+      .append("        SOURCE_DIRECTORY BSA_FILE\n\n")
+      .append("Options:\n    --version V         - Create an archive of version V. Allowed values are\n")
+      .append("                          104 (Skyrim, files are compressed with zlib) and\n")
+      .append("                          105 (Skyrim Special Edition, files are compressed\n")
+      .append("                          with lz4). Default is 104.\n")
+      .append("    --uncompressed      - Store the files without compression.\n")
+      .append("    --threads N         - Use N threads to compress the files. Default is one\n")
+      .append("                          thread. N must be between 1 and ")
+      .append(std::to_string(maximum_thread_count)).append(".\n")
+      .append("    SOURCE_DIRECTORY    - directory containing the files to pack. The paths of\n")
+      .append("                          the files in the archive are relative to that\n")
+      .append("                          directory. This option must be present.\n")
+      .append("    BSA_FILE            - name of the archive to create. This option must be\n")
+      .append("                          present. The file must not exist yet.\n\n")
+      .append("Example:\n")
+      .append("    To pack all files from the directory\n    ")
+      .append(source).append(" into the new archive\n    ").append(archive)
+      .append(" type:\n\n    ").append(binaryName)
+      .append(" pack ").append(source).append(" ").append(archive)
+      .append("\n");
+}
+
+} // namespace
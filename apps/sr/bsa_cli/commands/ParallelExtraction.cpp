@@ -0,0 +1,102 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "ParallelExtraction.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include "../../../../lib/base/DirectoryFunctions.hpp"
+
+namespace SRTP::bsa_cli
+{
+
+std::optional<unsigned int> parseThreadCount(const std::string& value)
+{
+  if (value.empty() || (value.size() > 3))
+    return std::nullopt;
+
+  unsigned int count = 0;
+  for (const char c: value)
+  {
+    if ((c < '0') || (c > '9'))
+      return std::nullopt;
+    count = count * 10 + static_cast<unsigned int>(c - '0');
+  }
+  if ((count == 0) || (count > maximum_thread_count))
+    return std::nullopt;
+
+  return count;
+}
+
+void addDirectoryJobs(const BSA& bsa, const uint32_t directoryIndex, const std::string& outputDirName, std::vector<ExtractionJob>& jobs)
+{
+  const auto& files = bsa.getDirectoryBlocks()[directoryIndex].files;
+  for (uint32_t i = 0; i < files.size(); ++i)
+  {
+    jobs.push_back(ExtractionJob{ directoryIndex, i,
+        outputDirName + MWTP::pathDelimiter + files[i].fileName });
+  }
+}
+
+bool extractParallel(const BSA& bsa, const std::vector<ExtractionJob>& jobs, const unsigned int threadCount, uint32_t& extractedFileCount)
+{
+  extractedFileCount = 0;
+  std::atomic<std::size_t> next_job = 0;
+  std::atomic<uint32_t> extracted = 0;
+  std::atomic<bool> failed = false;
+
+  const auto worker = [&]()
+  {
+    while (!failed)
+    {
+      const std::size_t idx = next_job++;
+      if (idx >= jobs.size())
+        return;
+      const auto& job = jobs[idx];
+      if (!bsa.extractFile(job.directoryIndex, job.fileIndex, job.destination))
+      {
+        std::cerr << "Error: Could not extract file \"" << job.destination << "\".\n";
+        failed = true;
+        return;
+      }
+      ++extracted;
+    }
+  };
+
+  const std::size_t count = std::max<std::size_t>(1, std::min<std::size_t>(threadCount, jobs.size()));
+  std::vector<std::thread> threads;
+  threads.reserve(count - 1);
+  for (std::size_t i = 1; i < count; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  // The current thread does some of the work, too.
+  worker();
+  for (auto& thread: threads)
+  {
+    thread.join();
+  }
+
+  extractedFileCount = extracted;
+  return !failed;
+}
+
+} // namespace
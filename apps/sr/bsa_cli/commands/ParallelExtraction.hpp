@@ -0,0 +1,81 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SRTP_BSACLI_COMMANDS_PARALLELEXTRACTION_HPP
+#define SRTP_BSACLI_COMMANDS_PARALLELEXTRACTION_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../../../../lib/sr/bsa/BSA.hpp"
+
+namespace SRTP::bsa_cli
+{
+
+/// maximum number of threads that can be used for extraction
+constexpr unsigned int maximum_thread_count = 256;
+
+/// single file to extract
+struct ExtractionJob
+{
+  uint32_t directoryIndex;  /**< index of the directory in the archive */
+  uint32_t fileIndex;       /**< index of the file within that directory */
+  std::string destination;  /**< path of the destination file */
+};
+
+/** \brief Parses the value of the --threads option.
+ *
+ * \param value  the value given on the command line
+ * \return Returns the number of threads in case of success.
+ *         Returns an empty optional, if the value is not a number between one
+ *         and maximum_thread_count.
+ */
+std::optional<unsigned int> parseThreadCount(const std::string& value);
+
+/** \brief Creates the extraction jobs for all files of a directory.
+ *
+ * \param bsa             the archive, structure data has to be read already
+ * \param directoryIndex  index of the directory in the archive
+ * \param outputDirName   path of the destination directory, without (back)slash at the end
+ * \param jobs            vector where the jobs will be appended
+ */
+void addDirectoryJobs(const BSA& bsa, const uint32_t directoryIndex, const std::string& outputDirName, std::vector<ExtractionJob>& jobs);
+
+/** \brief Extracts files from an archive using several threads.
+ *
+ * \param bsa          the archive, structure data has to be read already
+ * \param jobs         the files to extract; destination directories must exist
+ * \param threadCount  maximum number of threads to use
+ * \param extractedFileCount  variable that will contain the number of
+ *                            extracted files
+ * \return Returns true, if all files were extracted successfully.
+ *         Returns false, if an error occurred.
+ * \remarks Extraction does not change the state of the archive, so the
+ *          threads need no synchronization. Archives opened with
+ *          BSA::OpenMode::MemoryMapped avoid additional reads and copies.
+ *          Decompression and writing of the files happen on the worker
+ *          threads.
+ */
+bool extractParallel(const BSA& bsa, const std::vector<ExtractionJob>& jobs, const unsigned int threadCount, uint32_t& extractedFileCount);
+
+} // namespace
+
+#endif // SRTP_BSACLI_COMMANDS_PARALLELEXTRACTION_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2021, 2022, 2023, 2024, 2025  Dirk Stolle
+    Copyright (C) 2021, 2022, 2023, 2024, 2025, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -34,9 +34,9 @@
 
 void showVersion()
 {
-  std::cout << "BSA Command Line Tool for Skyrim, version 0.12.0, 2025-05-14\n"
+  std::cout << "BSA Command Line Tool for Skyrim, version 0.13.0, 2026-10-17\n"
             << "\n"
-            << "Copyright (C) 2021 - 2025  Dirk Stolle\n"
+            << "Copyright (C) 2021 - 2026  Dirk Stolle\n"
             << "License GPLv3+: GNU GPL version 3 or later <https://gnu.org/licenses/gpl.html>\n"
             << "This is free software: you are free to change and redistribute it under the\n"
             << "terms of the GNU General Public License version 3 or any later version.\n"
@@ -74,6 +74,8 @@ void showHelp()
             << "                   info               - shows BSA header information\n"
             << "                   list               - lists all directories and files in the\n"
             << "                                        archive\n"
+            << "                   pack               - creates a new archive from the files\n"
+            << "                                        in a directory\n"
             << "\n"
             << "               More commands may be added in the future.\n"
             << "               The command must be given in most cases.\n"
@@ -0,0 +1,208 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "ArchiveSet.hpp"
+#include <algorithm>
+#include <iostream>
+#include <tuple>
+#include "../../../lib/base/UtilityFunctions.hpp"
+
+namespace SRTP::bsafs
+{
+
+ArchiveSet::ArchiveSet()
+: m_Archives(),
+  m_Files(),
+  m_Directories()
+{
+  // The root directory always exists.
+  m_Directories[std::string()];
+}
+
+bool ArchiveSet::add(const std::filesystem::path& path)
+{
+  auto archive = std::make_unique<BSA>();
+  if (!archive->open(path, BSA::OpenMode::MemoryMapped))
+  {
+    // Reading file data at explicit offsets is a bit slower, but it works
+    // with several threads, too.
+    if (!archive->open(path, BSA::OpenMode::Stream))
+    {
+      return false;
+    }
+    // Only mention the fallback when it worked. Files that cannot be opened
+    // at all (e. g. because they do not exist) already got an error message.
+    std::cerr << "Info: Falling back to reading " << path.string()
+              << " without memory mapping.\n";
+  }
+  // Some BSA files do not contain information about directory and file names.
+  // These are useless for us.
+  const auto& header = archive->getHeader();
+  if (!header.hasNamesForDirectories() || !header.hasNamesForFiles())
+  {
+    std::cerr << "Error: The file " << path.string() << " does not contain "
+              << "information about its directory names and file names.\n";
+    return false;
+  }
+  if (!archive->grabAllStructureData())
+  {
+    return false;
+  }
+  return add(std::move(archive));
+}
+
+bool ArchiveSet::add(std::unique_ptr<BSA> archive)
+{
+  if ((archive == nullptr) || !archive->hasAllStructureData())
+  {
+    return false;
+  }
+  const auto sizes = getFileSizes(*archive);
+  if (!sizes.has_value())
+  {
+    return false;
+  }
+  m_Archives.push_back(std::move(archive));
+  indexLastArchive(sizes.value());
+  return true;
+}
+
+std::optional<std::vector<std::vector<uint32_t> > > ArchiveSet::getFileSizes(const BSA& archive)
+{
+  const auto& blocks = archive.getDirectoryBlocks();
+  std::vector<std::vector<uint32_t> > sizes(blocks.size());
+  // offset, directory index, file index
+  std::vector<std::tuple<uint32_t, uint32_t, uint32_t> > order;
+  for (uint32_t dir_index = 0; dir_index < blocks.size(); ++dir_index)
+  {
+    const auto& files = blocks[dir_index].files;
+    sizes[dir_index].resize(files.size(), 0);
+    for (uint32_t file_index = 0; file_index < files.size(); ++file_index)
+    {
+      order.emplace_back(files[file_index].offset, dir_index, file_index);
+    }
+  }
+  // Compressed files store their extracted size at the start of their data,
+  // so visiting them by offset turns many random reads into one forward pass.
+  std::sort(order.begin(), order.end());
+  for (const auto& [offset, dir_index, file_index]: order)
+  {
+    const auto size = archive.getExtractedFileSize(dir_index, file_index);
+    if (!size.has_value())
+    {
+      std::cerr << "Error: Could not get the size of the file "
+                << blocks[dir_index].name << '\\'
+                << blocks[dir_index].files[file_index].fileName << "!\n";
+      return std::nullopt;
+    }
+    sizes[dir_index][file_index] = size.value();
+  }
+  return sizes;
+}
+
+DirectoryEntry& ArchiveSet::getOrCreateDirectory(const std::string& path)
+{
+  const std::string key = lowerCase(path);
+  const auto iter = m_Directories.find(key);
+  if (iter != m_Directories.end())
+  {
+    return iter->second;
+  }
+  // Listings show the name as stored in the archive, lookups ignore the case.
+  const auto position = path.rfind('\\');
+  const std::string parent = (position == std::string::npos) ? std::string() : path.substr(0, position);
+  const std::string name = (position == std::string::npos) ? path : path.substr(position + 1);
+  getOrCreateDirectory(parent).directories.push_back(name);
+  return m_Directories[key];
+}
+
+void ArchiveSet::indexLastArchive(const std::vector<std::vector<uint32_t> >& sizes)
+{
+  const uint32_t archive_index = static_cast<uint32_t>(m_Archives.size() - 1);
+  const auto& blocks = m_Archives.back()->getDirectoryBlocks();
+  for (uint32_t dir_index = 0; dir_index < blocks.size(); ++dir_index)
+  {
+    const std::string directory = lowerCase(blocks[dir_index].name);
+    DirectoryEntry& entry = getOrCreateDirectory(blocks[dir_index].name);
+
+    const auto& files = blocks[dir_index].files;
+    for (uint32_t file_index = 0; file_index < files.size(); ++file_index)
+    {
+      const FileEntry file{ files[file_index].fileName,
+                            FileLocation{ archive_index, dir_index, file_index },
+                            sizes[dir_index][file_index] };
+      const auto [iter, inserted] = m_Files.insert_or_assign(
+          directory + '\\' + lowerCase(files[file_index].fileName), file);
+      // Later archives override the files of earlier archives. The
+      // overridden entry is updated in place, so the directory listing
+      // already points to it.
+      if (inserted)
+      {
+        entry.files.push_back(&iter->second);
+      }
+    }
+  }
+}
+
+std::size_t ArchiveSet::size() const
+{
+  return m_Archives.size();
+}
+
+bool ArchiveSet::empty() const
+{
+  return m_Archives.empty();
+}
+
+const BSA& ArchiveSet::archive(const std::size_t index) const
+{
+  return *m_Archives[index];
+}
+
+bool ArchiveSet::isDirectory(const std::string& path) const
+{
+  return findDirectory(path) != nullptr;
+}
+
+const DirectoryEntry* ArchiveSet::findDirectory(const std::string& path) const
+{
+  const auto iter = m_Directories.find(lowerCase(path));
+  if (iter == m_Directories.end())
+    return nullptr;
+  return &iter->second;
+}
+
+const FileEntry* ArchiveSet::findFile(const std::string& path) const
+{
+  const auto iter = m_Files.find(lowerCase(path));
+  if (iter == m_Files.end())
+    return nullptr;
+  return &iter->second;
+}
+
+void ArchiveSet::clear()
+{
+  m_Files.clear();
+  m_Directories.clear();
+  m_Directories[std::string()];
+  m_Archives.clear();
+}
+
+} // namespace
@@ -0,0 +1,167 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SRTP_BSAFS_ARCHIVESET_HPP
+#define SRTP_BSAFS_ARCHIVESET_HPP
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../../../lib/sr/bsa/BSA.hpp"
+#include "FileLocation.hpp"
+
+namespace SRTP::bsafs
+{
+
+/** Metadata of a file in the merged directory tree. */
+struct FileEntry
+{
+  std::string name;      /**< name of the file without its directory */
+  FileLocation location; /**< location of the file data */
+  uint32_t size;         /**< size of the file after extraction, in bytes */
+};
+
+/** Contents of a directory in the merged directory tree. */
+struct DirectoryEntry
+{
+  std::vector<std::string> directories; /**< names of the direct sub-directories, as stored in the first archive that contains them */
+  std::vector<const FileEntry*> files;  /**< files in the directory, only the winning ones */
+};
+
+/** Ordered list of archives which are presented as one merged directory
+ *  tree.
+ *
+ * Archives are added in load order: if several archives contain a file with
+ * the same path, then the file of the archive that was added last is used.
+ * All paths are indexed once when an archive is added, including the sizes
+ * of the extracted files, so lookups and directory listings are done in
+ * memory only and do not depend on the number of archives.
+ */
+class ArchiveSet
+{
+  public:
+    /// Creates an empty set.
+    ArchiveSet();
+
+    ArchiveSet(const ArchiveSet& other) = delete;
+    ArchiveSet& operator=(const ArchiveSet& other) = delete;
+
+    /** \brief Opens an archive and adds it on top of the previous ones.
+     *
+     * \param path  path of the BSA file
+     * \return Returns true in case of success. Returns false, if the archive
+     *         could not be opened or read, if it does not contain the
+     *         names of its directories and files, or if the size of one of
+     *         its files cannot be determined.
+     * \remarks The archive is memory-mapped, if possible.
+     */
+    bool add(const std::filesystem::path& path);
+
+    /** \brief Adds an already opened archive on top of the previous ones.
+     *
+     * \param archive  the archive, all structure data must have been read
+     * \return Returns true in case of success. Returns false, if not all
+     *         structure data of the archive is present or if the size of one
+     *         of its files cannot be determined.
+     */
+    bool add(std::unique_ptr<BSA> archive);
+
+    /// Gets the number of archives in the set.
+    std::size_t size() const;
+
+    /// Checks whether the set contains no archives.
+    bool empty() const;
+
+    /** \brief Gets the archive with the given index.
+     *
+     * \param index  index of the archive in load order, must be less than size()
+     * \return Returns a reference to the archive.
+     */
+    const BSA& archive(const std::size_t index) const;
+
+    /** \brief Checks whether a directory exists in any of the archives.
+     *
+     * \param path  path of the directory, using backslashes as separator and
+     *              without leading backslash; the empty string is the root
+     * \return Returns true, if the directory exists or is an intermediate
+     *         directory of any of the archives. Returns false otherwise.
+     */
+    bool isDirectory(const std::string& path) const;
+
+    /** \brief Finds a directory.
+     *
+     * \param path  path of the directory, using backslashes as separator and
+     *              without leading backslash; the empty string is the root
+     * \return Returns a pointer to the contents of the directory, if it
+     *         exists in any of the archives. Returns nullptr otherwise.
+     * \remarks The pointer stays valid until the next call to add() or clear().
+     */
+    const DirectoryEntry* findDirectory(const std::string& path) const;
+
+    /** \brief Finds the archive that provides a file.
+     *
+     * \param path  path of the file, using backslashes as separator and
+     *              without leading backslash
+     * \return Returns a pointer to the entry of the file in the archive with
+     *         the highest priority that contains it. Returns nullptr, if no
+     *         archive contains the file.
+     * \remarks The pointer stays valid until the next call to add() or clear().
+     */
+    const FileEntry* findFile(const std::string& path) const;
+
+    /// Closes all archives and removes them from the set.
+    void clear();
+  private:
+    /** \brief Gets the extracted sizes of all files of an archive.
+     *
+     * \param archive  the archive
+     * \return Returns the sizes, indexed by directory and file index, in case
+     *         of success. Returns an empty optional, if a size could not be
+     *         determined.
+     * \remarks The files are visited in the order of their data in the
+     *          archive, so the archive is read sequentially.
+     */
+    static std::optional<std::vector<std::vector<uint32_t> > > getFileSizes(const BSA& archive);
+
+    /** \brief Gets the entry of a directory, creates it and its parents, if
+     *         it does not exist yet.
+     *
+     * \param path  path of the directory, as stored in the archive
+     * \return Returns a reference to the directory entry.
+     */
+    DirectoryEntry& getOrCreateDirectory(const std::string& path);
+
+    /** \brief Adds the directories and files of the last archive to the index.
+     *
+     * \param sizes  extracted sizes of the files of the last archive
+     */
+    void indexLastArchive(const std::vector<std::vector<uint32_t> >& sizes);
+
+    std::vector<std::unique_ptr<BSA> > m_Archives; /**< archives in load order */
+    std::unordered_map<std::string, FileEntry> m_Files; /**< lower-case file paths and their winning entries */
+    std::unordered_map<std::string, DirectoryEntry> m_Directories; /**< lower-case paths of all directories, including intermediate ones and the root */
+}; // class
+
+} // namespace
+
+#endif // SRTP_BSAFS_ARCHIVESET_HPP
@@ -0,0 +1,183 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "FileCache.hpp"
+#include <limits>
+
+namespace SRTP::bsafs
+{
+
+FileCache::FileCache(const std::size_t capacity)
+: m_Mutex(),
+  m_Capacity(capacity),
+  m_Size(0),
+  m_Entries(),
+  m_Index(),
+  m_Hits(0),
+  m_Misses(0),
+  m_Evictions(0)
+{
+}
+
+FileData FileCache::get(const FileLocation& location)
+{
+  std::lock_guard lock(m_Mutex);
+  const auto iter = m_Index.find(location);
+  if (iter == m_Index.end())
+  {
+    ++m_Misses;
+    return nullptr;
+  }
+  ++m_Hits;
+  // Move entry to the front, it is the most recently used one now.
+  m_Entries.splice(m_Entries.begin(), m_Entries, iter->second);
+  return iter->second->data;
+}
+
+void FileCache::put(const FileLocation& location, FileData data)
+{
+  if (data == nullptr)
+    return;
+
+  std::lock_guard lock(m_Mutex);
+  if (data->size() > m_Capacity)
+    return;
+
+  const Key& key = location;
+  const auto iter = m_Index.find(key);
+  if (iter != m_Index.end())
+  {
+    // Entry may have been added by another thread in the meantime.
+    m_Size -= iter->second->data->size();
+    m_Entries.erase(iter->second);
+    m_Index.erase(iter);
+  }
+
+  makeRoom(data->size());
+  m_Size += data->size();
+  m_Entries.push_front(Entry{ key, std::move(data) });
+  m_Index[key] = m_Entries.begin();
+}
+
+void FileCache::makeRoom(const std::size_t required)
+{
+  while (!m_Entries.empty() && (m_Size + required > m_Capacity))
+  {
+    const Entry& oldest = m_Entries.back();
+    m_Size -= oldest.data->size();
+    m_Index.erase(oldest.key);
+    m_Entries.pop_back();
+    ++m_Evictions;
+  }
+}
+
+void FileCache::clear()
+{
+  std::lock_guard lock(m_Mutex);
+  m_Entries.clear();
+  m_Index.clear();
+  m_Size = 0;
+  m_Hits = 0;
+  m_Misses = 0;
+  m_Evictions = 0;
+}
+
+void FileCache::setCapacity(const std::size_t capacity)
+{
+  std::lock_guard lock(m_Mutex);
+  m_Capacity = capacity;
+  makeRoom(0);
+}
+
+std::size_t FileCache::capacity() const
+{
+  std::lock_guard lock(m_Mutex);
+  return m_Capacity;
+}
+
+std::size_t FileCache::size() const
+{
+  std::lock_guard lock(m_Mutex);
+  return m_Size;
+}
+
+uint64_t FileCache::hits() const
+{
+  std::lock_guard lock(m_Mutex);
+  return m_Hits;
+}
+
+uint64_t FileCache::misses() const
+{
+  std::lock_guard lock(m_Mutex);
+  return m_Misses;
+}
+
+uint64_t FileCache::evictions() const
+{
+  std::lock_guard lock(m_Mutex);
+  return m_Evictions;
+}
+
+std::optional<std::size_t> parseSize(const std::string& text)
+{
+  if (text.empty())
+    return std::nullopt;
+
+  std::size_t multiplier = 1;
+  std::string digits = text;
+  switch (text.back())
+  {
+    case 'k':
+    case 'K':
+         multiplier = 1024;
+         digits.pop_back();
+         break;
+    case 'm':
+    case 'M':
+         multiplier = 1024 * 1024;
+         digits.pop_back();
+         break;
+    case 'g':
+    case 'G':
+         multiplier = 1024 * 1024 * 1024;
+         digits.pop_back();
+         break;
+  }
+  if (digits.empty())
+    return std::nullopt;
+
+  std::size_t value = 0;
+  for (const char c: digits)
+  {
+    if ((c < '0') || (c > '9'))
+      return std::nullopt;
+    const std::size_t digit = static_cast<std::size_t>(c - '0');
+    if (value > (std::numeric_limits<std::size_t>::max() - digit) / 10)
+      return std::nullopt;
+    value = value * 10 + digit;
+  }
+  if (value > std::numeric_limits<std::size_t>::max() / multiplier)
+    return std::nullopt;
+
+  return value * multiplier;
+}
+
+} // namespace
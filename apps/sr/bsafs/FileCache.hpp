@@ -0,0 +1,139 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SRTP_BSAFS_FILECACHE_HPP
+#define SRTP_BSAFS_FILECACHE_HPP
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "FileLocation.hpp"
+
+namespace SRTP::bsafs
+{
+
+/// shared, immutable content of an extracted file
+using FileData = std::shared_ptr<const std::vector<uint8_t> >;
+
+/** Least recently used cache for decompressed files from the archives.
+ *
+ * Files are identified by their location within the mounted archives. The
+ * cache never holds more bytes than its capacity allows. Files which are
+ * larger than the capacity are never cached.
+ */
+class FileCache
+{
+  public:
+    /** \brief Creates an empty cache.
+     *
+     * \param capacity  maximum number of bytes the cache may hold, zero
+     *                  disables caching completely
+     */
+    explicit FileCache(const std::size_t capacity);
+
+    FileCache(const FileCache& other) = delete;
+    FileCache& operator=(const FileCache& other) = delete;
+
+    /** \brief Gets the content of a file from the cache.
+     *
+     * \param location  location of the file in the mounted archives
+     * \return Returns the content of the file, if it is in the cache.
+     *         Returns nullptr otherwise.
+     */
+    FileData get(const FileLocation& location);
+
+    /** \brief Puts the content of a file into the cache.
+     *
+     * \param location  location of the file in the mounted archives
+     * \param data      content of the file
+     * \remarks Least recently used entries are evicted until the new entry
+     *          fits into the cache.
+     */
+    void put(const FileLocation& location, FileData data);
+
+    /** \brief Removes all entries from the cache and resets the counters. */
+    void clear();
+
+    /** \brief Changes the capacity of the cache.
+     *
+     * \param capacity  new maximum number of bytes the cache may hold
+     * \remarks Entries are evicted, if the new capacity is lower than the
+     *          current size.
+     */
+    void setCapacity(const std::size_t capacity);
+
+    /// Gets the maximum number of bytes the cache may hold.
+    std::size_t capacity() const;
+
+    /// Gets the number of bytes that are currently held by the cache.
+    std::size_t size() const;
+
+    /// Gets the number of cache lookups that found the requested file.
+    uint64_t hits() const;
+
+    /// Gets the number of cache lookups that did not find the requested file.
+    uint64_t misses() const;
+
+    /// Gets the number of entries that were removed to make room for others.
+    uint64_t evictions() const;
+  private:
+    using Key = FileLocation;
+
+    struct Entry
+    {
+      Key key;       /**< location of the file */
+      FileData data; /**< content of the file */
+    };
+
+    /** \brief Evicts least recently used entries until the given number of
+     *         bytes is available.
+     *
+     * \param required  number of bytes that have to be free afterwards
+     * \remarks The caller has to hold the mutex.
+     */
+    void makeRoom(const std::size_t required);
+
+    mutable std::mutex m_Mutex; /**< guards all members below */
+    std::size_t m_Capacity; /**< maximum size in bytes */
+    std::size_t m_Size;     /**< current size in bytes */
+    std::list<Entry> m_Entries; /**< entries, most recently used first */
+    std::unordered_map<Key, std::list<Entry>::iterator, FileLocationHash> m_Index; /**< entries by key */
+    uint64_t m_Hits;
+    uint64_t m_Misses;
+    uint64_t m_Evictions;
+}; // class
+
+/** \brief Parses a human-readable size like "512M" into a number of bytes.
+ *
+ * \param text  the text to parse, a number optionally followed by one of the
+ *              suffixes K, M or G (binary units, case-insensitive)
+ * \return Returns the number of bytes in case of success.
+ *         Returns an empty optional, if the text is not a valid size.
+ */
+std::optional<std::size_t> parseSize(const std::string& text);
+
+} // namespace
+
+#endif // SRTP_BSAFS_FILECACHE_HPP
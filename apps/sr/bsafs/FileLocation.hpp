@@ -0,0 +1,58 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SRTP_BSAFS_FILELOCATION_HPP
+#define SRTP_BSAFS_FILELOCATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace SRTP::bsafs
+{
+
+/** Identifies a file within the mounted archives. */
+struct FileLocation
+{
+  uint32_t archive;   /**< index of the archive in the load order */
+  uint32_t directory; /**< index of the directory within the archive */
+  uint32_t file;      /**< index of the file within the directory */
+
+  bool operator==(const FileLocation& other) const
+  {
+    return (archive == other.archive) && (directory == other.directory)
+        && (file == other.file);
+  }
+}; // struct
+
+/** Hash function for FileLocation, so it can be used as key in unordered
+ *  containers. */
+struct FileLocationHash
+{
+  std::size_t operator()(const FileLocation& location) const
+  {
+    const uint64_t indexes = (static_cast<uint64_t>(location.directory) << 32) | location.file;
+    return std::hash<uint64_t>()(indexes) ^ (std::hash<uint32_t>()(location.archive) << 1);
+  }
+}; // struct
+
+} // namespace
+
+#endif // SRTP_BSAFS_FILELOCATION_HPP
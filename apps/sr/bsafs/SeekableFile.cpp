@@ -0,0 +1,200 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "SeekableFile.hpp"
+#include <algorithm>
+
+namespace SRTP::bsafs
+{
+
+SeekableFile::SeekableFile(std::unique_ptr<MWTP::StreamDecompressor> start, const uint64_t size, const uint64_t interval, const std::size_t maxCheckpoints)
+: m_Mutex(),
+  m_Size(size),
+  m_Interval(std::max<uint64_t>(interval, 1)),
+  m_Checkpoints(),
+  m_Current(nullptr)
+{
+  // Checkpoints are at all multiples of the interval below the size, so an
+  // interval of at least size / maxCheckpoints (rounded up) keeps the number
+  // of checkpoints within the limit.
+  const uint64_t limit = std::max<std::size_t>(maxCheckpoints, 1);
+  m_Interval = std::max(m_Interval, (m_Size + limit - 1) / limit);
+  if (start != nullptr)
+  {
+    m_Checkpoints.push_back(std::move(start));
+  }
+}
+
+uint64_t SeekableFile::size() const
+{
+  return m_Size;
+}
+
+std::size_t SeekableFile::checkpoints() const
+{
+  std::lock_guard lock(m_Mutex);
+  return m_Checkpoints.size();
+}
+
+uint64_t SeekableFile::interval() const
+{
+  return m_Interval;
+}
+
+uint64_t SeekableFile::nextBoundary(const uint64_t position) const
+{
+  return std::min((position / m_Interval + 1) * m_Interval, m_Size);
+}
+
+void SeekableFile::addCheckpoint()
+{
+  const uint64_t position = m_Current->totalOut();
+  // Checkpoints are added in order, so the next one is always at the position
+  // right after the last known checkpoint.
+  if (position != m_Checkpoints.size() * m_Interval)
+    return;
+  // A checkpoint at the end of the file would never be used.
+  if (position >= m_Size)
+    return;
+  auto state = m_Current->clone();
+  if (state != nullptr)
+  {
+    m_Checkpoints.push_back(std::move(state));
+  }
+}
+
+bool SeekableFile::advance(const uint64_t offset)
+{
+  while (m_Current->totalOut() < offset)
+  {
+    const uint64_t position = m_Current->totalOut();
+    const uint64_t target = std::min(offset, nextBoundary(position));
+    const auto skipped = m_Current->skip(target - position);
+    if (!skipped.has_value() || (skipped.value() == 0))
+      return false;
+    addCheckpoint();
+  }
+  return true;
+}
+
+std::optional<std::size_t> SeekableFile::read(uint8_t* buffer, const std::size_t count, const uint64_t offset)
+{
+  std::lock_guard lock(m_Mutex);
+  if (m_Checkpoints.empty())
+    return std::nullopt;
+  if ((offset >= m_Size) || (count == 0))
+    return 0;
+
+  // Continue from the nearest checkpoint, unless the position of the last read
+  // is closer to the requested offset.
+  const std::size_t nearest = std::min<uint64_t>(offset / m_Interval, m_Checkpoints.size() - 1);
+  const uint64_t checkpoint_position = nearest * m_Interval;
+  if ((m_Current == nullptr) || (m_Current->totalOut() > offset)
+      || (m_Current->totalOut() < checkpoint_position))
+  {
+    m_Current = m_Checkpoints[nearest]->clone();
+    if (m_Current == nullptr)
+      return std::nullopt;
+  }
+  if (!advance(offset))
+  {
+    m_Current = nullptr;
+    return std::nullopt;
+  }
+
+  const std::size_t wanted = static_cast<std::size_t>(std::min<uint64_t>(count, m_Size - offset));
+  std::size_t done = 0;
+  while (done < wanted)
+  {
+    const uint64_t position = m_Current->totalOut();
+    const std::size_t chunk = static_cast<std::size_t>(std::min<uint64_t>(wanted - done, nextBoundary(position) - position));
+    const auto produced = m_Current->read(buffer + done, chunk);
+    if (!produced.has_value() || (produced.value() == 0))
+    {
+      m_Current = nullptr;
+      return std::nullopt;
+    }
+    done += produced.value();
+    addCheckpoint();
+  }
+  return done;
+}
+
+
+SeekableFileCache::SeekableFileCache(const std::size_t capacity)
+: m_Mutex(),
+  m_Capacity(capacity),
+  m_Entries(),
+  m_Index()
+{
+}
+
+std::shared_ptr<SeekableFile> SeekableFileCache::get(const FileLocation& location)
+{
+  std::lock_guard lock(m_Mutex);
+  const auto iter = m_Index.find(location);
+  if (iter == m_Index.end())
+    return nullptr;
+  // Move entry to the front, it is the most recently used one now.
+  m_Entries.splice(m_Entries.begin(), m_Entries, iter->second);
+  return iter->second->file;
+}
+
+std::shared_ptr<SeekableFile> SeekableFileCache::put(const FileLocation& location, std::shared_ptr<SeekableFile> file)
+{
+  if (file == nullptr)
+    return nullptr;
+
+  std::lock_guard lock(m_Mutex);
+  const Key& key = location;
+  const auto iter = m_Index.find(key);
+  if (iter != m_Index.end())
+  {
+    // Entry may have been added by another thread in the meantime.
+    m_Entries.splice(m_Entries.begin(), m_Entries, iter->second);
+    return iter->second->file;
+  }
+  if (m_Capacity == 0)
+    return file;
+
+  while (m_Entries.size() >= m_Capacity)
+  {
+    m_Index.erase(m_Entries.back().key);
+    m_Entries.pop_back();
+  }
+  m_Entries.push_front(Entry{ key, file });
+  m_Index[key] = m_Entries.begin();
+  return file;
+}
+
+void SeekableFileCache::clear()
+{
+  std::lock_guard lock(m_Mutex);
+  m_Entries.clear();
+  m_Index.clear();
+}
+
+std::size_t SeekableFileCache::size() const
+{
+  std::lock_guard lock(m_Mutex);
+  return m_Entries.size();
+}
+
+} // namespace
@@ -0,0 +1,185 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SRTP_BSAFS_SEEKABLEFILE_HPP
+#define SRTP_BSAFS_SEEKABLEFILE_HPP
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "FileLocation.hpp"
+#include "../../../lib/base/StreamDecompressor.hpp"
+
+namespace SRTP::bsafs
+{
+
+/** Random access to the decompressed content of a compressed file without
+ *  decompressing the whole file.
+ *
+ * Whenever decompression passes a multiple of the checkpoint interval, a copy
+ * of the decompression state is kept. A read at a given offset continues from
+ * the nearest checkpoint before that offset, or from the position where the
+ * previous read ended, whichever is closer. So sequential reads never
+ * decompress data twice, and a read at an arbitrary offset decompresses at
+ * most one interval of data that is not returned.
+ *
+ * Each checkpoint holds a complete copy of the decompression state, which is
+ * about 40 KiB for zlib, because that includes its 32 KiB window. The number
+ * of checkpoints per file is limited, so very large files get a larger
+ * interval instead of more checkpoints.
+ *
+ * All methods are thread-safe.
+ */
+class SeekableFile
+{
+  public:
+    /** \brief Creates a seekable file.
+     *
+     * \param start     decompressor that is fed with the whole compressed data
+     *                  and that has not decompressed anything yet
+     * \param size      size of the decompressed data in bytes
+     * \param interval  distance between two checkpoints in bytes, not zero
+     * \param maxCheckpoints  maximum number of checkpoints, including the one
+     *                        at the start
+     * \remarks The compressed data has to stay valid as long as the instance
+     *          exists. This is the case for data of a memory-mapped archive.
+     *          If size / interval is more than maxCheckpoints, then the
+     *          interval is increased, so that the checkpoints are spread over
+     *          the whole file.
+     */
+    SeekableFile(std::unique_ptr<MWTP::StreamDecompressor> start, const uint64_t size, const uint64_t interval, const std::size_t maxCheckpoints);
+
+    SeekableFile(const SeekableFile& other) = delete;
+    SeekableFile& operator=(const SeekableFile& other) = delete;
+
+    /** \brief Reads decompressed data.
+     *
+     * \param buffer  the buffer that will hold the data
+     * \param count   maximum number of bytes to read
+     * \param offset  offset of the first byte in the decompressed data
+     * \return Returns the number of bytes that were read, which is only less
+     *         than count at the end of the file. Returns an empty optional,
+     *         if an error occurred.
+     */
+    std::optional<std::size_t> read(uint8_t* buffer, const std::size_t count, const uint64_t offset);
+
+    /// Gets the size of the decompressed data in bytes.
+    uint64_t size() const;
+
+    /// Gets the number of checkpoints, including the one at the start.
+    std::size_t checkpoints() const;
+
+    /// Gets the distance between two checkpoints in bytes.
+    uint64_t interval() const;
+  private:
+    /** \brief Decompresses and discards data up to the given offset.
+     *
+     * \param offset  the wanted position in the decompressed data
+     * \return Returns true in case of success. Returns false otherwise.
+     * \remarks The caller has to hold the mutex.
+     */
+    bool advance(const uint64_t offset);
+
+    /** \brief Keeps a checkpoint, if the current position is at the next
+     *         multiple of the interval that has no checkpoint yet.
+     *
+     * \remarks The caller has to hold the mutex.
+     */
+    void addCheckpoint();
+
+    /** \brief Gets the next multiple of the interval after a position.
+     *
+     * \param position  a position in the decompressed data
+     * \return Returns the next multiple of the interval, but never more than
+     *         the size of the decompressed data.
+     */
+    uint64_t nextBoundary(const uint64_t position) const;
+
+    mutable std::mutex m_Mutex; /**< guards all members below */
+    uint64_t m_Size;            /**< size of the decompressed data */
+    uint64_t m_Interval;        /**< distance between checkpoints */
+    std::vector<std::unique_ptr<MWTP::StreamDecompressor> > m_Checkpoints; /**< states at multiples of the interval */
+    std::unique_ptr<MWTP::StreamDecompressor> m_Current; /**< state after the last read */
+}; // class
+
+/** Keeps the seekable files of the most recently read files, so that their
+ *  checkpoints can be used by later reads.
+ *
+ * Files are identified by their location within the mounted archives. Only a
+ * limited number of files is kept, because each checkpoint needs some memory
+ * for the decompression state. So the memory used by all checkpoints is at
+ * most capacity * maximum checkpoints per file * size of one checkpoint.
+ */
+class SeekableFileCache
+{
+  public:
+    /** \brief Creates an empty cache.
+     *
+     * \param capacity  maximum number of files the cache may hold
+     */
+    explicit SeekableFileCache(const std::size_t capacity);
+
+    SeekableFileCache(const SeekableFileCache& other) = delete;
+    SeekableFileCache& operator=(const SeekableFileCache& other) = delete;
+
+    /** \brief Gets a file from the cache.
+     *
+     * \param location  location of the file in the mounted archives
+     * \return Returns the file, if it is in the cache. Returns nullptr otherwise.
+     */
+    std::shared_ptr<SeekableFile> get(const FileLocation& location);
+
+    /** \brief Puts a file into the cache.
+     *
+     * \param location  location of the file in the mounted archives
+     * \param file      the file
+     * \return Returns the file that is in the cache afterwards. If another
+     *         thread added the same file in the meantime, then that one is
+     *         returned and kept, so that its checkpoints are not lost.
+     */
+    std::shared_ptr<SeekableFile> put(const FileLocation& location, std::shared_ptr<SeekableFile> file);
+
+    /** \brief Removes all files from the cache. */
+    void clear();
+
+    /// Gets the number of files that are currently held by the cache.
+    std::size_t size() const;
+  private:
+    using Key = FileLocation;
+
+    struct Entry
+    {
+      Key key;                            /**< location of the file */
+      std::shared_ptr<SeekableFile> file; /**< the file */
+    };
+
+    mutable std::mutex m_Mutex; /**< guards all members below */
+    std::size_t m_Capacity;     /**< maximum number of files */
+    std::list<Entry> m_Entries; /**< entries, most recently used first */
+    std::unordered_map<Key, std::list<Entry>::iterator, FileLocationHash> m_Index; /**< entries by key */
+}; // class
+
+} // namespace
+
+#endif // SRTP_BSAFS_SEEKABLEFILE_HPP
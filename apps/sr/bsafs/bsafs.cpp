@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2024  Dirk Stolle
+    Copyright (C) 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -28,14 +28,14 @@
 #include <sys/stat.h>
 #include <type_traits>
 #include <unistd.h>
-#include "../../../lib/base/FileGuard.hpp"
 #include "../../../lib/base/SlashFunctions.hpp"
-#include "../../../lib/base/RandomFunctions.hpp"
 
 namespace SRTP::bsafs
 {
 
-BSA archive;
+ArchiveSet archives;
+FileCache cache(default_cache_size);
+SeekableFileCache seekable_files(default_seekable_files);
 std::time_t access_time;
 std::time_t modification_time;
 std::time_t status_change_time;
@@ -72,6 +72,45 @@ std::string fuseVersion()
   return std::to_string(major).append(".").append(std::to_string(minor));
 }
 
+bool runs_in_foreground(const std::vector<std::string>& fuse_parameters)
+{
+  const auto count = fuse_parameters.size();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const std::string& param = fuse_parameters[i];
+    // -d implies -f
+    if ((param == "-f") || (param == "-d"))
+    {
+      return true;
+    }
+    // Mount options are given as "-o opt1,opt2" or as "-oopt1,opt2".
+    std::string options;
+    if (param == "-o")
+    {
+      if (i + 1 < count)
+      {
+        options = fuse_parameters[i + 1];
+        ++i;
+      }
+    }
+    else if (param.substr(0, 2) == "-o")
+    {
+      options = param.substr(2);
+    }
+    std::string::size_type start = 0;
+    while (start < options.size())
+    {
+      auto end = options.find(',', start);
+      if (end == std::string::npos)
+        end = options.size();
+      if (options.compare(start, end - start, "debug") == 0)
+        return true;
+      start = end + 1;
+    }
+  }
+  return false;
+}
+
 void set_common_attributes(struct stat& attr)
 {
   attr.st_uid = getuid();
@@ -97,6 +136,39 @@ void set_file_attributes(struct stat& attr)
   attr.st_mode = S_IFREG | 0644;
 }
 
+std::shared_ptr<SeekableFile> get_seekable_file(const FileLocation& location)
+{
+  const BSA& archive = archives.archive(location.archive);
+  // Only zlib allows to copy the decompression state, LZ4 (version 105) does not.
+  if (!archive.isMemoryMapped() || (archive.getHeader().version >= 105)
+      || !archive.isFileCompressed(location.directory, location.file))
+  {
+    return nullptr;
+  }
+  auto file = seekable_files.get(location);
+  if (file != nullptr)
+  {
+    return file;
+  }
+
+  const auto block = archive.getFileBlock(location.directory, location.file);
+  if (!block.has_value() || (block.value().size() < 4))
+  {
+    return nullptr;
+  }
+  uint32_t decompressed_size = 0;
+  std::memcpy(&decompressed_size, block.value().data(), 4);
+  if (decompressed_size < seekable_file_threshold)
+  {
+    return nullptr;
+  }
+  // The compressed data stays valid, because the archive is memory-mapped.
+  auto start = std::make_unique<MWTP::ZlibStreamDecompressor>();
+  start->feed(block.value().data() + 4, block.value().size() - 4);
+  file = std::make_shared<SeekableFile>(std::move(start), decompressed_size, checkpoint_interval, max_checkpoints_per_file);
+  return seekable_files.put(location, file);
+}
+
 int bsa_getattr(const char * pathname, struct stat * attr, [[maybe_unused]] struct fuse_file_info *fi)
 {
   #ifdef BSAFS_DEBUG
@@ -113,32 +185,19 @@ int bsa_getattr(const char * pathname, struct stat * attr, [[maybe_unused]] stru
   }
 
   const std::string real_path = MWTP::flipForwardSlashes(pathname).substr(1);
-  auto dir_index = archive.getIndexOfDirectory(real_path);
-  if (dir_index.has_value() || archive.hasIntermediateDirectory(real_path))
+  if (archives.isDirectory(real_path))
   {
     set_directory_attributes(*attr);
     return 0;
   }
 
-  std::optional<uint32_t> file_index;
-  if (archive.getIndexPairForFile(real_path, dir_index, file_index))
+  const FileEntry* file = archives.findFile(real_path);
+  if (file != nullptr)
   {
-    if (dir_index.has_value() && file_index.has_value())
-    {
-      const auto opt_size = archive.getExtractedFileSize(dir_index.value(), file_index.value());
-      if (opt_size.has_value())
-      {
-        const auto file_size = opt_size.value();
-        set_file_attributes(*attr);
-        attr->st_size = file_size;
-        attr->st_blocks = file_size / 512 + (file_size % 512 != 0);
-        return 0;
-      }
-      else
-      {
-        return -EIO;
-      }
-    }
+    set_file_attributes(*attr);
+    attr->st_size = file->size;
+    attr->st_blocks = file->size / 512 + (file->size % 512 != 0);
+    return 0;
   }
 
   return -ENOENT;
@@ -162,6 +221,13 @@ int bsa_readdir(const char* path, void* buffer, fuse_fill_dir_t filler,
   #ifdef BSAFS_DEBUG
   std::clog << "DEBUG: readdir(" << path << ", ..., ..., offset=" << offset << ", ...)\n";
   #endif // BSAFS_DEBUG
+  const std::string real_path = MWTP::flipForwardSlashes(path).substr(1);
+  const DirectoryEntry* directory = archives.findDirectory(real_path);
+  if (directory == nullptr)
+  {
+    return -ENOENT;
+  }
+
   struct stat attr;
   std::memset(&attr, 0, sizeof(attr));
   set_directory_attributes(attr);
@@ -169,34 +235,18 @@ int bsa_readdir(const char* path, void* buffer, fuse_fill_dir_t filler,
   filler(buffer, ".", &attr, 0, zero_flag);
   filler(buffer, "..", std::string(path) == "/" ? nullptr : &attr, 0, zero_flag);
 
-  const std::string real_path = MWTP::flipForwardSlashes(path).substr(1);
-
-  // Get sub-directories, if any.
-  const auto directories = archive.getVirtualSubDirectories(real_path);
-  for (const auto& entry: directories)
+  // Everything is already known from the index built at mount time.
+  for (const auto& name: directory->directories)
   {
-    filler(buffer, entry.c_str(), &attr, 0, zero_flag);
+    filler(buffer, name.c_str(), &attr, 0, zero_flag);
   }
 
-  // List all files in a directory.
-  const auto dir_index = archive.getIndexOfDirectory(real_path);
-  if (dir_index.has_value())
+  set_file_attributes(attr);
+  for (const FileEntry* file: directory->files)
   {
-    const auto& block = archive.getDirectoryBlocks()[dir_index.value()];
-    set_file_attributes(attr);
-    for (std::vector<BSAFileRecord>::size_type idx = 0; idx < block.files.size(); ++idx)
-    {
-      const auto size = archive.getExtractedFileSize(dir_index.value(), idx);
-      if (size.has_value())
-      {
-        attr.st_size = size.value();
-      }
-      else
-      {
-        return -EIO;
-      }
-      filler(buffer, block.files[idx].fileName.c_str(), &attr, 0, zero_flag);
-    }
+    attr.st_size = file->size;
+    attr.st_blocks = file->size / 512 + (file->size % 512 != 0);
+    filler(buffer, file->name.c_str(), &attr, 0, zero_flag);
   }
 
   return 0;
@@ -256,32 +306,9 @@ int bsa_truncate([[maybe_unused]] const char* path, [[maybe_unused]] off_t lengt
   return -EROFS;
 }
 
-std::optional<std::filesystem::path> temporary_file_path(const std::filesystem::path& directory)
-{
-  namespace fs = std::filesystem;
-
-  fs::path file_path = directory / MWTP::randomAlphaNumericSequence(12).append(".tmp");
-  unsigned int i = 0;
-  while (fs::exists(file_path))
-  {
-    ++i;
-    if (i > 10)
-    {
-      #ifdef BSAFS_DEBUG
-      std::cerr << "Error: Could not find suitable temporary file path.\n";
-      #endif // BSAFS_DEBUG
-      return std::nullopt;
-    }
-    file_path = directory / MWTP::randomAlphaNumericSequence(12).append(".tmp");
-  }
-
-  return file_path;
-}
-
 int bsa_read(const char* path, char* buffer, size_t count, off_t offset,
 		     [[maybe_unused]] struct fuse_file_info* info)
 {
-  namespace fs = std::filesystem;
   #ifdef BSAFS_DEBUG
   std::clog << "DEBUG: read(" << path << ", ..., count=" << count << ", offset="
             << offset << ", ...)\n";
@@ -289,91 +316,73 @@ int bsa_read(const char* path, char* buffer, size_t count, off_t offset,
 
   const std::string real_path = MWTP::flipForwardSlashes(path).substr(1);
   // Check for directory.
-  auto dir_index = archive.getIndexOfDirectory(real_path);
-  if (dir_index.has_value() || archive.hasIntermediateDirectory(real_path))
+  if (archives.isDirectory(real_path))
   {
     return -EISDIR;
   }
 
   // Is it an existing file?
-  std::optional<uint32_t> file_index = std::nullopt;
-  if (!archive.getIndexPairForFile(real_path, dir_index, file_index))
-  {
-    return -EIO;
-  }
-
-  if (!dir_index.has_value() || !file_index.has_value())
+  const FileEntry* file = archives.findFile(real_path);
+  if (file == nullptr)
   {
     // File does not exist.
     return -ENOENT;
   }
+  const FileLocation& location = file->location;
 
-  const auto extracted_size = archive.getExtractedFileSize(dir_index.value(),
-                                                           file_index.value());
-  if (!extracted_size.has_value())
-  {
-    #ifdef BSAFS_DEBUG
-    std::clog << "DEBUG: Could not calculate extracted file size.\n";
-    #endif // BSAFS_DEBUG
-    return -EIO;
-  }
-
-  if ((offset >= extracted_size) && (count > 0))
-  {
-    return -EIO;
-  }
-  std::error_code error;
-  auto temp_dir_path = fs::temp_directory_path(error);
-  if (error)
+  using cast_type = std::make_unsigned_t<decltype(offset)>;
+  const auto seekable = get_seekable_file(location);
+  if (seekable != nullptr)
   {
+    // Large compressed files are decompressed from the nearest checkpoint
+    // instead of being extracted completely.
+    if ((offset < 0) || ((static_cast<cast_type>(offset) >= seekable->size()) && (count > 0)))
+    {
+      return -EIO;
+    }
+    const auto bytes_read = seekable->read(reinterpret_cast<uint8_t*>(buffer), count, offset);
+    if (!bytes_read.has_value())
+    {
+      #ifdef BSAFS_DEBUG
+      std::clog << "DEBUG: Decompression of file from archive failed.\n";
+      #endif // BSAFS_DEBUG
+      return -EIO;
+    }
     #ifdef BSAFS_DEBUG
-    std::clog << "DEBUG: Could not get temporary directory path.\n";
+    std::clog << "DEBUG: Transferred " << bytes_read.value() << " of the requested "
+              << count << " bytes.\n";
     #endif // BSAFS_DEBUG
-    return -EIO;
+    return bytes_read.value();
   }
 
-  const auto file_path = temporary_file_path(temp_dir_path);
-  if (!file_path.has_value())
+  FileData data = cache.get(location);
+  if (data == nullptr)
   {
-    return -EIO;
-  }
-  MWTP::FileGuard guard {file_path.value()};
-  if (!archive.extractFile(dir_index.value(), file_index.value(), file_path.value().string()))
-  {
-    #ifdef BSAFS_DEBUG
-    std::clog << "DEBUG: File extraction from archive failed.\n";
-    #endif // BSAFS_DEBUG
-    return -EIO;
+    auto extracted = archives.archive(location.archive)
+        .extractFileToMemory(location.directory, location.file);
+    if (!extracted.has_value())
+    {
+      #ifdef BSAFS_DEBUG
+      std::clog << "DEBUG: File extraction from archive failed.\n";
+      #endif // BSAFS_DEBUG
+      return -EIO;
+    }
+    data = std::make_shared<const std::vector<uint8_t> >(std::move(extracted.value()));
+    cache.put(location, data);
   }
 
-  std::ifstream stream(file_path.value());
-  stream.seekg(offset);
-  if (!stream.good())
-  {
-    #ifdef BSAFS_DEBUG
-    std::clog << "DEBUG: Could not jump to offset " << offset << ".\n";
-    #endif // BSAFS_DEBUG
-    return -EIO;
-  }
-  using cast_type = std::make_unsigned_t<decltype(offset)>;
-  const auto max_bytes = std::min(count, extracted_size.value() - static_cast<cast_type>(offset));
-  stream.read(buffer, max_bytes);
-  if (stream.fail())
+  const auto extracted_size = data->size();
+  if ((offset < 0) || ((static_cast<cast_type>(offset) >= extracted_size) && (count > 0)))
   {
-    #ifdef BSAFS_DEBUG
-    std::clog << "DEBUG: Reading data to buffer failed.\n";
-    std::clog << "DEBUG: eof: " << std::boolalpha << stream.eof() << ", bad: "
-              << stream.bad() << ", fail: " << stream.fail() << "\n";
-    #endif // BSAFS_DEBUG
     return -EIO;
   }
-  const auto bytes_read = stream.gcount();
-  stream.close();
+  const auto max_bytes = std::min(count, extracted_size - static_cast<cast_type>(offset));
+  std::memcpy(buffer, data->data() + offset, max_bytes);
   #ifdef BSAFS_DEBUG
-  std::clog << "DEBUG: Transferred " << bytes_read << " of the requested "
+  std::clog << "DEBUG: Transferred " << max_bytes << " of the requested "
             << count << " bytes.\n";
   #endif // BSAFS_DEBUG
-  return bytes_read;
+  return max_bytes;
 }
 
 fuse_operations get_operations()
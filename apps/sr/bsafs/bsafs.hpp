@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2024  Dirk Stolle
+    Copyright (C) 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -23,21 +23,52 @@
 
 #define FUSE_USE_VERSION 39
 #include <fuse3/fuse.h>
+#include <string>
 #include <sys/stat.h>
-#include "../../../lib/sr/bsa/BSA.hpp"
+#include <vector>
+#include "ArchiveSet.hpp"
+#include "FileCache.hpp"
+#include "SeekableFile.hpp"
 
 namespace SRTP::bsafs
 {
 
-extern BSA archive; /**< global BSA instance for all file operations */
+extern ArchiveSet archives; /**< global set of mounted archives for all file operations */
 
-extern std::time_t access_time;        /**< last access time of the archive */
-extern std::time_t modification_time;  /**< modification time of the archive */
-extern std::time_t status_change_time; /**< last status change of the archive */
+/// default capacity of the cache for extracted files in bytes (256 MiB)
+constexpr std::size_t default_cache_size = 256 * 1024 * 1024;
+
+extern FileCache cache; /**< cache for extracted files of the archive */
+
+/// distance between two checkpoints of the decompression state in bytes (1 MiB)
+constexpr uint64_t checkpoint_interval = 1024 * 1024;
+
+/// minimum decompressed size of compressed files that are read via checkpoints
+/// instead of being extracted as a whole (4 MiB)
+constexpr uint64_t seekable_file_threshold = 4 * checkpoint_interval;
+
+/// default number of files whose checkpoints are kept
+constexpr std::size_t default_seekable_files = 16;
+
+/** maximum number of checkpoints per file, larger files get a larger interval
+ *  between their checkpoints instead
+ *
+ * Each checkpoint needs about 40 KiB for the zlib state and its window, so the
+ * checkpoints of one file need about 1.25 MiB at most, and the checkpoints of
+ * all default_seekable_files files need about 20 MiB at most. That memory is
+ * not part of the cache size for extracted files.
+ */
+constexpr std::size_t max_checkpoints_per_file = 32;
+
+extern SeekableFileCache seekable_files; /**< checkpoints of large compressed files */
+
+extern std::time_t access_time;        /**< last access time of the archives */
+extern std::time_t modification_time;  /**< modification time of the archives */
+extern std::time_t status_change_time; /**< last status change of the archives */
 
 /** \brief Sets the values of the three time_t variables above based on the given file.
  *
- * \param bsa_path   path to the BSA file
+ * \param bsa_path   path to the BSA file, usually the last one in load order
  * \remarks This function should be called once before the file system is
  *          mounted. Otherwise the time values reported for the files are
  *          incorrect / set to the current time.
@@ -54,6 +85,27 @@ void set_time_values(const std::filesystem::path& bsa_path);
  */
 std::string fuseVersion();
 
+/** \brief Checks whether FUSE stays in the foreground with the given parameters.
+ *
+ * \param fuse_parameters  the parameters that are passed on to FUSE, without
+ *                         the program name
+ * \return Returns true, if one of the parameters is -f or -d, or if the mount
+ *         option "debug" is set via -o. Returns false otherwise.
+ */
+bool runs_in_foreground(const std::vector<std::string>& fuse_parameters);
+
+/** \brief Gets the seekable file for a large compressed file of an archive.
+ *
+ * \param location  location of the file in the mounted archives
+ * \return Returns the seekable file, if the file is zlib-compressed and its
+ *         decompressed size is at least seekable_file_threshold bytes.
+ *         Returns nullptr otherwise, i.e. the file has to be extracted as a
+ *         whole.
+ * \remarks LZ4-compressed files are always extracted as a whole, because the
+ *          LZ4 decompression state cannot be copied to create checkpoints.
+ */
+std::shared_ptr<SeekableFile> get_seekable_file(const FileLocation& location);
+
 int bsa_getattr(const char* pathname, struct stat * attr, struct fuse_file_info *fi);
 
 int bsa_readdir(const char* path, void* buffer, fuse_fill_dir_t filler,
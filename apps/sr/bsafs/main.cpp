@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2024  Dirk Stolle
+    Copyright (C) 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -18,6 +18,7 @@
  -------------------------------------------------------------------------------
 */
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -30,7 +31,7 @@
 
 void showVersion()
 {
-  std::cout << "bsafs - FUSE file system for Skyrim BSA archives, version 0.3.0, 2024-01-31\n"
+  std::cout << "bsafs - FUSE file system for Skyrim BSA archives, version 0.4.0, 2026-10-17\n"
             << "\nLibrary versions:\n"
             << " * fuse: " << SRTP::bsafs::fuseVersion() << "\n"
             << " * lz4:  " << MWTP::lz4Version() << "\n"
@@ -39,7 +40,7 @@ void showVersion()
 
 void showHelp()
 {
-  std::cout << "bsafs [OPTIONS] --archive BSA_FILE MOUNT_POINT\n"
+  std::cout << "bsafs [OPTIONS] --archive BSA_FILE [--archive BSA_FILE ...] MOUNT_POINT\n"
             << "\n"
             << "options:\n"
             << "  --help             - Displays this help message and quits.\n"
@@ -47,7 +48,15 @@ void showHelp()
             << "  --version          - Displays the version of the program and quits.\n"
             << "  -v                 - same as --version\n"
             << "  --archive BSA_FILE - Set path to the BSA file to operate on to BSA_FILE.\n"
-            << "                       The BSA_FILE must be given.\n"
+            << "                       The BSA_FILE must be given. The parameter can be\n"
+            << "                       repeated to mount several archives as one merged\n"
+            << "                       file system. Archives are given in load order, i.e.\n"
+            << "                       files of later archives override files with the\n"
+            << "                       same path in earlier archives.\n"
+            << "  --cache-size SIZE  - Set the maximum amount of memory that is used to cache\n"
+            << "                       extracted files to SIZE bytes. SIZE may have one of\n"
+            << "                       the suffixes K, M or G for KiB, MiB or GiB, e.g. 512M.\n"
+            << "                       Zero disables the cache. Default is 256M.\n"
             << "\n"
             << "Furthermore, some FUSE-specific parameters apply.\n";
 }
@@ -57,13 +66,15 @@ int main(int argc, char* argv[])
   std::unique_ptr<char*[]> fuse_args = std::make_unique<char*[]>(argc + 1);
   int fuse_argc = 0;
   fuse_args[argc] = nullptr;
+  // parameters for FUSE without the program name
+  std::vector<std::string> fuse_parameters;
   if ((argc > 0) && (argv != nullptr))
   {
     fuse_argc = 1;
     fuse_args[0] = argv[0];
   }
 
-  std::string archive_path;
+  std::vector<std::string> archive_paths;
 
   if ((argc > 1) && (argv != nullptr))
   {
@@ -87,20 +98,43 @@ int main(int argc, char* argv[])
         }
         else if (param == "--archive")
         {
-          if (!archive_path.empty())
+          // enough parameters?
+          if ((i+1 < argc) && (argv[i+1] != nullptr))
+          {
+            const std::string archive_path = std::string(argv[i+1]);
+            if (std::find(archive_paths.begin(), archive_paths.end(), archive_path) != archive_paths.end())
+            {
+              std::cerr << "Error: Archive " << archive_path << " was already specified.\n";
+              return SRTP::rcInvalidParameter;
+            }
+            archive_paths.push_back(archive_path);
+            ++i; // skip next parameter, because it's already used as path
+          }
+          else
           {
-            std::cerr << "Error: Archive path was already specified.\n";
+            std::cerr << "Error: You have to enter the path to a BSA file after \""
+                      << param << "\".\n";
             return SRTP::rcInvalidParameter;
           }
+        }
+        else if (param == "--cache-size")
+        {
           // enough parameters?
           if ((i+1 < argc) && (argv[i+1] != nullptr))
           {
-            archive_path = std::string(argv[i+1]);
-            ++i; // skip next parameter, because it's already used as path
+            const auto size = SRTP::bsafs::parseSize(argv[i+1]);
+            if (!size.has_value())
+            {
+              std::cerr << "Error: \"" << argv[i+1] << "\" is not a valid "
+                        << "cache size.\n";
+              return SRTP::rcInvalidParameter;
+            }
+            SRTP::bsafs::cache.setCapacity(size.value());
+            ++i; // skip next parameter, because it's already used as size
           }
           else
           {
-            std::cerr << "Error: You have to enter the path to a BSA file after \""
+            std::cerr << "Error: You have to enter a size after \""
                       << param << "\".\n";
             return SRTP::rcInvalidParameter;
           }
@@ -108,6 +142,7 @@ int main(int argc, char* argv[])
         else
         {
           // unknown parameter, probably fuse-related
+          fuse_parameters.push_back(param);
           fuse_args[fuse_argc] = argv[i];
           fuse_argc++;
         }
@@ -127,7 +162,7 @@ int main(int argc, char* argv[])
     return SRTP::rcInvalidParameter;
   }
 
-  if (archive_path.empty())
+  if (archive_paths.empty())
   {
     std::cerr << "You have to specify the path to the archive file via the "
               << "--archive parameter for this program to run properly.\n"
@@ -135,31 +170,39 @@ int main(int argc, char* argv[])
     return SRTP::rcInvalidParameter;
   }
 
-  if (!SRTP::bsafs::archive.open(archive_path))
-  {
-    return SRTP::rcFileError;
-  }
-  // Some BSA files do not contain information about directory and file names.
-  // These are useless for us.
-  const auto& header = SRTP::bsafs::archive.getHeader();
-  if (!header.hasNamesForDirectories() || !header.hasNamesForFiles())
-  {
-    std::cout << "Info: The file " << archive_path << " does not contain "
-              << "information about its directory names and file names."
-              << "Therefore, it cannot be mounted as file system.\n";
-    return 0;
-  }
-  if (!SRTP::bsafs::archive.grabAllStructureData())
+  // Archives are indexed in load order, later ones override earlier ones.
+  for (const auto& archive_path: archive_paths)
   {
-    return SRTP::rcFileError;
+    if (!SRTP::bsafs::archives.add(archive_path))
+    {
+      std::cerr << "Error: Could not load archive " << archive_path << ".\n";
+      return SRTP::rcFileError;
+    }
   }
-  SRTP::bsafs::set_time_values(archive_path);
+  SRTP::bsafs::set_time_values(archive_paths.back());
 
   for (int i = fuse_argc + 1; i < argc; ++i)
   {
     fuse_args[i] = nullptr;
   }
 
+  // FUSE handles requests in several threads, unless the option -s is given.
+  // That is fine, because reading from the archive does not change its state
+  // once all structure data has been read, and the caches use locks.
   const auto operations = SRTP::bsafs::get_operations();
-  return fuse_main(fuse_argc, fuse_args.get(), &operations, nullptr);
+  const int fuse_result = fuse_main(fuse_argc, fuse_args.get(), &operations, nullptr);
+  // A daemonized process writes to /dev/null, so the statistics are only
+  // shown in foreground mode or in debug builds.
+  #ifdef BSAFS_DEBUG
+  const bool foreground = true;
+  #else
+  const bool foreground = SRTP::bsafs::runs_in_foreground(fuse_parameters);
+  #endif // BSAFS_DEBUG
+  if ((fuse_result == 0) && foreground)
+  {
+    std::clog << "Cache statistics: " << SRTP::bsafs::cache.hits() << " hit(s), "
+              << SRTP::bsafs::cache.misses() << " miss(es), "
+              << SRTP::bsafs::cache.evictions() << " eviction(s)\n";
+  }
+  return fuse_result;
 }
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2012, 2013, 2021, 2022  Dirk Stolle
+    Copyright (C) 2011, 2012, 2013, 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,6 +19,9 @@
 */
 
 #include "ESMReaderFinder.hpp"
+#include <iostream>
+#include <utility>
+#include "../../../lib/mw/HelperIO.hpp"
 #include "../../../lib/sr/SR_Constants.hpp"
 #include "../../../lib/sr/Activators.hpp"
 #include "../../../lib/sr/AlchemyPotions.hpp"
@@ -48,9 +51,154 @@
 namespace SRTP
 {
 
+namespace
+{
+
+LocalizedString indexedString(const std::optional<std::string>& str)
+{
+  if (!str.has_value())
+    return LocalizedString();
+  return LocalizedString(LocalizedString::Type::String, 0, str.value());
+}
+
+// calls a function for each record manager that the reader fills
+template<typename Function>
+void forAllManagers(Function function)
+{
+  function(Activators::get());
+  function(AlchemyPotions::get());
+  function(Ammunitions::get());
+  function(Apparatuses::get());
+  function(Armours::get());
+  function(Books::get());
+  function(Containers::get());
+  function(Factions::get());
+  function(Floras::get());
+  function(Furniture::get());
+  function(Ingredients::get());
+  function(Keys::get());
+  function(MiscObjects::get());
+  function(NPCs::get());
+  function(Perks::get());
+  function(Quests::get());
+  function(Scrolls::get());
+  function(Shouts::get());
+  function(SoulGems::get());
+  function(Spells::get());
+  function(TalkingActivators::get());
+  function(Trees::get());
+  function(Weapons::get());
+  function(WordsOfPower::get());
+}
+
+template<typename recT>
+recT indexedRecord(const PluginIndex::Record& entry)
+{
+  recT record;
+  record.headerFormID = entry.formID;
+  record.editorID = entry.editorID;
+  record.name = indexedString(entry.name);
+  return record;
+}
+
+bool projectedString(const ProjectedSubRecord& sub, const bool localized, const StringTable& table, std::optional<std::string>& target)
+{
+  std::string str;
+  if (!sub.getString(localized, table, str))
+    return false;
+  target = std::move(str);
+  return true;
+}
+
+// fills an index entry with the subrecords of a projected record
+bool projectRecord(const RecordProjection& projection, const bool localized, const StringTable& table, PluginIndex::Record& entry)
+{
+  for (const auto& sub: projection.subRecords())
+  {
+    switch (sub.name)
+    {
+      case cEDID:
+           if (!sub.getString(false, table, entry.editorID))
+             return false;
+           break;
+      case cFULL:
+           if (!projectedString(sub, localized, table, entry.name))
+             return false;
+           break;
+      case cRNAM:
+           entry.ranks.push_back(PluginIndex::Rank{ 0, std::nullopt, std::nullopt });
+           if (!sub.getValue(entry.ranks.back().index))
+             return false;
+           break;
+      case cMNAM:
+           if (entry.ranks.empty())
+             return false;
+           if (!projectedString(sub, localized, table, entry.ranks.back().maleName))
+             return false;
+           break;
+      case cFNAM:
+           if (entry.ranks.empty())
+             return false;
+           if (!projectedString(sub, localized, table, entry.ranks.back().femaleName))
+             return false;
+           break;
+      case cINDX:
+           entry.stages.push_back(PluginIndex::Stage{ 0, { } });
+           if (!sub.getValue(entry.stages.back().index))
+             return false;
+           break;
+      case cQSDT:
+           {
+             uint8_t flags = 0;
+             if (entry.stages.empty() || !sub.getValue(flags))
+               return false;
+             entry.stages.back().logEntries.push_back(PluginIndex::LogEntry{ flags != 0, std::nullopt });
+           }
+           break;
+      case cCNAM:
+           if (entry.stages.empty() || entry.stages.back().logEntries.empty())
+             return false;
+           if (!projectedString(sub, localized, table, entry.stages.back().logEntries.back().text))
+             return false;
+           break;
+      case cQOBJ:
+           entry.objectives.push_back(PluginIndex::Objective{ 0, std::nullopt });
+           if (!sub.getValue(entry.objectives.back().index))
+             return false;
+           break;
+      case cNNAM:
+           if (entry.objectives.empty())
+             return false;
+           if (!projectedString(sub, localized, table, entry.objectives.back().text))
+             return false;
+           break;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
 ESMReaderFinder::ESMReaderFinder(const std::vector<std::string>& loadOrder)
-: ESMReaderReIndexMod(loadOrder)
+: ESMReaderReIndexMod(loadOrder),
+  m_Index(nullptr),
+  m_Projection(RecordProjection())
 {
+  for (const uint32_t recName: { cACTI, cALCH, cAMMO, cAPPA, cARMO, cBOOK,
+       cCONT, cFACT, cFLOR, cFURN, cINGR, cKEYM, cMISC, cNPC_, cPERK, cQUST,
+       cSCRL, cSHOU, cSLGM, cSPEL, cTACT, cTREE, cWEAP, cWOOP })
+  {
+    m_Projection.add(recName, { cEDID, cFULL });
+  }
+  // ranks of factions
+  m_Projection.add(cFACT, { cRNAM, cMNAM, cFNAM });
+  // stages, log entries and objectives of quests
+  m_Projection.add(cQUST, { cINDX, cQSDT, cCNAM, cQOBJ, cNNAM });
+}
+
+void ESMReaderFinder::setIndex(PluginIndex* index)
+{
+  m_Index = index;
 }
 
 bool ESMReaderFinder::needGroup(const GroupData& g_data) const
@@ -104,178 +252,262 @@ bool ESMReaderFinder::groupFinished([[maybe_unused]] const GroupData& g_data)
 
 int ESMReaderFinder::readNextRecord(std::istream& input, const uint32_t recName, const bool localized, const StringTable& table)
 {
-  BasicRecord * recPtr = nullptr;
+  if (!m_Projection.hasRecordType(recName))
+    return -1;
+  if (!m_Projection.read(input, recName))
+    return -1;
+  PluginIndex::Record entry;
+  entry.recName = recName;
+  entry.formID = m_Projection.formID();
+  if (!projectRecord(m_Projection, localized, table, entry))
+  {
+    std::cerr << "ESMReaderFinder: Error while reading record "
+              << IntTo4Char(recName) << "!\n";
+    return -1;
+  }
+  // re-index record's form ID
+  if (!reIndex(entry.formID))
+    return -1;
+  // Group readers only queue the record, it is added when they are merged.
+  applyChange([entry = std::move(entry), index = m_Index]()
+  {
+    if (index != nullptr)
+      index->addRecord(entry);
+    addIndexedRecord(entry);
+  });
+  return 1;
+}
+
+std::unique_ptr<ESMReader> ESMReaderFinder::createGroupReader() const
+{
+  return std::make_unique<ESMReaderFinder>(*this);
+}
+
+void ESMReaderFinder::addRecord(BasicRecord&& record, const uint32_t recName)
+{
   switch (recName)
   {
     case cACTI:
-         recPtr = new ActivatorRecord;
+         Activators::get().addRecord(std::move(static_cast<ActivatorRecord&>(record)));
          break;
     case cALCH:
-         recPtr = new AlchemyPotionRecord;
+         AlchemyPotions::get().addRecord(std::move(static_cast<AlchemyPotionRecord&>(record)));
          break;
     case cAMMO:
-         recPtr = new AmmunitionRecord;
+         Ammunitions::get().addRecord(std::move(static_cast<AmmunitionRecord&>(record)));
          break;
     case cAPPA:
-         recPtr = new ApparatusRecord;
+         Apparatuses::get().addRecord(std::move(static_cast<ApparatusRecord&>(record)));
          break;
     case cARMO:
-         recPtr = new ArmourRecord;
+         Armours::get().addRecord(std::move(static_cast<ArmourRecord&>(record)));
          break;
     case cBOOK:
-         recPtr = new BookRecord;
+         Books::get().addRecord(std::move(static_cast<BookRecord&>(record)));
          break;
     case cCONT:
-         recPtr = new ContainerRecord;
+         Containers::get().addRecord(std::move(static_cast<ContainerRecord&>(record)));
          break;
     case cFACT:
-         recPtr = new FactionRecord;
+         Factions::get().addRecord(std::move(static_cast<FactionRecord&>(record)));
          break;
     case cFLOR:
-         recPtr = new FloraRecord;
+         Floras::get().addRecord(std::move(static_cast<FloraRecord&>(record)));
          break;
     case cFURN:
-         recPtr = new FurnitureRecord;
+         Furniture::get().addRecord(std::move(static_cast<FurnitureRecord&>(record)));
          break;
     case cINGR:
-         recPtr = new IngredientRecord;
+         Ingredients::get().addRecord(std::move(static_cast<IngredientRecord&>(record)));
          break;
     case cKEYM:
-         recPtr = new KeyRecord;
+         Keys::get().addRecord(std::move(static_cast<KeyRecord&>(record)));
          break;
     case cMISC:
-         recPtr = new MiscObjectRecord;
+         MiscObjects::get().addRecord(std::move(static_cast<MiscObjectRecord&>(record)));
          break;
     case cNPC_:
-         recPtr = new NPCRecord;
+         NPCs::get().addRecord(std::move(static_cast<NPCRecord&>(record)));
          break;
     case cPERK:
-         recPtr = new PerkRecord;
+         Perks::get().addRecord(std::move(static_cast<PerkRecord&>(record)));
          break;
     case cQUST:
-         recPtr = new QuestRecord;
+         Quests::get().addRecord(std::move(static_cast<QuestRecord&>(record)));
          break;
     case cSCRL:
-         recPtr = new ScrollRecord;
+         Scrolls::get().addRecord(std::move(static_cast<ScrollRecord&>(record)));
          break;
     case cSHOU:
-         recPtr = new ShoutRecord;
+         Shouts::get().addRecord(std::move(static_cast<ShoutRecord&>(record)));
          break;
     case cSLGM:
-         recPtr = new SoulGemRecord;
+         SoulGems::get().addRecord(std::move(static_cast<SoulGemRecord&>(record)));
          break;
     case cSPEL:
-         recPtr = new SpellRecord;
+         Spells::get().addRecord(std::move(static_cast<SpellRecord&>(record)));
          break;
     case cTACT:
-         recPtr = new TalkingActivatorRecord;
+         TalkingActivators::get().addRecord(std::move(static_cast<TalkingActivatorRecord&>(record)));
          break;
     case cTREE:
-         recPtr = new TreeRecord;
+         Trees::get().addRecord(std::move(static_cast<TreeRecord&>(record)));
          break;
     case cWEAP:
-         recPtr = new WeaponRecord;
+         Weapons::get().addRecord(std::move(static_cast<WeaponRecord&>(record)));
          break;
     case cWOOP:
-         recPtr = new WordOfPowerRecord;
+         WordsOfPower::get().addRecord(std::move(static_cast<WordOfPowerRecord&>(record)));
          break;
     default:
-         return -1;
+         std::cerr << "ESMReaderFinder::addRecord: Cannot add unknown record type!\n";
+         break;
   }
-  // load record
-  if (!recPtr->loadFromStream(input, localized, table))
+}
+
+void ESMReaderFinder::addIndexedRecords(const PluginIndex& index)
+{
+  for (const auto& entry: index.records())
   {
-    delete recPtr;
-    return -1;
+    addIndexedRecord(entry);
   }
-  // re-index record's form ID
-  if (!reIndex(recPtr->headerFormID))
-  {
-    delete recPtr;
-    return -1;
-  }
-  // add record
-  switch (recName)
+}
+
+void ESMReaderFinder::addIndexedRecord(const PluginIndex::Record& entry)
+{
+  switch (entry.recName)
   {
     case cACTI:
-         Activators::get().addRecord(*static_cast<ActivatorRecord*>(recPtr));
+         addRecord(indexedRecord<ActivatorRecord>(entry), entry.recName);
          break;
     case cALCH:
-         AlchemyPotions::get().addRecord(*static_cast<AlchemyPotionRecord*>(recPtr));
+         addRecord(indexedRecord<AlchemyPotionRecord>(entry), entry.recName);
          break;
     case cAMMO:
-         Ammunitions::get().addRecord(*static_cast<AmmunitionRecord*>(recPtr));
+         addRecord(indexedRecord<AmmunitionRecord>(entry), entry.recName);
          break;
     case cAPPA:
-         Apparatuses::get().addRecord(*static_cast<ApparatusRecord*>(recPtr));
+         addRecord(indexedRecord<ApparatusRecord>(entry), entry.recName);
          break;
     case cARMO:
-         Armours::get().addRecord(*static_cast<ArmourRecord*>(recPtr));
+         addRecord(indexedRecord<ArmourRecord>(entry), entry.recName);
          break;
     case cBOOK:
-         Books::get().addRecord(*static_cast<BookRecord*>(recPtr));
+         {
+           BookRecord record;
+           record.headerFormID = entry.formID;
+           record.editorID = entry.editorID;
+           record.title = indexedString(entry.name);
+           addRecord(std::move(record), entry.recName);
+         }
          break;
     case cCONT:
-         Containers::get().addRecord(*static_cast<ContainerRecord*>(recPtr));
+         addRecord(indexedRecord<ContainerRecord>(entry), entry.recName);
          break;
     case cFACT:
-         Factions::get().addRecord(*static_cast<FactionRecord*>(recPtr));
+         {
+           FactionRecord record = indexedRecord<FactionRecord>(entry);
+           for (const auto& rank: entry.ranks)
+           {
+             FactionRecord::RankData data;
+             data.index = rank.index;
+             data.maleName = indexedString(rank.maleName);
+             data.femaleName = indexedString(rank.femaleName);
+             record.ranks.push_back(data);
+           }
+           addRecord(std::move(record), entry.recName);
+         }
          break;
     case cFLOR:
-         Floras::get().addRecord(*static_cast<FloraRecord*>(recPtr));
+         addRecord(indexedRecord<FloraRecord>(entry), entry.recName);
          break;
     case cFURN:
-         Furniture::get().addRecord(*static_cast<FurnitureRecord*>(recPtr));
+         addRecord(indexedRecord<FurnitureRecord>(entry), entry.recName);
          break;
     case cINGR:
-         Ingredients::get().addRecord(*static_cast<IngredientRecord*>(recPtr));
+         addRecord(indexedRecord<IngredientRecord>(entry), entry.recName);
          break;
     case cKEYM:
-         Keys::get().addRecord(*static_cast<KeyRecord*>(recPtr));
+         addRecord(indexedRecord<KeyRecord>(entry), entry.recName);
          break;
     case cMISC:
-         MiscObjects::get().addRecord(*static_cast<MiscObjectRecord*>(recPtr));
+         addRecord(indexedRecord<MiscObjectRecord>(entry), entry.recName);
          break;
     case cNPC_:
-         NPCs::get().addRecord(*static_cast<NPCRecord*>(recPtr));
+         addRecord(indexedRecord<NPCRecord>(entry), entry.recName);
          break;
     case cPERK:
-         Perks::get().addRecord(*static_cast<PerkRecord*>(recPtr));
+         addRecord(indexedRecord<PerkRecord>(entry), entry.recName);
          break;
     case cQUST:
-         Quests::get().addRecord(*static_cast<QuestRecord*>(recPtr));
+         {
+           QuestRecord record = indexedRecord<QuestRecord>(entry);
+           for (const auto& stage: entry.stages)
+           {
+             IndexEntry questIndex;
+             questIndex.index = stage.index;
+             for (const auto& logEntry: stage.logEntries)
+             {
+               QSDTRecord qsdt;
+               qsdt.isFinisher = logEntry.finishes;
+               qsdt.logEntry = indexedString(logEntry.text);
+               questIndex.theQSDTs.push_back(qsdt);
+             }
+             record.indices.push_back(questIndex);
+           }
+           for (const auto& objective: entry.objectives)
+           {
+             QOBJEntry qobj;
+             qobj.unknownQOBJ = objective.index;
+             qobj.displayText = indexedString(objective.text);
+             record.theQOBJs.push_back(qobj);
+           }
+           addRecord(std::move(record), entry.recName);
+         }
          break;
     case cSCRL:
-         Scrolls::get().addRecord(*static_cast<ScrollRecord*>(recPtr));
+         addRecord(indexedRecord<ScrollRecord>(entry), entry.recName);
          break;
     case cSHOU:
-         Shouts::get().addRecord(*static_cast<ShoutRecord*>(recPtr));
+         addRecord(indexedRecord<ShoutRecord>(entry), entry.recName);
          break;
     case cSLGM:
-         SoulGems::get().addRecord(*static_cast<SoulGemRecord*>(recPtr));
+         addRecord(indexedRecord<SoulGemRecord>(entry), entry.recName);
          break;
     case cSPEL:
-         Spells::get().addRecord(*static_cast<SpellRecord*>(recPtr));
+         addRecord(indexedRecord<SpellRecord>(entry), entry.recName);
          break;
     case cTACT:
-          TalkingActivators::get().addRecord(*static_cast<TalkingActivatorRecord*>(recPtr));
+         addRecord(indexedRecord<TalkingActivatorRecord>(entry), entry.recName);
          break;
     case cTREE:
-         Trees::get().addRecord(*static_cast<TreeRecord*>(recPtr));
+         addRecord(indexedRecord<TreeRecord>(entry), entry.recName);
          break;
     case cWEAP:
-         Weapons::get().addRecord(*static_cast<WeaponRecord*>(recPtr));
+         addRecord(indexedRecord<WeaponRecord>(entry), entry.recName);
          break;
     case cWOOP:
-         WordsOfPower::get().addRecord(*static_cast<WordOfPowerRecord*>(recPtr));
+         addRecord(indexedRecord<WordOfPowerRecord>(entry), entry.recName);
          break;
     default:
-         std::cerr << "ESMReaderFinder::readNextRecord: Cannot add unknown record type!\n";
-         delete recPtr;
-         return -1;
+         std::cerr << "ESMReaderFinder::addIndexedRecord: Cannot add unknown record type!\n";
+         break;
   }
-  delete recPtr;
-  return 1;
+}
+
+void ESMReaderFinder::clearRecords()
+{
+  forAllManagers([](auto& manager) { manager.clear(); });
+}
+
+void ESMReaderFinder::startBulkLoad()
+{
+  forAllManagers([](auto& manager) { manager.startBulkLoad(); });
+}
+
+void ESMReaderFinder::finishBulkLoad()
+{
+  forAllManagers([](auto& manager) { manager.finishBulkLoad(); });
 }
 
 } // namespace
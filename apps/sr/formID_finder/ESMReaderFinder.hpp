@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2012, 2013, 2021  Dirk Stolle
+    Copyright (C) 2011, 2012, 2013, 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -22,12 +22,17 @@
 #define SR_ESMREADERFINDER_HPP
 
 #include "../../../lib/sr/ESMReaderReIndex.hpp"
+#include "../../../lib/sr/RecordProjection.hpp"
+#include "../../../lib/sr/records/BasicRecord.hpp"
+#include "PluginIndex.hpp"
 
 namespace SRTP
 {
 
 /* This descendant of the ESMReader class tries to read all records from the
-   given .esm/.esp file, that are relevant to the form ID finder.
+   given .esm/.esp file, that are relevant to the form ID finder. It only
+   decodes the subrecords that are searched, e.g. editor ID and name, and
+   skips all other data of the records.
 */
 class ESMReaderFinder: public ESMReaderReIndexMod
 {
@@ -37,6 +42,38 @@ class ESMReaderFinder: public ESMReaderReIndexMod
      * \param loadOrder   file names of ESM files in load order
      */
     ESMReaderFinder(const std::vector<std::string>& loadOrder);
+
+    /* sets the index that shall receive the searchable data of all records
+       that are added by this reader and the group or staging readers created
+       from it afterwards, or nullptr to stop collecting data
+
+       parameters:
+           index - the index, has to outlive the reader and all its changes
+    */
+    void setIndex(PluginIndex* index);
+
+    /* adds all records of an index to the matching record managers, as if
+       they had been read from the plugin again
+
+       parameters:
+           index - the index, e.g. as read from the cache
+    */
+    static void addIndexedRecords(const PluginIndex& index);
+
+    /* removes all records from the record managers that this reader fills,
+       e.g. before the load order is read again
+    */
+    static void clearRecords();
+
+    /* starts a bulk load in all record managers that this reader fills, so
+       that added records are only sorted once when finishBulkLoad() is called
+    */
+    static void startBulkLoad();
+
+    /* finishes the bulk load of all record managers that this reader fills
+       and makes the added records visible
+    */
+    static void finishBulkLoad();
   protected:
     /* returns true, if the given group may contains some data that the reader
        wants to read. Returns false otherwise.
@@ -90,6 +127,29 @@ class ESMReaderFinder: public ESMReaderReIndexMod
            table     - the associated string table
     */
     virtual int readNextRecord(std::istream& input, const uint32_t recName, const bool localized, const StringTable& table) override;
+
+    /* creates a reader that reads a single top-level group on a worker thread,
+       see ESMReader::createGroupReader() for details
+    */
+    virtual std::unique_ptr<ESMReader> createGroupReader() const override;
+  private:
+    /* adds the record of an index entry to the matching record manager
+
+       parameters:
+           entry - the index entry
+    */
+    static void addIndexedRecord(const PluginIndex::Record& entry);
+
+    /* moves a record into the matching record manager
+
+       parameters:
+           record  - the record that was read
+           recName - name (header) of the record
+    */
+    static void addRecord(BasicRecord&& record, const uint32_t recName);
+
+    PluginIndex* m_Index;          // index that collects the added records, if any
+    RecordProjection m_Projection; // searched subrecords of each record type
 }; // class
 
 } // namespace
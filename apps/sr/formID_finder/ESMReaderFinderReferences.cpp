@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2012, 2013, 2021, 2022  Dirk Stolle
+    Copyright (C) 2012, 2013, 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -36,10 +36,60 @@ ESMReaderFinderReferences::CellRefIDPair::CellRefIDPair(const uint32_t cell, con
 ESMReaderFinderReferences::ESMReaderFinderReferences(const std::vector<std::string>& loadOrder)
 : ESMReaderReIndexMod(loadOrder),
   refMap(std::map<uint32_t, std::vector<CellRefIDPair> >()),
-  m_CellStack(std::vector<uint32_t>())
+  m_CellStack(std::vector<uint32_t>()),
+  m_Index(nullptr)
 {
 }
 
+void ESMReaderFinderReferences::setIndex(PluginIndex* index)
+{
+  m_Index = index;
+}
+
+void ESMReaderFinderReferences::addIndexedData(const PluginIndex& index)
+{
+  for (const auto& cell: index.cells())
+  {
+    CellRecord record;
+    record.headerFormID = cell.formID;
+    if (cell.name.has_value())
+    {
+      record.name = LocalizedString(LocalizedString::Type::String, 0, cell.name.value());
+    }
+    if (cell.grid.has_value())
+    {
+      record.gridLocation.presence = true;
+      record.gridLocation.locationX = cell.grid.value().first;
+      record.gridLocation.locationY = cell.grid.value().second;
+    }
+    Cells::get().addRecord(record);
+  }
+  for (const auto& ref: index.references())
+  {
+    refMap[ref.baseID].push_back(CellRefIDPair(ref.cellID, ref.refID));
+  }
+}
+
+void ESMReaderFinderReferences::clear()
+{
+  Cells::get().clear();
+  WorldSpaces::get().clear();
+  refMap.clear();
+  m_CellStack.clear();
+}
+
+void ESMReaderFinderReferences::startBulkLoad()
+{
+  Cells::get().startBulkLoad();
+  WorldSpaces::get().startBulkLoad();
+}
+
+void ESMReaderFinderReferences::finishBulkLoad()
+{
+  Cells::get().finishBulkLoad();
+  WorldSpaces::get().finishBulkLoad();
+}
+
 bool ESMReaderFinderReferences::needGroup(const GroupData& g_data) const
 {
   return
@@ -104,7 +154,12 @@ int ESMReaderFinderReferences::readNextRecord(std::istream& input, const uint32_
              return -1;
            if (!reIndex(recC.headerFormID))
              return -1;
-           Cells::get().addRecord(recC);
+           applyChange([recC = std::move(recC), index = m_Index]() mutable
+           {
+             if (index != nullptr)
+               index->addCell(recC);
+             Cells::get().addRecord(std::move(recC));
+           });
            return 1;
          }
          break;
@@ -115,7 +170,7 @@ int ESMReaderFinderReferences::readNextRecord(std::istream& input, const uint32_
              return -1;
            if (!reIndex(recW.headerFormID))
              return -1;
-           WorldSpaces::get().addRecord(recW);
+           applyChange([recW = std::move(recW)]() mutable { WorldSpaces::get().addRecord(std::move(recW)); });
            return 1;
          }
          break;
@@ -145,4 +200,33 @@ int ESMReaderFinderReferences::readNextRecord(std::istream& input, const uint32_
   return 1;
 }
 
+std::unique_ptr<ESMReader> ESMReaderFinderReferences::createGroupReader() const
+{
+  return std::make_unique<ESMReaderFinderReferences>(*this);
+}
+
+bool ESMReaderFinderReferences::mergeGroupReader(ESMReader& groupReader)
+{
+  if (!ESMReaderReIndexMod::mergeGroupReader(groupReader))
+    return false;
+  auto& other = static_cast<ESMReaderFinderReferences&>(groupReader);
+  // Group readers share the index of their staging reader, so references are
+  // only collected once the staging reader itself gets merged.
+  const bool collect = (other.m_Index != nullptr) && (other.m_Index != m_Index);
+  for (auto& [baseID, references]: other.refMap)
+  {
+    if (collect)
+    {
+      for (const auto& pair: references)
+      {
+        other.m_Index->addReference(baseID, pair.cellID, pair.refID);
+      }
+    }
+    auto& target = refMap[baseID];
+    target.insert(target.end(), references.begin(), references.end());
+  }
+  other.refMap.clear();
+  return true;
+}
+
 } // namespace
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2012, 2013, 2021  Dirk Stolle
+    Copyright (C) 2012, 2013, 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -24,6 +24,7 @@
 #include "../../../lib/sr/ESMReaderReIndex.hpp"
 #include <map>
 #include <vector>
+#include "PluginIndex.hpp"
 
 namespace SRTP
 {
@@ -50,6 +51,40 @@ class ESMReaderFinderReferences: public ESMReaderReIndexMod
 
     // fid map - key is base object form ID, value is list of cell IDs
     std::map<uint32_t, std::vector<CellRefIDPair> > refMap;
+
+    /* sets the index that shall receive the cells and references that are
+       added by the staging readers created from this reader afterwards, or
+       nullptr to stop collecting data
+
+       parameters:
+           index - the index, has to outlive the reader and all its changes
+
+       remarks:
+           References of a staging reader are added to its index when it is
+           merged into a reader that does not collect for the same index.
+    */
+    void setIndex(PluginIndex* index);
+
+    /* adds all cells and references of an index, as if they had been read
+       from the plugin again
+
+       parameters:
+           index - the index, e.g. as read from the cache
+    */
+    void addIndexedData(const PluginIndex& index);
+
+    /* removes all cells, world spaces and references that were read so far,
+       e.g. before the load order is read again
+    */
+    void clear();
+
+    /* starts a bulk load of cells and world spaces, see
+       ESMReaderFinder::startBulkLoad()
+    */
+    static void startBulkLoad();
+
+    /* finishes the bulk load of cells and world spaces */
+    static void finishBulkLoad();
   protected:
     /* returns true, if the given group may contains some data that the reader
        wants to read. Returns false otherwise.
@@ -104,8 +139,24 @@ class ESMReaderFinderReferences: public ESMReaderReIndexMod
     */
     virtual int readNextRecord(std::istream& input, const uint32_t recName, const bool localized, const StringTable& table) override;
 
+    /* creates a reader that reads a single top-level group on a worker thread,
+       see ESMReader::createGroupReader() for details
+    */
+    virtual std::unique_ptr<ESMReader> createGroupReader() const override;
+
+    /* takes over the references found by a group reader and returns true, if
+       the results were merged successfully
+
+       parameters:
+           groupReader - the group reader, as created by createGroupReader()
+    */
+    virtual bool mergeGroupReader(ESMReader& groupReader) override;
+
    // cell form ID stack
    std::vector<uint32_t> m_CellStack;
+
+   // index that collects the added cells and references, if any
+   PluginIndex* m_Index;
 }; // class
 
 } // namespace
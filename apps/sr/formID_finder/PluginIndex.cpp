@@ -0,0 +1,512 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "PluginIndex.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include "../../../lib/base/FileFunctions.hpp"
+#include "../../../lib/base/MappedFile.hpp"
+#include "../../../lib/sr/FormIDFunctions.hpp"
+
+namespace SRTP
+{
+
+namespace
+{
+
+/// magic bytes at the start of every cache file ("FIDX")
+const uint32_t cIndexMagic = 0x58444946;
+
+/// version of the cache file format, increase when the format changes
+const uint32_t cIndexVersion = 1;
+
+std::optional<std::string> optionalString(const LocalizedString& str)
+{
+  if (!str.isPresent())
+    return std::nullopt;
+  return str.getString();
+}
+
+template<typename T>
+void writeValue(std::ostream& output, const T& value)
+{
+  output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeString(std::ostream& output, const std::string& str)
+{
+  const uint32_t length = str.size();
+  writeValue(output, length);
+  output.write(str.data(), length);
+}
+
+void writeOptionalString(std::ostream& output, const std::optional<std::string>& str)
+{
+  const uint8_t present = str.has_value() ? 1 : 0;
+  writeValue(output, present);
+  if (str.has_value())
+    writeString(output, str.value());
+}
+
+/// Reads the values of a cache file with bounds checks.
+class IndexReader
+{
+  public:
+    explicit IndexReader(const MWTP::ByteView data)
+    : m_Data(data), m_Offset(0)
+    {
+    }
+
+    template<typename T>
+    bool read(T& value)
+    {
+      if (m_Data.size() - m_Offset < sizeof(T))
+        return false;
+      std::memcpy(&value, m_Data.data() + m_Offset, sizeof(T));
+      m_Offset += sizeof(T);
+      return true;
+    }
+
+    bool read(std::string& str)
+    {
+      uint32_t length = 0;
+      if (!read(length) || (m_Data.size() - m_Offset < length))
+        return false;
+      str.assign(reinterpret_cast<const char*>(m_Data.data() + m_Offset), length);
+      m_Offset += length;
+      return true;
+    }
+
+    bool read(std::optional<std::string>& str)
+    {
+      uint8_t present = 0;
+      if (!read(present))
+        return false;
+      if (present == 0)
+      {
+        str.reset();
+        return true;
+      }
+      str.emplace();
+      return read(str.value());
+    }
+
+    bool atEnd() const
+    {
+      return m_Offset == m_Data.size();
+    }
+  private:
+    MWTP::ByteView m_Data;
+    std::size_t m_Offset;
+}; // class
+
+} // namespace
+
+std::optional<IndexKey> IndexKey::forFile(const std::string& path, const std::optional<Localization>& l10n)
+{
+  std::error_code error;
+  const auto size = std::filesystem::file_size(path, error);
+  if (error)
+    return std::nullopt;
+  const auto modified = std::filesystem::last_write_time(path, error);
+  if (error)
+    return std::nullopt;
+
+  IndexKey key;
+  key.path = path;
+  key.size = size;
+  key.modified = static_cast<int64_t>(modified.time_since_epoch().count());
+  key.language = l10n.has_value() ? stringTableSuffix(l10n.value()) : "default";
+  return key;
+}
+
+std::string IndexKey::cacheFileName() const
+{
+  // FNV-1a, because std::hash may differ between implementations.
+  uint64_t hash = 0xCBF29CE484222325;
+  const std::string data = path + '\n' + language;
+  for (const char c: data)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001B3;
+  }
+  std::ostringstream name;
+  name << std::filesystem::path(path).filename().string() << '.'
+       << std::hex << hash << ".fidx";
+  return name.str();
+}
+
+bool IndexKey::operator==(const IndexKey& other) const
+{
+  return (path == other.path) && (size == other.size)
+      && (modified == other.modified) && (language == other.language);
+}
+
+PluginIndex::PluginIndex(const bool withReferences)
+: m_WithReferences(withReferences),
+  m_Records(std::vector<Record>()),
+  m_Cells(std::vector<Cell>()),
+  m_References(std::vector<Reference>())
+{
+}
+
+void PluginIndex::addRecord(Record record)
+{
+  m_Records.push_back(std::move(record));
+}
+
+void PluginIndex::addCell(const CellRecord& record)
+{
+  Cell cell{ record.headerFormID, optionalString(record.name), std::nullopt };
+  if (record.gridLocation.presence)
+  {
+    cell.grid = std::make_pair(record.gridLocation.locationX, record.gridLocation.locationY);
+  }
+  m_Cells.push_back(std::move(cell));
+}
+
+void PluginIndex::addReference(const uint32_t baseID, const uint32_t cellID, const uint32_t refID)
+{
+  m_References.push_back(Reference{ baseID, cellID, refID });
+}
+
+bool PluginIndex::hasReferences() const
+{
+  return m_WithReferences;
+}
+
+const std::vector<PluginIndex::Record>& PluginIndex::records() const
+{
+  return m_Records;
+}
+
+const std::vector<PluginIndex::Cell>& PluginIndex::cells() const
+{
+  return m_Cells;
+}
+
+const std::vector<PluginIndex::Reference>& PluginIndex::references() const
+{
+  return m_References;
+}
+
+bool PluginIndex::save(const std::filesystem::path& fileName, const IndexKey& key, const std::vector<std::string>& loadOrder) const
+{
+  // Form IDs are stored with an index into a table of file names instead of
+  // the index in the current load order.
+  std::vector<std::string> fileTable;
+  std::map<uint8_t, uint8_t> tableIndex;
+  bool validIDs = true;
+  const auto toCache = [&](const uint32_t formID) -> uint32_t
+  {
+    const uint8_t modIndex = extractModIndex(formID);
+    if (modIndex >= loadOrder.size())
+    {
+      validIDs = false;
+      return formID;
+    }
+    auto iter = tableIndex.find(modIndex);
+    if (iter == tableIndex.end())
+    {
+      iter = tableIndex.emplace(modIndex, static_cast<uint8_t>(fileTable.size())).first;
+      fileTable.push_back(loadOrder[modIndex]);
+    }
+    uint32_t result = formID;
+    changeModIndexInSitu(result, iter->second);
+    return result;
+  };
+
+  std::ostringstream body;
+  writeValue(body, static_cast<uint32_t>(m_Records.size()));
+  for (const auto& record: m_Records)
+  {
+    writeValue(body, record.recName);
+    writeValue(body, toCache(record.formID));
+    writeString(body, record.editorID);
+    writeOptionalString(body, record.name);
+    writeValue(body, static_cast<uint32_t>(record.ranks.size()));
+    for (const auto& rank: record.ranks)
+    {
+      writeValue(body, rank.index);
+      writeOptionalString(body, rank.maleName);
+      writeOptionalString(body, rank.femaleName);
+    }
+    writeValue(body, static_cast<uint32_t>(record.stages.size()));
+    for (const auto& stage: record.stages)
+    {
+      writeValue(body, stage.index);
+      writeValue(body, static_cast<uint32_t>(stage.logEntries.size()));
+      for (const auto& entry: stage.logEntries)
+      {
+        writeValue(body, static_cast<uint8_t>(entry.finishes ? 1 : 0));
+        writeOptionalString(body, entry.text);
+      }
+    }
+    writeValue(body, static_cast<uint32_t>(record.objectives.size()));
+    for (const auto& objective: record.objectives)
+    {
+      writeValue(body, objective.index);
+      writeOptionalString(body, objective.text);
+    }
+  }
+  writeValue(body, static_cast<uint32_t>(m_Cells.size()));
+  for (const auto& cell: m_Cells)
+  {
+    writeValue(body, toCache(cell.formID));
+    writeOptionalString(body, cell.name);
+    writeValue(body, static_cast<uint8_t>(cell.grid.has_value() ? 1 : 0));
+    if (cell.grid.has_value())
+    {
+      writeValue(body, cell.grid.value().first);
+      writeValue(body, cell.grid.value().second);
+    }
+  }
+  writeValue(body, static_cast<uint32_t>(m_References.size()));
+  for (const auto& ref: m_References)
+  {
+    writeValue(body, toCache(ref.baseID));
+    writeValue(body, toCache(ref.cellID));
+    writeValue(body, toCache(ref.refID));
+  }
+  if (!validIDs)
+  {
+    std::cerr << "PluginIndex::save: Error: Form ID does not match the load order!\n";
+    return false;
+  }
+
+  // Use a unique temporary file, so that concurrent runs never write into the
+  // same file and only complete files get renamed into place.
+  const std::filesystem::path tempName = temporaryFileName(fileName.string());
+  std::ofstream output(tempName, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!output.good())
+  {
+    std::cerr << "PluginIndex::save: Error: Could not create file "
+              << tempName.string() << "!\n";
+    return false;
+  }
+  writeValue(output, cIndexMagic);
+  writeValue(output, cIndexVersion);
+  writeString(output, key.path);
+  writeValue(output, key.size);
+  writeValue(output, key.modified);
+  writeString(output, key.language);
+  writeValue(output, static_cast<uint8_t>(m_WithReferences ? 1 : 0));
+  writeValue(output, static_cast<uint32_t>(fileTable.size()));
+  for (const auto& name: fileTable)
+  {
+    writeString(output, name);
+  }
+  output << body.str();
+  output.close();
+  if (!output.good())
+  {
+    std::cerr << "PluginIndex::save: Error while writing file "
+              << tempName.string() << "!\n";
+    std::error_code error;
+    std::filesystem::remove(tempName, error);
+    return false;
+  }
+
+  std::error_code error;
+  std::filesystem::rename(tempName, fileName, error);
+  if (error)
+  {
+    std::cerr << "PluginIndex::save: Error: Could not rename "
+              << tempName.string() << " to " << fileName.string() << "!\n";
+    std::filesystem::remove(tempName, error);
+    return false;
+  }
+  return true;
+}
+
+bool PluginIndex::load(const std::filesystem::path& fileName, const IndexKey& key, const std::vector<std::string>& loadOrder, const bool needReferences)
+{
+  m_Records.clear();
+  m_Cells.clear();
+  m_References.clear();
+
+  std::error_code error;
+  if (!std::filesystem::is_regular_file(fileName, error))
+    return false;
+  MWTP::MappedFile file;
+  if (!file.open(fileName))
+    return false;
+  IndexReader input(file.view());
+
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  if (!input.read(magic) || (magic != cIndexMagic)
+      || !input.read(version) || (version != cIndexVersion))
+  {
+    // Cache of another version, it will just be replaced.
+    return false;
+  }
+  IndexKey fileKey;
+  uint8_t withReferences = 0;
+  if (!input.read(fileKey.path) || !input.read(fileKey.size)
+      || !input.read(fileKey.modified) || !input.read(fileKey.language)
+      || !input.read(withReferences))
+  {
+    std::cerr << "PluginIndex::load: Warning: Cache file "
+              << fileName.string() << " is corrupt.\n";
+    return false;
+  }
+  if (!(fileKey == key) || (needReferences && (withReferences == 0)))
+    return false;
+
+  uint32_t fileCount = 0;
+  if (!input.read(fileCount))
+  {
+    std::cerr << "PluginIndex::load: Warning: Cache file "
+              << fileName.string() << " is corrupt.\n";
+    return false;
+  }
+  std::vector<uint8_t> loadOrderIndex;
+  for (uint32_t i = 0; i < fileCount; ++i)
+  {
+    std::string name;
+    if (!input.read(name))
+    {
+      std::cerr << "PluginIndex::load: Warning: Cache file "
+                << fileName.string() << " is corrupt.\n";
+      return false;
+    }
+    const auto iter = std::find(loadOrder.begin(), loadOrder.end(), name);
+    if ((iter == loadOrder.end()) || (iter - loadOrder.begin() > 255))
+    {
+      // A master is not part of the load order anymore.
+      return false;
+    }
+    loadOrderIndex.push_back(static_cast<uint8_t>(iter - loadOrder.begin()));
+  }
+
+  bool validIDs = true;
+  const auto fromCache = [&](uint32_t& formID)
+  {
+    const uint8_t index = extractModIndex(formID);
+    if (index >= loadOrderIndex.size())
+      validIDs = false;
+    else
+      changeModIndexInSitu(formID, loadOrderIndex[index]);
+  };
+
+  const auto corrupt = [&]()
+  {
+    std::cerr << "PluginIndex::load: Warning: Cache file "
+              << fileName.string() << " is corrupt.\n";
+    m_Records.clear();
+    m_Cells.clear();
+    m_References.clear();
+    return false;
+  };
+
+  uint32_t count = 0;
+  if (!input.read(count))
+    return corrupt();
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    Record record;
+    uint32_t subCount = 0;
+    if (!input.read(record.recName) || !input.read(record.formID)
+        || !input.read(record.editorID) || !input.read(record.name)
+        || !input.read(subCount))
+      return corrupt();
+    fromCache(record.formID);
+    for (uint32_t j = 0; j < subCount; ++j)
+    {
+      Rank rank;
+      if (!input.read(rank.index) || !input.read(rank.maleName) || !input.read(rank.femaleName))
+        return corrupt();
+      record.ranks.push_back(std::move(rank));
+    }
+    if (!input.read(subCount))
+      return corrupt();
+    for (uint32_t j = 0; j < subCount; ++j)
+    {
+      Stage stage;
+      uint32_t entryCount = 0;
+      if (!input.read(stage.index) || !input.read(entryCount))
+        return corrupt();
+      for (uint32_t k = 0; k < entryCount; ++k)
+      {
+        uint8_t finishes = 0;
+        LogEntry entry;
+        if (!input.read(finishes) || !input.read(entry.text))
+          return corrupt();
+        entry.finishes = finishes != 0;
+        stage.logEntries.push_back(std::move(entry));
+      }
+      record.stages.push_back(std::move(stage));
+    }
+    if (!input.read(subCount))
+      return corrupt();
+    for (uint32_t j = 0; j < subCount; ++j)
+    {
+      Objective objective;
+      if (!input.read(objective.index) || !input.read(objective.text))
+        return corrupt();
+      record.objectives.push_back(std::move(objective));
+    }
+    m_Records.push_back(std::move(record));
+  }
+
+  if (!input.read(count))
+    return corrupt();
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    Cell cell;
+    uint8_t hasGrid = 0;
+    if (!input.read(cell.formID) || !input.read(cell.name) || !input.read(hasGrid))
+      return corrupt();
+    fromCache(cell.formID);
+    if (hasGrid != 0)
+    {
+      std::pair<int32_t, int32_t> grid;
+      if (!input.read(grid.first) || !input.read(grid.second))
+        return corrupt();
+      cell.grid = grid;
+    }
+    m_Cells.push_back(std::move(cell));
+  }
+
+  if (!input.read(count))
+    return corrupt();
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    Reference ref;
+    if (!input.read(ref.baseID) || !input.read(ref.cellID) || !input.read(ref.refID))
+      return corrupt();
+    fromCache(ref.baseID);
+    fromCache(ref.cellID);
+    fromCache(ref.refID);
+    m_References.push_back(ref);
+  }
+
+  if (!input.atEnd() || !validIDs)
+    return corrupt();
+  m_WithReferences = withReferences != 0;
+  return true;
+}
+
+} // namespace
@@ -0,0 +1,202 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SR_FORMID_FINDER_PLUGININDEX_HPP
+#define SR_FORMID_FINDER_PLUGININDEX_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../../../lib/sr/Localization.hpp"
+#include "../../../lib/sr/records/CellRecord.hpp"
+
+namespace SRTP
+{
+
+/** Identifies the state of a plugin file that an index was created from. */
+struct IndexKey
+{
+  std::string path;     /**< path of the plugin file */
+  uint64_t size;        /**< size of the plugin file in bytes */
+  int64_t modified;     /**< time of last modification of the plugin file */
+  std::string language; /**< language of the string tables */
+
+  /** \brief Gets the key for the current state of a plugin file.
+   *
+   * \param path  path of the plugin file
+   * \param l10n  the preferred localization for string tables, if any
+   * \return Returns the key, if the file exists.
+   *         Returns an empty optional, if the file could not be inspected.
+   */
+  static std::optional<IndexKey> forFile(const std::string& path, const std::optional<Localization>& l10n);
+
+  /** \brief Gets the name of the cache file for that key.
+   *
+   * \return Returns the file name, without directory.
+   * \remarks The name is derived from the plugin path and the language, so
+   *          different data directories or languages do not share a file.
+   */
+  std::string cacheFileName() const;
+
+  bool operator==(const IndexKey& other) const;
+}; // struct
+
+/** Holds the data of a single plugin that formID_finder searches through,
+ *  and allows to store it in a compact binary cache file.
+ *
+ * All form IDs inside an instance use the mod indices of the current load
+ * order. The cache file stores the names of the files instead, so a cache
+ * stays valid when the load order changes.
+ */
+class PluginIndex
+{
+  public:
+    /// log entry of a quest stage
+    struct LogEntry
+    {
+      bool finishes;                   /**< whether the entry finishes the quest */
+      std::optional<std::string> text; /**< text of the log entry, if any */
+    };
+
+    /// quest stage
+    struct Stage
+    {
+      uint16_t index;                   /**< stage index */
+      std::vector<LogEntry> logEntries; /**< log entries of the stage */
+    };
+
+    /// quest objective
+    struct Objective
+    {
+      uint16_t index;                  /**< objective index */
+      std::optional<std::string> text; /**< display text, if any */
+    };
+
+    /// faction rank
+    struct Rank
+    {
+      uint32_t index;                        /**< rank index */
+      std::optional<std::string> maleName;   /**< male rank name, if any */
+      std::optional<std::string> femaleName; /**< female rank name, if any */
+    };
+
+    /// searchable record, e.g. a weapon
+    struct Record
+    {
+      uint32_t recName;                  /**< record type, e.g. cWEAP */
+      uint32_t formID;                   /**< form ID of the record */
+      std::string editorID;              /**< editor ID of the record */
+      std::optional<std::string> name;   /**< name (or title of books), if any */
+      std::vector<Rank> ranks;           /**< ranks, only used by factions */
+      std::vector<Stage> stages;         /**< stages, only used by quests */
+      std::vector<Objective> objectives; /**< objectives, only used by quests */
+    };
+
+    /// cell, as needed to show where references are located
+    struct Cell
+    {
+      uint32_t formID;                   /**< form ID of the cell */
+      std::optional<std::string> name;   /**< name of the cell, if any */
+      std::optional<std::pair<int32_t, int32_t> > grid; /**< grid location, if any */
+    };
+
+    /// placed reference
+    struct Reference
+    {
+      uint32_t baseID; /**< form ID of the base object */
+      uint32_t cellID; /**< form ID of the cell that contains the reference */
+      uint32_t refID;  /**< form ID of the reference */
+    };
+
+    /** \brief Constructor.
+     *
+     * \param withReferences  whether the index contains cells and references
+     */
+    explicit PluginIndex(const bool withReferences = false);
+
+    /** \brief Adds a record entry directly.
+     *
+     * \param record  the record entry
+     */
+    void addRecord(Record record);
+
+    /** \brief Adds the data of a cell record.
+     *
+     * \param record  the cell record
+     */
+    void addCell(const CellRecord& record);
+
+    /** \brief Adds a placed reference.
+     *
+     * \param baseID  form ID of the base object
+     * \param cellID  form ID of the cell that contains the reference
+     * \param refID   form ID of the reference
+     */
+    void addReference(const uint32_t baseID, const uint32_t cellID, const uint32_t refID);
+
+    /// Checks whether the index contains cells and references.
+    bool hasReferences() const;
+
+    /// Gets all records of the index in the order they were added.
+    const std::vector<Record>& records() const;
+
+    /// Gets all cells of the index in the order they were added.
+    const std::vector<Cell>& cells() const;
+
+    /// Gets all references of the index in the order they were added.
+    const std::vector<Reference>& references() const;
+
+    /** \brief Writes the index to a cache file.
+     *
+     * \param fileName   path of the cache file
+     * \param key        key of the plugin the index was created from
+     * \param loadOrder  names of the files in the current load order
+     * \return Returns true, if the file was written successfully.
+     *         Returns false, if an error occurred.
+     * \remarks The file is written under a unique temporary name first and
+     *          then renamed, so other processes never see a partial file, even
+     *          if they save the same index at the same time.
+     */
+    bool save(const std::filesystem::path& fileName, const IndexKey& key, const std::vector<std::string>& loadOrder) const;
+
+    /** \brief Reads the index from a memory-mapped cache file.
+     *
+     * \param fileName        path of the cache file
+     * \param key             key of the current state of the plugin
+     * \param loadOrder       names of the files in the current load order
+     * \param needReferences  whether the index has to contain references
+     * \return Returns true, if the cache file matches the key and could be
+     *         read. Returns false otherwise, e.g. if the plugin was modified
+     *         since the cache file was written.
+     */
+    bool load(const std::filesystem::path& fileName, const IndexKey& key, const std::vector<std::string>& loadOrder, const bool needReferences);
+  private:
+    bool m_WithReferences;               /**< whether cells and references are present */
+    std::vector<Record> m_Records;       /**< searchable records */
+    std::vector<Cell> m_Cells;           /**< cells */
+    std::vector<Reference> m_References; /**< placed references */
+}; // class
+
+} // namespace
+
+#endif // SR_FORMID_FINDER_PLUGININDEX_HPP
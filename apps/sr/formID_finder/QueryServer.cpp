@@ -0,0 +1,136 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "QueryServer.hpp"
+#include <iostream>
+#include <sstream>
+#include "../../../lib/base/UtilityFunctions.hpp"
+
+namespace SRTP
+{
+
+QueryServer::QueryServer(SearchData& data, const SearchOptions& defaults)
+: UnixDomainSocketServer(),
+  m_Data(data),
+  m_Defaults(defaults)
+{
+}
+
+std::optional<QueryServer::Request> QueryServer::parseRequest(const std::string& request, const SearchOptions& defaults)
+{
+  // Clients may end the request with a line break, so trim() is not enough.
+  const char* whitespace = " \t\r\n";
+  const auto first = request.find_first_not_of(whitespace);
+  if (first == std::string::npos)
+    return std::nullopt;
+  std::string remainder = request.substr(first, request.find_last_not_of(whitespace) - first + 1);
+  // Splits the next word off the remaining text.
+  const auto nextWord = [&remainder, whitespace]() -> std::string
+  {
+    const auto pos = remainder.find_first_of(whitespace);
+    const std::string word = remainder.substr(0, pos);
+    const auto next = remainder.find_first_not_of(whitespace, pos);
+    remainder = (next == std::string::npos) ? std::string() : remainder.substr(next);
+    return word;
+  };
+
+  const std::string command = nextWord();
+  if ((command == "reload") || (command == "shutdown"))
+  {
+    if (!remainder.empty())
+      return std::nullopt;
+    Request result;
+    result.command = (command == "reload") ? Command::Reload : Command::Shutdown;
+    result.options = defaults;
+    return result;
+  }
+  if (command != "search")
+    return std::nullopt;
+
+  Request result;
+  result.command = Command::Search;
+  result.options = defaults;
+  while (remainder.find("--") == 0)
+  {
+    const std::string option = nextWord();
+    if (option == "--case-sensitive")
+      result.options.caseSensitive = true;
+    else if (option == "--all-quest-info")
+      result.options.allQuestInfo = true;
+    else if ((option == "--faction-ranks") || (option == "--ranks"))
+      result.options.listFactionRanks = true;
+    else if (option == "--show-files")
+      result.options.showFiles = true;
+    else
+      return std::nullopt;
+  }
+  if (remainder.empty())
+    return std::nullopt;
+  result.options.keyword = result.options.caseSensitive ? remainder : lowerCase(remainder);
+  return result;
+}
+
+std::string QueryServer::answer(const std::string& request)
+{
+  const auto parsed = parseRequest(request, m_Defaults);
+  if (!parsed.has_value())
+  {
+    return "error: invalid request";
+  }
+
+  switch (parsed.value().command)
+  {
+    case Command::Shutdown:
+         m_shutdown = true;
+         return "ok";
+    case Command::Reload:
+         if (m_Data.load() != 0)
+           return "error: could not read the load order";
+         return "ok";
+    case Command::Search:
+         break;
+  }
+
+  if (m_Data.filesChanged())
+  {
+    std::cout << "Files of the load order were modified, reading them again.\n";
+    if (m_Data.load() != 0)
+      return "error: could not read the load order";
+  }
+  std::ostringstream stream;
+  searchRecords(parsed.value().options, m_Data.loadOrder(), m_Data.references(), stream);
+  return stream.str();
+}
+
+void QueryServer::serveClient(const int client_socket_fd, [[maybe_unused]] bool& closeWhenDone)
+{
+  std::string request;
+  if (!receiveString(client_socket_fd, request))
+  {
+    std::cerr << "Error: Could not receive request from client.\n";
+    return;
+  }
+  if (!sendString(client_socket_fd, answer(request)))
+  {
+    std::cerr << "Error: Could not send answer to client.\n";
+  }
+}
+
+} // namespace
@@ -0,0 +1,105 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SR_FORMID_FINDER_QUERYSERVER_HPP
+#define SR_FORMID_FINDER_QUERYSERVER_HPP
+
+#include <optional>
+#include <string>
+#include "../../../lib/base/UnixDomainSocketServer.hpp"
+#include "Search.hpp"
+#include "SearchData.hpp"
+
+namespace SRTP
+{
+
+/** Answers search requests over a Unix domain socket, so that the load order
+ *  only has to be read once for many searches.
+ *
+ * Every connection carries exactly one request, and the server sends one
+ * answer back before it closes the connection. Requests and answers are
+ * NUL-terminated strings. Known requests are:
+ *
+ *   search [--case-sensitive] [--all-quest-info] [--faction-ranks]
+ *          [--show-files] KEYWORD
+ *       searches for KEYWORD and answers with the list of matches, file
+ *       names are part of the answer if the default options of the server
+ *       or the request enable them
+ *   reload
+ *       reads all modified files of the load order again, answers "ok"
+ *   shutdown
+ *       stops the server, answers "ok"
+ *
+ * Failed requests get an answer that starts with "error: ".
+ */
+class QueryServer: public MWTP::UnixDomainSocketServer
+{
+  public:
+    /// type of a request
+    enum class Command { Search, Reload, Shutdown };
+
+    /// parsed request of a client
+    struct Request
+    {
+      Command command;       /**< type of the request */
+      SearchOptions options; /**< search parameters, only used for searches */
+    };
+
+    /** \brief Constructor.
+     *
+     * \param data      the loaded data that gets searched, has to outlive the server
+     * \param defaults  default search options, e.g. from the command line
+     */
+    QueryServer(SearchData& data, const SearchOptions& defaults);
+
+    /** \brief Parses a request.
+     *
+     * \param request   the request as received from the client
+     * \param defaults  default search options
+     * \return Returns the parsed request, if it is valid.
+     *         Returns an empty optional, if the request is invalid.
+     * \remarks The keyword of searches is converted to lower case, unless the
+     *          search is case-sensitive.
+     */
+    static std::optional<Request> parseRequest(const std::string& request, const SearchOptions& defaults);
+
+    /** \brief Handles a single request.
+     *
+     * \param request  the request as received from the client
+     * \return Returns the answer to the request.
+     * \remarks Modified files of the load order are read again before a
+     *          search is performed.
+     */
+    std::string answer(const std::string& request);
+  protected:
+    /** \brief Reads the request of a connected client and sends the answer.
+     *
+     * \param client_socket_fd  file descriptor of the client socket
+     * \param closeWhenDone     whether the connection shall be closed afterwards
+     */
+    virtual void serveClient(const int client_socket_fd, bool& closeWhenDone) override;
+  private:
+    SearchData& m_Data;       /**< the loaded data */
+    SearchOptions m_Defaults; /**< default search options */
+}; // class
+
+} // namespace
+
+#endif // SR_FORMID_FINDER_QUERYSERVER_HPP
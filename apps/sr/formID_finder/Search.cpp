@@ -0,0 +1,454 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2011, 2012, 2013, 2015, 2021, 2023, 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "Search.hpp"
+#include "../../../lib/sr/Activators.hpp"
+#include "../../../lib/sr/AlchemyPotions.hpp"
+#include "../../../lib/sr/Ammunitions.hpp"
+#include "../../../lib/sr/Apparatuses.hpp"
+#include "../../../lib/sr/Armours.hpp"
+#include "../../../lib/sr/Books.hpp"
+#include "../../../lib/sr/Containers.hpp"
+#include "../../../lib/sr/Factions.hpp"
+#include "../../../lib/sr/Floras.hpp"
+#include "../../../lib/sr/FormIDFunctions.hpp"
+#include "../../../lib/sr/Furniture.hpp"
+#include "../../../lib/sr/Ingredients.hpp"
+#include "../../../lib/sr/Keys.hpp"
+#include "../../../lib/sr/MiscObjects.hpp"
+#include "../../../lib/sr/NPCs.hpp"
+#include "../../../lib/sr/Perks.hpp"
+#include "../../../lib/sr/Quests.hpp"
+#include "../../../lib/sr/Scrolls.hpp"
+#include "../../../lib/sr/Shouts.hpp"
+#include "../../../lib/sr/SoulGems.hpp"
+#include "../../../lib/sr/Spells.hpp"
+#include "../../../lib/sr/TalkingActivators.hpp"
+#include "../../../lib/sr/Trees.hpp"
+#include "../../../lib/sr/Weapons.hpp"
+#include "../../../lib/sr/WordsOfPower.hpp"
+#include "AuxFunctions.hpp"
+
+unsigned int searchRecords(const SearchOptions& options, const std::vector<std::string>& loadOrder, const std::map<uint32_t, std::vector<SRTP::ESMReaderFinderReferences::CellRefIDPair> >& refMap, std::ostream& basic_out)
+{
+  const std::string& searchKeyword = options.keyword;
+  const bool caseSensitive = options.caseSensitive;
+  const bool allQuestInfo = options.allQuestInfo;
+  const bool listFactionRanks = options.listFactionRanks;
+  const bool withReferences = options.withReferences;
+  const bool showFiles = options.showFiles;
+
+  unsigned int totalMatches = 0;
+
+  auto listMatches = [&] (const auto& mgr, const std::string_view typePlural)
+  {
+    unsigned int typedMatches = 0;
+    auto mgr_iter = mgr.begin();
+    const auto end = mgr.end();
+    while (mgr_iter != end)
+    {
+      if (mgr_iter->second.name.isPresent())
+      {
+        if (!mgr_iter->second.name.getString().empty())
+        {
+          if (matchesKeyword(mgr_iter->second.name.getString(), searchKeyword, caseSensitive))
+          {
+            // found matching record
+            if (typedMatches == 0)
+            {
+              basic_out << "\n\nMatching " << typePlural << ":\n";
+            }
+            basic_out << "    \"" << mgr_iter->second.name.getString()
+                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(mgr_iter->second.headerFormID, loadOrder, showFiles)
+                      << "\n        editor ID \"" << mgr_iter->second.editorID << "\"\n";
+            if (withReferences)
+            {
+              showRefIDs(mgr_iter->second.headerFormID, refMap, basic_out);
+            }
+            ++typedMatches;
+            ++totalMatches;
+          }
+        }
+      }
+      ++mgr_iter;
+    }
+    if (typedMatches > 0)
+    {
+      basic_out << "Total matching " << typePlural << ": " << typedMatches << "\n";
+    }
+  };
+
+  listMatches(SRTP::Activators::get(), "activators");
+  listMatches(SRTP::AlchemyPotions::get(), "alchemy potions");
+  listMatches(SRTP::Ammunitions::get(), "ammunition");
+  listMatches(SRTP::Apparatuses::get(), "apparatuses");
+  listMatches(SRTP::Armours::get(), "armours");
+
+  // check books for matches
+  {
+    unsigned int bookMatches = 0;
+    auto book_iter = SRTP::Books::get().begin();
+    while (book_iter != SRTP::Books::get().end())
+    {
+      if (book_iter->second.title.isPresent())
+      {
+        if (!book_iter->second.title.getString().empty())
+        {
+          if (matchesKeyword(book_iter->second.title.getString(), searchKeyword, caseSensitive))
+          {
+            // found matching book record
+            if (bookMatches == 0)
+            {
+              basic_out << "\n\nMatching books:\n";
+            }
+            basic_out << "    \"" << book_iter->second.title.getString()
+                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(book_iter->second.headerFormID, loadOrder, showFiles)
+                      << "\n        editor ID \"" << book_iter->second.editorID << "\"\n";
+            if (withReferences)
+            {
+              showRefIDs(book_iter->second.headerFormID, refMap, basic_out);
+            }
+            ++bookMatches;
+            ++totalMatches;
+          }
+        }
+      }
+      ++book_iter;
+    }
+    if (bookMatches > 0)
+    {
+      basic_out << "Total matching books: " << bookMatches << "\n";
+    }
+  }
+
+  listMatches(SRTP::Containers::get(), "containers");
+
+  // check factions for matches
+  {
+    unsigned int factionMatches = 0;
+    auto faction_iter = SRTP::Factions::get().begin();
+    while (faction_iter != SRTP::Factions::get().end())
+    {
+      if (faction_iter->second.name.isPresent())
+      {
+        if (!faction_iter->second.name.getString().empty())
+        {
+          if (matchesKeyword(faction_iter->second.name.getString(), searchKeyword, caseSensitive))
+          {
+            // found matching faction record
+            if (factionMatches == 0)
+            {
+              basic_out << "\n\nMatching factions:\n";
+            }
+            basic_out << "    \"" << faction_iter->second.name.getString()
+                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(faction_iter->second.headerFormID, loadOrder, showFiles)
+                      << "\n        editor ID \"" << faction_iter->second.editorID << "\"\n";
+            if (listFactionRanks)
+            {
+              basic_out << "        ranks: ";
+              const auto rankCount = faction_iter->second.ranks.size();
+              if (rankCount == 0)
+              {
+                // no ranks found
+                basic_out << "none\n";
+              }
+              else
+              {
+                basic_out << rankCount << "\n";
+                for (const auto& rank: faction_iter->second.ranks)
+                {
+                  basic_out << "          (" << rank.index
+                            << ") male: ";
+                  if (!rank.maleName.isPresent())
+                  {
+                    basic_out << "(none)";
+                  }
+                  else
+                  {
+                    basic_out << "\"" << rank.maleName.getString() << "\"";
+                  }
+                  basic_out << ", female: ";
+                  if (!rank.femaleName.isPresent())
+                  {
+                    basic_out << "(none)\n";
+                  }
+                  else
+                  {
+                    basic_out << "\"" << rank.femaleName.getString() << "\"\n";
+                  }
+                }
+              } // else (at least one rank)
+            } // if faction ranks requested
+            ++factionMatches;
+            ++totalMatches;
+          }
+        }
+      }
+      ++faction_iter;
+    }
+    if (factionMatches > 0)
+    {
+      basic_out << "Total matching factions: " << factionMatches << "\n";
+    }
+  }
+
+  listMatches(SRTP::Floras::get(), "floras");
+  listMatches(SRTP::Furniture::get(), "furniture");
+  listMatches(SRTP::Ingredients::get(), "ingredients");
+  listMatches(SRTP::Keys::get(), "keys");
+  listMatches(SRTP::MiscObjects::get(), "misc. objects");
+  listMatches(SRTP::NPCs::get(), "NPCs");
+
+  // check perks for matches - no reference checks
+  {
+    unsigned int perkMatches = 0;
+    auto perk_iter = SRTP::Perks::get().begin();
+    while (perk_iter != SRTP::Perks::get().end())
+    {
+      if (perk_iter->second.name.isPresent())
+      {
+        if (!perk_iter->second.name.getString().empty())
+        {
+          if (matchesKeyword(perk_iter->second.name.getString(), searchKeyword, caseSensitive))
+          {
+            // found matching perk record
+            if (perkMatches == 0)
+            {
+              basic_out << "\n\nMatching perks:\n";
+            }
+            basic_out << "    \"" << perk_iter->second.name.getString()
+                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(perk_iter->second.headerFormID, loadOrder, showFiles)
+                      << "\n        editor ID \"" << perk_iter->second.editorID << "\"\n";
+            ++perkMatches;
+            ++totalMatches;
+          }
+        }
+      }
+      ++perk_iter;
+    }
+    if (perkMatches > 0)
+    {
+      basic_out << "Total matching perks: " << perkMatches << "\n";
+    }
+  }
+
+  // check quests for matches
+  {
+    unsigned int questMatches = 0;
+    bool prefix;
+    auto quest_iter = SRTP::Quests::get().begin();
+    while (quest_iter != SRTP::Quests::get().end())
+    {
+      if (quest_iter->second.name.isPresent())
+      {
+        if (!quest_iter->second.name.getString().empty())
+        {
+          if (matchesKeyword(quest_iter->second.name.getString(), searchKeyword, caseSensitive))
+          {
+            // found matching quest record
+            if (questMatches == 0)
+            {
+              basic_out << "\n\nMatching quests:\n";
+            }
+            basic_out << "    \"" << quest_iter->second.name.getString()
+                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(quest_iter->second.headerFormID, loadOrder, showFiles)
+                      << "\n        editor ID \"" << quest_iter->second.editorID << "\"\n";
+            // indices
+            const auto idx_count = quest_iter->second.indices.size();
+            if (!allQuestInfo)
+            {
+              basic_out << "        indices: ";
+              for (std::vector<SRTP::IndexEntry>::size_type i = 0; i < idx_count; ++i)
+              {
+                if (i != 0)
+                  basic_out << ", ";
+                basic_out << quest_iter->second.indices[i].index;
+                if (quest_iter->second.indices[i].hasFinishingQSDT())
+                  basic_out << " (finishes)";
+              }
+              if (idx_count == 0)
+                basic_out << "none";
+              basic_out << "\n";
+            }
+            else
+            {
+              // full quest info requested
+              basic_out << "        indices:\n";
+              for (const auto& index: quest_iter->second.indices)
+              {
+                basic_out << "          index " << index.index << "\n";
+                // run through QSDTs
+                for (const auto& qsdt: index.theQSDTs)
+                {
+                  prefix = false;
+                  if (qsdt.isFinisher)
+                  {
+                    basic_out << "            (finishes quest) ";
+                    prefix = true;
+                  }
+                  if (qsdt.logEntry.isPresent())
+                  {
+                    if (!prefix)
+                    {
+                      prefix = true;
+                      basic_out << "            ";
+                    }
+                    basic_out << "\"" << qsdt.logEntry.getString() << "\"";
+                  }
+                  if (prefix)
+                    basic_out << "\n";
+                }
+                // check for objective
+                if (quest_iter->second.hasQOBJForIndex(index.index))
+                {
+                  const SRTP::QOBJEntry& ziel = quest_iter->second.getQOBJForIndex(index.index);
+                  if (ziel.displayText.isPresent())
+                  {
+                    basic_out << "            [new objective] \"" << ziel.displayText.getString() << "\"\n";
+                  }
+                }
+              } // for i
+              if (idx_count == 0)
+                basic_out << "          none\n";
+            } // else
+            ++questMatches;
+            ++totalMatches;
+          }
+        }
+      }
+      ++quest_iter;
+    }
+    if (questMatches > 0)
+    {
+      basic_out << "Total matching quests: " << questMatches << "\n";
+    }
+  }
+
+  listMatches(SRTP::Scrolls::get(), "scrolls");
+  listMatches(SRTP::SoulGems::get(), "soul gems");
+  listMatches(SRTP::Spells::get(), "spells");
+
+  // check shouts for matches - no reference checks
+  {
+    unsigned int shoutMatches = 0;
+    auto shout_iter = SRTP::Shouts::get().begin();
+    while (shout_iter != SRTP::Shouts::get().end())
+    {
+      if (shout_iter->second.name.isPresent())
+      {
+        if (!shout_iter->second.name.getString().empty())
+        {
+          if (matchesKeyword(shout_iter->second.name.getString(), searchKeyword, caseSensitive))
+          {
+            // found matching shout record
+            if (shoutMatches == 0)
+            {
+              basic_out << "\n\nMatching dragon shouts:\n";
+            }
+            basic_out << "    \"" << shout_iter->second.name.getString()
+                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(shout_iter->second.headerFormID, loadOrder, showFiles)
+                      << "\n        editor ID \"" << shout_iter->second.editorID << "\"\n";
+            ++shoutMatches;
+            ++totalMatches;
+          }
+        }
+      }
+      ++shout_iter;
+    }
+    if (shoutMatches > 0)
+    {
+      basic_out << "Total matching dragon shouts: " << shoutMatches << "\n";
+    }
+  }
+
+  // check words of power for matches (also checks editor ID for matches)
+  {
+    unsigned int wordMatches = 0;
+    auto word_iter = SRTP::WordsOfPower::get().begin();
+    while (word_iter != SRTP::WordsOfPower::get().end())
+    {
+      if (word_iter->second.name.isPresent())
+      {
+        if (!word_iter->second.name.getString().empty())
+        {
+          if (matchesKeyword(word_iter->second.name.getString(), searchKeyword, caseSensitive)
+            || matchesKeyword(word_iter->second.editorID, searchKeyword, caseSensitive))
+          {
+            // found matching word of power record
+            if (wordMatches == 0)
+            {
+              basic_out << "\n\nMatching words of power:\n";
+            }
+            basic_out << "    \"" << word_iter->second.name.getString()
+                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(word_iter->second.headerFormID, loadOrder, showFiles)
+                      << "\n        editor ID \"" << word_iter->second.editorID << "\"\n";
+            ++wordMatches;
+            ++totalMatches;
+          }
+        }
+      }
+      ++word_iter;
+    }
+    if (wordMatches > 0)
+    {
+      basic_out << "Total matching words of power: " << wordMatches << "\n";
+    }
+  }
+
+  listMatches(SRTP::TalkingActivators::get(), "talking activators");
+
+  // check trees for matches - no reference checks
+  {
+    unsigned int treeMatches = 0;
+    auto tree_iter = SRTP::Trees::get().begin();
+    while (tree_iter != SRTP::Trees::get().end())
+    {
+      if (tree_iter->second.name.isPresent())
+      {
+        if (!tree_iter->second.name.getString().empty())
+        {
+          if (matchesKeyword(tree_iter->second.name.getString(), searchKeyword, caseSensitive))
+          {
+            // found matching tree record
+            if (treeMatches == 0)
+            {
+              basic_out << "\n\nMatching trees:\n";
+            }
+            basic_out << "    \"" << tree_iter->second.name.getString()
+                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(tree_iter->second.headerFormID, loadOrder, showFiles)
+                      << "\n        editor ID \"" << tree_iter->second.editorID << "\"\n";
+            ++treeMatches;
+            ++totalMatches;
+          }
+        }
+      }
+      ++tree_iter;
+    }
+    if (treeMatches > 0)
+    {
+      basic_out << "Total matching trees: " << treeMatches << "\n";
+    }
+  }
+
+  listMatches(SRTP::Weapons::get(), "weapons");
+
+  basic_out << "\nTotal matching objects found: " << totalMatches << "\n";
+  return totalMatches;
+}
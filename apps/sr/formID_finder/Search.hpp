@@ -0,0 +1,50 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SR_FORMID_FINDER_SEARCH_HPP
+#define SR_FORMID_FINDER_SEARCH_HPP
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ESMReaderFinderReferences.hpp"
+
+/** Holds the parameters of a single search. */
+struct SearchOptions
+{
+  std::string keyword;           /**< text to search for, lower case for case-insensitive search */
+  bool caseSensitive = false;    /**< whether to use case-sensitive search */
+  bool allQuestInfo = false;     /**< whether to show texts of quest stages and objectives */
+  bool listFactionRanks = false; /**< whether to show the ranks of factions */
+  bool withReferences = false;   /**< whether to show references of matching objects */
+  bool showFiles = false;        /**< whether to show the file names next to form IDs */
+};
+
+/** \brief Searches the loaded records for a keyword and lists the matches.
+ *
+ * \param options    parameters of the search
+ * \param loadOrder  names of the files in the load order
+ * \param refMap     reference map as produced by ESMReaderFinderReferences
+ * \param basic_out  the output stream to which the matches are written
+ * \return Returns the total number of matching records.
+ */
+unsigned int searchRecords(const SearchOptions& options, const std::vector<std::string>& loadOrder, const std::map<uint32_t, std::vector<SRTP::ESMReaderFinderReferences::CellRefIDPair> >& refMap, std::ostream& basic_out);
+
+#endif // SR_FORMID_FINDER_SEARCH_HPP
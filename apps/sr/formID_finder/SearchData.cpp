@@ -0,0 +1,249 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "SearchData.hpp"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include "../../../lib/sr/ReturnCodes.hpp"
+#include "../../../lib/sr/StringTableCache.hpp"
+#include "../../../lib/sr/records/TES4HeaderRecord.hpp"
+
+namespace SRTP
+{
+
+SearchData::SearchData(const std::vector<std::string>& loadOrder, const Settings& settings)
+: m_LoadOrder(loadOrder),
+  m_Settings(settings),
+  m_Reader(loadOrder),
+  m_References(loadOrder),
+  m_Plugins(std::vector<PluginState>())
+{
+}
+
+int SearchData::load()
+{
+  ESMReaderFinder::clearRecords();
+  m_References.clear();
+
+  if (!m_Settings.cacheDir.empty())
+  {
+    std::error_code error;
+    std::filesystem::create_directories(m_Settings.cacheDir, error);
+    if (error)
+    {
+      std::cerr << "Error: Could not create cache directory "
+                << m_Settings.cacheDir << "!\n";
+      return rcFileError;
+    }
+    // String tables of localized plugins are kept there, too.
+    StringTableCache::get().setDirectory(m_Settings.cacheDir);
+  }
+
+  // Records are only sorted into the record managers once all files are read.
+  ESMReaderFinder::startBulkLoad();
+  ESMReaderFinderReferences::startBulkLoad();
+  const bool staged = (m_Settings.threads > 1) || !m_Settings.cacheDir.empty() || m_Settings.keepIndexes;
+  const int result = staged ? loadStaged() : loadSequentially();
+  ESMReaderFinder::finishBulkLoad();
+  ESMReaderFinderReferences::finishBulkLoad();
+  return result;
+}
+
+int SearchData::loadSequentially()
+{
+  Tes4HeaderRecord tes4rec;
+  m_Plugins.clear();
+
+  // read the usual stuff (for base IDs)
+  for (const auto& element: m_LoadOrder)
+  {
+    if (element != "Update.esm")
+    {
+      PluginState state;
+      state.fileName = m_Settings.dataDir + element;
+      state.key = IndexKey::forFile(state.fileName, m_Settings.localization);
+      m_Plugins.push_back(std::move(state));
+      m_Reader.requestIndexMapUpdate(element);
+      if (m_Reader.readESM(m_Settings.dataDir + element, tes4rec, m_Settings.localization) < 0)
+      {
+        std::cerr << "Error while reading " << m_Settings.dataDir + element << "!\n";
+        return rcFileError;
+      }
+    }
+  }
+
+  if (m_Settings.withReferences)
+  {
+    for (const auto& fileName: m_LoadOrder)
+    {
+      if (fileName != "Update.esm")
+      {
+        m_References.requestIndexMapUpdate(fileName);
+        if (m_References.readESM(m_Settings.dataDir + fileName, tes4rec, m_Settings.localization) < 0)
+        {
+          std::cerr << "Error while reading references from "
+                    << m_Settings.dataDir + fileName << "!\n";
+          return rcFileError;
+        }
+      }
+    }
+  } // if references requested
+  return 0;
+}
+
+int SearchData::loadStaged()
+{
+  // Read all files at once. Every file gets its own staging readers, whose
+  // results are merged in load order afterwards, so that later files still
+  // override earlier ones. Files with an up to date index in memory or in the
+  // cache are not read at all, their index is used at the same position.
+  const bool useCache = !m_Settings.cacheDir.empty();
+  const bool useIndex = useCache || m_Settings.keepIndexes;
+  struct Pending
+  {
+    bool indexed = false;
+    std::unique_ptr<ESMReader> staging;
+    std::unique_ptr<ESMReader> stagingReferences;
+  };
+  std::vector<PluginState> previous = std::move(m_Plugins);
+  m_Plugins.clear();
+  std::vector<Pending> pending;
+  std::vector<std::pair<ESMReader*, std::string> > files;
+  for (const auto& element: m_LoadOrder)
+  {
+    if (element == "Update.esm")
+      continue;
+    PluginState state;
+    state.fileName = m_Settings.dataDir + element;
+    state.key = IndexKey::forFile(state.fileName, m_Settings.localization);
+    Pending work;
+    if (useIndex)
+    {
+      const auto iter = std::find_if(previous.begin(), previous.end(),
+          [&state](const PluginState& p) { return p.fileName == state.fileName; });
+      if ((iter != previous.end()) && (iter->index != nullptr)
+          && state.key.has_value() && (iter->key == state.key))
+      {
+        state.index = std::move(iter->index);
+        work.indexed = true;
+      }
+      else
+      {
+        state.index = std::make_unique<PluginIndex>(m_Settings.withReferences);
+        if (useCache && state.key.has_value())
+        {
+          work.indexed = state.index->load(cacheFile(state.key.value()), state.key.value(),
+                                           m_LoadOrder, m_Settings.withReferences);
+        }
+      }
+    }
+    if (!work.indexed)
+    {
+      m_Reader.requestIndexMapUpdate(element);
+      m_Reader.setIndex(state.index.get());
+      work.staging = m_Reader.createStagingReader();
+      files.emplace_back(work.staging.get(), state.fileName);
+      if (m_Settings.withReferences)
+      {
+        m_References.requestIndexMapUpdate(element);
+        m_References.setIndex(state.index.get());
+        work.stagingReferences = m_References.createStagingReader();
+        files.emplace_back(work.stagingReferences.get(), state.fileName);
+      }
+    }
+    m_Plugins.push_back(std::move(state));
+    pending.push_back(std::move(work));
+  }
+  m_Reader.setIndex(nullptr);
+  m_References.setIndex(nullptr);
+
+  if (!files.empty() && !ESMReader::readESMsConcurrently(files, m_Settings.localization, std::max(m_Settings.threads, 1u)))
+  {
+    std::cerr << "Error while reading the files of the load order!\n";
+    m_Plugins.clear();
+    return rcFileError;
+  }
+  for (std::size_t i = 0; i < m_Plugins.size(); ++i)
+  {
+    PluginState& state = m_Plugins[i];
+    Pending& work = pending[i];
+    if (work.indexed)
+    {
+      ESMReaderFinder::addIndexedRecords(*state.index);
+      if (m_Settings.withReferences)
+      {
+        m_References.addIndexedData(*state.index);
+      }
+    }
+    else
+    {
+      if (!m_Reader.mergeStagingReader(*work.staging)
+          || (m_Settings.withReferences && !m_References.mergeStagingReader(*work.stagingReferences)))
+      {
+        std::cerr << "Error while merging data of " << state.fileName << "!\n";
+        m_Plugins.clear();
+        return rcFileError;
+      }
+      work.staging.reset();
+      work.stagingReferences.reset();
+      if (useCache && state.key.has_value())
+      {
+        if (!state.index->save(cacheFile(state.key.value()), state.key.value(), m_LoadOrder))
+        {
+          std::cerr << "Warning: Could not write index of " << state.fileName
+                    << " to the cache.\n";
+        }
+      }
+    }
+    if (!m_Settings.keepIndexes)
+    {
+      state.index.reset();
+    }
+  }
+  return 0;
+}
+
+bool SearchData::filesChanged() const
+{
+  for (const auto& state: m_Plugins)
+  {
+    if (!(state.key == IndexKey::forFile(state.fileName, m_Settings.localization)))
+      return true;
+  }
+  return false;
+}
+
+const std::vector<std::string>& SearchData::loadOrder() const
+{
+  return m_LoadOrder;
+}
+
+const std::map<uint32_t, std::vector<ESMReaderFinderReferences::CellRefIDPair> >& SearchData::references() const
+{
+  return m_References.refMap;
+}
+
+std::filesystem::path SearchData::cacheFile(const IndexKey& key) const
+{
+  return std::filesystem::path(m_Settings.cacheDir) / key.cacheFileName();
+}
+
+} // namespace
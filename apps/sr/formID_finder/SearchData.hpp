@@ -0,0 +1,125 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SR_FORMID_FINDER_SEARCHDATA_HPP
+#define SR_FORMID_FINDER_SEARCHDATA_HPP
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../../../lib/sr/Localization.hpp"
+#include "ESMReaderFinder.hpp"
+#include "ESMReaderFinderReferences.hpp"
+#include "PluginIndex.hpp"
+
+namespace SRTP
+{
+
+/** Loads the records of all files in the load order that formID_finder
+ *  searches through.
+ */
+class SearchData
+{
+  public:
+    /// settings that control how the data is loaded
+    struct Settings
+    {
+      std::string dataDir;                       /**< path of the Data directory, with trailing slash */
+      std::optional<Localization> localization;  /**< preferred localization for string tables */
+      bool withReferences = false;               /**< whether to load cells and references, too */
+      unsigned int threads = 1;                  /**< number of threads used for reading */
+      std::string cacheDir;                      /**< directory of the index cache, empty for none */
+      bool keepIndexes = false;                  /**< whether to keep the index of every file in memory */
+    };
+
+    /** \brief Constructor.
+     *
+     * \param loadOrder  names of the files in load order
+     * \param settings   settings that control how the data is loaded
+     */
+    SearchData(const std::vector<std::string>& loadOrder, const Settings& settings);
+
+    /** \brief Loads the data of all files in the load order.
+     *
+     * \return Returns zero in case of success.
+     *         Returns a non-zero return code, if an error occurred.
+     * \remarks Data of a previous call is discarded first. With a cache
+     *          directory, files that did not change are read from the cache.
+     *          If the indexes are kept in memory, files that did not change
+     *          since the previous call are not read again at all.
+     */
+    int load();
+
+    /** \brief Checks whether any file of the load order was modified since
+     *         the data was loaded.
+     *
+     * \return Returns true, if the size or the modification time of at least
+     *         one file changed. Returns false otherwise.
+     */
+    bool filesChanged() const;
+
+    /// Gets the names of the files in load order.
+    const std::vector<std::string>& loadOrder() const;
+
+    /// Gets the reference map, only filled when references are loaded.
+    const std::map<uint32_t, std::vector<ESMReaderFinderReferences::CellRefIDPair> >& references() const;
+  private:
+    /// state of a single file of the load order
+    struct PluginState
+    {
+      std::string fileName;               /**< path of the file */
+      std::optional<IndexKey> key;        /**< key of the file when it was loaded */
+      std::unique_ptr<PluginIndex> index; /**< searchable data of the file, if kept */
+    };
+
+    /** \brief Reads all files one after another without any index.
+     *
+     * \return Returns zero in case of success.
+     *         Returns a non-zero return code, if an error occurred.
+     */
+    int loadSequentially();
+
+    /** \brief Reads all files at once, using indexes where possible.
+     *
+     * \return Returns zero in case of success.
+     *         Returns a non-zero return code, if an error occurred.
+     */
+    int loadStaged();
+
+    /** \brief Gets the path of the cache file for a key.
+     *
+     * \param key  the key of the file
+     * \return Returns the path inside the cache directory.
+     */
+    std::filesystem::path cacheFile(const IndexKey& key) const;
+
+    std::vector<std::string> m_LoadOrder;   /**< names of the files in load order */
+    Settings m_Settings;                    /**< settings for loading */
+    ESMReaderFinder m_Reader;               /**< reader for searchable records */
+    ESMReaderFinderReferences m_References; /**< reader for cells and references */
+    std::vector<PluginState> m_Plugins;     /**< state of each loaded file */
+}; // class
+
+} // namespace
+
+#endif // SR_FORMID_FINDER_SEARCHDATA_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2012, 2013, 2015, 2021, 2023  Dirk Stolle
+    Copyright (C) 2011, 2012, 2013, 2015, 2021, 2023, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -18,10 +18,11 @@
  -------------------------------------------------------------------------------
 */
 
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <string>
-#include <set>
+#include <vector>
 #if defined(_WIN32)
 #include <windows.h>
 #else
@@ -31,41 +32,17 @@
 #endif
 #include "../../../lib/base/FileFunctions.hpp"
 #include "../../../lib/base/UtilityFunctions.hpp"
-#include "../../../lib/sr/Activators.hpp"
-#include "../../../lib/sr/AlchemyPotions.hpp"
-#include "../../../lib/sr/Ammunitions.hpp"
-#include "../../../lib/sr/Apparatuses.hpp"
-#include "../../../lib/sr/Armours.hpp"
-#include "../../../lib/sr/Books.hpp"
-#include "../../../lib/sr/Cells.hpp"
-#include "../../../lib/sr/Containers.hpp"
 #include "../../../lib/sr/DependencySolver.hpp"
 #include "../../../lib/sr/Edition.hpp"
-#include "../../../lib/sr/Factions.hpp"
-#include "../../../lib/sr/Floras.hpp"
-#include "../../../lib/sr/FormIDFunctions.hpp"
-#include "../../../lib/sr/Furniture.hpp"
-#include "../../../lib/sr/Ingredients.hpp"
-#include "../../../lib/sr/Keys.hpp"
 #include "../../../lib/sr/Localization.hpp"
-#include "../../../lib/sr/MiscObjects.hpp"
-#include "../../../lib/sr/NPCs.hpp"
 #include "../../../lib/sr/PathFunctions.hpp"
-#include "../../../lib/sr/Perks.hpp"
 #include "../../../lib/sr/ReturnCodes.hpp"
-#include "../../../lib/sr/Quests.hpp"
-#include "../../../lib/sr/Scrolls.hpp"
-#include "../../../lib/sr/Shouts.hpp"
-#include "../../../lib/sr/SoulGems.hpp"
-#include "../../../lib/sr/Spells.hpp"
-#include "../../../lib/sr/TalkingActivators.hpp"
-#include "../../../lib/sr/Trees.hpp"
-#include "../../../lib/sr/Weapons.hpp"
-#include "../../../lib/sr/WordsOfPower.hpp"
-#include "../../../lib/sr/records/TES4HeaderRecord.hpp"
 #include "AuxFunctions.hpp"
-#include "ESMReaderFinder.hpp"
-#include "ESMReaderFinderReferences.hpp"
+#include "Search.hpp"
+#include "SearchData.hpp"
+#if !defined(_WIN32)
+#include "QueryServer.hpp"
+#endif
 
 void showGPLNotice()
 {
@@ -135,7 +112,21 @@ void showHelp()
             << "  --italian | --it - set the language to load to Italian.\n"
             << "  --polish | --pl  - set the language to load to Polish.\n"
             << "  --russian | --ru - set the language to load to Russian.\n"
-            << "  --spanish | --es - set the language to load to Spanish.\n";
+            << "  --spanish | --es - set the language to load to Spanish.\n"
+            << "  --threads N      - read all files of the load order with N threads in\n"
+            << "                     parallel. N has to be between 1 and 256. Default is 1.\n"
+            << "  --cache DIR      - keep an index of the searchable data and the string\n"
+            << "                     tables of each file in the directory DIR. Files that\n"
+            << "                     did not change since the last search are read from\n"
+            << "                     that index, which is much faster.\n"
+            #if !defined(_WIN32)
+            << "  --serve SOCKET   - read the load order once and then answer search\n"
+            << "                     requests on the Unix domain socket SOCKET until a\n"
+            << "                     shutdown request arrives. Modified files are read\n"
+            << "                     again before the next search. No search keyword may\n"
+            << "                     be given in that mode.\n"
+            #endif
+            ;
 }
 
 int main(int argc, char **argv)
@@ -154,6 +145,9 @@ int main(int argc, char **argv)
   std::string sendParam2nd = "";
   bool withReferences = false;
   bool showFiles = false;
+  unsigned int threads = 0;
+  std::string cacheDir = "";
+  std::string serverSocket = "";
   std::optional<SRTP::Edition> edition = std::nullopt;
   std::optional<SRTP::Localization> localization = std::nullopt;
 
@@ -409,6 +403,82 @@ int main(int argc, char **argv)
           }
           showFiles = true;
         } // show files
+        else if (param == "--threads")
+        {
+          // set more than once?
+          if (threads != 0)
+          {
+            std::cerr << "Error: Parameter " << param << " was already specified!\n";
+            return SRTP::rcInvalidParameter;
+          }
+          // enough parameters?
+          if ((i + 1 < argc) && (argv[i+1] != nullptr))
+          {
+            int32_t value = 0;
+            if (!stringToLong(std::string(argv[i+1]), value) || (value < 1) || (value > 256))
+            {
+              std::cerr << "Error: \"" << std::string(argv[i+1]) << "\" is not a "
+                        << "valid number of threads. It has to be an integer "
+                        << "between 1 and 256.\n";
+              return SRTP::rcInvalidParameter;
+            }
+            threads = static_cast<unsigned int>(value);
+            ++i; // skip next parameter, because it's used as thread count already
+            std::cout << "Number of threads was set to " << threads << ".\n";
+          }
+          else
+          {
+            std::cerr << "Error: You have to specify a number after \""
+                      << param << "\".\n";
+            return SRTP::rcInvalidParameter;
+          }
+        } // threads
+        else if (param == "--cache")
+        {
+          // set more than once?
+          if (!cacheDir.empty())
+          {
+            std::cerr << "Error: Parameter " << param << " was already specified!\n";
+            return SRTP::rcInvalidParameter;
+          }
+          // enough parameters?
+          if ((i + 1 < argc) && (argv[i+1] != nullptr) && (argv[i+1][0] != '\0'))
+          {
+            cacheDir = std::string(argv[i+1]);
+            ++i; // skip next parameter, because it's used as directory already
+            std::cout << "Cache directory was set to " << cacheDir << ".\n";
+          }
+          else
+          {
+            std::cerr << "Error: You have to specify a directory name after \""
+                      << param << "\".\n";
+            return SRTP::rcInvalidParameter;
+          }
+        } // cache
+        #if !defined(_WIN32)
+        else if (param == "--serve")
+        {
+          // set more than once?
+          if (!serverSocket.empty())
+          {
+            std::cerr << "Error: Parameter " << param << " was already specified!\n";
+            return SRTP::rcInvalidParameter;
+          }
+          // enough parameters?
+          if ((i + 1 < argc) && (argv[i+1] != nullptr) && (argv[i+1][0] != '\0'))
+          {
+            serverSocket = std::string(argv[i+1]);
+            ++i; // skip next parameter, because it's used as socket name already
+            std::cout << "Server mode was requested, socket is " << serverSocket << ".\n";
+          }
+          else
+          {
+            std::cerr << "Error: You have to specify a socket file name after \""
+                      << param << "\".\n";
+            return SRTP::rcInvalidParameter;
+          }
+        } // server mode
+        #endif
         else if (searchKeyword.empty())
         {
           // assume search keyword was given without prior --keyword option
@@ -442,22 +512,39 @@ int main(int argc, char **argv)
   // Has the user specified a data directory?
   SRTP::getDataDir(dataDir, edition);
 
+  if (!serverSocket.empty())
+  {
+    if (!searchKeyword.empty() || sendData)
+    {
+      std::cerr << "Error: Parameter --serve cannot be combined with a search "
+                << "keyword or with --send-data. Keywords are sent by the "
+                << "clients of the server instead.\n";
+      return SRTP::rcInvalidParameter;
+    }
+  }
   // keyword given?
-  if (searchKeyword.empty())
+  else if (searchKeyword.empty())
   {
     std::cout << "Error: No search keyword was specified. Use the parameter --keyword"
               << " to specify the stuff you want that programme to search for.\n";
     return SRTP::rcInvalidParameter;
   }
 
-  // adjust keyword to selected case-sensitivity
-  if (!caseSensitive)
-    searchKeyword = lowerCase(searchKeyword);
-
-  std::cout << "\n\nSearching for \"" << searchKeyword << "\" using case-";
-  if (!caseSensitive)
-    std::cout << "in";
-  std::cout << "sensitive search. This may take a while...\n";
+  if (serverSocket.empty())
+  {
+    // adjust keyword to selected case-sensitivity
+    if (!caseSensitive)
+      searchKeyword = lowerCase(searchKeyword);
+
+    std::cout << "\n\nSearching for \"" << searchKeyword << "\" using case-";
+    if (!caseSensitive)
+      std::cout << "in";
+    std::cout << "sensitive search. This may take a while...\n";
+  }
+  else
+  {
+    std::cout << "\n\nReading the load order for server mode. This may take a while...\n";
+  }
   if (withReferences)
   {
     std::cout << "Since you want to search for reference IDs, too, this may take even longer...\n";
@@ -492,446 +579,70 @@ int main(int argc, char **argv)
     }
   }
 
-  SRTP::ESMReaderFinder reader(loadOrder);
-  SRTP::Tes4HeaderRecord tes4rec;
-
-  // read the usual stuff (for base IDs)
-  for (const auto& element: loadOrder)
+  SRTP::SearchData::Settings settings;
+  settings.dataDir = dataDir;
+  settings.localization = localization;
+  settings.withReferences = withReferences;
+  settings.threads = threads;
+  settings.cacheDir = cacheDir;
+  // The server keeps the data of each file, so that only modified files have
+  // to be read again later.
+  settings.keepIndexes = !serverSocket.empty();
+  SRTP::SearchData data(loadOrder, settings);
+  const int loadResult = data.load();
+  if (loadResult != 0)
   {
-    if (element != "Update.esm")
-    {
-      reader.requestIndexMapUpdate(element);
-      if (reader.readESM(dataDir + element, tes4rec, localization) < 0)
-      {
-        std::cerr << "Error while reading " << dataDir + element << "!\n";
-        return SRTP::rcFileError;
-      }
-    }
+    return loadResult;
   }
 
-  SRTP::ESMReaderFinderReferences readerReferences(loadOrder);
-  if (withReferences)
-  {
-    for (const auto& fileName: loadOrder)
-    {
-      if (fileName != "Update.esm")
-      {
-        readerReferences.requestIndexMapUpdate(fileName);
-        if (readerReferences.readESM(dataDir + fileName, tes4rec, localization) < 0)
-        {
-          std::cerr << "Error while reading references from "
-                    << dataDir + fileName << "!\n";
-          return SRTP::rcFileError;
-        }
-      }
-    }
-  } // if references requested
-
-  std::ostringstream string_out;
-  std::basic_ostream<char>& basic_out = sendData ? string_out : std::cout;
-
   /*Adjust show files value.
 
     Files are shown by default. However, if sendData is true, then they are not
     shown for compatibility reasons, unless the --show-files parameter was set.
+    The server mode cannot be combined with sendData, so its answers always
+    show the files, just like a normal run.
   */
   showFiles = (showFiles || !sendData);
 
-  unsigned int totalMatches = 0;
-
-  auto listMatches = [&] (const auto& mgr, const std::string_view typePlural)
-  {
-    unsigned int typedMatches = 0;
-    auto mgr_iter = mgr.begin();
-    const auto end = mgr.end();
-    while (mgr_iter != end)
-    {
-      if (mgr_iter->second.name.isPresent())
-      {
-        if (!mgr_iter->second.name.getString().empty())
-        {
-          if (matchesKeyword(mgr_iter->second.name.getString(), searchKeyword, caseSensitive))
-          {
-            // found matching record
-            if (typedMatches == 0)
-            {
-              basic_out << "\n\nMatching " << typePlural << ":\n";
-            }
-            basic_out << "    \"" << mgr_iter->second.name.getString()
-                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(mgr_iter->second.headerFormID, loadOrder, showFiles)
-                      << "\n        editor ID \"" << mgr_iter->second.editorID << "\"\n";
-            if (withReferences)
-            {
-              showRefIDs(mgr_iter->second.headerFormID, readerReferences.refMap, basic_out);
-            }
-            ++typedMatches;
-            ++totalMatches;
-          }
-        }
-      }
-      ++mgr_iter;
-    }
-    if (typedMatches > 0)
-    {
-      basic_out << "Total matching " << typePlural << ": " << typedMatches << "\n";
-    }
-  };
-
-  listMatches(SRTP::Activators::get(), "activators");
-  listMatches(SRTP::AlchemyPotions::get(), "alchemy potions");
-  listMatches(SRTP::Ammunitions::get(), "ammunition");
-  listMatches(SRTP::Apparatuses::get(), "apparatuses");
-  listMatches(SRTP::Armours::get(), "armours");
-
-  // check books for matches
-  {
-    unsigned int bookMatches = 0;
-    auto book_iter = SRTP::Books::get().begin();
-    while (book_iter != SRTP::Books::get().end())
-    {
-      if (book_iter->second.title.isPresent())
-      {
-        if (!book_iter->second.title.getString().empty())
-        {
-          if (matchesKeyword(book_iter->second.title.getString(), searchKeyword, caseSensitive))
-          {
-            // found matching book record
-            if (bookMatches == 0)
-            {
-              basic_out << "\n\nMatching books:\n";
-            }
-            basic_out << "    \"" << book_iter->second.title.getString()
-                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(book_iter->second.headerFormID, loadOrder, showFiles)
-                      << "\n        editor ID \"" << book_iter->second.editorID << "\"\n";
-            if (withReferences)
-            {
-              showRefIDs(book_iter->second.headerFormID, readerReferences.refMap, basic_out);
-            }
-            ++bookMatches;
-            ++totalMatches;
-          }
-        }
-      }
-      ++book_iter;
-    }
-    if (bookMatches > 0)
-    {
-      basic_out << "Total matching books: " << bookMatches << "\n";
-    }
-  }
-
-  listMatches(SRTP::Containers::get(), "containers");
-
-  // check factions for matches
-  {
-    unsigned int factionMatches = 0;
-    auto faction_iter = SRTP::Factions::get().begin();
-    while (faction_iter != SRTP::Factions::get().end())
-    {
-      if (faction_iter->second.name.isPresent())
-      {
-        if (!faction_iter->second.name.getString().empty())
-        {
-          if (matchesKeyword(faction_iter->second.name.getString(), searchKeyword, caseSensitive))
-          {
-            // found matching faction record
-            if (factionMatches == 0)
-            {
-              basic_out << "\n\nMatching factions:\n";
-            }
-            basic_out << "    \"" << faction_iter->second.name.getString()
-                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(faction_iter->second.headerFormID, loadOrder, showFiles)
-                      << "\n        editor ID \"" << faction_iter->second.editorID << "\"\n";
-            if (listFactionRanks)
-            {
-              basic_out << "        ranks: ";
-              const auto rankCount = faction_iter->second.ranks.size();
-              if (rankCount == 0)
-              {
-                // no ranks found
-                basic_out << "none\n";
-              }
-              else
-              {
-                basic_out << rankCount << "\n";
-                for (const auto& rank: faction_iter->second.ranks)
-                {
-                  basic_out << "          (" << rank.index
-                            << ") male: ";
-                  if (!rank.maleName.isPresent())
-                  {
-                    basic_out << "(none)";
-                  }
-                  else
-                  {
-                    basic_out << "\"" << rank.maleName.getString() << "\"";
-                  }
-                  basic_out << ", female: ";
-                  if (!rank.femaleName.isPresent())
-                  {
-                    basic_out << "(none)\n";
-                  }
-                  else
-                  {
-                    basic_out << "\"" << rank.femaleName.getString() << "\"\n";
-                  }
-                }
-              } // else (at least one rank)
-            } // if faction ranks requested
-            ++factionMatches;
-            ++totalMatches;
-          }
-        }
-      }
-      ++faction_iter;
-    }
-    if (factionMatches > 0)
-    {
-      basic_out << "Total matching factions: " << factionMatches << "\n";
-    }
-  }
-
-  listMatches(SRTP::Floras::get(), "floras");
-  listMatches(SRTP::Furniture::get(), "furniture");
-  listMatches(SRTP::Ingredients::get(), "ingredients");
-  listMatches(SRTP::Keys::get(), "keys");
-  listMatches(SRTP::MiscObjects::get(), "misc. objects");
-  listMatches(SRTP::NPCs::get(), "NPCs");
-
-  // check perks for matches - no reference checks
-  {
-    unsigned int perkMatches = 0;
-    auto perk_iter = SRTP::Perks::get().begin();
-    while (perk_iter != SRTP::Perks::get().end())
-    {
-      if (perk_iter->second.name.isPresent())
-      {
-        if (!perk_iter->second.name.getString().empty())
-        {
-          if (matchesKeyword(perk_iter->second.name.getString(), searchKeyword, caseSensitive))
-          {
-            // found matching perk record
-            if (perkMatches == 0)
-            {
-              basic_out << "\n\nMatching perks:\n";
-            }
-            basic_out << "    \"" << perk_iter->second.name.getString()
-                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(perk_iter->second.headerFormID, loadOrder, showFiles)
-                      << "\n        editor ID \"" << perk_iter->second.editorID << "\"\n";
-            ++perkMatches;
-            ++totalMatches;
-          }
-        }
-      }
-      ++perk_iter;
-    }
-    if (perkMatches > 0)
-    {
-      basic_out << "Total matching perks: " << perkMatches << "\n";
-    }
-  }
-
-  // check quests for matches
-  {
-    unsigned int questMatches = 0;
-    bool prefix;
-    auto quest_iter = SRTP::Quests::get().begin();
-    while (quest_iter != SRTP::Quests::get().end())
-    {
-      if (quest_iter->second.name.isPresent())
-      {
-        if (!quest_iter->second.name.getString().empty())
-        {
-          if (matchesKeyword(quest_iter->second.name.getString(), searchKeyword, caseSensitive))
-          {
-            // found matching quest record
-            if (questMatches == 0)
-            {
-              basic_out << "\n\nMatching quests:\n";
-            }
-            basic_out << "    \"" << quest_iter->second.name.getString()
-                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(quest_iter->second.headerFormID, loadOrder, showFiles)
-                      << "\n        editor ID \"" << quest_iter->second.editorID << "\"\n";
-            // indices
-            const auto idx_count = quest_iter->second.indices.size();
-            if (!allQuestInfo)
-            {
-              basic_out << "        indices: ";
-              for (std::vector<SRTP::IndexEntry>::size_type i = 0; i < idx_count; ++i)
-              {
-                if (i != 0)
-                  basic_out << ", ";
-                basic_out << quest_iter->second.indices[i].index;
-                if (quest_iter->second.indices[i].hasFinishingQSDT())
-                  basic_out << " (finishes)";
-              }
-              if (idx_count == 0)
-                basic_out << "none";
-              basic_out << "\n";
-            }
-            else
-            {
-              // full quest info requested
-              basic_out << "        indices:\n";
-              for (const auto& index: quest_iter->second.indices)
-              {
-                basic_out << "          index " << index.index << "\n";
-                // run through QSDTs
-                for (const auto& qsdt: index.theQSDTs)
-                {
-                  prefix = false;
-                  if (qsdt.isFinisher)
-                  {
-                    basic_out << "            (finishes quest) ";
-                    prefix = true;
-                  }
-                  if (qsdt.logEntry.isPresent())
-                  {
-                    if (!prefix)
-                    {
-                      prefix = true;
-                      basic_out << "            ";
-                    }
-                    basic_out << "\"" << qsdt.logEntry.getString() << "\"";
-                  }
-                  if (prefix)
-                    basic_out << "\n";
-                }
-                // check for objective
-                if (quest_iter->second.hasQOBJForIndex(index.index))
-                {
-                  const SRTP::QOBJEntry& ziel = quest_iter->second.getQOBJForIndex(index.index);
-                  if (ziel.displayText.isPresent())
-                  {
-                    basic_out << "            [new objective] \"" << ziel.displayText.getString() << "\"\n";
-                  }
-                }
-              } // for i
-              if (idx_count == 0)
-                basic_out << "          none\n";
-            } // else
-            ++questMatches;
-            ++totalMatches;
-          }
-        }
-      }
-      ++quest_iter;
-    }
-    if (questMatches > 0)
-    {
-      basic_out << "Total matching quests: " << questMatches << "\n";
-    }
-  }
-
-  listMatches(SRTP::Scrolls::get(), "scrolls");
-  listMatches(SRTP::SoulGems::get(), "soul gems");
-  listMatches(SRTP::Spells::get(), "spells");
-
-  // check shouts for matches - no reference checks
-  {
-    unsigned int shoutMatches = 0;
-    auto shout_iter = SRTP::Shouts::get().begin();
-    while (shout_iter != SRTP::Shouts::get().end())
-    {
-      if (shout_iter->second.name.isPresent())
-      {
-        if (!shout_iter->second.name.getString().empty())
-        {
-          if (matchesKeyword(shout_iter->second.name.getString(), searchKeyword, caseSensitive))
-          {
-            // found matching shout record
-            if (shoutMatches == 0)
-            {
-              basic_out << "\n\nMatching dragon shouts:\n";
-            }
-            basic_out << "    \"" << shout_iter->second.name.getString()
-                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(shout_iter->second.headerFormID, loadOrder, showFiles)
-                      << "\n        editor ID \"" << shout_iter->second.editorID << "\"\n";
-            ++shoutMatches;
-            ++totalMatches;
-          }
-        }
-      }
-      ++shout_iter;
-    }
-    if (shoutMatches > 0)
-    {
-      basic_out << "Total matching dragon shouts: " << shoutMatches << "\n";
-    }
-  }
-
-  // check words of power for matches (also checks editor ID for matches)
+  #if !defined(_WIN32)
+  if (!serverSocket.empty())
   {
-    unsigned int wordMatches = 0;
-    auto word_iter = SRTP::WordsOfPower::get().begin();
-    while (word_iter != SRTP::WordsOfPower::get().end())
+    SearchOptions defaults;
+    defaults.caseSensitive = caseSensitive;
+    defaults.allQuestInfo = allQuestInfo;
+    defaults.listFactionRanks = listFactionRanks;
+    defaults.withReferences = withReferences;
+    defaults.showFiles = showFiles;
+    SRTP::QueryServer server(data, defaults);
+    if (!server.activate(serverSocket) || !server.makeNonBlocking())
     {
-      if (word_iter->second.name.isPresent())
-      {
-        if (!word_iter->second.name.getString().empty())
-        {
-          if (matchesKeyword(word_iter->second.name.getString(), searchKeyword, caseSensitive)
-            || matchesKeyword(word_iter->second.editorID, searchKeyword, caseSensitive))
-          {
-            // found matching word of power record
-            if (wordMatches == 0)
-            {
-              basic_out << "\n\nMatching words of power:\n";
-            }
-            basic_out << "    \"" << word_iter->second.name.getString()
-                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(word_iter->second.headerFormID, loadOrder, showFiles)
-                      << "\n        editor ID \"" << word_iter->second.editorID << "\"\n";
-            ++wordMatches;
-            ++totalMatches;
-          }
-        }
-      }
-      ++word_iter;
+      std::cerr << "Error: Could not create Unix domain socket " << serverSocket << "!\n";
+      return SRTP::rcSocketError;
     }
-    if (wordMatches > 0)
+    std::cout << "Waiting for search requests on " << serverSocket << ".\n";
+    while (!server.shutdownRequested())
     {
-      basic_out << "Total matching words of power: " << wordMatches << "\n";
-    }
-  }
-
-  listMatches(SRTP::TalkingActivators::get(), "talking activators");
-
-  // check trees for matches - no reference checks
-  {
-    unsigned int treeMatches = 0;
-    auto tree_iter = SRTP::Trees::get().begin();
-    while (tree_iter != SRTP::Trees::get().end())
-    {
-      if (tree_iter->second.name.isPresent())
+      if (!server.startListening(1000))
       {
-        if (!tree_iter->second.name.getString().empty())
-        {
-          if (matchesKeyword(tree_iter->second.name.getString(), searchKeyword, caseSensitive))
-          {
-            // found matching tree record
-            if (treeMatches == 0)
-            {
-              basic_out << "\n\nMatching trees:\n";
-            }
-            basic_out << "    \"" << tree_iter->second.name.getString()
-                      << "\"\n        form ID " << SRTP::getFormIDAsStringWithFile(tree_iter->second.headerFormID, loadOrder, showFiles)
-                      << "\n        editor ID \"" << tree_iter->second.editorID << "\"\n";
-            ++treeMatches;
-            ++totalMatches;
-          }
-        }
+        return SRTP::rcSocketError;
       }
-      ++tree_iter;
-    }
-    if (treeMatches > 0)
-    {
-      basic_out << "Total matching trees: " << treeMatches << "\n";
     }
+    std::cout << "Shutdown was requested, server stops.\n";
+    return 0;
   }
+  #endif
 
-  listMatches(SRTP::Weapons::get(), "weapons");
+  std::ostringstream string_out;
+  std::basic_ostream<char>& basic_out = sendData ? string_out : std::cout;
 
-  basic_out << "\nTotal matching objects found: " << totalMatches << "\n";
+  SearchOptions options;
+  options.keyword = searchKeyword;
+  options.caseSensitive = caseSensitive;
+  options.allQuestInfo = allQuestInfo;
+  options.listFactionRanks = listFactionRanks;
+  options.withReferences = withReferences;
+  options.showFiles = showFiles;
+  searchRecords(options, loadOrder, data.references(), basic_out);
 
   if (sendData)
   {
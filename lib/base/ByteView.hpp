@@ -0,0 +1,109 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef MWTP_BASE_BYTEVIEW_HPP
+#define MWTP_BASE_BYTEVIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MWTP
+{
+
+/** Non-owning, read-only view of a contiguous sequence of bytes.
+ *
+ * This is basically what std::span<const uint8_t> is in C++20. The viewed
+ * memory must outlive the view.
+ */
+class ByteView
+{
+  public:
+    /// Creates an empty view.
+    constexpr ByteView() noexcept
+    : m_Data(nullptr),
+      m_Size(0)
+    { }
+
+    /** \brief Creates a view of the given memory.
+     *
+     * \param data  pointer to the first byte
+     * \param size  number of bytes in the view
+     */
+    constexpr ByteView(const uint8_t* data, const std::size_t size) noexcept
+    : m_Data(data),
+      m_Size(size)
+    { }
+
+    /// Gets a pointer to the first byte of the view.
+    constexpr const uint8_t* data() const noexcept
+    {
+      return m_Data;
+    }
+
+    /// Gets the number of bytes in the view.
+    constexpr std::size_t size() const noexcept
+    {
+      return m_Size;
+    }
+
+    /// Checks whether the view contains no bytes.
+    constexpr bool empty() const noexcept
+    {
+      return m_Size == 0;
+    }
+
+    constexpr const uint8_t* begin() const noexcept
+    {
+      return m_Data;
+    }
+
+    constexpr const uint8_t* end() const noexcept
+    {
+      return m_Data + m_Size;
+    }
+
+    constexpr uint8_t operator[](const std::size_t index) const noexcept
+    {
+      return m_Data[index];
+    }
+
+    /** \brief Gets a view of a part of this view.
+     *
+     * \param offset  offset of the first byte of the sub view
+     * \param count   number of bytes in the sub view
+     * \return Returns the sub view. If the requested range exceeds the bounds
+     *         of this view, the sub view is truncated accordingly.
+     */
+    constexpr ByteView subView(std::size_t offset, std::size_t count) const noexcept
+    {
+      if (offset > m_Size)
+        offset = m_Size;
+      if (count > m_Size - offset)
+        count = m_Size - offset;
+      return ByteView(m_Data + offset, count);
+    }
+  private:
+    const uint8_t* m_Data; /**< pointer to the first byte */
+    std::size_t m_Size;    /**< number of bytes */
+}; // class
+
+} // namespace
+
+#endif // MWTP_BASE_BYTEVIEW_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2011, 2012, 2013, 2021, 2022  Dirk Stolle
+    Copyright (C) 2011, 2012, 2013, 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -25,7 +25,7 @@
 namespace MWTP
 {
 
-bool zlibDecompress(uint8_t * compressedData, const uint32_t compressedSize, uint8_t * decompBuffer, const uint32_t decompSize)
+bool zlibDecompress(const uint8_t * compressedData, const uint32_t compressedSize, uint8_t * decompBuffer, const uint32_t decompSize)
 {
   if ((compressedData == nullptr) || (compressedSize == 0)
      || (decompBuffer == nullptr) || (decompSize == 0))
@@ -64,7 +64,8 @@ bool zlibDecompress(uint8_t * compressedData, const uint32_t compressedSize, uin
   }
 
   streamZlib.avail_in = compressedSize;
-  streamZlib.next_in = compressedData;
+  // zlib does not modify the input, it just lacks const in its API.
+  streamZlib.next_in = const_cast<uint8_t*>(compressedData);
 
   streamZlib.avail_out = decompSize;
   streamZlib.next_out = decompBuffer;
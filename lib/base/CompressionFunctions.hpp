@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2011, 2021, 2022  Dirk Stolle
+    Copyright (C) 2011, 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -36,7 +36,7 @@ namespace MWTP
  * \param decompSize       size of decompBuffer in bytes
  * \return Returns true in case of success, or false if an error occurred.
  */
-bool zlibDecompress(uint8_t * compressedData, const uint32_t compressedSize, uint8_t * decompBuffer, const uint32_t decompSize);
+bool zlibDecompress(const uint8_t * compressedData, const uint32_t compressedSize, uint8_t * decompBuffer, const uint32_t decompSize);
 
 /** Tries to compress the data pointed to by rawData and stores the compressed
  * bits in compBuffer.
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2011, 2013, 2021, 2024  Dirk Stolle
+    Copyright (C) 2011, 2013, 2021, 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -20,7 +20,14 @@
 
 #include "FileFunctions.hpp"
 #include <filesystem>
+#include <random>
+#include <sstream>
 #include <sys/stat.h> // stat()
+#if defined(_WIN32)
+#include <process.h> // _getpid()
+#else
+#include <unistd.h> // getpid()
+#endif
 #include <cmath>   // std::round()
 #include "UtilityFunctions.hpp" // floatToString()
 
@@ -134,6 +141,19 @@ bool deleteFile(const std::string& fileName)
   return std::filesystem::remove(fileName, error) && !error;
 }
 
+std::string temporaryFileName(const std::string& fileName)
+{
+  #if defined(_WIN32)
+  const auto pid = _getpid();
+  #else
+  const auto pid = getpid();
+  #endif
+  std::random_device randDev;
+  std::ostringstream stream;
+  stream << fileName << '.' << pid << '-' << std::hex << randDev() << ".tmp";
+  return stream.str();
+}
+
 FileEntry::FileEntry()
 : fileName(""), isDirectory(false)
 { }
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2011, 2013, 2021, 2024  Dirk Stolle
+    Copyright (C) 2011, 2013, 2021, 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -79,6 +79,17 @@ bool FileExists(const std::string& FileName);
  */
 bool deleteFile(const std::string& fileName);
 
+/** \brief Gets a name for a temporary file next to the file @fileName.
+ *
+ * \param fileName  the file that will be replaced by the temporary file later
+ * \return Returns the name of a file in the same directory as @fileName.
+ * \remarks The name contains the current process id and a random suffix, so
+ *          concurrent processes that write the same file use different
+ *          temporary files, and renaming one of them into place never exposes
+ *          data written by another process.
+ */
+std::string temporaryFileName(const std::string& fileName);
+
 /** structure for file list entries */
 struct FileEntry {
     std::string fileName; /**< base name of the file */
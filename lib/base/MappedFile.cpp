@@ -0,0 +1,227 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "MappedFile.hpp"
+#include <iostream>
+#if defined(_WIN32)
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace MWTP
+{
+
+MappedFile::MappedFile()
+: m_Data(nullptr),
+  m_Size(0),
+  m_Open(false)
+  #if defined(_WIN32)
+  , m_File(INVALID_HANDLE_VALUE),
+  m_Mapping(nullptr)
+  #endif
+{
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+: m_Data(other.m_Data),
+  m_Size(other.m_Size),
+  m_Open(other.m_Open)
+  #if defined(_WIN32)
+  , m_File(other.m_File),
+  m_Mapping(other.m_Mapping)
+  #endif
+{
+  other.m_Data = nullptr;
+  other.m_Size = 0;
+  other.m_Open = false;
+  #if defined(_WIN32)
+  other.m_File = INVALID_HANDLE_VALUE;
+  other.m_Mapping = nullptr;
+  #endif
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  if (this != &other)
+  {
+    close();
+    m_Data = other.m_Data;
+    m_Size = other.m_Size;
+    m_Open = other.m_Open;
+    other.m_Data = nullptr;
+    other.m_Size = 0;
+    other.m_Open = false;
+    #if defined(_WIN32)
+    m_File = other.m_File;
+    m_Mapping = other.m_Mapping;
+    other.m_File = INVALID_HANDLE_VALUE;
+    other.m_Mapping = nullptr;
+    #endif
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+bool MappedFile::open(const std::filesystem::path& fileName)
+{
+  close();
+  #if defined(_WIN32)
+  HANDLE file = CreateFileW(fileName.wstring().c_str(), GENERIC_READ,
+                            FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    std::cerr << "MappedFile::open: Error: Could not open file "
+              << fileName.string() << "!\n";
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize))
+  {
+    std::cerr << "MappedFile::open: Error: Could not get size of file "
+              << fileName.string() << "!\n";
+    CloseHandle(file);
+    return false;
+  }
+  if (static_cast<unsigned long long>(fileSize.QuadPart) > static_cast<std::size_t>(-1))
+  {
+    std::cerr << "MappedFile::open: Error: File " << fileName.string()
+              << " is too large to be mapped into memory!\n";
+    CloseHandle(file);
+    return false;
+  }
+  m_Size = static_cast<std::size_t>(fileSize.QuadPart);
+  if (m_Size == 0)
+  {
+    // Empty files cannot be mapped, but there is nothing to map anyway.
+    CloseHandle(file);
+    m_Open = true;
+    return true;
+  }
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr)
+  {
+    std::cerr << "MappedFile::open: Error: Could not create mapping for file "
+              << fileName.string() << "!\n";
+    CloseHandle(file);
+    m_Size = 0;
+    return false;
+  }
+  const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view == nullptr)
+  {
+    std::cerr << "MappedFile::open: Error: Could not map file "
+              << fileName.string() << " into memory!\n";
+    CloseHandle(mapping);
+    CloseHandle(file);
+    m_Size = 0;
+    return false;
+  }
+  m_File = file;
+  m_Mapping = mapping;
+  m_Data = static_cast<const uint8_t*>(view);
+  #else
+  const int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    std::cerr << "MappedFile::open: Error: Could not open file "
+              << fileName.string() << "!\n";
+    return false;
+  }
+  struct stat buffer;
+  if (fstat(fd, &buffer) != 0)
+  {
+    std::cerr << "MappedFile::open: Error: Could not get size of file "
+              << fileName.string() << "!\n";
+    ::close(fd);
+    return false;
+  }
+  m_Size = static_cast<std::size_t>(buffer.st_size);
+  if (m_Size == 0)
+  {
+    // mmap() does not allow zero-length mappings.
+    ::close(fd);
+    m_Open = true;
+    return true;
+  }
+  void* view = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the file descriptor is closed.
+  ::close(fd);
+  if (view == MAP_FAILED)
+  {
+    std::cerr << "MappedFile::open: Error: Could not map file "
+              << fileName.string() << " into memory!\n";
+    m_Size = 0;
+    return false;
+  }
+  m_Data = static_cast<const uint8_t*>(view);
+  #endif
+  m_Open = true;
+  return true;
+}
+
+void MappedFile::close()
+{
+  if (m_Data != nullptr)
+  {
+    #if defined(_WIN32)
+    UnmapViewOfFile(m_Data);
+    CloseHandle(m_Mapping);
+    CloseHandle(m_File);
+    m_Mapping = nullptr;
+    m_File = INVALID_HANDLE_VALUE;
+    #else
+    munmap(const_cast<uint8_t*>(m_Data), m_Size);
+    #endif
+  }
+  m_Data = nullptr;
+  m_Size = 0;
+  m_Open = false;
+}
+
+bool MappedFile::isOpen() const
+{
+  return m_Open;
+}
+
+const uint8_t* MappedFile::data() const
+{
+  return m_Data;
+}
+
+std::size_t MappedFile::size() const
+{
+  return m_Size;
+}
+
+ByteView MappedFile::view() const
+{
+  return ByteView(m_Data, m_Size);
+}
+
+} // namespace
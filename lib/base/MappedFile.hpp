@@ -0,0 +1,80 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef MWTP_BASE_MAPPEDFILE_HPP
+#define MWTP_BASE_MAPPEDFILE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include "ByteView.hpp"
+
+namespace MWTP
+{
+
+/** Read-only memory mapping of a whole file. */
+class MappedFile
+{
+  public:
+    /// Creates an instance without any mapped file.
+    MappedFile();
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    /** \brief Maps the given file into memory.
+     *
+     * \param fileName  path of the file to map
+     * \return Returns true in case of success. Returns false otherwise.
+     * \remarks Any previously mapped file is unmapped first.
+     */
+    bool open(const std::filesystem::path& fileName);
+
+    /// Unmaps the file, if any.
+    void close();
+
+    /// Checks whether a file is currently mapped.
+    bool isOpen() const;
+
+    /// Gets a pointer to the start of the mapped file.
+    const uint8_t* data() const;
+
+    /// Gets the size of the mapped file in bytes.
+    std::size_t size() const;
+
+    /// Gets a view of the whole mapped file.
+    ByteView view() const;
+  private:
+    const uint8_t* m_Data; /**< start of the mapping */
+    std::size_t m_Size;    /**< size of the mapping in bytes */
+    bool m_Open;           /**< whether a file is mapped (may be empty) */
+    #if defined(_WIN32)
+    void* m_File;    /**< handle of the file */
+    void* m_Mapping; /**< handle of the file mapping object */
+    #endif
+}; // class
+
+} // namespace
+
+#endif // MWTP_BASE_MAPPEDFILE_HPP
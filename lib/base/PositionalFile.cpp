@@ -0,0 +1,170 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "PositionalFile.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+#if defined(_WIN32)
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace MWTP
+{
+
+PositionalFile::PositionalFile()
+  #if defined(_WIN32)
+: m_File(INVALID_HANDLE_VALUE),
+  #else
+: m_File(-1),
+  #endif
+  m_Size(0)
+{
+}
+
+PositionalFile::~PositionalFile()
+{
+  close();
+}
+
+bool PositionalFile::open(const std::filesystem::path& fileName)
+{
+  close();
+  #if defined(_WIN32)
+  HANDLE file = CreateFileW(fileName.wstring().c_str(), GENERIC_READ,
+                            FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    std::cerr << "PositionalFile::open: Error: Could not open file "
+              << fileName.string() << "!\n";
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize))
+  {
+    std::cerr << "PositionalFile::open: Error: Could not get size of file "
+              << fileName.string() << "!\n";
+    CloseHandle(file);
+    return false;
+  }
+  m_File = file;
+  m_Size = static_cast<uint64_t>(fileSize.QuadPart);
+  #else
+  const int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    std::cerr << "PositionalFile::open: Error: Could not open file "
+              << fileName.string() << "!\n";
+    return false;
+  }
+  struct stat buffer;
+  if (fstat(fd, &buffer) != 0)
+  {
+    std::cerr << "PositionalFile::open: Error: Could not get size of file "
+              << fileName.string() << "!\n";
+    ::close(fd);
+    return false;
+  }
+  m_File = fd;
+  m_Size = static_cast<uint64_t>(buffer.st_size);
+  #endif
+  return true;
+}
+
+void PositionalFile::close()
+{
+  #if defined(_WIN32)
+  if (m_File != INVALID_HANDLE_VALUE)
+  {
+    CloseHandle(m_File);
+    m_File = INVALID_HANDLE_VALUE;
+  }
+  #else
+  if (m_File != -1)
+  {
+    ::close(m_File);
+    m_File = -1;
+  }
+  #endif
+  m_Size = 0;
+}
+
+bool PositionalFile::isOpen() const
+{
+  #if defined(_WIN32)
+  return m_File != INVALID_HANDLE_VALUE;
+  #else
+  return m_File != -1;
+  #endif
+}
+
+uint64_t PositionalFile::size() const
+{
+  return m_Size;
+}
+
+bool PositionalFile::readAt(const uint64_t offset, uint8_t* buffer, const std::size_t count) const
+{
+  if (!isOpen() || ((buffer == nullptr) && (count > 0)))
+    return false;
+  if ((offset > m_Size) || (count > m_Size - offset))
+    return false;
+
+  std::size_t done = 0;
+  while (done < count)
+  {
+    const uint64_t position = offset + done;
+    #if defined(_WIN32)
+    // ReadFile() reads at most 4 GiB - 1 bytes per call.
+    const DWORD chunk = static_cast<DWORD>(std::min<std::size_t>(count - done, 0x7FFFFFFF));
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+    DWORD bytesRead = 0;
+    if (!ReadFile(m_File, buffer + done, chunk, &bytesRead, &overlapped) || (bytesRead == 0))
+    {
+      return false;
+    }
+    done += bytesRead;
+    #else
+    const ssize_t bytesRead = pread(m_File, buffer + done, count - done, static_cast<off_t>(position));
+    if (bytesRead < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    if (bytesRead == 0)
+    {
+      // unexpected end of file
+      return false;
+    }
+    done += static_cast<std::size_t>(bytesRead);
+    #endif
+  }
+  return true;
+}
+
+} // namespace
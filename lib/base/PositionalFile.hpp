@@ -0,0 +1,86 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef MWTP_BASE_POSITIONALFILE_HPP
+#define MWTP_BASE_POSITIONALFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace MWTP
+{
+
+/** Read-only file that is read at explicit offsets instead of a shared file
+ *  position.
+ *
+ * Unlike a std::ifstream, reading does not change any state of the instance,
+ * so several threads can read from the same instance at the same time.
+ */
+class PositionalFile
+{
+  public:
+    /// Creates an instance without any open file.
+    PositionalFile();
+
+    PositionalFile(const PositionalFile& other) = delete;
+    PositionalFile& operator=(const PositionalFile& other) = delete;
+
+    ~PositionalFile();
+
+    /** \brief Opens the given file for reading.
+     *
+     * \param fileName  path of the file to open
+     * \return Returns true in case of success. Returns false otherwise.
+     * \remarks Any previously opened file is closed first.
+     */
+    bool open(const std::filesystem::path& fileName);
+
+    /// Closes the file, if any.
+    void close();
+
+    /// Checks whether a file is currently open.
+    bool isOpen() const;
+
+    /// Gets the size of the file in bytes, as it was when it was opened.
+    uint64_t size() const;
+
+    /** \brief Reads data from the given offset of the file.
+     *
+     * \param offset  offset of the first byte to read
+     * \param buffer  buffer that will hold the data, at least count bytes
+     * \param count   number of bytes to read
+     * \return Returns true, if all count bytes were read.
+     *         Returns false, if an error occurred or the file ended before.
+     * \remarks This method is thread-safe.
+     */
+    bool readAt(const uint64_t offset, uint8_t* buffer, const std::size_t count) const;
+  private:
+    #if defined(_WIN32)
+    void* m_File;    /**< handle of the file */
+    #else
+    int m_File;      /**< file descriptor */
+    #endif
+    uint64_t m_Size; /**< size of the file in bytes */
+}; // class
+
+} // namespace
+
+#endif // MWTP_BASE_POSITIONALFILE_HPP
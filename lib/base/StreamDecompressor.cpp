@@ -0,0 +1,323 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "StreamDecompressor.hpp"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <zlib.h>
+#if !defined(MWTP_NO_LZ4)
+#include <lz4frame.h>
+#endif
+
+namespace MWTP
+{
+
+StreamDecompressor::StreamDecompressor()
+: m_Input(nullptr),
+  m_InputSize(0),
+  m_Finished(false),
+  m_Failed(false),
+  m_TotalOut(0)
+{
+}
+
+void StreamDecompressor::feed(const uint8_t* data, const size_t size)
+{
+  m_Input = data;
+  m_InputSize = (data != nullptr) ? size : 0;
+}
+
+std::optional<size_t> StreamDecompressor::read(uint8_t* buffer, const size_t size)
+{
+  if (m_Failed)
+    return std::nullopt;
+  if ((buffer == nullptr) || (size == 0))
+    return 0;
+
+  size_t total = 0;
+  while ((total < size) && !m_Finished)
+  {
+    const size_t inputBefore = m_InputSize;
+    size_t produced = 0;
+    if (!step(buffer + total, size - total, produced))
+    {
+      m_Failed = true;
+      return std::nullopt;
+    }
+    total += produced;
+    // No output and no consumed input means that more input is required.
+    if ((produced == 0) && (inputBefore == m_InputSize))
+      break;
+  }
+  m_TotalOut += total;
+  return total;
+}
+
+std::optional<uint64_t> StreamDecompressor::skip(const uint64_t count)
+{
+  uint8_t scratch[16384];
+  uint64_t skipped = 0;
+  while (skipped < count)
+  {
+    const size_t wanted = static_cast<size_t>(std::min<uint64_t>(count - skipped, sizeof(scratch)));
+    const auto produced = read(scratch, wanted);
+    if (!produced.has_value())
+      return std::nullopt;
+    if (produced.value() == 0)
+      break;
+    skipped += produced.value();
+  }
+  return skipped;
+}
+
+bool StreamDecompressor::needsInput() const
+{
+  return (m_InputSize == 0) && !m_Finished;
+}
+
+bool StreamDecompressor::finished() const
+{
+  return m_Finished;
+}
+
+uint64_t StreamDecompressor::totalOut() const
+{
+  return m_TotalOut;
+}
+
+void StreamDecompressor::resetState()
+{
+  m_Input = nullptr;
+  m_InputSize = 0;
+  m_Finished = false;
+  m_Failed = false;
+  m_TotalOut = 0;
+}
+
+void StreamDecompressor::copyState(const StreamDecompressor& other)
+{
+  m_Input = other.m_Input;
+  m_InputSize = other.m_InputSize;
+  m_Finished = other.m_Finished;
+  m_Failed = other.m_Failed;
+  m_TotalOut = other.m_TotalOut;
+}
+
+
+ZlibStreamDecompressor::ZlibStreamDecompressor()
+: StreamDecompressor(),
+  m_Stream(new z_stream)
+{
+  m_Stream->zalloc = Z_NULL;
+  m_Stream->zfree = Z_NULL;
+  m_Stream->opaque = Z_NULL;
+  m_Stream->avail_in = 0;
+  m_Stream->next_in = Z_NULL;
+  if (inflateInit(m_Stream) != Z_OK)
+  {
+    std::cerr << "ZlibStreamDecompressor: Error: Could not initialize z_stream!\n";
+    delete m_Stream;
+    m_Stream = nullptr;
+  }
+}
+
+ZlibStreamDecompressor::~ZlibStreamDecompressor()
+{
+  if (m_Stream != nullptr)
+  {
+    (void) inflateEnd(m_Stream);
+    delete m_Stream;
+    m_Stream = nullptr;
+  }
+}
+
+bool ZlibStreamDecompressor::reset()
+{
+  resetState();
+  return (m_Stream != nullptr) && (inflateReset(m_Stream) == Z_OK);
+}
+
+std::unique_ptr<StreamDecompressor> ZlibStreamDecompressor::clone() const
+{
+  if ((m_Stream == nullptr) || m_Failed)
+    return nullptr;
+  auto copy = std::make_unique<ZlibStreamDecompressor>();
+  if (copy->m_Stream == nullptr)
+    return nullptr;
+  // The freshly initialized state is replaced by a copy of the current one.
+  (void) inflateEnd(copy->m_Stream);
+  if (inflateCopy(copy->m_Stream, m_Stream) != Z_OK)
+  {
+    std::cerr << "ZlibStreamDecompressor: Error: Could not copy z_stream!\n";
+    delete copy->m_Stream;
+    copy->m_Stream = nullptr;
+    return nullptr;
+  }
+  copy->copyState(*this);
+  return copy;
+}
+
+bool ZlibStreamDecompressor::step(uint8_t* buffer, const size_t size, size_t& produced)
+{
+  produced = 0;
+  if (m_Stream == nullptr)
+  {
+    std::cerr << "ZlibStreamDecompressor: Error: z_stream is not initialized!\n";
+    return false;
+  }
+
+  // zlib uses 32 bit sizes, so larger chunks are handled in several steps.
+  constexpr size_t max_chunk = std::numeric_limits<uInt>::max();
+  const uInt available_in = static_cast<uInt>(std::min(m_InputSize, max_chunk));
+  const uInt available_out = static_cast<uInt>(std::min(size, max_chunk));
+  // zlib does not modify the input, it just lacks const in its API.
+  m_Stream->next_in = const_cast<uint8_t*>(m_Input);
+  m_Stream->avail_in = available_in;
+  m_Stream->next_out = buffer;
+  m_Stream->avail_out = available_out;
+
+  const int z_return = inflate(m_Stream, Z_NO_FLUSH);
+  const size_t consumed = available_in - m_Stream->avail_in;
+  m_Input += consumed;
+  m_InputSize -= consumed;
+  produced = available_out - m_Stream->avail_out;
+  switch (z_return)
+  {
+    case Z_OK:
+         return true;
+    case Z_STREAM_END:
+         m_Finished = true;
+         return true;
+    case Z_BUF_ERROR:
+         // No progress was possible, i.e. more input is needed.
+         return true;
+    default:
+         std::cerr << "ZlibStreamDecompressor: Error while calling inflate()!\n";
+         return false;
+  }
+}
+
+
+#if defined(MWTP_NO_LZ4)
+Lz4StreamDecompressor::Lz4StreamDecompressor()
+: StreamDecompressor(),
+  m_Context(nullptr)
+{
+}
+
+Lz4StreamDecompressor::~Lz4StreamDecompressor()
+{
+}
+
+bool Lz4StreamDecompressor::reset()
+{
+  resetState();
+  return false;
+}
+
+std::unique_ptr<StreamDecompressor> Lz4StreamDecompressor::clone() const
+{
+  return nullptr;
+}
+
+bool Lz4StreamDecompressor::step([[maybe_unused]] uint8_t* buffer, [[maybe_unused]] const size_t size, size_t& produced)
+{
+  // This is a build without liblz4, decompression is not available.
+  produced = 0;
+  return false;
+}
+#else
+Lz4StreamDecompressor::Lz4StreamDecompressor()
+: StreamDecompressor(),
+  m_Context(nullptr)
+{
+  const auto errorCode = LZ4F_createDecompressionContext(&m_Context, LZ4F_VERSION);
+  if (LZ4F_isError(errorCode))
+  {
+    std::cerr << "Lz4StreamDecompressor: Error: Failed to get decompression context!\n"
+              << "Error message: " << LZ4F_getErrorName(errorCode) << "\n";
+    m_Context = nullptr;
+  }
+}
+
+Lz4StreamDecompressor::~Lz4StreamDecompressor()
+{
+  if (m_Context != nullptr)
+  {
+    LZ4F_freeDecompressionContext(m_Context);
+    m_Context = nullptr;
+  }
+}
+
+bool Lz4StreamDecompressor::reset()
+{
+  resetState();
+  // Older versions of liblz4 have no function to reset a context, so it is
+  // just replaced by a new one.
+  if (m_Context != nullptr)
+  {
+    LZ4F_freeDecompressionContext(m_Context);
+    m_Context = nullptr;
+  }
+  const auto errorCode = LZ4F_createDecompressionContext(&m_Context, LZ4F_VERSION);
+  if (LZ4F_isError(errorCode))
+  {
+    m_Context = nullptr;
+    return false;
+  }
+  return true;
+}
+
+std::unique_ptr<StreamDecompressor> Lz4StreamDecompressor::clone() const
+{
+  return nullptr;
+}
+
+bool Lz4StreamDecompressor::step(uint8_t* buffer, const size_t size, size_t& produced)
+{
+  produced = 0;
+  if (m_Context == nullptr)
+  {
+    std::cerr << "Lz4StreamDecompressor: Error: Decompression context is not available!\n";
+    return false;
+  }
+
+  size_t outputSize = size;
+  size_t inputSize = m_InputSize;
+  const auto expectedBytes = LZ4F_decompress(m_Context, buffer, &outputSize,
+                                             m_Input, &inputSize, nullptr);
+  if (LZ4F_isError(expectedBytes))
+  {
+    std::cerr << "Lz4StreamDecompressor: Error: Failed to decompress more data!\n"
+              << "Error message: " << LZ4F_getErrorName(expectedBytes) << "\n";
+    return false;
+  }
+  m_Input += inputSize;
+  m_InputSize -= inputSize;
+  produced = outputSize;
+  // If the decompression context expects zero bytes, the frame is finished.
+  if (expectedBytes == 0)
+    m_Finished = true;
+  return true;
+}
+#endif
+
+} // namespace
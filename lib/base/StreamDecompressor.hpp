@@ -0,0 +1,221 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef MWTP_BASE_STREAMDECOMPRESSOR_HPP
+#define MWTP_BASE_STREAMDECOMPRESSOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+// forward declarations, so that users do not need the library headers
+struct z_stream_s;
+struct LZ4F_dctx_s;
+
+namespace MWTP
+{
+
+/** Decompresses data incrementally, so that neither the whole compressed input
+ *  nor the whole decompressed output have to be in memory at the same time.
+ *
+ * Input is handed over in chunks via feed(), output is pulled in chunks via
+ * read() or discarded via skip(). A typical loop looks like this:
+ *
+ *     while (!decomp.finished())
+ *     {
+ *       if (decomp.needsInput())
+ *         decomp.feed(nextChunk, nextChunkSize);
+ *       const auto produced = decomp.read(buffer, bufferSize);
+ *       if (!produced.has_value())
+ *         break; // error
+ *       // use produced.value() bytes of buffer
+ *     }
+ *
+ * The decompressor does not copy the input. Data passed to feed() has to stay
+ * valid until needsInput() returns true again.
+ */
+class StreamDecompressor
+{
+  public:
+    /** Constructor. */
+    StreamDecompressor();
+
+    StreamDecompressor(const StreamDecompressor& other) = delete;
+    StreamDecompressor& operator=(const StreamDecompressor& other) = delete;
+
+    /** Destructor. */
+    virtual ~StreamDecompressor() = default;
+
+    /** \brief Sets the next chunk of compressed input.
+     *
+     * \param data  pointer to the compressed data
+     * \param size  size of the compressed data in bytes
+     * \remarks Any remaining input of a previous call is dropped, so this
+     *          should only be called when needsInput() returns true.
+     */
+    void feed(const uint8_t* data, const size_t size);
+
+    /** \brief Decompresses as much data as possible into the given buffer.
+     *
+     * \param buffer  the buffer that will hold the decompressed data
+     * \param size    size of the buffer in bytes
+     * \return Returns the number of bytes that were written to the buffer.
+     *         Returns an empty optional, if an error occurred.
+     * \remarks The number of bytes may be less than size, if the current input
+     *          is used up or the end of the compressed stream is reached.
+     *          A return value of zero means that no progress can be made
+     *          without further input.
+     */
+    std::optional<size_t> read(uint8_t* buffer, const size_t size);
+
+    /** \brief Decompresses data and discards it, e.g. to seek forward to a
+     *         later position in the decompressed data.
+     *
+     * \param count  number of decompressed bytes to skip
+     * \return Returns the number of bytes that were skipped.
+     *         Returns an empty optional, if an error occurred.
+     * \remarks As with read(), fewer bytes are skipped when the current input
+     *          is used up or the end of the compressed stream is reached.
+     */
+    std::optional<uint64_t> skip(const uint64_t count);
+
+    /** \brief Checks whether the current input is used up.
+     *
+     * \return Returns true, if all input passed to feed() has been consumed
+     *         and the end of the compressed stream has not been reached yet.
+     * \remarks The decompressor may still hold some decompressed data
+     *          internally, so read() should be called until it returns zero
+     *          before concluding that the input is truncated.
+     */
+    bool needsInput() const;
+
+    /** \brief Checks whether the end of the compressed stream was reached.
+     *
+     * \return Returns true, if the whole compressed stream was decompressed
+     *         and all of its data was returned by read() or skip().
+     */
+    bool finished() const;
+
+    /** \brief Gets the number of bytes that were decompressed so far.
+     *
+     * \return Returns the total number of bytes returned by read() and skip()
+     *         since construction or the last call to reset().
+     */
+    uint64_t totalOut() const;
+
+    /** \brief Resets the decompressor, so that a new compressed stream can be
+     *         decompressed.
+     *
+     * \return Returns true in case of success. Returns false otherwise.
+     */
+    virtual bool reset() = 0;
+
+    /** \brief Creates an independent copy of the current decompression state.
+     *
+     * \return Returns a decompressor that continues at the same position as
+     *         this one. Returns nullptr, if the state cannot be copied.
+     * \remarks The copy uses the same input as this instance, so that input
+     *          has to stay valid for the copy, too. A copy can be used as a
+     *          checkpoint to return to a position in the decompressed data
+     *          without decompressing everything before it again.
+     */
+    virtual std::unique_ptr<StreamDecompressor> clone() const = 0;
+  protected:
+    /** \brief Performs a single decompression step.
+     *
+     * \param buffer    the buffer that will hold the decompressed data
+     * \param size      size of the buffer in bytes, never zero
+     * \param produced  will be set to the number of bytes written to buffer
+     * \return Returns true in case of success. Returns false otherwise.
+     * \remarks Implementations consume input from m_Input and m_InputSize,
+     *          and set m_Finished when the end of the stream is reached.
+     */
+    virtual bool step(uint8_t* buffer, const size_t size, size_t& produced) = 0;
+
+    /** Clears the state kept by the base class. */
+    void resetState();
+
+    /** \brief Copies the state kept by the base class from another instance.
+     *
+     * \param other  the instance to copy the state from
+     */
+    void copyState(const StreamDecompressor& other);
+
+    const uint8_t* m_Input; /**< remaining compressed input */
+    size_t m_InputSize;     /**< size of remaining input in bytes */
+    bool m_Finished;        /**< whether the end of the stream was reached */
+    bool m_Failed;          /**< whether an error occurred */
+  private:
+    uint64_t m_TotalOut;    /**< number of decompressed bytes so far */
+}; // class
+
+/** Streaming decompression of zlib-compressed data, as used by compressed
+ *  records in ESM files and by compressed files in BSA archives up to version
+ *  104.
+ */
+class ZlibStreamDecompressor: public StreamDecompressor
+{
+  public:
+    /** Constructor. */
+    ZlibStreamDecompressor();
+
+    /** Destructor. */
+    virtual ~ZlibStreamDecompressor();
+
+    virtual bool reset() override;
+
+    virtual std::unique_ptr<StreamDecompressor> clone() const override;
+  protected:
+    virtual bool step(uint8_t* buffer, const size_t size, size_t& produced) override;
+  private:
+    z_stream_s* m_Stream; /**< zlib's stream state, nullptr on failure */
+}; // class
+
+/** Streaming decompression of data in the LZ4 frame format, as used by
+ *  compressed files in BSA archives of version 105.
+ *
+ * Builds without liblz4 (i.e. with MWTP_NO_LZ4) provide the class, too, but
+ * every call to read() or skip() fails.
+ */
+class Lz4StreamDecompressor: public StreamDecompressor
+{
+  public:
+    /** Constructor. */
+    Lz4StreamDecompressor();
+
+    /** Destructor. */
+    virtual ~Lz4StreamDecompressor();
+
+    virtual bool reset() override;
+
+    /** \brief Returns nullptr, because the LZ4 frame API has no way to copy
+     *         a decompression context.
+     */
+    virtual std::unique_ptr<StreamDecompressor> clone() const override;
+  protected:
+    virtual bool step(uint8_t* buffer, const size_t size, size_t& produced) override;
+  private:
+    LZ4F_dctx_s* m_Context; /**< decompression context, nullptr on failure */
+}; // class
+
+} // namespace
+
+#endif // MWTP_BASE_STREAMDECOMPRESSOR_HPP
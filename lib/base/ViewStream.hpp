@@ -0,0 +1,125 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef MWTP_BASE_VIEWSTREAM_HPP
+#define MWTP_BASE_VIEWSTREAM_HPP
+
+#include <cstring>
+#include <istream>
+#include <streambuf>
+#include "ByteView.hpp"
+
+namespace MWTP
+{
+
+/** Read-only stream buffer that reads directly from a ByteView.
+ *
+ * Unlike a file buffer, no data is copied into an intermediate buffer, and
+ * seeking or querying the position is just pointer arithmetic. Reads and
+ * seeks beyond the end of the view fail. The viewed memory must outlive the
+ * buffer.
+ */
+class ViewStreamBuffer: public std::streambuf
+{
+  public:
+    /** \brief Creates a buffer for the given view.
+     *
+     * \param view  the memory to read from
+     */
+    explicit ViewStreamBuffer(const ByteView view)
+    {
+      char* start = const_cast<char*>(reinterpret_cast<const char*>(view.data()));
+      setg(start, start, start + view.size());
+    }
+
+  protected:
+    int_type underflow() override
+    {
+      return gptr() < egptr() ? traits_type::to_int_type(*gptr()) : traits_type::eof();
+    }
+
+    std::streamsize showmanyc() override
+    {
+      return gptr() < egptr() ? egptr() - gptr() : -1;
+    }
+
+    std::streamsize xsgetn(char* s, std::streamsize count) override
+    {
+      const std::streamsize available = egptr() - gptr();
+      if (count > available)
+        count = available;
+      if (count > 0)
+      {
+        std::memcpy(s, gptr(), static_cast<std::size_t>(count));
+        setg(eback(), gptr() + count, egptr());
+      }
+      return count;
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+      if ((which & std::ios_base::in) == 0)
+        return pos_type(off_type(-1));
+      off_type base = 0;
+      if (dir == std::ios_base::cur)
+        base = gptr() - eback();
+      else if (dir == std::ios_base::end)
+        base = egptr() - eback();
+      const off_type target = base + off;
+      if ((target < 0) || (target > egptr() - eback()))
+        return pos_type(off_type(-1));
+      setg(eback(), eback() + target, egptr());
+      return pos_type(target);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+    {
+      return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+}; // class
+
+/** Input stream that reads directly from memory, e.g. a memory-mapped file.
+ *
+ * This allows all the existing loadFromStream() methods to read from mapped
+ * memory without any changes. The viewed memory must outlive the stream.
+ */
+class ViewStream: public std::istream
+{
+  public:
+    /** \brief Creates a stream for the given view.
+     *
+     * \param view  the memory to read from
+     */
+    explicit ViewStream(const ByteView view)
+    : std::istream(nullptr),
+      m_Buffer(view)
+    {
+      rdbuf(&m_Buffer);
+    }
+
+    ViewStream(const ViewStream& other) = delete;
+    ViewStream& operator=(const ViewStream& other) = delete;
+  private:
+    ViewStreamBuffer m_Buffer; /**< the stream buffer */
+}; // class
+
+} // namespace
+
+#endif // MWTP_BASE_VIEWSTREAM_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2021, 2022, 2024  Dirk Stolle
+    Copyright (C) 2021, 2022, 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -29,7 +29,7 @@ namespace MWTP
 {
 
 #if defined(MWTP_NO_LZ4)
-bool lz4Decompress([[maybe_unused]] uint8_t * compressedData,
+bool lz4Decompress([[maybe_unused]] const uint8_t * compressedData,
                    [[maybe_unused]] const uint32_t compressedSize,
                    [[maybe_unused]] uint8_t * decompBuffer,
                    [[maybe_unused]] const uint32_t decompSize)
@@ -48,7 +48,7 @@ bool lz4Compress([[maybe_unused]] uint8_t * rawData,
   return false;
 }
 #else
-bool lz4Decompress(uint8_t * compressedData, const uint32_t compressedSize, uint8_t * decompBuffer, const uint32_t decompSize)
+bool lz4Decompress(const uint8_t * compressedData, const uint32_t compressedSize, uint8_t * decompBuffer, const uint32_t decompSize)
 {
   if ((compressedData == nullptr) || (compressedSize == 0)
      || (decompBuffer == nullptr) || (decompSize == 0))
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2010, 2011, 2012, 2021, 2024  Dirk Stolle
+    Copyright (C) 2010, 2011, 2012, 2021, 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,9 +19,12 @@
 */
 
 #include "ESMReader.hpp"
+#include <cstring>
 #include <iostream>
 #include "MW_Constants.hpp"
 #include "HelperIO.hpp"
+#include "../base/MappedFile.hpp"
+#include "../base/ViewStream.hpp"
 
 namespace MWTP
 {
@@ -44,19 +47,15 @@ int ESMReader::skipRecord(std::istream& input)
 
 int ESMReader::readESM(const std::string& FileName, TES3Record& theHead)
 {
-  std::ifstream input;
-  input.open(FileName, std::ios::in | std::ios::binary);
-  if (!input)
+  // The whole file is mapped into memory, so reads and position queries do
+  // not need any system calls or copies into an intermediate file buffer.
+  MappedFile file;
+  if (!file.open(FileName))
   {
     std::cerr << "Error: Could not open file \"" << FileName << "\".\n";
     return -1;
   }
-
-  // set file pointer to end
-  input.seekg(0, std::ios::end);
-  const auto FileSize = input.tellg();
-  // reset file pointer to start of file
-  input.seekg(0, std::ios::beg);
+  ViewStream input(file.view());
 
   // read the header
   // TES3
@@ -65,7 +64,6 @@ int ESMReader::readESM(const std::string& FileName, TES3Record& theHead)
   if (Buffer != cTES3)
   {
     std::cerr << "Error: File \"" << FileName << "\" is not a valid .esp/.esm file.\n";
-    input.close();
     return -1;
   }
 
@@ -74,54 +72,59 @@ int ESMReader::readESM(const std::string& FileName, TES3Record& theHead)
   {
     std::cerr << "Error while reading TES3 header from \"" << FileName
               << "\".\n";
-    input.close();
     return -1;
   }
 
   if (!input.good())
   {
     std::cerr << "Error while reading header of file \"" << FileName << "\".\n";
-    input.close();
+    return -1;
+  }
+
+  // Scan the record headers once, so that records of irrelevant types can be
+  // left out without looking at their data.
+  std::vector<RecordIndexEntry> index;
+  if (!buildRecordIndex(file.view(), static_cast<std::size_t>(input.tellg()), index))
+  {
+    const std::size_t lastGoodPosition = index.empty() ? static_cast<std::size_t>(input.tellg())
+        : index.back().offset + 16 + index.back().size;
+    std::cerr << "Error: readESM of file \"" << FileName << "\" failed. Last "
+              << "known good position was " << lastGoodPosition << ".\n";
     return -1;
   }
 
   // Now we will read the real data records that follow after the header.
   int relevantRecords = 0;
-  int lastResult = 0;
-  auto lastGoodPosition = input.tellg();
-  // now read all the records
-  while ((input.tellg() < FileSize) && (lastResult != -1))
+  for (const RecordIndexEntry& entry: index)
   {
-    lastResult = processNextRecord(input);
-    if (lastResult != -1)
+    if (!isRelevantRecord(entry.recordName))
+      continue;
+    input.seekg(static_cast<std::streamoff>(entry.offset));
+    const int lastResult = processNextRecord(input);
+    if ((lastResult == -1) || !input.good())
     {
-      relevantRecords += lastResult;
-      lastGoodPosition = input.tellg();
+      std::cerr << "Error: readESM of file \"" << FileName << "\" failed. "
+                << "Could not read " << IntTo4Char(entry.recordName)
+                << " record at position " << entry.offset << ".\n";
+      return -1;
     }
+    relevantRecords += lastResult;
   }
 
-  const bool good_result = input.good() && (lastResult != -1);
-  input.close();
-  if (!good_result)
-  {
-    std::cerr << "Error: readESM of file \"" << FileName << "\" failed. Last "
-              << "known good position was " << lastGoodPosition << ".\n";
-    return -1;
-  }
   // save data and return
   return relevantRecords;
 }
 
 bool ESMReader::peekESMHeader(const std::string& FileName, TES3Record& theHead)
 {
-  std::ifstream input;
-  input.open(FileName.c_str(), std::ios::in | std::ios::binary);
-  if (!input)
+  MappedFile file;
+  if (!file.open(FileName))
   {
     std::cerr << "ESMReader::peekESMHeader: Error: Could not open file \""
               << FileName << "\".\n";
     return false;
   }
+  ViewStream input(file.view());
 
   // read the header
   // TES3
@@ -131,7 +134,6 @@ bool ESMReader::peekESMHeader(const std::string& FileName, TES3Record& theHead)
   {
     std::cerr << "ESMReader::peekESMHeader: Error: File \"" << FileName
               << "\" is not a valid .esp/.esm file.\n";
-    input.close();
     return false;
   }
 
@@ -140,21 +142,56 @@ bool ESMReader::peekESMHeader(const std::string& FileName, TES3Record& theHead)
   {
     std::cerr << "ESMReader::peekESMHeader: Error while reading TES3 header from \""
               << FileName << "\".\n";
-    input.close();
     return false;
   }
 
-  input.close();
   return input.good();
 }
 
-int ESMReader::processNextRecord(std::istream& input)
+bool ESMReader::buildRecordIndex(const ByteView data, std::size_t offset, std::vector<RecordIndexEntry>& index)
 {
-  // Normally should be 4 chars, but char array is not eligible for switch.
-  uint32_t RecordName = 0;
-  // read record name
-  input.read(reinterpret_cast<char*>(&RecordName), 4);
-  switch(RecordName)
+  index.clear();
+  while (offset < data.size())
+  {
+    // record header: name, size, header one, flags
+    if (data.size() - offset < 16)
+      return false;
+    RecordIndexEntry entry;
+    std::memcpy(&entry.recordName, data.data() + offset, 4);
+    std::memcpy(&entry.size, data.data() + offset + 4, 4);
+    entry.offset = offset;
+    entry.idOffset = offset;
+    entry.idSize = 0;
+    if (data.size() - offset - 16 < entry.size)
+      return false;
+
+    // subrecord header: name, size
+    const ByteView recordData = data.subView(offset + 16, entry.size);
+    if (recordData.size() >= 8)
+    {
+      uint32_t subName = 0;
+      uint32_t subSize = 0;
+      std::memcpy(&subName, recordData.data(), 4);
+      std::memcpy(&subSize, recordData.data() + 4, 4);
+      if ((subName == cNAME) || (subName == cINAM))
+      {
+        const ByteView id = recordData.subView(8, subSize);
+        // ID is NUL-terminated in most cases, but not always.
+        const void* end = std::memchr(id.data(), '\0', id.size());
+        entry.idOffset = offset + 24;
+        entry.idSize = static_cast<uint32_t>(end != nullptr ? static_cast<const uint8_t*>(end) - id.data() : id.size());
+      }
+    }
+
+    offset += 16 + static_cast<std::size_t>(entry.size);
+    index.push_back(entry);
+  }
+  return true;
+}
+
+bool ESMReader::isKnownRecordType(const uint32_t recordName)
+{
+  switch(recordName)
   {
     case cACTI:
     case cALCH:
@@ -198,13 +235,31 @@ int ESMReader::processNextRecord(std::istream& input)
     case cSSCR:
     case cSTAT:
     case cWEAP:
-         return ESMReader::skipRecord(input);
+         return true;
     default:
-         std::cerr << "ESMReader::processNextRecord: ERROR: Unknown record type found: \""
-                   << IntTo4Char(RecordName) << "\".\n"
-                   << "Current file position: " << input.tellg() << " bytes.\n";
-         return -1;
+         return false;
+  }
+}
+
+bool ESMReader::isRelevantRecord([[maybe_unused]] const uint32_t recordName) const
+{
+  return true;
+}
+
+int ESMReader::processNextRecord(std::istream& input)
+{
+  // Normally should be 4 chars, but char array is not eligible for switch.
+  uint32_t RecordName = 0;
+  // read record name
+  input.read(reinterpret_cast<char*>(&RecordName), 4);
+  if (isKnownRecordType(RecordName))
+  {
+    return ESMReader::skipRecord(input);
   }
+  std::cerr << "ESMReader::processNextRecord: ERROR: Unknown record type found: \""
+            << IntTo4Char(RecordName) << "\".\n"
+            << "Current file position: " << input.tellg() << " bytes.\n";
+  return -1;
 }
 
 } // namespace
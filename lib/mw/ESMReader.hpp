@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Morrowind Tools Project.
-    Copyright (C) 2010, 2011, 2012, 2021  Dirk Stolle
+    Copyright (C) 2010, 2011, 2012, 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -22,13 +22,36 @@
 #define MW_ESMREADER_HPP
 
 #include <string>
+#include <string_view>
 #include <fstream>
+#include <vector>
+#include "../base/ByteView.hpp"
 #include "DepFiles.hpp"
 #include "records/TES3Record.hpp"
 
 namespace MWTP
 {
 
+/** Position and ID of a record in an .esm/.esp file. */
+struct RecordIndexEntry
+{
+  uint32_t recordName;  /**< type of the record, e.g. cSTAT */
+  std::size_t offset;   /**< offset of the record name from the start of the file */
+  uint32_t size;        /**< size of the record data, excluding the header */
+  std::size_t idOffset; /**< offset of the ID from the start of the file */
+  uint32_t idSize;      /**< length of the ID without NUL, zero if there is no ID */
+
+  /** \brief Gets the ID of the record.
+   *
+   * \param data  the file data that the index was built from
+   * \return Returns the ID. The view is only valid as long as the data is.
+   */
+  std::string_view ID(const ByteView data) const
+  {
+    return std::string_view(reinterpret_cast<const char*>(data.data()) + idOffset, idSize);
+  }
+};
+
 /** ESMReader class
  *
  * This is the basic class for reading master (.esm) and plugin (.esp) files of
@@ -38,6 +61,11 @@ namespace MWTP
  * To change that behaviour and actually read some data, you have to derive a
  * new class from ESMReader and re-implement the processNextRecord() function,
  * which has to take care that the required data is read and not skipped.
+ *
+ * readESM() first builds an index of all records in the file and then only
+ * calls processNextRecord() for records whose type is relevant according to
+ * isRelevantRecord(). Derived classes that only need a few record types should
+ * override that function, so that other records are not touched at all.
  */
 class ESMReader
 {
@@ -72,6 +100,40 @@ class ESMReader
      */
     static bool peekESMHeader(const std::string& FileName, TES3Record& theHead);
 
+    /** \brief Builds an index of the records in the data of an .esm/.esp file.
+     *
+     * \param data    the file data
+     * \param offset  offset of the first record after the TES3 header
+     * \param index   vector that will receive the index entries in file order
+     * \return Returns true in case of success, false on failure.
+     * \remarks The ID of a record is taken from its first subrecord, if that
+     *          is a NAME or an INAM subrecord. Otherwise the ID is empty.
+     *          The scan only checks the sizes of the records and fails on
+     *          incomplete records. In case of failure, the index contains all
+     *          records before the first incomplete record. Record types are
+     *          not checked here, that is up to processNextRecord().
+     */
+    static bool buildRecordIndex(const ByteView data, std::size_t offset, std::vector<RecordIndexEntry>& index);
+
+    /** \brief Checks whether a record type exists in Morrowind's files.
+     *
+     * \param recordName  type of the record, e.g. cSTAT
+     * \return Returns true, if the type is known. Returns false otherwise.
+     */
+    static bool isKnownRecordType(const uint32_t recordName);
+
+    /** \brief Checks whether records of a type shall be read by readESM().
+     *
+     * \param recordName  type of the record, e.g. cSTAT
+     * \return Returns true, if processNextRecord() shall be called for records
+     *         of that type. Returns false, if those records shall be skipped.
+     * \remarks The implementation in ESMReader returns true for all types.
+     *          Records of unknown types are only rejected, if this function
+     *          returns true for them, because the check for unknown types
+     *          happens in processNextRecord().
+     */
+    virtual bool isRelevantRecord(const uint32_t recordName) const;
+
     /** \brief Tries to read the next record from a stream.
      *
      * \param input  the input stream the record shall be read from
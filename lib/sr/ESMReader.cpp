@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2012, 2013, 2021, 2022, 2024  Dirk Stolle
+    Copyright (C) 2011, 2012, 2013, 2021, 2022, 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,19 +19,37 @@
 */
 
 #include "ESMReader.hpp"
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <thread>
 #include "SR_Constants.hpp"
-#include "TableUtilities.hpp"
+#include "StringTableCache.hpp"
 #include "../mw/HelperIO.hpp"
+#include "../base/MappedFile.hpp"
+#include "../base/ViewStream.hpp"
 
 namespace SRTP
 {
 
 ESMReader::ESMReader()
-: currentHead(Tes4HeaderRecord())
+: currentHead(Tes4HeaderRecord()),
+  m_ThreadCount(1),
+  m_Staging(false),
+  m_Changes(std::vector<std::function<void()> >())
 {
 }
 
+void ESMReader::setThreadCount(const unsigned int threads)
+{
+  m_ThreadCount = std::max(1u, threads);
+}
+
+unsigned int ESMReader::threadCount() const
+{
+  return m_ThreadCount;
+}
+
 int ESMReader::skipRecord(std::istream& input)
 {
   uint32_t Size = 0;
@@ -62,47 +80,27 @@ int ESMReader::skipGroup(std::istream& input, const GroupData& g_data)
 
 int ESMReader::readESM(const std::string& FileName, Tes4HeaderRecord& head, const std::optional<Localization>& l10n)
 {
-  std::ifstream input;
-  input.open(FileName, std::ios::in | std::ios::binary);
-  if (!input)
+  // The whole file is mapped into memory, so reads and position queries do
+  // not need any system calls or copies into an intermediate file buffer.
+  MWTP::MappedFile file;
+  if (!file.open(FileName))
   {
     std::cerr << "Error: Could not open file \"" << FileName << "\".\n";
     return -1;
   }
+  MWTP::ViewStream input(file.view());
+  const std::streampos FileSize = static_cast<std::streamoff>(file.size());
 
-  // set file pointer to end
-  input.seekg(0, std::ios::end);
-  const auto FileSize = input.tellg();
-  // reset file pointer to start of file
-  input.seekg(0, std::ios::beg);
-
-  // read the header name
-  // -> TES4
-  uint32_t recordName = 0;
-  input.read(reinterpret_cast<char*>(&recordName), 4);
-  if (recordName != cTES4)
-  {
-    std::cerr << "Error: File \"" << FileName << "\" is not a valid .esp/.esm file."
-              << " Expected TES4, but \"" << IntTo4Char(recordName)
-              << "\" was found instead.\n";
-    input.close();
+  if (!readHeader(input, FileName, head))
     return -1;
-  }
-  // now read the actual header
-  if (!head.loadFromStream(input, true, StringTable()))
-  {
-    std::cerr << "Error: Could not read header from \"" << FileName << "\".\n";
-    input.close();
-    return -1;
-  }
 
   const bool localized = head.isLocalized();
-  StringTable table;
-  if (localized)
+  std::shared_ptr<const StringTable> table = std::make_shared<const StringTable>();
+  if (localized && needStringTables())
   {
-    if (!loadStringTables(FileName, table, l10n))
+    table = StringTableCache::get().load(FileName, l10n);
+    if (table == nullptr)
     {
-      input.close();
       std::cerr << "Error while reading string tables for " << FileName << "!\n";
       return -1;
     }
@@ -111,6 +109,16 @@ int ESMReader::readESM(const std::string& FileName, Tes4HeaderRecord& head, cons
   // save header for subsequent functions that might need it
   currentHead = head;
 
+  if ((m_ThreadCount > 1) && (createGroupReader() != nullptr))
+  {
+    const int groups = readGroupsConcurrently(file.view(), static_cast<std::size_t>(input.tellg()), localized, *table);
+    if (groups < 0)
+    {
+      std::cerr << "Error: readESM of file \"" << FileName << "\" failed.\n";
+    }
+    return groups;
+  }
+
   // read the groups/ records
   uint32_t processedGroups = 0;
   int lastResult = 0;
@@ -118,7 +126,7 @@ int ESMReader::readESM(const std::string& FileName, Tes4HeaderRecord& head, cons
   while ((input.tellg() < FileSize) && (lastResult >= 0))
   {
     // try to read or skip a group - possibly that won't always work
-    lastResult = processGroup(input, true, localized, table);
+    lastResult = processGroup(input, true, localized, *table);
     if (lastResult >= 0)
     {
       processedGroups += lastResult;
@@ -127,7 +135,6 @@ int ESMReader::readESM(const std::string& FileName, Tes4HeaderRecord& head, cons
   }
   // finished here
   const bool good_result = (input.good() && (lastResult >= 0));
-  input.close();
   if (!good_result)
   {
     std::cerr << "Error: readESM of file \"" << FileName << "\" failed. Last known "
@@ -138,16 +145,253 @@ int ESMReader::readESM(const std::string& FileName, Tes4HeaderRecord& head, cons
   return processedGroups;
 }
 
+bool ESMReader::readHeader(std::istream& input, const std::string& FileName, Tes4HeaderRecord& head)
+{
+  // read the header name
+  // -> TES4
+  uint32_t recordName = 0;
+  input.read(reinterpret_cast<char*>(&recordName), 4);
+  if (recordName != cTES4)
+  {
+    std::cerr << "Error: File \"" << FileName << "\" is not a valid .esp/.esm file."
+              << " Expected TES4, but \"" << IntTo4Char(recordName)
+              << "\" was found instead.\n";
+    return false;
+  }
+  // now read the actual header
+  if (!head.loadFromStream(input, true, StringTable()))
+  {
+    std::cerr << "Error: Could not read header from \"" << FileName << "\".\n";
+    return false;
+  }
+  return true;
+}
+
+int ESMReader::readGroupsConcurrently(const MWTP::ByteView data, const std::size_t start, const bool localized, const StringTable& table)
+{
+  std::vector<GroupJob> jobs;
+  if (!scanGroups(data, start, localized, table, jobs))
+    return -1;
+  std::vector<GroupJob*> pending;
+  for (GroupJob& job: jobs)
+  {
+    pending.push_back(&job);
+  }
+  if (!readGroupJobs(pending, m_ThreadCount))
+    return -1;
+  return mergeGroupJobs(jobs);
+}
+
+bool ESMReader::readESMsConcurrently(const std::vector<std::pair<ESMReader*, std::string> >& files, const std::optional<Localization>& l10n, const unsigned int threads)
+{
+  /// state of a file while it is read
+  struct FileState
+  {
+    MWTP::MappedFile file;                    /**< content of the file */
+    std::shared_ptr<const StringTable> table; /**< string tables of the file */
+    std::vector<GroupJob> jobs;               /**< top-level groups of the file */
+  };
+  std::vector<FileState> states(files.size());
+
+  // Headers and string tables of all files are loaded first, ...
+  const bool prepared = runTasks(files.size(), threads, [&](const std::size_t idx)
+  {
+    ESMReader& reader = *files[idx].first;
+    const std::string& fileName = files[idx].second;
+    FileState& state = states[idx];
+    if (!state.file.open(fileName))
+    {
+      std::cerr << "Error: Could not open file \"" << fileName << "\".\n";
+      return false;
+    }
+    MWTP::ViewStream input(state.file.view());
+    if (!readHeader(input, fileName, reader.currentHead))
+      return false;
+    const bool localized = reader.currentHead.isLocalized();
+    state.table = (localized && reader.needStringTables())
+        ? StringTableCache::get().load(fileName, l10n)
+        : std::make_shared<const StringTable>();
+    if (state.table == nullptr)
+    {
+      std::cerr << "Error while reading string tables for " << fileName << "!\n";
+      return false;
+    }
+    if (!reader.scanGroups(state.file.view(), static_cast<std::size_t>(input.tellg()), localized, *state.table, state.jobs))
+    {
+      std::cerr << "Error: Could not read groups of file \"" << fileName << "\".\n";
+      return false;
+    }
+    return true;
+  });
+  if (!prepared)
+    return false;
+
+  // ... then the groups of all files are read together, ...
+  std::vector<GroupJob*> pending;
+  for (FileState& state: states)
+  {
+    for (GroupJob& job: state.jobs)
+    {
+      pending.push_back(&job);
+    }
+  }
+  if (!readGroupJobs(pending, threads))
+    return false;
+
+  // ... and finally the results are merged in file order.
+  for (std::size_t i = 0; i < files.size(); ++i)
+  {
+    if (files[i].first->mergeGroupJobs(states[i].jobs) < 0)
+    {
+      std::cerr << "Error: Could not merge data of file \"" << files[i].second << "\".\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ESMReader::scanGroups(const MWTP::ByteView data, const std::size_t start, const bool localized, const StringTable& table, std::vector<GroupJob>& jobs) const
+{
+  // Every group header contains the size of the whole group, so the groups
+  // can be located without reading their content.
+  MWTP::ViewStream input(data);
+  input.seekg(start, std::ios::beg);
+  std::size_t offset = start;
+  while (offset < data.size())
+  {
+    uint32_t recordName = 0;
+    input.read(reinterpret_cast<char*>(&recordName), 4);
+    if (!input.good())
+    {
+      std::cerr << "ESMReader::scanGroups: Error: Could not read group header "
+                << "at position " << offset << "!\n";
+      return false;
+    }
+    if (recordName != cGRUP)
+    {
+      UnexpectedRecord(cGRUP, recordName);
+      return false;
+    }
+    GroupData gd;
+    if (!gd.loadFromStream(input))
+    {
+      std::cerr << "ESMReader::scanGroups: Error: Could not read group data at "
+                << "position " << offset << "!\n";
+      return false;
+    }
+    if ((gd.size() < 24) || (gd.size() > data.size() - offset))
+    {
+      std::cerr << "ESMReader::scanGroups: Error: Group at position " << offset
+                << " has an invalid size of " << gd.size() << " bytes!\n";
+      return false;
+    }
+    if (needGroup(gd))
+    {
+      std::unique_ptr<ESMReader> reader = createGroupReader();
+      reader->currentHead = currentHead;
+      reader->m_ThreadCount = 1;
+      reader->m_Staging = true;
+      reader->m_Changes.clear();
+      jobs.push_back(GroupJob{ data.subView(offset, gd.size()), offset, localized, &table, std::move(reader), -1 });
+    }
+    offset += gd.size();
+    input.seekg(offset, std::ios::beg);
+  }
+  return true;
+}
+
+bool ESMReader::readGroupJobs(std::vector<GroupJob*>& jobs, const unsigned int threads)
+{
+  // Start with the largest groups, so that no thread gets one of them late
+  // and keeps running long after all others are done.
+  std::stable_sort(jobs.begin(), jobs.end(), [](const GroupJob* a, const GroupJob* b)
+  {
+    return a->data.size() > b->data.size();
+  });
+  return runTasks(jobs.size(), threads, [&jobs](const std::size_t idx)
+  {
+    GroupJob& job = *jobs[idx];
+    MWTP::ViewStream input(job.data);
+    try
+    {
+      job.result = job.reader->processGroup(input, true, job.localized, *job.table);
+    }
+    catch (const std::exception& ex)
+    {
+      std::cerr << "ESMReader::readGroupJobs: Error: " << ex.what() << "\n";
+      job.result = -1;
+    }
+    if (job.result < 0)
+    {
+      std::cerr << "ESMReader::readGroupJobs: Error while reading group at "
+                << "position " << job.offset << "!\n";
+      return false;
+    }
+    return true;
+  });
+}
+
+int ESMReader::mergeGroupJobs(std::vector<GroupJob>& jobs)
+{
+  // Merge results in file order, so the outcome is the same as for a
+  // sequential read.
+  int processedGroups = 0;
+  for (GroupJob& job: jobs)
+  {
+    if (!mergeGroupReader(*job.reader))
+    {
+      std::cerr << "ESMReader::mergeGroupJobs: Error: Could not merge results "
+                << "of group at position " << job.offset << "!\n";
+      return -1;
+    }
+    job.reader.reset();
+    processedGroups += job.result;
+  }
+  return processedGroups;
+}
+
+bool ESMReader::runTasks(const std::size_t taskCount, const unsigned int threads, const std::function<bool(const std::size_t)>& task)
+{
+  std::atomic<std::size_t> next_task = 0;
+  std::atomic<bool> failed = false;
+  const auto worker = [&]()
+  {
+    while (!failed)
+    {
+      const std::size_t idx = next_task++;
+      if (idx >= taskCount)
+        return;
+      if (!task(idx))
+        failed = true;
+    }
+  };
+
+  const std::size_t count = std::max<std::size_t>(1, std::min<std::size_t>(threads, taskCount));
+  std::vector<std::thread> workers;
+  workers.reserve(count - 1);
+  for (std::size_t i = 1; i < count; ++i)
+  {
+    workers.emplace_back(worker);
+  }
+  // The current thread does some of the work, too.
+  worker();
+  for (auto& thread: workers)
+  {
+    thread.join();
+  }
+  return !failed;
+}
+
 bool ESMReader::peekESMHeader(const std::string& FileName, Tes4HeaderRecord& head)
 {
-  std::ifstream input;
-  input.open(FileName, std::ios::in | std::ios::binary);
-  if (!input)
+  MWTP::MappedFile file;
+  if (!file.open(FileName))
   {
     std::cerr << "ESMReader::peekESMHeader: Error: Could not open file \""
               << FileName << "\".\n";
     return false;
   }
+  MWTP::ViewStream input(file.view());
 
   // read the header name
   // TES4
@@ -158,7 +402,6 @@ bool ESMReader::peekESMHeader(const std::string& FileName, Tes4HeaderRecord& hea
     std::cerr << "ESMReader::peekESMHeader: Error: File \"" << FileName
               << "\" is not a valid .esp/.esm file. Expected TES4, but \""
               << IntTo4Char(recordName) << "\" was found instead.\n";
-    input.close();
     return false;
   }
   // now read the actual header
@@ -166,11 +409,9 @@ bool ESMReader::peekESMHeader(const std::string& FileName, Tes4HeaderRecord& hea
   {
     std::cerr << "ESMReader::peekESMHeader: Error: Could not read header from \""
               << FileName << "\".\n";
-    input.close();
     return false;
   }
 
-  input.close();
   return true;
 }
 
@@ -221,6 +462,57 @@ int ESMReader::processGroup(std::istream& input, const bool withHeader, const bo
   return skipGroup(input, gd);
 }
 
+std::unique_ptr<ESMReader> ESMReader::createGroupReader() const
+{
+  return nullptr;
+}
+
+bool ESMReader::needStringTables() const
+{
+  return true;
+}
+
+std::unique_ptr<ESMReader> ESMReader::createStagingReader() const
+{
+  std::unique_ptr<ESMReader> reader = createGroupReader();
+  if (reader != nullptr)
+  {
+    reader->m_ThreadCount = 1;
+    reader->m_Staging = true;
+    reader->m_Changes.clear();
+  }
+  return reader;
+}
+
+bool ESMReader::mergeStagingReader(ESMReader& stagingReader)
+{
+  return mergeGroupReader(stagingReader);
+}
+
+bool ESMReader::mergeGroupReader(ESMReader& groupReader)
+{
+  // A staging reader passes the changes on instead of performing them.
+  for (auto& change: groupReader.m_Changes)
+  {
+    applyChange(std::move(change));
+  }
+  groupReader.m_Changes.clear();
+  return true;
+}
+
+void ESMReader::applyChange(std::function<void()> change)
+{
+  if (m_Staging)
+    m_Changes.push_back(std::move(change));
+  else
+    change();
+}
+
+bool ESMReader::isStaging() const
+{
+  return m_Staging;
+}
+
 int ESMReader::readGroup(std::istream& input, const GroupData& g_data, const bool localized, const StringTable& table)
 {
   // actually read the group
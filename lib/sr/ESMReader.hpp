@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2012, 2013, 2021, 2022  Dirk Stolle
+    Copyright (C) 2011, 2012, 2013, 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -22,10 +22,15 @@
 #define SR_ESMREADER_HPP
 
 #include <fstream>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 #include "Localization.hpp"
 #include "StringTable.hpp"
 #include "records/TES4HeaderRecord.hpp"
 #include "records/GroupData.hpp"
+#include "../base/ByteView.hpp"
 
 namespace SRTP
 {
@@ -75,6 +80,60 @@ class ESMReader
      */
     static bool peekESMHeader(const std::string& FileName, Tes4HeaderRecord& theHead);
 
+    /** \brief Sets the number of threads that readESM() uses to read the
+     *         top-level groups of a file.
+     *
+     * \param threads  the number of threads; values below two mean that the
+     *                 file is read sequentially on the calling thread
+     * \remarks More than one thread is only used, if the reader implementation
+     *          supports it, i.e. if createGroupReader() returns a reader.
+     */
+    void setThreadCount(const unsigned int threads);
+
+    /** \brief Gets the number of threads used to read top-level groups.
+     *
+     * \return Returns the number of threads set by setThreadCount().
+     */
+    unsigned int threadCount() const;
+
+    /** \brief Creates a staging reader, i.e. a reader that keeps the changes to
+     *         shared state (e.g. the record managers) to itself instead of
+     *         performing them.
+     *
+     * \return Returns a new reader of the same type with the same settings, or
+     *         nullptr, if the reader implementation does not support that.
+     * \remarks Staging readers allow to read several files at the same time,
+     *          see readESMsConcurrently(). Their results are taken over by
+     *          calling mergeStagingReader() on the reader they were created
+     *          from.
+     */
+    std::unique_ptr<ESMReader> createStagingReader() const;
+
+    /** \brief Takes over the results of a staging reader.
+     *
+     * \param stagingReader  the staging reader, as created by
+     *                       createStagingReader()
+     * \return Returns true, if the results were merged successfully.
+     *         Returns false, if an error occurred.
+     */
+    bool mergeStagingReader(ESMReader& stagingReader);
+
+    /** \brief Reads several .esm/.esp files of Skyrim at the same time.
+     *
+     * \param files    pairs of reader and name of the file it shall read; every
+     *                 reader has to be a staging reader
+     * \param l10n     the preferred localization for string tables, if any
+     * \param threads  the number of threads to use
+     * \return Returns true, if all files were read successfully.
+     *         Returns false, if an error occurred.
+     * \remarks The top-level groups of all files are distributed over the
+     *          threads together, so large files do not hold up the others.
+     *          The results of each group end up in the reader of its file, and
+     *          it is up to the caller to merge those readers in the desired
+     *          order with mergeStagingReader().
+     */
+    static bool readESMsConcurrently(const std::vector<std::pair<ESMReader*, std::string> >& files, const std::optional<Localization>& l10n, const unsigned int threads);
+
   protected:
     /** \brief Tries to read the next group from a stream.
      *
@@ -169,12 +228,149 @@ class ESMReader
      */
     virtual int readNextRecord(std::istream& input, const uint32_t recName, const bool localized, const StringTable& table) = 0;
 
+    /** \brief Creates a reader that reads a single top-level group on a worker
+     *         thread.
+     *
+     * \return Returns a new reader of the same type with the same settings, or
+     *         nullptr, if the reader implementation can only read a file
+     *         sequentially. The implementation in ESMReader returns nullptr.
+     * \remarks Top-level groups are only read concurrently, if this returns a
+     *          reader. A group reader must not modify any state that is shared
+     *          with other readers (e.g. the record manager singletons) while
+     *          it reads. Such changes have to be passed to applyChange(), and
+     *          everything else has to be taken over in mergeGroupReader().
+     */
+    virtual std::unique_ptr<ESMReader> createGroupReader() const;
+
+    /** \brief Takes over the results of a group reader that has finished.
+     *
+     * \param groupReader  the group reader, as created by createGroupReader()
+     * \return Returns true, if the results were merged successfully.
+     *         Returns false, if an error occurred.
+     * \remarks This is called on the thread that called readESM(), once for
+     *          every group, and in the same order as the groups appear in the
+     *          file. It is also used to merge staging readers. The
+     *          implementation in ESMReader passes the changes that the group
+     *          reader queued on to applyChange(). Derived classes that override
+     *          this function should call it, too.
+     */
+    virtual bool mergeGroupReader(ESMReader& groupReader);
+
+    /** \brief Indicates whether the reader needs the string tables of
+     *         localized files.
+     *
+     * \return Returns true, if the string tables shall be loaded before the
+     *         groups of a localized file are read. The implementation in
+     *         ESMReader returns true.
+     * \remarks Readers that do not decode any localized strings while they
+     *          read can return false to save the time and memory it takes to
+     *          load the string tables. They get an empty table instead.
+     */
+    virtual bool needStringTables() const;
+
+    /** \brief Performs a change of state that is shared between readers, e.g.
+     *         adding a record to a record manager.
+     *
+     * \param change  the function that performs the change
+     * \remarks A normal reader performs the change immediately. Group readers
+     *          and staging readers queue it instead, and the queued changes are
+     *          performed by mergeGroupReader() in file order, so the outcome is
+     *          the same as for a sequential read.
+     */
+    void applyChange(std::function<void()> change);
+
+    /** \brief Checks whether this reader queues changes to shared state
+     *         instead of performing them, i.e. whether it is a group reader or
+     *         a staging reader.
+     *
+     * \return Returns true, if changes are queued.
+     */
+    bool isStaging() const;
+
     /** \brief Holds the current/last TES4 header record that was read by the reader.
      *
      * \remark This is only valid, if readESM() has been called. Otherwise its
      *         content is undefined.
      */
     Tes4HeaderRecord currentHead;
+  private:
+    /// top-level group that is read by a group reader
+    struct GroupJob
+    {
+      MWTP::ByteView data;               /**< content of the group, including header */
+      std::size_t offset;                /**< offset of the group in its file */
+      bool localized;                    /**< whether the data is localized */
+      const StringTable* table;          /**< string table for localized data */
+      std::unique_ptr<ESMReader> reader; /**< reader for the group */
+      int result;                        /**< return value of processGroup() */
+    };
+
+    /** \brief Reads the TES4 header record at the start of a file.
+     *
+     * \param input     the input stream, positioned at the start of the file
+     * \param FileName  name of the file, used in error messages
+     * \param head      the record that will be used to store the header
+     * \return Returns true, if the header was read successfully.
+     *         Returns false, if an error occurred.
+     */
+    static bool readHeader(std::istream& input, const std::string& FileName, Tes4HeaderRecord& head);
+
+    /** \brief Reads the top-level groups of a file with several threads.
+     *
+     * \param data       the content of the whole file
+     * \param start      offset of the first top-level group in data
+     * \param localized  true, if the data in the stream is localized
+     * \param table      in case of localized data: the string table
+     * \return Returns the number of relevant groups that were read.
+     *         If an error occurred, -1 is returned.
+     */
+    int readGroupsConcurrently(const MWTP::ByteView data, const std::size_t start, const bool localized, const StringTable& table);
+
+    /** \brief Locates the top-level groups of a file and creates a group reader
+     *         for every group that is needed.
+     *
+     * \param data       the content of the whole file
+     * \param start      offset of the first top-level group in data
+     * \param localized  true, if the data in the stream is localized
+     * \param table      in case of localized data: the string table
+     * \param jobs       vector that will receive the groups, in file order
+     * \return Returns true, if all group headers could be read.
+     *         Returns false, if an error occurred.
+     */
+    bool scanGroups(const MWTP::ByteView data, const std::size_t start, const bool localized, const StringTable& table, std::vector<GroupJob>& jobs) const;
+
+    /** \brief Lets the group readers read their groups.
+     *
+     * \param jobs     the groups to read; will be reordered
+     * \param threads  the number of threads to use
+     * \return Returns true, if all groups were read successfully.
+     *         Returns false, if an error occurred.
+     */
+    static bool readGroupJobs(std::vector<GroupJob*>& jobs, const unsigned int threads);
+
+    /** \brief Merges the results of group readers into this reader.
+     *
+     * \param jobs  the groups that were read, in file order
+     * \return Returns the number of relevant groups that were read.
+     *         If an error occurred, -1 is returned.
+     */
+    int mergeGroupJobs(std::vector<GroupJob>& jobs);
+
+    /** \brief Runs tasks on several threads, including the calling thread.
+     *
+     * \param taskCount  the number of tasks
+     * \param threads    the maximum number of threads
+     * \param task       function that performs the task with the given index
+     *                   and returns whether it was successful
+     * \return Returns true, if all tasks were successful.
+     *         Returns false, if a task failed. Remaining tasks are not started
+     *         after a failure.
+     */
+    static bool runTasks(const std::size_t taskCount, const unsigned int threads, const std::function<bool(const std::size_t)>& task);
+
+    unsigned int m_ThreadCount; /**< number of threads for top-level groups */
+    bool m_Staging; /**< whether changes to shared state are queued */
+    std::vector<std::function<void()> > m_Changes; /**< queued changes */
 }; // class
 
 } // namespace
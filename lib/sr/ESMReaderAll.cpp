@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2012, 2013, 2014, 2021  Dirk Stolle
+    Copyright (C) 2011, 2012, 2013, 2014, 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -156,321 +156,359 @@ bool ESMReaderAll::groupFinished(const GroupData& g_data)
   return true;
 }
 
+std::unique_ptr<ESMReader> ESMReaderAll::createGroupReader() const
+{
+  return std::make_unique<ESMReaderAll>(*this);
+}
+
+template<typename recT>
+int ESMReaderAll::readRecord(MapBasedRecordManager<recT>& manager, std::istream& input, const bool localized, const StringTable& table)
+{
+  if (!isStaging())
+  {
+    return manager.readNextRecord(input, localized, table);
+  }
+  recT record;
+  if (!record.loadFromStream(input, localized, table))
+  {
+    std::cerr << "ESMReaderAll::readRecord: Error while reading record.\n";
+    return -1;
+  }
+  // Adding an equal record again does not change anything, so the equality
+  // check of readNextRecord() is not needed here.
+  applyChange([&manager, record = std::move(record)]() { manager.addRecord(record); });
+  return 1;
+}
+
 int ESMReaderAll::readNextRecord(std::istream& input, const uint32_t recName, const bool localized, const StringTable& table)
 {
   switch (recName)
   {
     case cAACT:
-         return Actions::get().readNextRecord(input, localized, table);
+         return readRecord(Actions::get(), input, localized, table);
          break;
     case cACHR:
-         return CharacterReferences::get().readNextRecord(input, localized, table);
+         return readRecord(CharacterReferences::get(), input, localized, table);
          break;
     case cACTI:
-         return Activators::get().readNextRecord(input, localized, table);
+         return readRecord(Activators::get(), input, localized, table);
          break;
     case cADDN:
-         return AddOnNodes::get().readNextRecord(input, localized, table);
+         return readRecord(AddOnNodes::get(), input, localized, table);
          break;
     case cALCH:
-         return AlchemyPotions::get().readNextRecord(input, localized, table);
+         return readRecord(AlchemyPotions::get(), input, localized, table);
          break;
     case cAMMO:
-         return Ammunitions::get().readNextRecord(input, localized, table);
+         return readRecord(Ammunitions::get(), input, localized, table);
          break;
     case cANIO:
-         return AnimatedObjects::get().readNextRecord(input, localized, table);
+         return readRecord(AnimatedObjects::get(), input, localized, table);
          break;
     case cAPPA:
-         return Apparatuses::get().readNextRecord(input, localized, table);
+         return readRecord(Apparatuses::get(), input, localized, table);
          break;
     case cARMO:
-         return Armours::get().readNextRecord(input, localized, table);
+         return readRecord(Armours::get(), input, localized, table);
          break;
     case cARTO:
-         return ArtObjects::get().readNextRecord(input, localized, table);
+         return readRecord(ArtObjects::get(), input, localized, table);
          break;
     case cASPC:
-         return AcousticSpaces::get().readNextRecord(input, localized, table);
+         return readRecord(AcousticSpaces::get(), input, localized, table);
          break;
     case cASTP:
-         return AssociationTypes::get().readNextRecord(input, localized, table);
+         return readRecord(AssociationTypes::get(), input, localized, table);
          break;
     case cBOOK:
-         return Books::get().readNextRecord(input, localized, table);
+         return readRecord(Books::get(), input, localized, table);
          break;
     case cCAMS:
-         return CameraShots::get().readNextRecord(input, localized, table);
+         return readRecord(CameraShots::get(), input, localized, table);
          break;
     case cCELL:
-         return Cells::get().readNextRecord(input, localized, table);
+         return readRecord(Cells::get(), input, localized, table);
          break;
     case cCLAS:
-         return Classes::get().readNextRecord(input, localized, table);
+         return readRecord(Classes::get(), input, localized, table);
          break;
     case cCLFM:
-         return ColourForms::get().readNextRecord(input, localized, table);
+         return readRecord(ColourForms::get(), input, localized, table);
          break;
     case cCLMT:
-         return Climates::get().readNextRecord(input, localized, table);
+         return readRecord(Climates::get(), input, localized, table);
          break;
     case cCOBJ:
-         return CraftableObjects::get().readNextRecord(input, localized, table);
+         return readRecord(CraftableObjects::get(), input, localized, table);
          break;
     case cCOLL:
-         return Collisions::get().readNextRecord(input, localized, table);
+         return readRecord(Collisions::get(), input, localized, table);
          break;
     case cCONT:
-         return Containers::get().readNextRecord(input, localized, table);
+         return readRecord(Containers::get(), input, localized, table);
          break;
     case cCPTH:
-         return CameraPaths::get().readNextRecord(input, localized, table);
+         return readRecord(CameraPaths::get(), input, localized, table);
          break;
     case cCSTY:
-         return CombatStyles::get().readNextRecord(input, localized, table);
+         return readRecord(CombatStyles::get(), input, localized, table);
          break;
     case cDEBR:
-         return Debris::get().readNextRecord(input, localized, table);
+         return readRecord(Debris::get(), input, localized, table);
          break;
     case cDIAL:
-         return Dialogues::get().readNextRecord(input, localized, table);
+         return readRecord(Dialogues::get(), input, localized, table);
          break;
     case cDLBR:
-         return DialogBranches::get().readNextRecord(input, localized, table);
+         return readRecord(DialogBranches::get(), input, localized, table);
          break;
     case cDLVW:
-         return DialogViews::get().readNextRecord(input, localized, table);
+         return readRecord(DialogViews::get(), input, localized, table);
          break;
     case cDOBJ:
-         return DOBJRecords::get().readNextRecord(input, localized, table);
+         return readRecord(DOBJRecords::get(), input, localized, table);
          break;
     case cDOOR:
-         return Doors::get().readNextRecord(input, localized, table);
+         return readRecord(Doors::get(), input, localized, table);
          break;
     case cDUAL:
-         return DualCastData::get().readNextRecord(input, localized, table);
+         return readRecord(DualCastData::get(), input, localized, table);
          break;
     case cECZN:
-         return EncounterZones::get().readNextRecord(input, localized, table);
+         return readRecord(EncounterZones::get(), input, localized, table);
          break;
     case cEFSH:
-         return EffectShaders::get().readNextRecord(input, localized, table);
+         return readRecord(EffectShaders::get(), input, localized, table);
          break;
     case cENCH:
-         return Enchantments::get().readNextRecord(input, localized, table);
+         return readRecord(Enchantments::get(), input, localized, table);
          break;
     case cEQUP:
-         return EquipmentSlots::get().readNextRecord(input, localized, table);
+         return readRecord(EquipmentSlots::get(), input, localized, table);
          break;
     case cEXPL:
-         return Explosions::get().readNextRecord(input, localized, table);
+         return readRecord(Explosions::get(), input, localized, table);
          break;
     case cEYES:
-         return Eyes::get().readNextRecord(input, localized, table);
+         return readRecord(Eyes::get(), input, localized, table);
          break;
     case cFACT:
-         return Factions::get().readNextRecord(input, localized, table);
+         return readRecord(Factions::get(), input, localized, table);
          break;
     case cFLOR:
-         return Floras::get().readNextRecord(input, localized, table);
+         return readRecord(Floras::get(), input, localized, table);
          break;
     case cFLST:
-         return FormLists::get().readNextRecord(input, localized, table);
+         return readRecord(FormLists::get(), input, localized, table);
          break;
     case cFSTP:
-         return Footsteps::get().readNextRecord(input, localized, table);
+         return readRecord(Footsteps::get(), input, localized, table);
          break;
     case cFSTS:
-         return FootstepSets::get().readNextRecord(input, localized, table);
+         return readRecord(FootstepSets::get(), input, localized, table);
          break;
     case cFURN:
-         return Furniture::get().readNextRecord(input, localized, table);
+         return readRecord(Furniture::get(), input, localized, table);
          break;
     case cGMST:
-         return GameSettings::get().readNextRecord(input, localized, table);
+         if (!isStaging())
+         {
+           return GameSettings::get().readNextRecord(input, localized, table);
+         }
+         else
+         {
+           GMSTRecord record;
+           if (!record.loadFromStream(input, localized, table))
+           {
+             std::cerr << "ESMReaderAll::readNextRecord: Error while reading GMST record.\n";
+             return -1;
+           }
+           applyChange([record]() { GameSettings::get().addGameSetting(record); });
+           return 1;
+         }
          break;
     case cGLOB:
-         return Globals::get().readNextRecord(input, localized, table);
+         return readRecord(Globals::get(), input, localized, table);
          break;
     case cGRAS:
-         return Grasses::get().readNextRecord(input, localized, table);
+         return readRecord(Grasses::get(), input, localized, table);
          break;
     case cHAZD:
-         return Hazards::get().readNextRecord(input, localized, table);
+         return readRecord(Hazards::get(), input, localized, table);
          break;
     case cHDPT:
-         return HeadParts::get().readNextRecord(input, localized, table);
+         return readRecord(HeadParts::get(), input, localized, table);
          break;
     case cIDLE:
-         return IdleAnimations::get().readNextRecord(input, localized, table);
+         return readRecord(IdleAnimations::get(), input, localized, table);
          break;
     case cIMAD:
-         return ImageSpaceModifiers::get().readNextRecord(input, localized, table);
+         return readRecord(ImageSpaceModifiers::get(), input, localized, table);
          break;
     case cIMGS:
-         return ImageSpaces::get().readNextRecord(input, localized, table);
+         return readRecord(ImageSpaces::get(), input, localized, table);
          break;
     case cIPCT:
-         return ImpactData::get().readNextRecord(input, localized, table);
+         return readRecord(ImpactData::get(), input, localized, table);
          break;
     case cIPDS:
-         return ImpactDataSets::get().readNextRecord(input, localized, table);
+         return readRecord(ImpactDataSets::get(), input, localized, table);
          break;
     case cINGR:
-         return Ingredients::get().readNextRecord(input, localized, table);
+         return readRecord(Ingredients::get(), input, localized, table);
          break;
     case cKEYM:
-         return Keys::get().readNextRecord(input, localized, table);
+         return readRecord(Keys::get(), input, localized, table);
          break;
     case cKYWD:
-         return Keywords::get().readNextRecord(input, localized, table);
+         return readRecord(Keywords::get(), input, localized, table);
          break;
     case cLCRT:
-         return LocationReferenceTypes::get().readNextRecord(input, localized, table);
+         return readRecord(LocationReferenceTypes::get(), input, localized, table);
          break;
     case cLCTN:
-         return Locations::get().readNextRecord(input, localized, table);
+         return readRecord(Locations::get(), input, localized, table);
          break;
     case cLGTM:
-         return LightingTemplates::get().readNextRecord(input, localized, table);
+         return readRecord(LightingTemplates::get(), input, localized, table);
          break;
     case cLIGH:
-         return Lights::get().readNextRecord(input, localized, table);
+         return readRecord(Lights::get(), input, localized, table);
          break;
     case cLSCR:
-         return LoadScreens::get().readNextRecord(input, localized, table);
+         return readRecord(LoadScreens::get(), input, localized, table);
          break;
     case cLTEX:
-         return LandscapeTextures::get().readNextRecord(input, localized, table);
+         return readRecord(LandscapeTextures::get(), input, localized, table);
          break;
     case cLVLI:
-         return LeveledItems::get().readNextRecord(input, localized, table);
+         return readRecord(LeveledItems::get(), input, localized, table);
          break;
     case cLVLN:
-         return LeveledCharacters::get().readNextRecord(input, localized, table);
+         return readRecord(LeveledCharacters::get(), input, localized, table);
          break;
     case cLVSP:
-         return LeveledSpells::get().readNextRecord(input, localized, table);
+         return readRecord(LeveledSpells::get(), input, localized, table);
          break;
     case cMATO:
-         return MaterialObjects::get().readNextRecord(input, localized, table);
+         return readRecord(MaterialObjects::get(), input, localized, table);
          break;
     case cMATT:
-         return MaterialTypes::get().readNextRecord(input, localized, table);
+         return readRecord(MaterialTypes::get(), input, localized, table);
          break;
     case cMESG:
-         return Messages::get().readNextRecord(input, localized, table);
+         return readRecord(Messages::get(), input, localized, table);
          break;
     case cMGEF:
-         return MagicEffects::get().readNextRecord(input, localized, table);
+         return readRecord(MagicEffects::get(), input, localized, table);
          break;
     case cMISC:
-         return MiscObjects::get().readNextRecord(input, localized, table);
+         return readRecord(MiscObjects::get(), input, localized, table);
          break;
     case cMOVT:
-         return MovementTypes::get().readNextRecord(input, localized, table);
+         return readRecord(MovementTypes::get(), input, localized, table);
          break;
     case cMSTT:
-         return MovableStatics::get().readNextRecord(input, localized, table);
+         return readRecord(MovableStatics::get(), input, localized, table);
          break;
     case cMUSC:
-         return MusicTypes::get().readNextRecord(input, localized, table);
+         return readRecord(MusicTypes::get(), input, localized, table);
          break;
     case cMUST:
-         return MusicTracks::get().readNextRecord(input, localized, table);
+         return readRecord(MusicTracks::get(), input, localized, table);
          break;
     case cNAVI:
-         return NAVIRecords::get().readNextRecord(input, localized, table);
+         return readRecord(NAVIRecords::get(), input, localized, table);
          break;
     case cNAVM:
-         return NavMeshes::get().readNextRecord(input, localized, table);
+         return readRecord(NavMeshes::get(), input, localized, table);
          break;
     case cNPC_:
-         return NPCs::get().readNextRecord(input, localized, table);
+         return readRecord(NPCs::get(), input, localized, table);
          break;
     case cOTFT:
-         return Outfits::get().readNextRecord(input, localized, table);
+         return readRecord(Outfits::get(), input, localized, table);
          break;
     case cPERK:
-         return Perks::get().readNextRecord(input, localized, table);
+         return readRecord(Perks::get(), input, localized, table);
          break;
     case cPGRE:
-         return PlacedGrenades::get().readNextRecord(input, localized, table);
+         return readRecord(PlacedGrenades::get(), input, localized, table);
          break;
     case cPHZD:
-         return PlacedHazards::get().readNextRecord(input, localized, table);
+         return readRecord(PlacedHazards::get(), input, localized, table);
          break;
     case cPROJ:
-         return Projectiles::get().readNextRecord(input, localized, table);
+         return readRecord(Projectiles::get(), input, localized, table);
          break;
     case cQUST:
-         return Quests::get().readNextRecord(input, localized, table);
+         return readRecord(Quests::get(), input, localized, table);
          break;
     case cRACE:
-         return Races::get().readNextRecord(input, localized, table);
+         return readRecord(Races::get(), input, localized, table);
          break;
     case cREFR:
-         return References::get().readNextRecord(input, localized, table);
+         return readRecord(References::get(), input, localized, table);
          break;
     case cRELA:
-         return Relationships::get().readNextRecord(input, localized, table);
+         return readRecord(Relationships::get(), input, localized, table);
          break;
     case cREVB:
-         return Reverbs::get().readNextRecord(input, localized, table);
+         return readRecord(Reverbs::get(), input, localized, table);
          break;
     case cRFCT:
-         return VisualEffects::get().readNextRecord(input, localized, table);
+         return readRecord(VisualEffects::get(), input, localized, table);
          break;
     case cSCRL:
-         return Scrolls::get().readNextRecord(input, localized, table);
+         return readRecord(Scrolls::get(), input, localized, table);
          break;
     case cSHOU:
-         return Shouts::get().readNextRecord(input, localized, table);
+         return readRecord(Shouts::get(), input, localized, table);
          break;
     case cSLGM:
-         return SoulGems::get().readNextRecord(input, localized, table);
+         return readRecord(SoulGems::get(), input, localized, table);
          break;
     case cSNCT:
-         return SoundCategories::get().readNextRecord(input, localized, table);
+         return readRecord(SoundCategories::get(), input, localized, table);
          break;
     case cSNDR:
-         return SoundDescriptors::get().readNextRecord(input, localized, table);
+         return readRecord(SoundDescriptors::get(), input, localized, table);
          break;
     case cSOUN:
-         return Sounds::get().readNextRecord(input, localized, table);
+         return readRecord(Sounds::get(), input, localized, table);
          break;
     case cSPEL:
-         return Spells::get().readNextRecord(input, localized, table);
+         return readRecord(Spells::get(), input, localized, table);
          break;
     case cSPGD:
-         return ShaderParticleGeometries::get().readNextRecord(input, localized, table);
+         return readRecord(ShaderParticleGeometries::get(), input, localized, table);
          break;
     case cSTAT:
-         return Statics::get().readNextRecord(input, localized, table);
+         return readRecord(Statics::get(), input, localized, table);
          break;
     case cTACT:
-         return TalkingActivators::get().readNextRecord(input, localized, table);
+         return readRecord(TalkingActivators::get(), input, localized, table);
          break;
     case cTREE:
-         return Trees::get().readNextRecord(input, localized, table);
+         return readRecord(Trees::get(), input, localized, table);
          break;
     case cTXST:
-         return TextureSets::get().readNextRecord(input, localized, table);
+         return readRecord(TextureSets::get(), input, localized, table);
          break;
     case cVTYP:
-         return VoiceTypes::get().readNextRecord(input, localized, table);
+         return readRecord(VoiceTypes::get(), input, localized, table);
          break;
     case cWATR:
-         return WaterTypes::get().readNextRecord(input, localized, table);
+         return readRecord(WaterTypes::get(), input, localized, table);
          break;
     case cWEAP:
-         return Weapons::get().readNextRecord(input, localized, table);
+         return readRecord(Weapons::get(), input, localized, table);
          break;
     case cWOOP:
-         return WordsOfPower::get().readNextRecord(input, localized, table);
+         return readRecord(WordsOfPower::get(), input, localized, table);
          break;
     case cWRLD:
-         return WorldSpaces::get().readNextRecord(input, localized, table);
+         return readRecord(WorldSpaces::get(), input, localized, table);
          break;
     default:
          // This branch should not be necessary once the reader class is finished.
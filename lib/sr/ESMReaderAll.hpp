@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2012, 2013, 2021  Thoronador
+    Copyright (C) 2011, 2012, 2013, 2021, 2026  Thoronador
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -23,6 +23,7 @@
 
 #include "ESMReader.hpp"
 #include <set>
+#include "MapBasedRecordManager.hpp"
 
 namespace SRTP
 {
@@ -94,7 +95,26 @@ class ESMReaderAll: public ESMReader
     */
     virtual int readNextRecord(std::istream& input, const uint32_t recName, const bool localized, const StringTable& table) override;
 
+    /* creates a reader that reads a single top-level group on a worker thread,
+       see ESMReader::createGroupReader() for details
+    */
+    virtual std::unique_ptr<ESMReader> createGroupReader() const override;
+
     std::set<uint32_t> encounters;
+  private:
+    /* tries to read the next record from a stream into the given record manager
+       and returns the number of relevant records that were read (usually one).
+       If an error occurred, -1 is returned. Group readers do not modify the
+       record manager directly, they only queue the record for it.
+
+       parameters:
+           manager    - the record manager that shall get the record
+           input      - the input stream the record shall be read from
+           localized  - true, if the data in the stream is localized
+           table      - in case of localized data: the string table
+    */
+    template<typename recT>
+    int readRecord(MapBasedRecordManager<recT>& manager, std::istream& input, const bool localized, const StringTable& table);
 }; // class
 
 } // namespace
@@ -0,0 +1,111 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "ESMReaderLazy.hpp"
+#include <filesystem>
+#include <iostream>
+#include "records/TES4HeaderRecord.hpp"
+
+namespace SRTP
+{
+
+ESMReaderLazy::ESMReaderLazy(const std::vector<std::string>& loadOrder)
+: ESMReaderReIndexMod(loadOrder),
+  m_Handlers(std::map<uint32_t, Handler>()),
+  m_Source(nullptr),
+  m_Indexed(0)
+{
+}
+
+int ESMReaderLazy::indexESM(const std::string& fileName, const std::optional<Localization>& l10n)
+{
+  auto source = std::make_shared<LazyRecordSource>(fileName, l10n);
+  if (!source->open())
+    return -1;
+  m_Source = source;
+  m_Indexed = 0;
+  requestIndexMapUpdate(std::filesystem::path(fileName).filename().string());
+  Tes4HeaderRecord head;
+  const int result = readESM(fileName, head, l10n);
+  m_Source = nullptr;
+  if (result < 0)
+    return -1;
+  // The header is read before any record, but records are only decoded
+  // later, so it is early enough to set the flag here.
+  source->setLocalized(head.isLocalized());
+  return m_Indexed;
+}
+
+bool ESMReaderLazy::needGroup(const GroupData& g_data) const
+{
+  return (g_data.type() == GroupData::cTopLevelGroup)
+      && (m_Handlers.find(g_data.label()) != m_Handlers.end());
+}
+
+bool ESMReaderLazy::nextGroupStarted([[maybe_unused]] const GroupData& g_data, [[maybe_unused]] const bool sub)
+{
+  if (indexMapsNeedsUpdate())
+  {
+    return updateIndexMap(m_CurrentMod);
+  }
+  return true;
+}
+
+bool ESMReaderLazy::groupFinished([[maybe_unused]] const GroupData& g_data)
+{
+  return true;
+}
+
+int ESMReaderLazy::readNextRecord(std::istream& input, const uint32_t recName, [[maybe_unused]] const bool localized, [[maybe_unused]] const StringTable& table)
+{
+  const auto handler = m_Handlers.find(recName);
+  if ((handler == m_Handlers.end()) || (m_Source == nullptr))
+  {
+    return (skipRecord(input) == 0) ? 0 : -1;
+  }
+
+  // Files are read sequentially from a stream over the whole file, so the
+  // position in the stream is the offset in the file.
+  RecordLocation location;
+  location.recName = recName;
+  location.offset = static_cast<uint64_t>(input.tellg());
+  input.read(reinterpret_cast<char*>(&location.size), 4);
+  input.read(reinterpret_cast<char*>(&location.flags), 4);
+  input.read(reinterpret_cast<char*>(&location.formID), 4);
+  // skip remaining header (revision, version, unknown value) and the data
+  input.seekg(static_cast<std::streamoff>(location.offset + 20 + location.size));
+  if (!input.good())
+  {
+    std::cerr << "ESMReaderLazy: Error while skipping record data.\n";
+    return -1;
+  }
+  if (!reIndex(location.formID))
+    return -1;
+  handler->second(m_Source, location);
+  ++m_Indexed;
+  return 1;
+}
+
+bool ESMReaderLazy::needStringTables() const
+{
+  return false;
+}
+
+} // namespace
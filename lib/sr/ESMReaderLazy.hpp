@@ -0,0 +1,128 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SR_ESMREADERLAZY_HPP
+#define SR_ESMREADERLAZY_HPP
+
+#include "ESMReaderReIndex.hpp"
+#include <functional>
+#include <map>
+#include <memory>
+#include "LazyRecordManager.hpp"
+
+namespace SRTP
+{
+
+/** This descendant of the ESMReader class does not decode any records. It only
+    stores the location of each record of the requested types in the matching
+    LazyRecordManager, so that the records can be decoded on first access.
+    Form IDs are adjusted to the load order, so that records of several files
+    can be indexed and overrides replace the records of their masters.
+*/
+class ESMReaderLazy: public ESMReaderReIndexMod
+{
+  public:
+    /** \brief Constructor.
+     *
+     * \param loadOrder  file names of all files that will be indexed, in load
+     *                   order, as well as of their masters
+     */
+    ESMReaderLazy(const std::vector<std::string>& loadOrder);
+
+    /** \brief Requests that records of a type shall be indexed.
+     *
+     * \param recName  type of the records, e.g. cNPC_
+     * \remarks The locations of the records are added to
+     *          LazyRecordManager<recT>.
+     */
+    template<typename recT>
+    void indexRecords(const uint32_t recName);
+
+    /** \brief Indexes all requested records of a plugin file.
+     *
+     * \param fileName  path of the plugin file, its file name has to be part
+     *                  of the load order
+     * \param l10n      preferred localization for string tables, if any
+     * \return Returns the number of indexed records.
+     *         Returns -1, if an error occurred.
+     * \remarks The file stays mapped into memory as long as any of its
+     *          records are in a record manager. String tables are only loaded
+     *          when the first record of the file is decoded.
+     */
+    int indexESM(const std::string& fileName, const std::optional<Localization>& l10n);
+  protected:
+    /** \brief Checks whether a group contains records of a requested type.
+     *
+     * \param g_data  the group header data
+     * \return Returns true for top-level groups of requested record types.
+     */
+    virtual bool needGroup(const GroupData& g_data) const override;
+
+    /** \brief Updates the index map for the current file, if necessary.
+     *
+     * \param g_data  the group header data
+     * \param sub     whether the new group is a sub-group of another group
+     * \return Returns true, if the index map is up to date.
+     *         Returns false, if the map could not be updated.
+     */
+    virtual bool nextGroupStarted(const GroupData& g_data, const bool sub) override;
+
+    /** \brief Does nothing, because the reader does not track groups.
+     *
+     * \param g_data  the group header data
+     * \return Returns always true.
+     */
+    virtual bool groupFinished(const GroupData& g_data) override;
+
+    /** \brief Stores the location of the next record, if its type was
+     *         requested, and skips its data.
+     *
+     * \param input      the input stream the record shall be read from
+     * \param recName    name (header) of the next record
+     * \param localized  true, if the data in the stream is localized
+     * \param table      in case of localized data: the string table
+     * \return Returns one, if the record was indexed, zero if it was skipped,
+     *         and -1 if an error occurred.
+     */
+    virtual int readNextRecord(std::istream& input, const uint32_t recName, const bool localized, const StringTable& table) override;
+
+    /** \brief Returns false, because no strings are decoded while indexing. */
+    virtual bool needStringTables() const override;
+  private:
+    /// function that adds the location of a record to a record manager
+    using Handler = std::function<void(const std::shared_ptr<LazyRecordSource>&, const RecordLocation&)>;
+
+    std::map<uint32_t, Handler> m_Handlers;     /**< handlers by record type */
+    std::shared_ptr<LazyRecordSource> m_Source; /**< file that is indexed */
+    int m_Indexed;                              /**< records indexed in current file */
+}; // class
+
+template<typename recT>
+void ESMReaderLazy::indexRecords(const uint32_t recName)
+{
+  m_Handlers[recName] = [](const std::shared_ptr<LazyRecordSource>& source, const RecordLocation& location)
+  {
+    LazyRecordManager<recT>::get().addLocation(source, location);
+  };
+}
+
+} // namespace
+
+#endif // SR_ESMREADERLAZY_HPP
@@ -0,0 +1,256 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SR_LAZYRECORDMANAGER_HPP
+#define SR_LAZYRECORDMANAGER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "LazyRecordSource.hpp"
+
+namespace SRTP
+{
+
+/** Singleton-based manager for records of a given type recT that are only
+ *  decoded when they are accessed.
+ *
+ * Reading a plugin just stores the location of each record (see
+ * ESMReaderLazy). The full loadFromStream() of a record runs on the first call
+ * of getRecord() for its form ID, and the decoded record is kept for later
+ * calls. Records that are never accessed are never decoded.
+ *
+ * The manager is not thread-safe, because getRecord() may decode a record.
+ */
+template<typename recT>
+class LazyRecordManager
+{
+  public:
+    /** \brief Provides access to the singleton instance.
+     *
+     * \return Returns a reference to the singleton instance.
+     */
+    static LazyRecordManager& get();
+
+    /** \brief Adds the location of a record.
+     *
+     * \param source    the plugin file that contains the record
+     * \param location  location of the record inside the file
+     * \remarks The record will NOT be added, if its form ID is zero.
+     *          An existing record with the same form ID will be replaced,
+     *          even if it was already decoded.
+     */
+    void addLocation(const std::shared_ptr<LazyRecordSource>& source, const RecordLocation& location);
+
+    /** \brief Checks whether a record with the given form ID is present.
+     *
+     * \param ID  the form ID of the record object
+     * \return Returns true, if a record with the given form ID is present.
+     *         Returns false otherwise.
+     * \remarks This does not decode the record.
+     */
+    bool hasRecord(const uint32_t ID) const;
+
+    /** Gets the number of records in the instance. */
+    unsigned int getNumberOfRecords() const;
+
+    /** Gets the number of records that have been decoded so far. */
+    unsigned int getNumberOfDecodedRecords() const;
+
+    /** \brief Gets the location of the record with the given form ID.
+     *
+     * \param ID  the form ID of the record
+     * \return Returns the location of the record with the given ID, if such a
+     *         record is present. Throws, if no such record exists.
+     * \remarks This does not decode the record.
+     */
+    const RecordLocation& getLocation(const uint32_t ID) const;
+
+    /** \brief Gets a reference to the record with the given form ID, decoding
+     *         it on first access.
+     *
+     * \param ID  the form ID of the record
+     * \return Returns a reference to the record with the given ID, if such a
+     *         record is present and can be decoded. Throws otherwise.
+     * \remarks Use hasRecord() to determine, if a record with the desired ID
+     *          is present.
+     */
+    const recT& getRecord(const uint32_t ID) const;
+
+    /** \brief Gets the form IDs of all records.
+     *
+     * \return Returns the form IDs in ascending order.
+     */
+    std::vector<uint32_t> getFormIDs() const;
+
+    /** Removes all records from the instance. */
+    void clear();
+  private:
+    /** Constructor. */
+    LazyRecordManager() = default;
+
+    /** Deleted copy constructor. */
+    LazyRecordManager(const LazyRecordManager& op) = delete;
+
+    /** Deleted move constructor. */
+    LazyRecordManager(LazyRecordManager&& op) = delete;
+
+    /// a record that may not be decoded yet
+    struct Entry
+    {
+      RecordLocation location;                  /**< location of the record */
+      std::shared_ptr<LazyRecordSource> source; /**< file of the record */
+      mutable std::unique_ptr<recT> record;     /**< decoded record, if any */
+    };
+
+    /** \brief Finds the entry with the given form ID.
+     *
+     * \param ID  the form ID
+     * \return Returns a pointer to the entry, or nullptr if there is none.
+     */
+    const Entry* find(const uint32_t ID) const;
+
+    std::vector<Entry> m_Entries;         /**< entries, sorted by form ID */
+    mutable unsigned int m_Decoded = 0;   /**< number of decoded records */
+};
+
+template<typename recT>
+LazyRecordManager<recT>& LazyRecordManager<recT>::get()
+{
+  static LazyRecordManager<recT> Instance;
+  return Instance;
+}
+
+template<typename recT>
+void LazyRecordManager<recT>::addLocation(const std::shared_ptr<LazyRecordSource>& source, const RecordLocation& location)
+{
+  if ((location.formID == 0) || (source == nullptr))
+    return;
+  // Records are often added in ascending order, so check the end first.
+  if (m_Entries.empty() || (m_Entries.back().location.formID < location.formID))
+  {
+    m_Entries.push_back(Entry{ location, source, nullptr });
+    return;
+  }
+  const auto pos = std::lower_bound(m_Entries.begin(), m_Entries.end(), location.formID,
+      [](const Entry& entry, const uint32_t value) { return entry.location.formID < value; });
+  if (pos->location.formID == location.formID)
+  {
+    if (pos->record != nullptr)
+      --m_Decoded;
+    *pos = Entry{ location, source, nullptr };
+  }
+  else
+  {
+    m_Entries.insert(pos, Entry{ location, source, nullptr });
+  }
+}
+
+template<typename recT>
+const typename LazyRecordManager<recT>::Entry* LazyRecordManager<recT>::find(const uint32_t ID) const
+{
+  const auto pos = std::lower_bound(m_Entries.begin(), m_Entries.end(), ID,
+      [](const Entry& entry, const uint32_t value) { return entry.location.formID < value; });
+  if ((pos == m_Entries.end()) || (pos->location.formID != ID))
+    return nullptr;
+  return &(*pos);
+}
+
+template<typename recT>
+bool LazyRecordManager<recT>::hasRecord(const uint32_t ID) const
+{
+  return find(ID) != nullptr;
+}
+
+template<typename recT>
+unsigned int LazyRecordManager<recT>::getNumberOfRecords() const
+{
+  return m_Entries.size();
+}
+
+template<typename recT>
+unsigned int LazyRecordManager<recT>::getNumberOfDecodedRecords() const
+{
+  return m_Decoded;
+}
+
+template<typename recT>
+const RecordLocation& LazyRecordManager<recT>::getLocation(const uint32_t ID) const
+{
+  const Entry* entry = find(ID);
+  if (entry == nullptr)
+  {
+    std::cerr << "LazyRecordManager: Error! No record with the ID \"" << ID
+              << "\" is present.\n";
+    throw std::runtime_error("LazyRecordManager: Error! No record with the requested ID is present.");
+  }
+  return entry->location;
+}
+
+template<typename recT>
+const recT& LazyRecordManager<recT>::getRecord(const uint32_t ID) const
+{
+  const Entry* entry = find(ID);
+  if (entry == nullptr)
+  {
+    std::cerr << "LazyRecordManager: Error! No record with the ID \"" << ID
+              << "\" is present.\n";
+    throw std::runtime_error("LazyRecordManager: Error! No record with the requested ID is present.");
+  }
+  if (entry->record == nullptr)
+  {
+    auto record = std::make_unique<recT>();
+    if (!entry->source->loadRecord(entry->location, *record))
+    {
+      std::cerr << "LazyRecordManager: Error! Record with the ID \"" << ID
+                << "\" could not be decoded from " << entry->source->fileName() << ".\n";
+      throw std::runtime_error("LazyRecordManager: Error! Record could not be decoded.");
+    }
+    entry->record = std::move(record);
+    ++m_Decoded;
+  }
+  return *entry->record;
+}
+
+template<typename recT>
+std::vector<uint32_t> LazyRecordManager<recT>::getFormIDs() const
+{
+  std::vector<uint32_t> result;
+  result.reserve(m_Entries.size());
+  for (const auto& entry: m_Entries)
+  {
+    result.push_back(entry.location.formID);
+  }
+  return result;
+}
+
+template<typename recT>
+void LazyRecordManager<recT>::clear()
+{
+  m_Entries.clear();
+  m_Decoded = 0;
+}
+
+} // namespace
+
+#endif // SR_LAZYRECORDMANAGER_HPP
@@ -0,0 +1,78 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "LazyRecordSource.hpp"
+#include <iostream>
+#include "StringTableCache.hpp"
+
+namespace SRTP
+{
+
+LazyRecordSource::LazyRecordSource(const std::string& fileName, const std::optional<Localization>& l10n)
+: m_FileName(fileName),
+  m_L10n(l10n),
+  m_Localized(false),
+  m_File(MWTP::MappedFile()),
+  m_Table(nullptr),
+  m_TableFailed(false)
+{
+}
+
+bool LazyRecordSource::open()
+{
+  if (!m_File.open(m_FileName))
+  {
+    std::cerr << "Error: Could not open file \"" << m_FileName << "\".\n";
+    return false;
+  }
+  return true;
+}
+
+const std::string& LazyRecordSource::fileName() const
+{
+  return m_FileName;
+}
+
+void LazyRecordSource::setLocalized(const bool localized)
+{
+  m_Localized = localized;
+}
+
+bool LazyRecordSource::isLocalized() const
+{
+  return m_Localized;
+}
+
+const StringTable* LazyRecordSource::table()
+{
+  if ((m_Table == nullptr) && !m_TableFailed)
+  {
+    m_Table = m_Localized ? StringTableCache::get().load(m_FileName, m_L10n)
+                          : std::make_shared<const StringTable>();
+    if (m_Table == nullptr)
+    {
+      std::cerr << "Error while reading string tables for " << m_FileName << "!\n";
+      m_TableFailed = true;
+    }
+  }
+  return m_Table.get();
+}
+
+} // namespace
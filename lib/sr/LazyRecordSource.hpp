@@ -0,0 +1,124 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SR_LAZYRECORDSOURCE_HPP
+#define SR_LAZYRECORDSOURCE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include "../base/MappedFile.hpp"
+#include "../base/ViewStream.hpp"
+#include "Localization.hpp"
+#include "StringTable.hpp"
+
+namespace SRTP
+{
+
+/** Position and header data of a record inside a plugin file. */
+struct RecordLocation
+{
+  uint32_t recName; /**< type of the record, e.g. cNPC_ */
+  uint32_t formID;  /**< form ID of the record, adjusted to the load order */
+  uint32_t flags;   /**< record flags from the header */
+  uint64_t offset;  /**< offset of the data size, i.e. directly after the record name */
+  uint32_t size;    /**< size of the record data, without the header */
+};
+
+/** A plugin file that stays mapped into memory, so that records can be
+ *  decoded from it later, when they are accessed for the first time.
+ */
+class LazyRecordSource
+{
+  public:
+    /** \brief Constructor.
+     *
+     * \param fileName  path of the plugin file
+     * \param l10n      preferred localization for string tables, if any
+     */
+    LazyRecordSource(const std::string& fileName, const std::optional<Localization>& l10n);
+
+    /** \brief Maps the plugin file into memory.
+     *
+     * \return Returns true, if the file could be mapped.
+     *         Returns false, if an error occurred.
+     */
+    bool open();
+
+    /// Gets the path of the plugin file.
+    const std::string& fileName() const;
+
+    /** \brief Sets whether strings of the plugin are localized.
+     *
+     * \param localized  whether the plugin uses string tables
+     */
+    void setLocalized(const bool localized);
+
+    /// Checks whether strings of the plugin are localized.
+    bool isLocalized() const;
+
+    /** \brief Decodes a record of the plugin.
+     *
+     * \param location  location of the record
+     * \param record    the record that will be used to store the data
+     * \return Returns true, if the record was decoded successfully.
+     *         Returns false, if an error occurred.
+     * \remarks The string tables of a localized plugin are loaded when the
+     *          first record is decoded. The header form ID of the record is
+     *          set to the form ID of the location.
+     */
+    template<typename recT>
+    bool loadRecord(const RecordLocation& location, recT& record);
+  private:
+    /** \brief Gets the string table of the plugin, loading it if necessary.
+     *
+     * \return Returns a pointer to the table, or nullptr, if the string tables
+     *         could not be loaded.
+     */
+    const StringTable* table();
+
+    std::string m_FileName;                     /**< path of the plugin */
+    std::optional<Localization> m_L10n;         /**< preferred localization */
+    bool m_Localized;                           /**< whether strings are localized */
+    MWTP::MappedFile m_File;                    /**< content of the plugin */
+    std::shared_ptr<const StringTable> m_Table; /**< string tables, once loaded */
+    bool m_TableFailed;                         /**< whether loading the tables failed */
+}; // class
+
+template<typename recT>
+bool LazyRecordSource::loadRecord(const RecordLocation& location, recT& record)
+{
+  if (!m_File.isOpen() || (location.offset >= m_File.size()))
+    return false;
+  const StringTable* strings = table();
+  if (strings == nullptr)
+    return false;
+  MWTP::ViewStream stream(m_File.view());
+  stream.seekg(static_cast<std::streamoff>(location.offset));
+  if (!stream.good() || !record.loadFromStream(stream, m_Localized, *strings))
+    return false;
+  record.headerFormID = location.formID;
+  return true;
+}
+
+} // namespace
+
+#endif // SR_LAZYRECORDSOURCE_HPP
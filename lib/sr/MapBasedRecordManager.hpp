@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2012, 2013, 2014, 2021, 2023  Dirk Stolle
+    Copyright (C) 2011, 2012, 2013, 2014, 2021, 2023, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,23 +21,34 @@
 #ifndef SR_MAPBASEDRECORDMANAGER_HPP
 #define SR_MAPBASEDRECORDMANAGER_HPP
 
+#include <algorithm>
 #include <cstdint>
 #include <fstream>
 #include <iostream>
-#include <map>
+#include <iterator>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 #include "StringTable.hpp"
 
 namespace SRTP
 {
 
-/** Singleton-based manager for records of a given type recT, using std::map. */
+/** Singleton-based manager for records of a given type recT.
+ *
+ * The records are kept in a vector of (form ID, record) pairs that is sorted
+ * by form ID. Lookups use binary search, and iteration walks through
+ * contiguous memory in ascending order of form IDs.
+ */
 template<typename recT>
 class MapBasedRecordManager
 {
   public:
-    /// iterator type for internal map structure
-    using ListIterator = typename std::map<uint32_t, recT>::const_iterator;
+    /// type of the elements in the internal structure
+    using Entry = std::pair<uint32_t, recT>;
+
+    /// iterator type for internal structure
+    using ListIterator = typename std::vector<Entry>::const_iterator;
 
     /** \brief Provides access to the singleton instance.
      *
@@ -53,6 +64,38 @@ class MapBasedRecordManager
      */
     void addRecord(const recT& record);
 
+    /** \brief Adds a record to the instance by moving it.
+     *
+     * \param record   the record to add
+     * \remarks The record will NOT be added, if its form ID is zero.
+     *          An existing record with the same form ID will be replaced.
+     */
+    void addRecord(recT&& record);
+
+    /** \brief Starts a bulk load.
+     *
+     * \remarks During a bulk load, added records are just appended to a
+     *          pending list, and they are only sorted into the instance when
+     *          finishBulkLoad() is called. Until then, they are not visible
+     *          to any of the other functions.
+     */
+    void startBulkLoad();
+
+    /** \brief Ends a bulk load and sorts all records added since the start
+     *         into the instance.
+     *
+     * \remarks If several records with the same form ID were added, then the
+     *          record that was added last wins, just like with addRecord().
+     */
+    void finishBulkLoad();
+
+    /** \brief Checks whether a bulk load is in progress.
+     *
+     * \return Returns true, if startBulkLoad() was called and
+     *         finishBulkLoad() was not called afterwards.
+     */
+    bool isBulkLoading() const;
+
     /** \brief Checks whether a record with the given form ID is present.
      *
      * \param ID  the form ID of the record object
@@ -125,12 +168,31 @@ class MapBasedRecordManager
     /** Deleted move constructor. */
     MapBasedRecordManager(MapBasedRecordManager&& op) = delete;
 
-    std::map<uint32_t, recT> m_Records; /**< internal data */
+    /** \brief Finds the position of a form ID in the sorted records.
+     *
+     * \param ID  the form ID
+     * \return Returns the first element whose form ID is not less than ID.
+     */
+    typename std::vector<Entry>::const_iterator lowerBound(const uint32_t ID) const;
+
+    /** \brief Inserts a record at its sorted position.
+     *
+     * \param ID      the form ID of the record
+     * \param record  the record to insert
+     */
+    template<typename T>
+    void insertSorted(const uint32_t ID, T&& record);
+
+    std::vector<Entry> m_Records; /**< records, sorted by form ID */
+    std::vector<Entry> m_Pending; /**< unsorted records of the current bulk load */
+    bool m_BulkLoad;              /**< whether a bulk load is in progress */
 };
 
 template<typename recT>
 MapBasedRecordManager<recT>::MapBasedRecordManager()
-: m_Records(std::map<uint32_t, recT>())
+: m_Records(std::vector<Entry>()),
+  m_Pending(std::vector<Entry>()),
+  m_BulkLoad(false)
 {
 }
 
@@ -144,16 +206,108 @@ MapBasedRecordManager<recT>& MapBasedRecordManager<recT>::get()
 template<typename recT>
 void MapBasedRecordManager<recT>::addRecord(const recT& record)
 {
-  if (record.headerFormID != 0)
+  if (record.headerFormID == 0)
+    return;
+  if (m_BulkLoad)
+    m_Pending.emplace_back(record.headerFormID, record);
+  else
+    insertSorted(record.headerFormID, record);
+}
+
+template<typename recT>
+void MapBasedRecordManager<recT>::addRecord(recT&& record)
+{
+  const uint32_t ID = record.headerFormID;
+  if (ID == 0)
+    return;
+  if (m_BulkLoad)
+    m_Pending.emplace_back(ID, std::move(record));
+  else
+    insertSorted(ID, std::move(record));
+}
+
+template<typename recT>
+template<typename T>
+void MapBasedRecordManager<recT>::insertSorted(const uint32_t ID, T&& record)
+{
+  // Records are often added in ascending order, so check the end first.
+  if (m_Records.empty() || (m_Records.back().first < ID))
+  {
+    m_Records.emplace_back(ID, std::forward<T>(record));
+    return;
+  }
+  const auto pos = m_Records.begin() + (lowerBound(ID) - m_Records.cbegin());
+  if (pos->first == ID)
+    pos->second = std::forward<T>(record);
+  else
+    m_Records.emplace(pos, ID, std::forward<T>(record));
+}
+
+template<typename recT>
+void MapBasedRecordManager<recT>::startBulkLoad()
+{
+  m_BulkLoad = true;
+}
+
+template<typename recT>
+void MapBasedRecordManager<recT>::finishBulkLoad()
+{
+  m_BulkLoad = false;
+  if (m_Pending.empty())
+    return;
+
+  // Stable sorting keeps records with the same ID in the order they were
+  // added, so the last one of each group is the one that has to be kept.
+  std::stable_sort(m_Pending.begin(), m_Pending.end(),
+      [](const Entry& a, const Entry& b) { return a.first < b.first; });
+  std::vector<Entry> merged;
+  merged.reserve(m_Records.size() + m_Pending.size());
+  auto old = m_Records.begin();
+  auto added = m_Pending.begin();
+  while (added != m_Pending.end())
   {
-    m_Records[record.headerFormID] = record;
+    const auto next = added + 1;
+    if ((next != m_Pending.end()) && (next->first == added->first))
+    {
+      // A later record with the same ID replaces this one.
+      added = next;
+      continue;
+    }
+    while ((old != m_Records.end()) && (old->first < added->first))
+    {
+      merged.push_back(std::move(*old));
+      ++old;
+    }
+    if ((old != m_Records.end()) && (old->first == added->first))
+      ++old;
+    merged.push_back(std::move(*added));
+    added = next;
   }
+  std::move(old, m_Records.end(), std::back_inserter(merged));
+  m_Records = std::move(merged);
+  m_Pending.clear();
+  m_Pending.shrink_to_fit();
+}
+
+template<typename recT>
+bool MapBasedRecordManager<recT>::isBulkLoading() const
+{
+  return m_BulkLoad;
+}
+
+template<typename recT>
+typename std::vector<typename MapBasedRecordManager<recT>::Entry>::const_iterator
+MapBasedRecordManager<recT>::lowerBound(const uint32_t ID) const
+{
+  return std::lower_bound(m_Records.begin(), m_Records.end(), ID,
+      [](const Entry& entry, const uint32_t value) { return entry.first < value; });
 }
 
 template<typename recT>
 bool MapBasedRecordManager<recT>::hasRecord(const uint32_t ID) const
 {
-  return m_Records.find(ID) != m_Records.end();
+  const ListIterator iter = lowerBound(ID);
+  return (iter != m_Records.end()) && (iter->first == ID);
 }
 
 template<typename recT>
@@ -165,8 +319,8 @@ unsigned int MapBasedRecordManager<recT>::getNumberOfRecords() const
 template<typename recT>
 const recT& MapBasedRecordManager<recT>::getRecord(const uint32_t ID) const
 {
-  const ListIterator iter = m_Records.find(ID);
-  if (iter != m_Records.end())
+  const ListIterator iter = lowerBound(ID);
+  if ((iter != m_Records.end()) && (iter->first == ID))
   {
     return iter->second;
   }
@@ -178,7 +332,11 @@ const recT& MapBasedRecordManager<recT>::getRecord(const uint32_t ID) const
 template<typename recT>
 bool MapBasedRecordManager<recT>::removeRecord(const uint32_t ID)
 {
-  return m_Records.erase(ID) !=0;
+  const ListIterator iter = lowerBound(ID);
+  if ((iter == m_Records.end()) || (iter->first != ID))
+    return false;
+  m_Records.erase(iter);
+  return true;
 }
 
 template<typename recT>
@@ -220,6 +378,7 @@ template<typename recT>
 void MapBasedRecordManager<recT>::clear()
 {
   m_Records.clear();
+  m_Pending.clear();
 }
 
 template<typename recT>
@@ -243,7 +402,7 @@ int MapBasedRecordManager<recT>::readNextRecord(std::istream& input, const bool
     }
   }
   #endif // SR_NO_SINGLETON_EQUALITY_CHECK
-  addRecord(temp);
+  addRecord(std::move(temp));
   return 1;
 }
 
@@ -0,0 +1,191 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "RecordProjection.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include "../mw/HelperIO.hpp"
+#include "SR_Constants.hpp"
+#include "records/BasicRecord.hpp"
+#include "records/RecordDecompression.hpp"
+
+namespace SRTP
+{
+
+bool ProjectedSubRecord::getString(const bool localized, const StringTable& table, std::string& result) const
+{
+  if (localized)
+  {
+    uint32_t index = 0;
+    if (data.size() != 4)
+    {
+      std::cerr << "Error: Sub record " << IntTo4Char(name)
+                << " has invalid length (" << data.size()
+                << " bytes). Should be four bytes.\n";
+      return false;
+    }
+    getValue(index);
+    if (index == 0)
+    {
+      result.clear();
+      return true;
+    }
+    if (!table.hasString(index))
+    {
+      std::cerr << "ProjectedSubRecord::getString: Table has no entry for index " << index << "!\n";
+      return false;
+    }
+    result = table.getString(index);
+    return true;
+  }
+  // plain string, terminated by NUL
+  const auto end = data.find('\0');
+  result = data.substr(0, end);
+  return true;
+}
+
+RecordProjection::RecordProjection()
+: m_Wanted(std::map<uint32_t, std::vector<uint32_t> >()),
+  m_FormID(0),
+  m_Flags(0),
+  m_Data(std::vector<char>()),
+  m_SubRecords(std::vector<ProjectedSubRecord>())
+{
+}
+
+void RecordProjection::add(const uint32_t recName, const std::vector<uint32_t>& subRecords)
+{
+  auto& wanted = m_Wanted[recName];
+  wanted.insert(wanted.end(), subRecords.begin(), subRecords.end());
+  std::sort(wanted.begin(), wanted.end());
+  wanted.erase(std::unique(wanted.begin(), wanted.end()), wanted.end());
+}
+
+bool RecordProjection::hasRecordType(const uint32_t recName) const
+{
+  return m_Wanted.find(recName) != m_Wanted.end();
+}
+
+bool RecordProjection::read(std::istream& input, const uint32_t recName)
+{
+  m_SubRecords.clear();
+  uint32_t size = 0;
+  input.read(reinterpret_cast<char*>(&size), 4);
+  input.read(reinterpret_cast<char*>(&m_Flags), 4);
+  input.read(reinterpret_cast<char*>(&m_FormID), 4);
+  // skip revision, version and unknown value
+  input.seekg(8, std::ios_base::cur);
+  if (!input.good())
+  {
+    std::cerr << "RecordProjection: Error while reading record header!\n";
+    return false;
+  }
+
+  const auto wanted = m_Wanted.find(recName);
+  if (wanted == m_Wanted.end())
+  {
+    input.seekg(size, std::ios_base::cur);
+    return input.good();
+  }
+
+  m_Data.resize(size);
+  input.read(m_Data.data(), size);
+  if (!input.good())
+  {
+    std::cerr << "RecordProjection: Error while reading data of record "
+              << IntTo4Char(recName) << "!\n";
+    return false;
+  }
+  if ((m_Flags & BasicRecord::cCompressionFlag) == 0)
+    return walk(m_Data.data(), size, wanted->second);
+
+  MWTP::ByteView decompressed;
+  if (!decompressRecordData(reinterpret_cast<const uint8_t*>(m_Data.data()), size, recName, decompressed))
+    return false;
+  return walk(reinterpret_cast<const char*>(decompressed.data()), decompressed.size(), wanted->second);
+}
+
+bool RecordProjection::walk(const char* data, const uint32_t length, const std::vector<uint32_t>& wanted)
+{
+  uint32_t pos = 0;
+  // size from XXXX subrecord, applies to the next subrecord
+  uint32_t extendedSize = 0;
+  bool hasExtendedSize = false;
+  while (pos < length)
+  {
+    if (length - pos < 6)
+    {
+      std::cerr << "RecordProjection: Error: Incomplete subrecord header at end of record!\n";
+      return false;
+    }
+    uint32_t subName = 0;
+    uint16_t subLength = 0;
+    std::memcpy(&subName, data + pos, 4);
+    std::memcpy(&subLength, data + pos + 4, 2);
+    pos += 6;
+    uint32_t dataLength = subLength;
+    if (hasExtendedSize)
+    {
+      dataLength = extendedSize;
+      hasExtendedSize = false;
+    }
+    if (length - pos < dataLength)
+    {
+      std::cerr << "RecordProjection: Error: Subrecord " << IntTo4Char(subName)
+                << " exceeds the record size!\n";
+      return false;
+    }
+    if (subName == cXXXX)
+    {
+      if (dataLength != 4)
+      {
+        std::cerr << "Error: Sub record XXXX has invalid length (" << dataLength
+                  << " bytes). Should be four bytes.\n";
+        return false;
+      }
+      std::memcpy(&extendedSize, data + pos, 4);
+      hasExtendedSize = true;
+    }
+    else if (std::binary_search(wanted.begin(), wanted.end(), subName))
+    {
+      m_SubRecords.push_back(ProjectedSubRecord{ subName, std::string_view(data + pos, dataLength) });
+    }
+    pos += dataLength;
+  }
+  return true;
+}
+
+uint32_t RecordProjection::formID() const
+{
+  return m_FormID;
+}
+
+uint32_t RecordProjection::flags() const
+{
+  return m_Flags;
+}
+
+const std::vector<ProjectedSubRecord>& RecordProjection::subRecords() const
+{
+  return m_SubRecords;
+}
+
+} // namespace
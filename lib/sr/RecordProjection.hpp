@@ -0,0 +1,152 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SR_RECORDPROJECTION_HPP
+#define SR_RECORDPROJECTION_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "StringTable.hpp"
+
+namespace SRTP
+{
+
+/** Raw data of a single subrecord, as returned by RecordProjection. */
+struct ProjectedSubRecord
+{
+  uint32_t name;         /**< header of the subrecord, e.g. cEDID */
+  std::string_view data; /**< data of the subrecord, without header */
+
+  /** \brief Gets the subrecord data as string.
+   *
+   * \param localized  whether the data is an index into the string table
+   * \param table      the string table, only used if localized is true
+   * \param result     the string that will be used to store the result
+   * \return Returns true, if the string could be read.
+   *         Returns false, if an error occurred.
+   * \remarks An index of zero results in an empty string, like in
+   *          LocalizedString.
+   */
+  bool getString(const bool localized, const StringTable& table, std::string& result) const;
+
+  /** \brief Gets a value from the start of the subrecord data.
+   *
+   * \param value  the variable that will be used to store the value
+   * \return Returns true, if the data is large enough to hold the value.
+   *         Returns false otherwise.
+   */
+  template<typename T>
+  bool getValue(T& value) const
+  {
+    if (data.size() < sizeof(T))
+      return false;
+    std::memcpy(&value, data.data(), sizeof(T));
+    return true;
+  }
+}; // struct
+
+/** Reads only selected subrecords of records.
+ *
+ * A reader registers the subrecords it needs for each record type, e.g.
+ * EDID and FULL of weapons. read() then walks the subrecords of a record and
+ * skips all others, instead of decoding the whole record with its
+ * loadFromStream() method. Compressed records are decompressed first.
+ *
+ * The buffers of an instance are reused for every record. They are resized to
+ * the size of each record, so reading a record allocates memory whenever it is
+ * larger than all records read before. Smaller records do not allocate
+ * memory. Compressed records are decompressed into the buffer of the current
+ * thread, see decompressRecordData(). An instance must not be used by more
+ * than one thread at a time.
+ */
+class RecordProjection
+{
+  public:
+    /** Constructor. */
+    RecordProjection();
+
+    /** \brief Requests subrecords of a record type.
+     *
+     * \param recName     type of the record, e.g. cWEAP
+     * \param subRecords  headers of the wanted subrecords, e.g. cEDID
+     * \remarks Calling the method again for the same type adds to the
+     *          already requested subrecords.
+     */
+    void add(const uint32_t recName, const std::vector<uint32_t>& subRecords);
+
+    /** \brief Checks whether subrecords of a record type were requested.
+     *
+     * \param recName  type of the record, e.g. cWEAP
+     * \return Returns true, if add() was called for the type.
+     */
+    bool hasRecordType(const uint32_t recName) const;
+
+    /** \brief Reads the next record from the stream.
+     *
+     * \param input    the input stream, positioned directly after the name
+     *                 of the record
+     * \param recName  type of the record, e.g. cWEAP
+     * \return Returns true, if the record was read successfully.
+     *         Returns false, if an error occurred.
+     * \remarks The stream is positioned after the record, if it succeeds.
+     *          Records of types without add() are skipped.
+     */
+    bool read(std::istream& input, const uint32_t recName);
+
+    /// Gets the form ID of the last record that was read.
+    uint32_t formID() const;
+
+    /// Gets the header flags of the last record that was read.
+    uint32_t flags() const;
+
+    /** \brief Gets the requested subrecords of the last record.
+     *
+     * \return Returns the subrecords in the order they appear in the record.
+     * \remarks The data is only valid until the next call of read(). Data of
+     *          compressed records is also overwritten by any other
+     *          decompression on the same thread.
+     */
+    const std::vector<ProjectedSubRecord>& subRecords() const;
+  private:
+    /** \brief Collects the requested subrecords from record data.
+     *
+     * \param data    start of the record data
+     * \param length  length of the record data in bytes
+     * \param wanted  sorted headers of the requested subrecords
+     * \return Returns true, if the data consists of complete subrecords.
+     *         Returns false otherwise.
+     */
+    bool walk(const char* data, const uint32_t length, const std::vector<uint32_t>& wanted);
+
+    std::map<uint32_t, std::vector<uint32_t> > m_Wanted; /**< sorted subrecords by record type */
+    uint32_t m_FormID;                           /**< form ID of last record */
+    uint32_t m_Flags;                            /**< flags of last record */
+    std::vector<char> m_Data;                    /**< data of last record */
+    std::vector<ProjectedSubRecord> m_SubRecords; /**< requested subrecords of last record */
+}; // class
+
+} // namespace
+
+#endif // SR_RECORDPROJECTION_HPP
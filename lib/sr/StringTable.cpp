@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2013, 2014, 2021  Dirk Stolle
+    Copyright (C) 2011, 2013, 2014, 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,40 +19,127 @@
 */
 
 #include "StringTable.hpp"
-#include <iostream>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <iostream>
+#include <limits>
 #include <stdexcept>
-#include <vector>
-#include <cstring>
 #include "../base/UtilityFunctions.hpp"
 
 namespace SRTP
 {
 
+namespace
+{
+
+/* Determines the type of string data based on the file extension, if the
+   type is unknown. Returns false, if it cannot be determined. */
+bool determineDataType(const std::string& FileName, StringTable::DataType& stringType)
+{
+  if (stringType != StringTable::sdUnknown)
+    return true;
+
+  const std::string::size_type dotPos = FileName.rfind('.');
+  if (dotPos == std::string::npos)
+  {
+    std::cerr << "Error: Cannot determine string data type!\n";
+    return false;
+  }
+  const std::string ext = lowerCase(FileName.substr(dotPos));
+  if (ext == ".strings")
+  {
+    stringType = StringTable::sdNULterminated;
+  }
+  else if ((ext == ".dlstrings") || (ext == ".ilstrings"))
+  {
+    stringType = StringTable::sdPascalStyle;
+  }
+  else
+  {
+    std::cerr << "Error: Cannot determine string data type, unknown extension \""
+              << ext << "\"!\n";
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
 StringTable::StringTable()
-: m_Strings(std::unordered_map<uint32_t, std::string>())
+: m_Data(),
+  m_Index()
+{
+}
+
+std::vector<StringTable::IndexEntry>::const_iterator StringTable::findEntry(const uint32_t stringID) const
 {
+  const auto iter = std::lower_bound(m_Index.begin(), m_Index.end(), stringID,
+      [](const IndexEntry& entry, const uint32_t id)
+      {
+        return entry.stringID < id;
+      });
+  if ((iter != m_Index.end()) && (iter->stringID == stringID))
+    return iter;
+  return m_Index.end();
 }
 
-void StringTable::addString(const uint32_t stringID, const std::string& content)
+void StringTable::addString(const uint32_t stringID, const std::string_view content)
 {
-  if (stringID != 0)
+  if (stringID == 0)
+    return;
+  if (m_Data.size() + content.size() >= std::numeric_limits<uint32_t>::max())
+  {
+    std::cerr << "StringTable: Error: Table cannot hold more string data!\n";
+    throw std::length_error("StringTable: Error: Table cannot hold more string data!");
+  }
+
+  const IndexEntry entry{ stringID, static_cast<uint32_t>(m_Data.size()), static_cast<uint32_t>(content.size()) };
+  // The content may be a view into the table itself, so its position has to
+  // be taken before the buffer grows.
+  const char* data_begin = reinterpret_cast<const char*>(m_Data.data());
+  const bool is_own_data = !m_Data.empty() && (content.data() >= data_begin)
+                        && (content.data() < data_begin + m_Data.size());
+  if (is_own_data)
   {
-    m_Strings[stringID] = content;
+    const std::size_t source = content.data() - data_begin;
+    const std::size_t target = m_Data.size();
+    m_Data.resize(target + content.size());
+    std::memcpy(m_Data.data() + target, m_Data.data() + source, content.size());
+  }
+  else
+  {
+    m_Data.insert(m_Data.end(), content.begin(), content.end());
+  }
+  m_Data.push_back(0);
+
+  auto iter = std::lower_bound(m_Index.begin(), m_Index.end(), stringID,
+      [](const IndexEntry& e, const uint32_t id)
+      {
+        return e.stringID < id;
+      });
+  if ((iter != m_Index.end()) && (iter->stringID == stringID))
+  {
+    // The old data stays in the buffer until the table is cleared.
+    *iter = entry;
+  }
+  else
+  {
+    m_Index.insert(iter, entry);
   }
 }
 
 bool StringTable::hasString(const uint32_t stringID) const
 {
-  return m_Strings.find(stringID) != m_Strings.end();
+  return findEntry(stringID) != m_Index.end();
 }
 
-const std::string& StringTable::getString(const uint32_t stringID) const
+std::string_view StringTable::getString(const uint32_t stringID) const
 {
-  const auto iter = m_Strings.find(stringID);
-  if (iter != m_Strings.end())
+  const auto iter = findEntry(stringID);
+  if (iter != m_Index.end())
   {
-    return iter->second;
+    return std::string_view(reinterpret_cast<const char*>(m_Data.data()) + iter->offset, iter->length);
   }
   std::cerr << "StringTable: Error there is no string for ID " << stringID << "!\n";
   throw std::runtime_error("StringTable: Error there is no string for the given ID!");
@@ -60,229 +147,222 @@ const std::string& StringTable::getString(const uint32_t stringID) const
 
 bool StringTable::deleteString(const uint32_t stringID)
 {
-  return m_Strings.erase(stringID) != 0;
+  const auto iter = findEntry(stringID);
+  if (iter == m_Index.end())
+    return false;
+  m_Index.erase(iter);
+  return true;
+}
+
+void StringTable::merge(const StringTable& other)
+{
+  // Merging a table with itself changes nothing.
+  if (other.m_Index.empty() || (&other == this))
+    return;
+  if (m_Data.size() + other.m_Data.size() >= std::numeric_limits<uint32_t>::max())
+  {
+    std::cerr << "StringTable: Error: Table cannot hold more string data!\n";
+    throw std::length_error("StringTable: Error: Table cannot hold more string data!");
+  }
+
+  const uint32_t shift = static_cast<uint32_t>(m_Data.size());
+  m_Data.insert(m_Data.end(), other.m_Data.begin(), other.m_Data.end());
+
+  // Both indexes are sorted, so one pass over them is enough.
+  std::vector<IndexEntry> index;
+  index.reserve(m_Index.size() + other.m_Index.size());
+  auto mine = m_Index.cbegin();
+  auto theirs = other.m_Index.cbegin();
+  while ((mine != m_Index.cend()) || (theirs != other.m_Index.cend()))
+  {
+    if ((theirs == other.m_Index.cend())
+        || ((mine != m_Index.cend()) && (mine->stringID < theirs->stringID)))
+    {
+      index.push_back(*mine);
+      ++mine;
+      continue;
+    }
+    if ((mine != m_Index.cend()) && (mine->stringID == theirs->stringID))
+    {
+      // The string of the other table wins.
+      ++mine;
+    }
+    index.push_back(IndexEntry{ theirs->stringID, theirs->offset + shift, theirs->length });
+    ++theirs;
+  }
+  m_Index = std::move(index);
 }
 
 void StringTable::tabulaRasa()
 {
-  m_Strings.clear();
+  m_Data.clear();
+  m_Data.shrink_to_fit();
+  m_Index.clear();
+  m_Index.shrink_to_fit();
 }
 
 uint32_t StringTable::getNumberOfTableEntries() const
 {
-  return m_Strings.size();
+  return m_Index.size();
 }
 
 bool StringTable::readTable(const std::string& FileName, DataType stringType)
 {
   // Try to determine the data type via extension, if it is not given.
-  if (stringType == sdUnknown)
+  if (!determineDataType(FileName, stringType))
   {
-    const std::string::size_type dotPos = FileName.rfind('.');
-    if (dotPos == std::string::npos)
-    {
-      std::cerr << "Error: Cannot determine string data type!\n";
-      return false;
-    }
-    const std::string ext = lowerCase(FileName.substr(dotPos));
-    if (ext == ".strings")
-    {
-      stringType = sdNULterminated;
-    }
-    else if ((ext == ".dlstrings") || (ext == ".ilstrings"))
-    {
-      stringType = sdPascalStyle;
-    }
-    else
-    {
-      std::cerr << "Error: Cannot determine string data type, unknown extension \""
-                << ext << "\"!\n";
-      return false;
-    }
+    return false;
   }
 
   std::ifstream input;
-  input.open(FileName, std::ios::in | std::ios::binary);
+  input.open(FileName, std::ios::in | std::ios::binary | std::ios::ate);
   if (!input)
   {
     std::cerr << "StringTable: Error: could not open file \"" << FileName
               << "\".\n";
     return false;
   }
+  const std::streamoff fileSize = input.tellg();
+  if ((fileSize < 0) || (static_cast<uint64_t>(fileSize) >= std::numeric_limits<uint32_t>::max()))
+  {
+    std::cerr << "StringTable: Error: File \"" << FileName << "\" is too large!\n";
+    return false;
+  }
 
-  uint32_t count = 0;
-  uint32_t dataSize = 0;
-
-  // read number of entries
-  input.read((char*) &count, 4);
-  // read data size
-  input.read((char*)&dataSize, 4);
+  // Read the whole file at once.
+  std::vector<uint8_t> buffer(static_cast<std::size_t>(fileSize));
+  input.seekg(0, std::ios_base::beg);
+  input.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
   if (!input.good())
   {
-    std::cerr << "StringTable: Error while reading header!\n";
-    input.close();
+    std::cerr << "StringTable: Error while reading file \"" << FileName << "\"!\n";
     return false;
   }
+  input.close();
 
-  //read directory entries
-  std::vector<DirectoryEntry> theDirectory;
-  DirectoryEntry temp;
-  for (uint32_t i = 0; i < count; ++i)
+  return readTable(std::move(buffer), stringType);
+}
+
+bool StringTable::readTable(std::vector<uint8_t>&& data, const DataType stringType)
+{
+  if (stringType == sdUnknown)
   {
-    input.read(reinterpret_cast<char*>(&(temp.stringID)), 4);
-    input.read(reinterpret_cast<char*>(&(temp.offset)), 4);
-    if (!input.good())
-    {
-      std::cerr << "StringTable: Error while reading directory!\n";
-      input.close();
-      return false;
-    }
-    theDirectory.emplace_back(temp);
+    std::cerr << "StringTable::readTable: Error: Type of string data must be "
+              << "known when reading from memory!\n";
+    return false;
   }
 
-  const std::ifstream::pos_type offsetBase = input.tellg();
+  if (m_Index.empty())
+  {
+    return loadFromBuffer(std::move(data), stringType);
+  }
+
+  // Merge into the existing strings.
+  StringTable other;
+  if (!other.loadFromBuffer(std::move(data), stringType))
+  {
+    return false;
+  }
+  merge(other);
+  return true;
+}
 
-  uint8_t * ptrSpace = nullptr;
-  uint32_t allocatedSpace = 0;
-  uint32_t length = 0;
+bool StringTable::loadFromBuffer(std::vector<uint8_t>&& buffer, const DataType stringType)
+{
+  const std::size_t size = buffer.size();
+  if (size < 8)
+  {
+    std::cerr << "StringTable: Error while reading header!\n";
+    return false;
+  }
+  uint32_t count = 0;
+  std::memcpy(&count, buffer.data(), 4);
+  // data size (bytes 4 to 7) is not needed, the data block is just the rest
+  // of the file
 
-  if (stringType == sdNULterminated)
+  const uint64_t dataStart = 8 + static_cast<uint64_t>(count) * 8;
+  if (dataStart > size)
   {
-    // pre-allocate memory
-    ptrSpace = new uint8_t[65537];
-    allocatedSpace = 65537;
+    std::cerr << "StringTable: Error while reading directory!\n";
+    return false;
   }
 
+  std::vector<IndexEntry> index;
+  index.reserve(count);
   for (uint32_t i = 0; i < count; ++i)
   {
-    input.seekg(offsetBase + static_cast<std::ifstream::pos_type>(theDirectory[i].offset), std::ios_base::beg);
-    if (!input.good())
+    uint32_t stringID = 0;
+    uint32_t offset = 0;
+    std::memcpy(&stringID, buffer.data() + 8 + i * 8, 4);
+    std::memcpy(&offset, buffer.data() + 12 + i * 8, 4);
+    uint64_t position = dataStart + offset;
+    if (position >= size)
     {
       std::cerr << "StringTable::readTable: Error: could not jump to given offset!\n";
-      delete[] ptrSpace;
-      input.close();
       return false;
     }
+    std::size_t maxLength = size - position;
     if (stringType == sdPascalStyle)
     {
-      // read strings, Pascal style
-      // ---- read length
-      input.read(reinterpret_cast<char*>(&length), 4);
-      if (length > 65536)
+      // Pascal style: length (including NUL) is given before the string.
+      uint32_t length = 0;
+      if (maxLength < 4)
       {
-        std::cerr << "Error: length (" << length << ") is greater than 65536!\n";
-        delete[] ptrSpace;
-        input.close();
+        std::cerr << "StringTable::readTable: Error while reading string!\n";
         return false;
       }
-      // Do we need to allocate more space?
-      if (length >= allocatedSpace)
-      {
-        delete[] ptrSpace;
-        ptrSpace = new uint8_t[length + 1];
-        allocatedSpace = length + 1;
-      }
-      // read whole string into buffer
-      memset(ptrSpace, 0, length + 1);
-      input.read(reinterpret_cast<char*>(ptrSpace), length);
-      if (!input.good())
+      std::memcpy(&length, buffer.data() + position, 4);
+      position += 4;
+      maxLength -= 4;
+      if (length > maxLength)
       {
         std::cerr << "StringTable::readTable: Error while reading string!\n";
-        input.close();
-        delete[] ptrSpace;
         return false;
       }
+      maxLength = length;
     }
-    else
+    // Strings end at the first NUL character, in both styles.
+    const uint8_t* start = buffer.data() + position;
+    const void* nul = std::memchr(start, 0, maxLength);
+    if ((nul == nullptr) && (stringType == sdNULterminated))
     {
-      // read NUL-terminated string data
-      length = 0;
-      do
-      {
-        // read next character
-        input.read(reinterpret_cast<char*>(&(ptrSpace[length])), 1);
-        ++length;
-      } while ((ptrSpace[length - 1] != '\0') && (length < allocatedSpace));
-      if (length + 1 == allocatedSpace)
-      {
-        ptrSpace[length] = '\0';
-        std::cerr << "Error: String was cut off after reaching allocation limit!\n";
-        delete[] ptrSpace;
-        return false;
-      }
+      std::cerr << "StringTable::readTable: Error: String is not terminated!\n";
+      return false;
     }
-    // put it into the table
-    m_Strings[theDirectory[i].stringID] = std::string(reinterpret_cast<const char*>(ptrSpace));
+    const std::size_t length = (nul == nullptr) ? maxLength : static_cast<const uint8_t*>(nul) - start;
+    index.push_back(IndexEntry{ stringID, static_cast<uint32_t>(position), static_cast<uint32_t>(length) });
   }
 
-  delete[] ptrSpace;
-  allocatedSpace = 0;
-  input.close();
+  // Sort by ID. If an ID occurs more than once, then the last one wins, just
+  // like it would when the strings are added one by one.
+  std::stable_sort(index.begin(), index.end(),
+      [](const IndexEntry& a, const IndexEntry& b)
+      {
+        return a.stringID < b.stringID;
+      });
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < index.size(); ++i)
+  {
+    if ((i + 1 < index.size()) && (index[i + 1].stringID == index[i].stringID))
+      continue;
+    index[kept] = index[i];
+    ++kept;
+  }
+  index.resize(kept);
+
+  m_Data = std::move(buffer);
+  m_Index = std::move(index);
   return true;
 }
 
 bool StringTable::writeTable(const std::string& FileName, DataType stringType) const
 {
   // try to determine the data type via extension, if it is not given
-  if (stringType == sdUnknown)
+  if (!determineDataType(FileName, stringType))
   {
-    const std::string::size_type dotPos = FileName.rfind('.');
-    if (dotPos == std::string::npos)
-    {
-      std::cerr << "Error: Cannot determine string data type!\n";
-      return false;
-    }
-    const std::string ext = lowerCase(FileName.substr(dotPos));
-    if (ext == ".strings")
-    {
-      stringType = sdNULterminated;
-    }
-    else if ((ext == ".dlstrings") || (ext == ".ilstrings"))
-    {
-      stringType = sdPascalStyle;
-    }
-    else
-    {
-      std::cerr << "Error: Cannot determine string data type, unknown extension \""
-                << ext << "\"!\n";
-      return false;
-    }
-  }
-
-  // prepare directory entries
-  std::vector<DirectoryEntry> theDirectory;
-  DirectoryEntry temp;
-  uint32_t nextAvailableOffset = 0;
-
-  for (const auto& [key, value]: m_Strings)
-  {
-    temp.stringID = key;
-    temp.offset = nextAvailableOffset;
-    // strings are NUL-terminated, even in "Pascal" style, so we add +1 at the end
-    nextAvailableOffset = nextAvailableOffset + value.length() + 1;
-    // add extra four bytes for length in "Pascal" style
-    if (sdPascalStyle == stringType)
-    {
-      nextAvailableOffset += 4;
-    }
-    theDirectory.emplace_back(temp);
-  }
-
-  // prepare values for count and data size
-  const uint32_t count = theDirectory.size();
-  uint32_t dataSize = 0;
-
-  // ---- data size is offset of last string plus length for that entry
-  if (!theDirectory.empty())
-  {
-    dataSize = theDirectory.back().offset + m_Strings.find(theDirectory.back().stringID)->second.length() + 1;
-    if (sdPascalStyle == stringType)
-    {
-      dataSize += 4;
-    }
+    return false;
   }
 
-  // now write the file
   std::ofstream output;
   output.open(FileName, std::ios::out | std::ios::binary | std::ios::trunc);
   if (!output)
@@ -291,6 +371,30 @@ bool StringTable::writeTable(const std::string& FileName, DataType stringType) c
               << FileName << "\".\n";
     return false;
   }
+  const bool success = writeTable(output, stringType);
+  output.close();
+  return success;
+}
+
+bool StringTable::writeTable(std::ostream& output, const DataType stringType) const
+{
+  if (stringType == sdUnknown)
+  {
+    std::cerr << "StringTable::writeTable: Error: Type of string data must be "
+              << "known when writing to a stream!\n";
+    return false;
+  }
+
+  // prepare values for count and data size
+  const uint32_t count = m_Index.size();
+  // strings are NUL-terminated, even in "Pascal" style, so we add +1 at the end
+  // and extra four bytes for length in "Pascal" style
+  const uint32_t extraBytes = (sdPascalStyle == stringType) ? 5 : 1;
+  uint32_t dataSize = 0;
+  for (const auto& entry: m_Index)
+  {
+    dataSize += entry.length + extraBytes;
+  }
 
   // write number of entries
   output.write(reinterpret_cast<const char*>(&count), 4);
@@ -299,45 +403,42 @@ bool StringTable::writeTable(const std::string& FileName, DataType stringType) c
   if (!output.good())
   {
     std::cerr << "StringTable::writeTable: Error while writing header!\n";
-    output.close();
     return false;
   }
 
   // write directory entries
-  for (const auto& entry: theDirectory)
+  uint32_t nextAvailableOffset = 0;
+  for (const auto& entry: m_Index)
   {
     output.write(reinterpret_cast<const char*>(&(entry.stringID)), 4);
-    output.write(reinterpret_cast<const char*>(&(entry.offset)), 4);
+    output.write(reinterpret_cast<const char*>(&nextAvailableOffset), 4);
     if (!output.good())
     {
       std::cerr << "StringTable::writeTable: Error while writing directory entries!\n";
-      output.close();
       return false;
     }
+    nextAvailableOffset += entry.length + extraBytes;
   }
 
   // write the data entries
-  uint32_t i;
-  for (const auto& key_value: m_Strings)
+  for (const auto& entry: m_Index)
   {
-    // store length in i
-    i = key_value.second.length() + 1;
     if (sdPascalStyle == stringType)
     {
-      // write length
-      output.write(reinterpret_cast<const char*>(&i), 4);
+      // write length, including the NUL character
+      const uint32_t length = entry.length + 1;
+      output.write(reinterpret_cast<const char*>(&length), 4);
     }
-    // write string
-    output.write(key_value.second.c_str(), i);
+    // write string and its NUL terminator
+    output.write(reinterpret_cast<const char*>(m_Data.data()) + entry.offset, entry.length);
+    output.put('\0');
     if (!output.good())
     {
       std::cerr << "StringTable::writeTable: Error while writing string data!\n";
-      output.close();
       return false;
     }
   }
 
-  output.close();
   return true;
 }
 
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2021 Thoronador
+    Copyright (C) 2011, 2021, 2026 Thoronador
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -22,13 +22,20 @@
 #define SR_STRINGTABLE_HPP
 
 #include <cstdint>
-#include <unordered_map>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace SRTP
 {
 
-/** Holds string data for an ESM / ESP file. */
+/** Holds string data for an ESM / ESP file.
+ *
+ * All strings are kept in one contiguous buffer, and a vector sorted by the
+ * string IDs points into that buffer. Reading a table file therefore needs
+ * just one read of the file and one allocation for the string data.
+ */
 class StringTable
 {
   public:
@@ -46,7 +53,7 @@ class StringTable
      * \param stringID  the ID of the string
      * \param content   the (new) content of the string
      */
-    void addString(const uint32_t stringID, const std::string& content);
+    void addString(const uint32_t stringID, const std::string_view content);
 
     /** \brief Checks whether the table contains a string with the given ID.
      *
@@ -63,8 +70,11 @@ class StringTable
      * \return Returns the string for a given ID, if it exists.
      * \throws If no string with the ID is present, the function will throw an
      *         exception.
+     * \remarks The returned view points into the table's data. It stays valid
+     *          until the table is changed by addString(), readTable() or
+     *          tabulaRasa(), or until the table is destroyed.
      */
-    const std::string& getString(const uint32_t stringID) const;
+    std::string_view getString(const uint32_t stringID) const;
 
     /** \brief Tries to remove the string with the given ID from the table.
      *
@@ -73,10 +83,24 @@ class StringTable
      */
     bool deleteString(const uint32_t stringID);
 
+    /** \brief Adds all strings of another table to this table.
+     *
+     * Strings of the other table replace strings with the same ID that are
+     * already in this table.
+     *
+     * \param other  the other table
+     * \remarks Unlike adding the strings one by one via addString(), this
+     *          needs linear time, so it is the way to combine large tables.
+     */
+    void merge(const StringTable& other);
+
     /** \brief Removes all entries from the string table. */
     void tabulaRasa();
 
     /** \brief Tries to read a string table from the given file.
+     *
+     * Strings of the file replace strings with the same ID that are already
+     * in the table.
      *
      * \param FileName  name of the file containing the string table
      * \param stringType  expected type of string data in table
@@ -86,6 +110,19 @@ class StringTable
      */
     bool readTable(const std::string& FileName, DataType stringType);
 
+    /** \brief Tries to read a string table from data in memory.
+     *
+     * Strings of the data replace strings with the same ID that are already
+     * in the table.
+     *
+     * \param data        complete content of a string table file, e.g. as it
+     *                    was extracted from an archive
+     * \param stringType  type of string data in table, must not be sdUnknown
+     * \return Returns true in case of success, false on failure.
+     * \remarks If the table is empty, it takes over the data without copying.
+     */
+    bool readTable(std::vector<uint8_t>&& data, const DataType stringType);
+
     /** \brief Tries to write a string table to a file.
      *
      * \param FileName  name of the output file for the string table
@@ -94,16 +131,45 @@ class StringTable
      */
     bool writeTable(const std::string& FileName, DataType stringType) const;
 
+    /** \brief Tries to write a string table to a stream.
+     *
+     * \param output      the output stream
+     * \param stringType  desired type of string data in table, must not be
+     *                    sdUnknown
+     * \return Returns true in case of success, false on failure.
+     */
+    bool writeTable(std::ostream& output, const DataType stringType) const;
+
     /** \brief Returns the number of strings in the table. */
     uint32_t getNumberOfTableEntries() const;
   private:
-    struct DirectoryEntry
+    /** Location of a string in the data buffer. */
+    struct IndexEntry
     {
-      uint32_t stringID;
-      uint32_t offset;
+      uint32_t stringID; /**< ID of the string */
+      uint32_t offset;   /**< offset of the first character in m_Data */
+      uint32_t length;   /**< length of the string, without terminating NUL */
     }; // struct
 
-    std::unordered_map<uint32_t, std::string> m_Strings; /**< holds the string */
+    /** \brief Finds the index entry of the given string ID.
+     *
+     * \param stringID  the ID of the string
+     * \return Returns an iterator to the entry, if it exists. Returns the end
+     *         iterator of m_Index otherwise.
+     */
+    std::vector<IndexEntry>::const_iterator findEntry(const uint32_t stringID) const;
+
+    /** \brief Sets the table's data to the content of a string table file.
+     *
+     * \param buffer      complete content of the file
+     * \param stringType  type of string data in table, must not be sdUnknown
+     * \return Returns true in case of success, false on failure.
+     * \remarks In case of failure, the table is left unchanged.
+     */
+    bool loadFromBuffer(std::vector<uint8_t>&& buffer, const DataType stringType);
+
+    std::vector<uint8_t> m_Data; /**< holds the string data */
+    std::vector<IndexEntry> m_Index; /**< locations of the strings, sorted by ID */
 }; // class
 
 } // namespace
@@ -0,0 +1,311 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "StringTableCache.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "../base/DirectoryFunctions.hpp" // for path delimiter
+#include "../base/FileFunctions.hpp"      // for splitPathFileExtension(), temporaryFileName()
+#include "TableUtilities.hpp"
+
+namespace SRTP
+{
+
+namespace
+{
+
+/// magic bytes at the start of every cache file ("STRC")
+const uint32_t cCacheMagic = 0x43525453;
+
+/// version of the cache file format, increase when the format changes
+const uint32_t cCacheVersion = 1;
+
+/// FNV-1a, because std::hash may differ between implementations
+class Fingerprint
+{
+  public:
+    Fingerprint()
+    : m_Hash(0xCBF29CE484222325)
+    {
+    }
+
+    void add(const void* data, const std::size_t size)
+    {
+      const uint8_t* bytes = static_cast<const uint8_t*>(data);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        m_Hash ^= bytes[i];
+        m_Hash *= 0x100000001B3;
+      }
+    }
+
+    uint64_t value() const
+    {
+      return m_Hash;
+    }
+  private:
+    uint64_t m_Hash;
+}; // class
+
+/* Gets the files that the string tables of a plugin are read from, i.e.
+   either the loose string table files or the BSA. */
+std::vector<std::string> tableSources(const std::string& esmFileName, bool& inBSA)
+{
+  std::vector<std::string> files;
+  inBSA = getAssociatedTableFiles(esmFileName, files) != 0;
+  if (inBSA)
+  {
+    files.clear();
+    std::string part_path, part_name, part_ext;
+    splitPathFileExtension(esmFileName, MWTP::pathDelimiter, part_path, part_name, part_ext);
+    files.push_back(part_path + getBsaName(part_name));
+  }
+  return files;
+}
+
+/* Does the same as loadStringTables(), but with already known sources. */
+bool readTables(const std::string& esmFileName, const std::vector<std::string>& sources, const bool inBSA, const std::optional<Localization>& l10n, StringTable& table)
+{
+  if (inBSA)
+    return loadStringTablesFromBSA(esmFileName, table, l10n);
+  if (!loadStringTableFiles(sources, table))
+  {
+    std::cerr << "Error while reading string tables for " << esmFileName << "!\n";
+    return false;
+  }
+  return true;
+}
+
+/* Gets a fingerprint of the plugin and of the sources of its string tables.
+   Returns an empty optional, if one of the files cannot be inspected. */
+std::optional<uint64_t> fingerprintOfFiles(const std::string& esmFileName, const std::vector<std::string>& sources)
+{
+  Fingerprint fingerprint;
+  for (std::size_t i = 0; i <= sources.size(); ++i)
+  {
+    const std::string& file = (i == 0) ? esmFileName : sources[i - 1];
+    std::error_code error;
+    const uint64_t size = std::filesystem::file_size(file, error);
+    if (error)
+      return std::nullopt;
+    const int64_t modified = static_cast<int64_t>(std::filesystem::last_write_time(file, error).time_since_epoch().count());
+    if (error)
+      return std::nullopt;
+    fingerprint.add(file.data(), file.size() + 1);
+    fingerprint.add(&size, sizeof(size));
+    fingerprint.add(&modified, sizeof(modified));
+  }
+  return fingerprint.value();
+}
+
+std::string cacheFileName(const std::string& esmFileName, const std::string& key)
+{
+  Fingerprint fingerprint;
+  fingerprint.add(key.data(), key.size());
+  std::ostringstream name;
+  name << std::filesystem::path(esmFileName).filename().string() << '.'
+       << std::hex << fingerprint.value() << ".strcache";
+  return name.str();
+}
+
+template<typename T>
+void writeValue(std::ostream& output, const T& value)
+{
+  output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool readValue(std::istream& input, T& value)
+{
+  input.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return input.good();
+}
+
+} // namespace
+
+StringTableCache::StringTableCache()
+: m_Mutex(),
+  m_Directory(std::filesystem::path()),
+  m_Tables(std::map<std::string, Entry>())
+{
+}
+
+StringTableCache& StringTableCache::get()
+{
+  static StringTableCache Instance;
+  return Instance;
+}
+
+void StringTableCache::setDirectory(const std::filesystem::path& directory)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Directory = directory;
+}
+
+std::shared_ptr<const StringTable> StringTableCache::load(const std::string& esmFileName, const std::optional<Localization>& l10n)
+{
+  bool inBSA = false;
+  const auto sources = tableSources(esmFileName, inBSA);
+  const auto stamp = fingerprintOfFiles(esmFileName, sources);
+  if (!stamp.has_value())
+  {
+    // Files are missing, so there is nothing to cache. Loading will report
+    // the details.
+    auto table = std::make_shared<StringTable>();
+    if (!readTables(esmFileName, sources, inBSA, l10n, *table))
+      return nullptr;
+    return table;
+  }
+
+  const std::string key = esmFileName + '\n'
+      + (l10n.has_value() ? stringTableSuffix(l10n.value()) : "default");
+  std::filesystem::path directory;
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    const auto iter = m_Tables.find(key);
+    if ((iter != m_Tables.end()) && (iter->second.stamp == stamp.value()))
+      return iter->second.table;
+    directory = m_Directory;
+  }
+
+  // The lock is not held while the tables are loaded, so that tables of
+  // different plugins can be loaded at the same time.
+  std::shared_ptr<StringTable> table;
+  std::filesystem::path cacheFile;
+  if (!directory.empty())
+  {
+    cacheFile = directory / cacheFileName(esmFileName, key);
+    table = loadFromDisk(cacheFile, key, stamp.value());
+  }
+  if (table == nullptr)
+  {
+    table = std::make_shared<StringTable>();
+    if (!readTables(esmFileName, sources, inBSA, l10n, *table))
+      return nullptr;
+    if (!cacheFile.empty() && !saveToDisk(cacheFile, key, stamp.value(), *table))
+    {
+      std::cerr << "Warning: Could not store string tables of " << esmFileName
+                << " in the cache.\n";
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  Entry& entry = m_Tables[key];
+  if ((entry.table != nullptr) && (entry.stamp == stamp.value()))
+  {
+    // Another thread loaded the same tables in the meantime.
+    return entry.table;
+  }
+  entry = Entry{ stamp.value(), table };
+  return table;
+}
+
+std::size_t StringTableCache::size() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Tables.size();
+}
+
+void StringTableCache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Tables.clear();
+}
+
+std::shared_ptr<StringTable> StringTableCache::loadFromDisk(const std::filesystem::path& fileName, const std::string& key, const uint64_t stamp)
+{
+  std::ifstream input(fileName, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+  if (!input.good())
+    return nullptr;
+  const std::streamoff fileSize = input.tellg();
+  input.seekg(0, std::ios_base::beg);
+
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  if (!readValue(input, magic) || (magic != cCacheMagic)
+      || !readValue(input, version) || (version != cCacheVersion))
+  {
+    // Cache of another version, it will just be replaced.
+    return nullptr;
+  }
+  uint32_t keyLength = 0;
+  if (!readValue(input, keyLength) || (keyLength != key.size()))
+    return nullptr;
+  std::string fileKey(keyLength, '\0');
+  input.read(fileKey.data(), keyLength);
+  uint64_t fileStamp = 0;
+  if (!input.good() || (fileKey != key) || !readValue(input, fileStamp)
+      || (fileStamp != stamp))
+  {
+    return nullptr;
+  }
+
+  std::vector<uint8_t> data(static_cast<std::size_t>(fileSize - input.tellg()));
+  input.read(reinterpret_cast<char*>(data.data()), data.size());
+  auto table = std::make_shared<StringTable>();
+  if (!input.good() || !table->readTable(std::move(data), StringTable::sdNULterminated))
+  {
+    std::cerr << "StringTableCache: Warning: Cache file " << fileName.string()
+              << " is corrupt.\n";
+    return nullptr;
+  }
+  return table;
+}
+
+bool StringTableCache::saveToDisk(const std::filesystem::path& fileName, const std::string& key, const uint64_t stamp, const StringTable& table)
+{
+  const std::filesystem::path tempName = temporaryFileName(fileName.string());
+  std::ofstream output(tempName, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!output.good())
+  {
+    std::cerr << "StringTableCache: Error: Could not create file "
+              << tempName.string() << "!\n";
+    return false;
+  }
+  writeValue(output, cCacheMagic);
+  writeValue(output, cCacheVersion);
+  writeValue(output, static_cast<uint32_t>(key.size()));
+  output.write(key.data(), key.size());
+  writeValue(output, stamp);
+  const bool written = table.writeTable(output, StringTable::sdNULterminated);
+  output.close();
+  std::error_code error;
+  if (!written || !output.good())
+  {
+    std::cerr << "StringTableCache: Error while writing file "
+              << tempName.string() << "!\n";
+    std::filesystem::remove(tempName, error);
+    return false;
+  }
+
+  std::filesystem::rename(tempName, fileName, error);
+  if (error)
+  {
+    std::cerr << "StringTableCache: Error: Could not rename "
+              << tempName.string() << " to " << fileName.string() << "!\n";
+    std::filesystem::remove(tempName, error);
+    return false;
+  }
+  return true;
+}
+
+} // namespace
@@ -0,0 +1,130 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SR_STRINGTABLECACHE_HPP
+#define SR_STRINGTABLECACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include "Localization.hpp"
+#include "StringTable.hpp"
+
+namespace SRTP
+{
+
+/** Singleton that keeps the string tables of localized plugins, so that
+ *  each table is only read once per process.
+ *
+ * Tables are identified by the path of the plugin and the language. An entry
+ * is only used while the plugin and the files that the tables come from (the
+ * loose string table files or the BSA archive) have the same size and time of
+ * last modification as when the entry was created.
+ *
+ * If a cache directory is set, tables are also stored in that directory in a
+ * compact form, so that later runs of a program do not have to parse the
+ * original files again.
+ *
+ * All methods are thread-safe. The returned tables are shared and must not be
+ * changed.
+ */
+class StringTableCache
+{
+  public:
+    /** \brief Provides access to the singleton instance.
+     *
+     * \return Returns a reference to the singleton instance.
+     */
+    static StringTableCache& get();
+
+    /** \brief Sets the directory where tables are stored between runs.
+     *
+     * \param directory  the cache directory, an empty path disables storing
+     *                   tables on disk (default)
+     * \remarks The directory has to exist already.
+     */
+    void setDirectory(const std::filesystem::path& directory);
+
+    /** \brief Gets the string tables for an ESM / ESP file, loading them if
+     *         they are not in the cache yet.
+     *
+     * \param esmFileName  path of the master / plugin file
+     * \param l10n         the preferred localization, if any
+     * \return Returns the tables in case of success.
+     *         Returns nullptr in case of failure.
+     */
+    std::shared_ptr<const StringTable> load(const std::string& esmFileName, const std::optional<Localization>& l10n);
+
+    /** Gets the number of tables in the cache. */
+    std::size_t size() const;
+
+    /** Removes all tables from the cache. The cache directory is kept. */
+    void clear();
+  private:
+    /** Constructor. */
+    StringTableCache();
+
+    /** Deleted copy constructor. */
+    StringTableCache(const StringTableCache& op) = delete;
+
+    /** Deleted move constructor. */
+    StringTableCache(StringTableCache&& op) = delete;
+
+    /// a loaded table and the state of its files when it was loaded
+    struct Entry
+    {
+      uint64_t stamp;                           /**< fingerprint of the files */
+      std::shared_ptr<const StringTable> table; /**< the string tables */
+    };
+
+    /** \brief Tries to read tables from the cache directory.
+     *
+     * \param fileName  path of the cache file
+     * \param key       key of the tables
+     * \param stamp     expected fingerprint of the files
+     * \return Returns the tables, if the file exists and matches the key and
+     *         the fingerprint. Returns nullptr otherwise.
+     */
+    static std::shared_ptr<StringTable> loadFromDisk(const std::filesystem::path& fileName, const std::string& key, const uint64_t stamp);
+
+    /** \brief Writes tables to the cache directory.
+     *
+     * \param fileName  path of the cache file
+     * \param key       key of the tables
+     * \param stamp     fingerprint of the files
+     * \param table     the tables to store
+     * \return Returns true in case of success, false on failure.
+     * \remarks The file is written under a unique temporary name first and
+     *          then renamed, so concurrent processes never mix their output.
+     */
+    static bool saveToDisk(const std::filesystem::path& fileName, const std::string& key, const uint64_t stamp, const StringTable& table);
+
+    mutable std::mutex m_Mutex;            /**< protects the members below */
+    std::filesystem::path m_Directory;     /**< cache directory, may be empty */
+    std::map<std::string, Entry> m_Tables; /**< tables by plugin and language */
+}; // class
+
+} // namespace
+
+#endif // SR_STRINGTABLECACHE_HPP
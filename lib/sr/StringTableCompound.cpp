@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2013, 2014  Thoronador
+    Copyright (C) 2011, 2013, 2014, 2026  Thoronador
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -39,7 +39,7 @@ StringTableCompound::~StringTableCompound()
   m_strings.tabulaRasa();
 }
 
-void StringTableCompound::addString(const uint32_t stringID, const std::string& content, const TableType tt)
+void StringTableCompound::addString(const uint32_t stringID, const std::string_view content, const TableType tt)
 {
   switch (tt)
   {
@@ -71,7 +71,7 @@ StringTableCompound::TableType StringTableCompound::locateString(const uint32_t
   return ttNone;
 }
 
-const std::string& StringTableCompound::getString(const uint32_t stringID) const
+std::string_view StringTableCompound::getString(const uint32_t stringID) const
 {
   const TableType location = locateString(stringID);
   switch (location)
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011 Thoronador
+    Copyright (C) 2011, 2026 Thoronador
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -47,7 +47,7 @@ class StringTableCompound
            content  - the (new) content of the string
            tt       - the table that shall hold the new string
     */
-    void addString(const uint32_t stringID, const std::string& content, const TableType tt);
+    void addString(const uint32_t stringID, const std::string_view content, const TableType tt);
 
     /* returns true, if the one of the tables contains a string with the given
        ID
@@ -67,12 +67,13 @@ class StringTableCompound
 
     /* returns the string for a given ID. If no string with that ID is present,
        the function will throw an exception. Use hasString() to check the
-       presence of a string first.
+       presence of a string first. The returned view stays valid until the
+       table that holds the string is changed.
 
        parameters:
            stringID - the ID of the string
     */
-    const std::string& getString(const uint32_t stringID) const;
+    std::string_view getString(const uint32_t stringID) const;
 
     /* returns a reference to the specified string table. If the type is ttNone,
        the function will throw an exception.
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2012, 2013, 2015, 2021  Dirk Stolle
+    Copyright (C) 2012, 2013, 2015, 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,23 +19,63 @@
 */
 
 #include "TableUtilities.hpp"
-#include <cstdlib>
-#include <filesystem>
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <set>
+#include <thread>
 #include "../base/DirectoryFunctions.hpp" // for path delimiter
 #include "../base/FileFunctions.hpp"      // for getDirectoryFileList()
-#include "../base/RandomFunctions.hpp"    // for randomAlphaNumericSequence()
 #include "../base/UtilityFunctions.hpp"   // for lowerCase()
 #include "bsa/BSA.hpp"
 #include "ReturnCodes.hpp"
-#if defined(_WIN32) || defined(_WIN64)
-#include <shlobj.h>  // for SHGetKnownFolderPath()
-#endif
 
 namespace SRTP
 {
 
+namespace
+{
+
+/* Loads several parts of a string table at the same time, each one in its own
+   thread, and merges them into table in the order of their indexes. The table
+   is left unchanged, if loading one of the parts fails. */
+bool loadParts(const std::size_t count, const std::function<bool(const std::size_t, StringTable&)>& load, StringTable& table)
+{
+  if (count == 0)
+    return true;
+  std::vector<StringTable> parts(count);
+  // not std::vector<bool>, because threads write to different elements
+  std::vector<uint8_t> results(count, 0);
+  std::vector<std::thread> threads;
+  threads.reserve(count - 1);
+  for (std::size_t idx = 1; idx < count; ++idx)
+  {
+    threads.emplace_back([&load, &parts, &results, idx]()
+    {
+      results[idx] = load(idx, parts[idx]) ? 1 : 0;
+    });
+  }
+  // The current thread loads the first part.
+  results[0] = load(0, parts[0]) ? 1 : 0;
+  for (auto& thread: threads)
+  {
+    thread.join();
+  }
+
+  if (std::find(results.begin(), results.end(), 0) != results.end())
+    return false;
+  for (auto& part: parts)
+  {
+    if (table.getNumberOfTableEntries() == 0)
+      table = std::move(part);
+    else
+      table.merge(part);
+  }
+  return true;
+}
+
+} // namespace
+
 int getLanguageComponent(const std::string& dataDir, const std::string& pluginName, std::string& languageComponent, std::vector<std::string>& stringTableFiles)
 {
   const std::string lcPluginName = lowerCase(pluginName);
@@ -121,18 +161,23 @@ bool loadStringTables(const std::string& esmFileName, StringTable& table, const
   {
     return loadStringTablesFromBSA(esmFileName, table, l10n);
   }
-  for (const auto& fileName: files)
+  if (!loadStringTableFiles(files, table))
   {
-    if (!table.readTable(fileName, StringTable::sdUnknown))
-    {
-      std::cerr << "Error while reading string tables for " << esmFileName << "!\n";
-      return false;
-    }
+    std::cerr << "Error while reading string tables for " << esmFileName << "!\n";
+    return false;
   }
 
   return true;
 }
 
+bool loadStringTableFiles(const std::vector<std::string>& files, StringTable& table)
+{
+  return loadParts(files.size(), [&files](const std::size_t idx, StringTable& part)
+  {
+    return part.readTable(files[idx], StringTable::sdUnknown);
+  }, table);
+}
+
 std::string getBsaName(const std::string& esmFileNamePart)
 {
   const auto lcNamePart = lowerCase(esmFileNamePart);
@@ -144,59 +189,6 @@ std::string getBsaName(const std::string& esmFileNamePart)
   return esmFileNamePart + ".bsa";
 }
 
-std::filesystem::path getTemporaryDirectory()
-{
-  namespace fs = std::filesystem;
-
-  std::error_code error;
-  auto tempPath = fs::temp_directory_path(error);
-  if (!error)
-    return tempPath;
-  #if defined(_WIN32) || defined(_WIN64)
-  // Get it from WinAPI.
-  TCHAR path[MAX_PATH];
-  const auto result = SHGetFolderPath(NULL, CSIDL_LOCAL_APPDATA | CSIDL_FLAG_CREATE,
-                                      NULL, SHGFP_TYPE_CURRENT, path);
-  if (result == S_OK)
-  {
-    tempPath = path;
-    tempPath /= "Temp";
-    if (fs::exists(tempPath, error) && !error
-      && fs::is_directory(tempPath, error) && !error)
-        return tempPath;
-  }
-  #else
-  // The /tmp directory basically exists on every major Linux distribution.
-  tempPath = "/tmp";
-  if (fs::exists(tempPath, error) && !error
-    && fs::is_directory(tempPath, error) && !error)
-      return tempPath;
-  #endif
-  // Try some common environment variables as last resort.
-  const auto vars = {
-      "TMP",
-      "TEMP",
-      #if defined(_WIN32) || defined(_WIN64)
-      "LOCALAPPDATA"
-      #else
-      "TMPDIR"
-      #endif
-  };
-  for (const auto& var: vars)
-  {
-    const char * envVar = std::getenv(var);
-    if (envVar != nullptr)
-    {
-      tempPath = envVar;
-      if (fs::exists(tempPath, error) && !error
-          && fs::is_directory(tempPath, error) && !error)
-          return tempPath;
-    }
-  }
-  // No success. Return empty path.
-  return fs::path();
-}
-
 bool loadStringTablesFromBSA(const std::string& esmFileName, StringTable& table, const std::optional<Localization>& l10n)
 {
   std::string part_path, part_name, part_ext;
@@ -208,36 +200,26 @@ bool loadStringTablesFromBSA(const std::string& esmFileName, StringTable& table,
     return false;
   part_name = lowerCase(part_name);
 
-  const auto tempPath = getTemporaryDirectory();
-  if (tempPath.empty())
-  {
-    std::cerr << "Error: Could not determine temporary directory for extraction"
-              << " of language files from BSA!\n";
-    return false;
-  }
   const std::string language = stringTableSuffix(l10n.value_or(Localization::German));
-  const auto prefix = "a" + MWTP::randomAlphaNumericSequence(7);
+  const std::string extensions[] = { ".strings", ".dlstrings", ".ilstrings" };
 
-  for (const auto& extension: { ".strings", ".dlstrings", ".ilstrings" })
+  // Extraction from the archive is thread-safe once the structure data has
+  // been read, so each table can be extracted and parsed in its own thread.
+  return loadParts(3, [&](const std::size_t idx, StringTable& part)
   {
-    const auto fn = part_name + "_" + language + extension;
-    const auto destination = (tempPath / (prefix + fn)).string();
-    if (!bsa.extractFile("strings\\" + fn, destination))
+    const auto fn = "strings\\" + part_name + "_" + language + extensions[idx];
+    auto data = bsa.extractFileToMemory(fn);
+    if (!data.has_value())
       return false;
-    const bool success = table.readTable(destination, StringTable::sdUnknown);
-    // Delete extracted file.
-    std::error_code error;
-    std::filesystem::remove(destination, error);
-    if (error)
-      std::cerr << "Error: Failed to delete temporary file " << destination
-                << ": " << error.message() << "\n";
-    if (!success)
+    const auto stringType = (idx == 0) ? StringTable::sdNULterminated : StringTable::sdPascalStyle;
+    if (!part.readTable(std::move(data.value()), stringType))
     {
+      std::cerr << "Error: Could not read string table " << fn << " from "
+                << bsaFileName << "!\n";
       return false;
     }
-  }
-
-  return true;
+    return true;
+  }, table);
 }
 
 } // namespace
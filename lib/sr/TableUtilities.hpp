@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2012, 2013, 2015, 2021  Thoronador
+    Copyright (C) 2012, 2013, 2015, 2021, 2026  Thoronador
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -68,6 +68,19 @@ int getAssociatedTableFiles(const std::string& fileName, std::vector<std::string
  */
 bool loadStringTables(const std::string& esmFileName, StringTable& table, const std::optional<Localization>& l10n);
 
+/** \brief Loads the given string table files.
+ *
+ * \param files  paths of the string table files, usually the .strings,
+ *               .dlstrings and .ilstrings file of a plugin
+ * \param table  the table to load the data into
+ * \return Returns true in case of success.
+ *         Returns false in case of failure.
+ * \remarks The files are parsed at the same time, each one in its own thread.
+ *          Strings of later files replace strings with the same ID from
+ *          earlier files.
+ */
+bool loadStringTableFiles(const std::vector<std::string>& files, StringTable& table);
+
 /** \brief Gets the name of the BSA file for a given ESM file name.
  *
  * \param esmFileNamePart  name of the ESM file without extension, e. g.
@@ -84,6 +97,7 @@ std::string getBsaName(const std::string& esmFileNamePart);
  * \param l10n         the preferred localization, if any
  * \return Returns true in case of success.
  *         Returns false in case of failure.
+ * \remarks The three tables are extracted and parsed at the same time.
  */
 bool loadStringTablesFromBSA(const std::string& esmFileName, StringTable& table, const std::optional<Localization>& l10n);
 
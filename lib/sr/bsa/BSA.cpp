@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2012, 2014, 2021, 2022, 2023, 2024  Dirk Stolle
+    Copyright (C) 2011, 2012, 2014, 2021, 2022, 2023, 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,10 +19,13 @@
 */
 
 #include "BSA.hpp"
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <cstring>
 #include "../../base/SlashFunctions.hpp"
+#include "../../base/StreamDecompressor.hpp"
 #include "../../base/UtilityFunctions.hpp"
 #include "../../base/DirectoryFunctions.hpp"
 #include "../../base/CompressionFunctions.hpp"
@@ -37,9 +40,14 @@ namespace SRTP
 BSA::BSA()
 : m_Status(Status::Fresh),
   m_Stream(std::ifstream()),
+  m_Mapping(),
+  m_File(),
   m_Header(BSAHeader()),
   m_Directories(std::vector<BSADirectoryRecord>()),
-  m_DirectoryBlocks(std::vector<BSADirectoryBlock>())
+  m_DirectoryBlocks(std::vector<BSADirectoryBlock>()),
+  m_DirectoryIndex(HashIndex()),
+  m_FileIndexes(std::vector<HashIndex>()),
+  m_IntermediateDirectories(std::unordered_set<std::string>())
 {
 }
 
@@ -48,7 +56,7 @@ BSA::~BSA()
   close();
 }
 
-bool BSA::open(const std::filesystem::path& fileName)
+bool BSA::open(const std::filesystem::path& fileName, const OpenMode mode)
 {
   if ((m_Status != Status::Fresh) && (m_Status != Status::Closed))
   {
@@ -72,6 +80,25 @@ bool BSA::open(const std::filesystem::path& fileName)
     return false;
   }
 
+  if ((mode == OpenMode::MemoryMapped) && !m_Mapping.open(fileName))
+  {
+    std::cerr << "BSA::open: Error while mapping file \"" << fileName.string()
+              << "\" into memory!\n";
+    m_Stream.close();
+    m_Status = Status::Closed;
+    return false;
+  }
+  // File data of archives that are not mapped is read at explicit offsets, so
+  // that reading file data does not depend on the position of m_Stream.
+  if ((mode == OpenMode::Stream) && !m_File.open(fileName))
+  {
+    std::cerr << "BSA::open: Error while opening file \"" << fileName.string()
+              << "\" for reading file data!\n";
+    m_Stream.close();
+    m_Status = Status::Closed;
+    return false;
+  }
+
   // header was read successfully
   m_Status = Status::Open;
   return true;
@@ -281,10 +308,70 @@ bool BSA::grabFileNames()
     return false;
   }
 
+  buildIndexes();
   m_Status = Status::OpenFileNames;
   return true;
 }
 
+void BSA::buildIndexes()
+{
+  const auto by_hash = [](const std::pair<BSAHash, uint32_t>& a, const std::pair<BSAHash, uint32_t>& b)
+  {
+    return a.first < b.first;
+  };
+
+  m_DirectoryIndex.clear();
+  m_DirectoryIndex.reserve(m_DirectoryBlocks.size());
+  m_FileIndexes.clear();
+  m_FileIndexes.resize(m_DirectoryBlocks.size());
+  m_IntermediateDirectories.clear();
+  for (uint32_t i = 0; i < m_DirectoryBlocks.size(); ++i)
+  {
+    const auto& block = m_DirectoryBlocks[i];
+    const BSAHash stored = i < m_Directories.size() ? m_Directories[i].nameHash : 0;
+    m_DirectoryIndex.emplace_back(stored, i);
+    const BSAHash calculated = calculateDirectoryNameHash(block.name);
+    if (calculated != stored)
+      m_DirectoryIndex.emplace_back(calculated, i);
+
+    auto& files = m_FileIndexes[i];
+    files.reserve(block.files.size());
+    for (uint32_t j = 0; j < block.files.size(); ++j)
+    {
+      const auto& file = block.files[j];
+      files.emplace_back(file.nameHash, j);
+      const BSAHash file_hash = calculateFileNameHash(file.fileName);
+      if (file_hash != file.nameHash)
+        files.emplace_back(file_hash, j);
+    }
+    std::stable_sort(files.begin(), files.end(), by_hash);
+
+    for (auto pos = block.name.find('\\'); pos != std::string::npos; pos = block.name.find('\\', pos + 1))
+    {
+      m_IntermediateDirectories.insert(block.name.substr(0, pos));
+    }
+  }
+  std::stable_sort(m_DirectoryIndex.begin(), m_DirectoryIndex.end(), by_hash);
+}
+
+template<typename Predicate>
+std::optional<uint32_t> BSA::findInIndex(const HashIndex& index, const BSAHash hash, Predicate matches)
+{
+  auto iter = std::lower_bound(index.begin(), index.end(), hash,
+      [](const std::pair<BSAHash, uint32_t>& elem, const BSAHash value)
+      {
+        return elem.first < value;
+      });
+  // Hashes may collide, so the name has to be checked, too.
+  while ((iter != index.end()) && (iter->first == hash))
+  {
+    if (matches(iter->second))
+      return iter->second;
+    ++iter;
+  }
+  return std::nullopt;
+}
+
 void BSA::listFileNames(std::ostream& stream, bool withCompressionStatus)
 {
   if (m_Status != Status::OpenFileNames)
@@ -344,10 +431,20 @@ void BSA::close()
   if ((m_Status != Status::Fresh) && (Status::Closed != m_Status))
   {
     m_Stream.close();
+    m_Mapping.close();
+    m_File.close();
+    m_DirectoryIndex.clear();
+    m_FileIndexes.clear();
+    m_IntermediateDirectories.clear();
     m_Status = Status::Closed;
   }
 }
 
+bool BSA::isMemoryMapped() const
+{
+  return m_Mapping.isOpen();
+}
+
 const BSAHeader& BSA::getHeader() const
 {
   return m_Header;
@@ -389,18 +486,10 @@ bool BSA::hasIntermediateDirectory(const std::string& directoryName) const
   }
 
   // Handle regular cases.
-  const std::string name = directoryName + "\\";
-  const auto name_length = name.size();
-  for(const auto& block: m_DirectoryBlocks)
-  {
-    if (block.name.substr(0, name_length) == name)
-      return true;
-  }
-
-  return false;
+  return m_IntermediateDirectories.find(directoryName) != m_IntermediateDirectories.end();
 }
 
-std::unordered_set<std::string> BSA::getVirtualSubDirectories(const std::string& directoryName)
+std::unordered_set<std::string> BSA::getVirtualSubDirectories(const std::string& directoryName) const
 {
   if (!hasAllStructureData())
   {
@@ -438,12 +527,11 @@ std::optional<uint32_t> BSA::getIndexOfDirectory(std::string directoryName) cons
     return std::nullopt;
   // transform to lower case
   directoryName = lowerCase(directoryName);
-  for (uint32_t i = 0; i < m_DirectoryBlocks.size(); ++i)
-  {
-    if (m_DirectoryBlocks[i].name == directoryName)
-      return i;
-  }
-  return std::nullopt;
+  return findInIndex(m_DirectoryIndex, calculateDirectoryNameHash(directoryName),
+      [this, &directoryName](const uint32_t idx)
+      {
+        return m_DirectoryBlocks[idx].name == directoryName;
+      });
 }
 
 std::optional<uint32_t> BSA::getIndexOfFile(const uint32_t directoryIndex, std::string fileName) const
@@ -462,13 +550,12 @@ std::optional<uint32_t> BSA::getIndexOfFile(const uint32_t directoryIndex, std::
   }
 
   fileName = lowerCase(fileName);
-  for (uint32_t i = 0; i < m_DirectoryBlocks[directoryIndex].files.size(); ++i)
-  {
-    if (m_DirectoryBlocks[directoryIndex].files[i].fileName == fileName)
-      return i;
-  }
-
-  return std::nullopt;
+  const auto& files = m_DirectoryBlocks[directoryIndex].files;
+  return findInIndex(m_FileIndexes[directoryIndex], calculateFileNameHash(fileName),
+      [&files, &fileName](const uint32_t idx)
+      {
+        return files[idx].fileName == fileName;
+      });
 }
 
 bool BSA::getIndexPairForFile(const std::string& fileName, std::optional<uint32_t>& directoryIndex, std::optional<uint32_t>& fileIndex) const
@@ -554,36 +641,44 @@ bool BSA::isFileCompressed(const uint32_t directoryIndex, const uint32_t fileInd
   return m_Header.filesCompressedByDefault() ^ m_DirectoryBlocks.at(directoryIndex).files.at(fileIndex).isCompressionToggled();
 }
 
-std::optional<uint32_t> BSA::handleEmbeddedFileName(const uint32_t file_block_size)
+bool BSA::readData(const uint64_t offset, uint8_t* buffer, const uint32_t count) const
+{
+  if (isMemoryMapped())
+  {
+    if ((offset > m_Mapping.size()) || (count > m_Mapping.size() - offset))
+      return false;
+    memcpy(buffer, m_Mapping.data() + offset, count);
+    return true;
+  }
+  return m_File.readAt(offset, buffer, count);
+}
+
+std::optional<std::pair<uint64_t, uint32_t> > BSA::locateFileData(const uint32_t directoryIndex, const uint32_t fileIndex) const
 {
+  const auto& file_record = m_DirectoryBlocks[directoryIndex].files[fileIndex];
+  const uint32_t file_block_size = file_record.getRealFileBlockSize();
   if (!m_Header.hasEmbeddedFileNames())
-    return 0;
+    return std::make_pair(static_cast<uint64_t>(file_record.offset), file_block_size);
 
   uint8_t embedded_name_length = 0;
-  m_Stream.read(reinterpret_cast<char*>(&embedded_name_length), 1);
-  if (!m_Stream.good())
+  if (!readData(file_record.offset, &embedded_name_length, 1))
   {
-    std::cerr << "BSA::handleEmbeddedFileName: Error: Could not read size of embedded file name!\n";
+    std::cerr << "BSA::locateFileData: Error: Could not read size of embedded file name!\n";
     return std::nullopt;
   }
   // Check integrity.
   if (embedded_name_length >= file_block_size)
   {
-    std::cerr << "BSA::handleEmbeddedFileName: Error: Size of embedded file "
+    std::cerr << "BSA::locateFileData: Error: Size of embedded file "
               << "name is not plausible! Archive may be corrupted.\n";
     return std::nullopt;
   }
   // Skip over embedded file name.
-  m_Stream.seekg(embedded_name_length, std::ios_base::cur);
-  if (!m_Stream.good())
-  {
-    std::cerr << "BSA::handleEmbeddedFileName: Error: Could not skip embedded file name!\n";
-    return std::nullopt;
-  }
-  return 1 + embedded_name_length;
+  const uint32_t skipped = 1 + embedded_name_length;
+  return std::make_pair(static_cast<uint64_t>(file_record.offset) + skipped, file_block_size - skipped);
 }
 
-std::optional<uint32_t> BSA::getExtractedFileSize(const uint32_t directoryIndex, const uint32_t fileIndex)
+std::optional<uint32_t> BSA::getExtractedFileSize(const uint32_t directoryIndex, const uint32_t fileIndex) const
 {
   bool compressed;
   try
@@ -595,38 +690,27 @@ std::optional<uint32_t> BSA::getExtractedFileSize(const uint32_t directoryIndex,
     std::cerr << "BSA::getExtractedFileSize: Error: Could not determine compression status!\n";
     return std::nullopt;
   }
-  const bool has_embedded_names = m_Header.hasEmbeddedFileNames();
-  const auto& file_record = m_DirectoryBlocks[directoryIndex].files[fileIndex];
-  const auto file_block_size = file_record.getRealFileBlockSize();
-  if (!compressed && !has_embedded_names)
+  if (!compressed && !m_Header.hasEmbeddedFileNames())
     // case #1: no compression and no embedded names
-    return file_block_size;
+    return m_DirectoryBlocks[directoryIndex].files[fileIndex].getRealFileBlockSize();
 
-  m_Stream.seekg(file_record.offset, std::ios_base::beg);
-  if (!m_Stream.good())
-  {
-    std::cerr << "BSA::getExtractedFileSize: Error: Bad internal stream, could not jump to file's offset!\n";
-    return std::nullopt;
-  }
-  const auto maybe_embedded_length = handleEmbeddedFileName(file_block_size);
-  if (!maybe_embedded_length.has_value())
+  const auto location = locateFileData(directoryIndex, fileIndex);
+  if (!location.has_value())
   {
     return std::nullopt;
   }
-  const auto embedded_name_length = maybe_embedded_length.value();
   if (!compressed)
     // case #2: no compression, but embedded names
-    return file_block_size - embedded_name_length;
+    return location.value().second;
 
-  if (file_block_size - embedded_name_length < 4)
+  if (location.value().second < 4)
   {
     std::cerr << "BSA::getExtractedFileSize: Error: Size is too small to contain any compressed data!\n";
     return std::nullopt;
   }
   uint32_t decompSize = 0;
   // read size of decompressed file
-  m_Stream.read(reinterpret_cast<char*>(&decompSize), 4);
-  if (!m_Stream.good())
+  if (!readData(location.value().first, reinterpret_cast<uint8_t*>(&decompSize), 4))
   {
     std::cerr << "BSA::getExtractedFileSize: Error: Could not read file's uncompressed size!\n";
     return std::nullopt;
@@ -635,106 +719,235 @@ std::optional<uint32_t> BSA::getExtractedFileSize(const uint32_t directoryIndex,
   return decompSize;
 }
 
-bool BSA::extractFile(const uint32_t directoryIndex, const uint32_t fileIndex, const std::string& outputFileName)
+std::optional<MWTP::ByteView> BSA::getFileBlock(const uint32_t directoryIndex, const uint32_t fileIndex) const
 {
+  if (!isMemoryMapped())
+  {
+    std::cerr << "BSA::getFileBlock: Error: Archive is not memory-mapped!\n";
+    return std::nullopt;
+  }
+
   if (!hasAllStructureData())
   {
-    std::cerr << "BSA::extractFile: Error: Not all structure data is present "
-              << "to properly fulfill the requested operation!\n";
-    return false;
+    std::cerr << "BSA::getFileBlock: Error: Not all structure data is "
+              << "present to properly fulfill the requested operation!\n";
+    return std::nullopt;
   }
 
   if (!isValidIndexPair(directoryIndex, fileIndex))
   {
-    std::cerr << "BSA::extractFile: Hint: File is not in the archive!\n";
-    return false;
+    std::cerr << "BSA::getFileBlock: Hint: File is not in the archive!\n";
+    return std::nullopt;
   }
 
-  uint32_t fileBlockSize = m_DirectoryBlocks[directoryIndex].files[fileIndex].getRealFileBlockSize();
-  m_Stream.seekg(m_DirectoryBlocks[directoryIndex].files[fileIndex].offset, std::ios_base::beg);
-  if (!m_Stream.good())
+  const auto& file_record = m_DirectoryBlocks[directoryIndex].files[fileIndex];
+  const uint64_t fileBlockSize = file_record.getRealFileBlockSize();
+  if ((file_record.offset > m_Mapping.size())
+      || (fileBlockSize > m_Mapping.size() - file_record.offset))
   {
-    std::cerr << "BSA::extractFile: Error: Bad internal stream, could not jump to file's offset!\n";
-    return false;
+    std::cerr << "BSA::getFileBlock: Error: File block exceeds the end of the archive!\n";
+    return std::nullopt;
   }
 
-  const auto maybe_embedded_length = handleEmbeddedFileName(fileBlockSize);
-  if (!maybe_embedded_length.has_value())
+  MWTP::ByteView block(m_Mapping.data() + file_record.offset, fileBlockSize);
+  if (!m_Header.hasEmbeddedFileNames())
+    return block;
+
+  if (block.empty())
   {
-    return false;
+    std::cerr << "BSA::getFileBlock: Error: Could not read size of embedded file name!\n";
+    return std::nullopt;
+  }
+  const uint8_t embedded_name_length = block[0];
+  if (embedded_name_length >= fileBlockSize)
+  {
+    std::cerr << "BSA::getFileBlock: Error: Size of embedded file "
+              << "name is not plausible! Archive may be corrupted.\n";
+    return std::nullopt;
   }
-  const auto embedded_name_length = maybe_embedded_length.value();
+  return block.subView(1 + embedded_name_length, fileBlockSize);
+}
 
-  uint8_t * buffer = nullptr; // buffer for output data
-  uint32_t buffer_size = 0;
-  if (isFileCompressed(directoryIndex, fileIndex))
+std::optional<std::vector<uint8_t> > BSA::decompress(const uint8_t* compressed, const uint32_t compressedSize, const uint32_t decompSize) const
+{
+  const bool compressionUsesLZ4 = m_Header.version >= 105;
+  #if defined(MWTP_NO_LZ4)
+  if (compressionUsesLZ4)
+  {
+    std::cerr << "BSA::decompress: Error: This archive uses LZ4 for "
+              << "compressed data, but LZ4 decompression is not enabled "
+              << "in the current build of this program!\n";
+    return std::nullopt;
+  }
+  #endif
+  // allocate buffer for decompressed data
+  std::vector<uint8_t> buffer(decompSize);
+  #if defined(MWTP_NO_LZ4)
+  const bool success = MWTP::zlibDecompress(compressed, compressedSize, buffer.data(), decompSize);
+  #else
+  const bool success = compressionUsesLZ4 ?
+      MWTP::lz4Decompress(compressed, compressedSize, buffer.data(), decompSize)
+      : MWTP::zlibDecompress(compressed, compressedSize, buffer.data(), decompSize);
+  #endif
+  if (!success)
+  {
+    std::cerr << "BSA::decompress: Error: Decompression failed!\n";
+    return std::nullopt;
+  }
+  return buffer;
+}
+
+std::optional<std::vector<uint8_t> > BSA::extractFileToMemory(const uint32_t directoryIndex, const uint32_t fileIndex) const
+{
+  if (!hasAllStructureData())
+  {
+    std::cerr << "BSA::extractFileToMemory: Error: Not all structure data is "
+              << "present to properly fulfill the requested operation!\n";
+    return std::nullopt;
+  }
+
+  if (!isValidIndexPair(directoryIndex, fileIndex))
   {
-    const bool compressionUsesLZ4 = m_Header.version >= 105;
-    #if defined(MWTP_NO_LZ4)
-    if (compressionUsesLZ4)
+    std::cerr << "BSA::extractFileToMemory: Hint: File is not in the archive!\n";
+    return std::nullopt;
+  }
+
+  if (isMemoryMapped())
+  {
+    const auto block = getFileBlock(directoryIndex, fileIndex);
+    if (!block.has_value())
     {
-      std::cerr << "BSA::extractFile: Error: This archive uses LZ4 for "
-                << "compressed data, but LZ4 decompression is not enabled "
-                << "in the current build of this program!\n";
-      return false;
+      return std::nullopt;
     }
-    #endif
-    if (fileBlockSize - embedded_name_length < 4)
+    const MWTP::ByteView& data = block.value();
+    if (!isFileCompressed(directoryIndex, fileIndex))
     {
-      std::cerr << "BSA::extractFile: Error: Size is too small to contain any compressed data!\n";
-      return false;
+      return std::vector<uint8_t>(data.begin(), data.end());
     }
-    uint32_t decompSize = 0;
-    // read size of decompressed file
-    m_Stream.read(reinterpret_cast<char*>(&decompSize), 4);
-    if (!m_Stream.good())
+    if (data.size() < 4)
     {
-      std::cerr << "BSA::extractFile: Error: Could not read file's uncompressed size!\n";
-      return false;
+      std::cerr << "BSA::extractFileToMemory: Error: Size is too small to contain any compressed data!\n";
+      return std::nullopt;
     }
-    // read compressed stuff
-    uint8_t * compressedBuffer = new uint8_t[fileBlockSize - embedded_name_length - 4];
-    m_Stream.read(reinterpret_cast<char*>(compressedBuffer), fileBlockSize - embedded_name_length - 4);
-    if (!m_Stream.good())
+    uint32_t decompSize = 0;
+    memcpy(&decompSize, data.data(), 4);
+    // Decompress directly from the mapped memory, no copy needed.
+    return decompress(data.data() + 4, static_cast<uint32_t>(data.size() - 4), decompSize);
+  }
+
+  const auto location = locateFileData(directoryIndex, fileIndex);
+  if (!location.has_value())
+  {
+    return std::nullopt;
+  }
+  const auto [offset, size] = location.value();
+
+  if (!isFileCompressed(directoryIndex, fileIndex))
+  {
+    // handle uncompressed data
+    std::vector<uint8_t> buffer(size);
+    if (!readData(offset, buffer.data(), size))
     {
-      std::cerr << "BSA::extractFile: Error: Could not read compressed file data from archive!\n";
-      delete [] compressedBuffer;
-      return false;
+      std::cerr << "BSA::extractFileToMemory: Error: Could not read file data from archive!\n";
+      return std::nullopt;
     }
-    // allocate buffer for decompressed data
-    buffer = new uint8_t[decompSize];
-    buffer_size = decompSize;
-    #if defined(MWTP_NO_LZ4)
-    const bool success = MWTP::zlibDecompress(compressedBuffer, fileBlockSize - embedded_name_length - 4, buffer, decompSize);
-    #else
-    const bool success = compressionUsesLZ4 ?
-        MWTP::lz4Decompress(compressedBuffer, fileBlockSize - embedded_name_length - 4, buffer, decompSize)
-        : MWTP::zlibDecompress(compressedBuffer, fileBlockSize - embedded_name_length - 4, buffer, decompSize);
-    #endif
-    if (!success)
+    return buffer;
+  }
+
+  if (size < 4)
+  {
+    std::cerr << "BSA::extractFileToMemory: Error: Size is too small to contain any compressed data!\n";
+    return std::nullopt;
+  }
+  uint32_t decompSize = 0;
+  // read size of decompressed file
+  if (!readData(offset, reinterpret_cast<uint8_t*>(&decompSize), 4))
+  {
+    std::cerr << "BSA::extractFileToMemory: Error: Could not read file's uncompressed size!\n";
+    return std::nullopt;
+  }
+  // Read compressed stuff into a buffer of the current thread, so that
+  // several threads can extract files at the same time without allocating
+  // a new buffer for every file.
+  constexpr std::size_t max_scratch_size = 16 * 1024 * 1024;
+  thread_local std::vector<uint8_t> compressed;
+  const uint32_t compressedSize = size - 4;
+  compressed.resize(compressedSize);
+  if (!readData(offset + 4, compressed.data(), compressedSize))
+  {
+    std::cerr << "BSA::extractFileToMemory: Error: Could not read compressed file data from archive!\n";
+    return std::nullopt;
+  }
+  auto result = decompress(compressed.data(), compressedSize, decompSize);
+  if (compressed.capacity() > max_scratch_size)
+  {
+    // Do not keep the memory of unusually large files around.
+    std::vector<uint8_t>().swap(compressed);
+  }
+  return result;
+}
+
+std::optional<std::vector<uint8_t> > BSA::extractFileToMemory(const std::string& inArchiveFileName) const
+{
+  if (!hasAllStructureData())
+  {
+    std::cerr << "BSA::extractFileToMemory: Error: Not all structure data is "
+              << "present to properly fulfill the requested operation!\n";
+    return std::nullopt;
+  }
+
+  std::optional<uint32_t> directoryIndex, fileIndex;
+  getIndexPairForFile(inArchiveFileName, directoryIndex, fileIndex);
+  if (!directoryIndex.has_value() || !fileIndex.has_value())
+  {
+    std::cerr << "BSA::extractFileToMemory: Hint: File " << inArchiveFileName
+              << " is not in the archive!\n";
+    return std::nullopt;
+  }
+
+  return extractFileToMemory(directoryIndex.value(), fileIndex.value());
+}
+
+bool BSA::extractFile(const uint32_t directoryIndex, const uint32_t fileIndex, const std::string& outputFileName) const
+{
+  if (!hasAllStructureData())
+  {
+    std::cerr << "BSA::extractFile: Error: Not all structure data is present "
+              << "to properly fulfill the requested operation!\n";
+    return false;
+  }
+
+  if (!isValidIndexPair(directoryIndex, fileIndex))
+  {
+    std::cerr << "BSA::extractFile: Hint: File is not in the archive!\n";
+    return false;
+  }
+
+  if (isFileCompressed(directoryIndex, fileIndex))
+  {
+    return extractCompressedFile(directoryIndex, fileIndex, outputFileName);
+  }
+
+  std::optional<std::vector<uint8_t> > buffer;
+  MWTP::ByteView data;
+  if (isMemoryMapped())
+  {
+    // Uncompressed data can be written directly from the mapped memory.
+    const auto block = getFileBlock(directoryIndex, fileIndex);
+    if (!block.has_value())
     {
-      std::cerr << "BSA::extractFile: Error: Decompression failed!\n";
-      delete [] compressedBuffer;
-      delete [] buffer;
       return false;
     }
-    // success, delete compressed data buffer
-    delete [] compressedBuffer;
-    compressedBuffer = nullptr;
+    data = block.value();
   }
   else
   {
-    // handle uncompressed data
-    buffer_size = fileBlockSize - embedded_name_length;
-    buffer = new uint8_t[buffer_size];
-    m_Stream.read(reinterpret_cast<char*>(buffer), buffer_size);
-    if (!m_Stream.good())
+    buffer = extractFileToMemory(directoryIndex, fileIndex);
+    if (!buffer.has_value())
     {
-      std::cerr << "BSA::extractFile: Error: Bad internal stream, could not read file data from archive!\n";
-      delete[] buffer;
-      buffer = nullptr;
       return false;
     }
+    data = MWTP::ByteView(buffer.value().data(), buffer.value().size());
   }
 
   std::ofstream outputStream;
@@ -743,24 +956,154 @@ bool BSA::extractFile(const uint32_t directoryIndex, const uint32_t fileIndex, c
   {
     std::cerr << "BSA::extractFile: Error: Could not open/create file \""
               << outputFileName << "\" for writing!\n";
-    delete[] buffer;
-    buffer = nullptr;
     return false;
   }
 
-  outputStream.write(reinterpret_cast<const char*>(buffer), buffer_size);
+  outputStream.write(reinterpret_cast<const char*>(data.data()), data.size());
   if (!outputStream.good())
   {
     std::cerr << "BSA::extractFile: Error: Could not write data to file \""
               << outputFileName << "\"!\n";
-    delete[] buffer;
-    buffer = nullptr;
     return false;
   }
   outputStream.close();
-  // free buffer
-  delete[] buffer;
-  buffer = nullptr;
+  return true;
+}
+
+bool BSA::extractCompressedFile(const uint32_t directoryIndex, const uint32_t fileIndex, const std::string& outputFileName) const
+{
+  const auto location = locateFileData(directoryIndex, fileIndex);
+  if (!location.has_value())
+  {
+    return false;
+  }
+  const auto [offset, size] = location.value();
+
+  if (size < 4)
+  {
+    std::cerr << "BSA::extractFile: Error: Size is too small to contain any compressed data!\n";
+    return false;
+  }
+  uint32_t decompSize = 0;
+  // read size of decompressed file
+  if (!readData(offset, reinterpret_cast<uint8_t*>(&decompSize), 4))
+  {
+    std::cerr << "BSA::extractFile: Error: Could not read file's uncompressed size!\n";
+    return false;
+  }
+
+  std::ofstream outputStream;
+  outputStream.open(outputFileName, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+  if (!outputStream)
+  {
+    std::cerr << "BSA::extractFile: Error: Could not open/create file \""
+              << outputFileName << "\" for writing!\n";
+    return false;
+  }
+
+  if (!decompressToStream(offset + 4, size - 4, decompSize, outputStream))
+  {
+    // Do not leave incomplete files behind.
+    outputStream.close();
+    std::error_code error;
+    std::filesystem::remove(outputFileName, error);
+    return false;
+  }
+  outputStream.close();
+  return true;
+}
+
+bool BSA::decompressToStream(const uint64_t offset, const uint32_t compressedSize, const uint32_t decompSize, std::ostream& output) const
+{
+  const bool compressionUsesLZ4 = m_Header.version >= 105;
+  #if defined(MWTP_NO_LZ4)
+  if (compressionUsesLZ4)
+  {
+    std::cerr << "BSA::decompressToStream: Error: This archive uses LZ4 for "
+              << "compressed data, but LZ4 decompression is not enabled "
+              << "in the current build of this program!\n";
+    return false;
+  }
+  #endif
+  std::unique_ptr<MWTP::StreamDecompressor> decompressor;
+  if (compressionUsesLZ4)
+    decompressor = std::make_unique<MWTP::Lz4StreamDecompressor>();
+  else
+    decompressor = std::make_unique<MWTP::ZlibStreamDecompressor>();
+
+  // Buffers have a fixed upper size, so that even large files only need a
+  // bounded amount of memory. They belong to the current thread, so several
+  // threads can extract files at the same time.
+  constexpr uint32_t max_chunk_size = 65536;
+  thread_local std::vector<uint8_t> inBuffer(max_chunk_size);
+  thread_local std::vector<uint8_t> outBuffer(max_chunk_size);
+  uint64_t position = offset;
+  uint32_t remaining = compressedSize;
+  while (!decompressor->finished())
+  {
+    if (decompressor->needsInput())
+    {
+      if (remaining == 0)
+      {
+        std::cerr << "BSA::decompressToStream: Error: Compressed data ends prematurely!\n";
+        return false;
+      }
+      if (isMemoryMapped())
+      {
+        // Mapped data can be fed directly without any copy.
+        if ((position > m_Mapping.size()) || (remaining > m_Mapping.size() - position))
+        {
+          std::cerr << "BSA::decompressToStream: Error: Compressed data exceeds the end of the archive!\n";
+          return false;
+        }
+        decompressor->feed(m_Mapping.data() + position, remaining);
+        position += remaining;
+        remaining = 0;
+      }
+      else
+      {
+        const uint32_t chunk = std::min<uint32_t>(remaining, inBuffer.size());
+        if (!readData(position, inBuffer.data(), chunk))
+        {
+          std::cerr << "BSA::decompressToStream: Error: Could not read compressed file data from archive!\n";
+          return false;
+        }
+        decompressor->feed(inBuffer.data(), chunk);
+        position += chunk;
+        remaining -= chunk;
+      }
+    }
+    const auto produced = decompressor->read(outBuffer.data(), outBuffer.size());
+    if (!produced.has_value())
+    {
+      std::cerr << "BSA::decompressToStream: Error: Decompression failed!\n";
+      return false;
+    }
+    if (decompressor->totalOut() > decompSize)
+    {
+      std::cerr << "BSA::decompressToStream: Error: Decompressed data is larger "
+                << "than the expected size of " << decompSize << " bytes.\n";
+      return false;
+    }
+    if ((produced.value() == 0) && !decompressor->needsInput() && !decompressor->finished())
+    {
+      std::cerr << "BSA::decompressToStream: Error: Decompression does not make any progress!\n";
+      return false;
+    }
+    output.write(reinterpret_cast<const char*>(outBuffer.data()), produced.value());
+    if (!output.good())
+    {
+      std::cerr << "BSA::decompressToStream: Error: Could not write decompressed data!\n";
+      return false;
+    }
+  }
+  if (decompressor->totalOut() != decompSize)
+  {
+    std::cerr << "BSA::decompressToStream: Error: Having only "
+              << decompressor->totalOut() << " bytes of decompressed data, "
+              << "but expected size is " << decompSize << " bytes.\n";
+    return false;
+  }
   return true;
 }
 
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2012, 2022, 2023, 2023, 2024  Dirk Stolle
+    Copyright (C) 2011, 2012, 2022, 2023, 2023, 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -24,10 +24,15 @@
 #include "BSAHeader.hpp"
 #include "BSADirectoryBlock.hpp"
 #include "BSADirectoryRecord.hpp"
+#include "../../base/ByteView.hpp"
+#include "../../base/MappedFile.hpp"
+#include "../../base/PositionalFile.hpp"
 #include <filesystem>
+#include <fstream>
 #include <optional>
 #include <ostream>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace SRTP
@@ -36,6 +41,17 @@ namespace SRTP
 struct BSA
 {
   public:
+    /// enumeration type for the way the archive data is accessed
+    enum class OpenMode
+    {
+      /// file data is read via a file stream
+      Stream,
+
+      /** whole archive is mapped into memory, file data is accessed without
+          any further reads or copies */
+      MemoryMapped
+    };
+
     BSA();
 
     ~BSA();
@@ -43,12 +59,20 @@ struct BSA
     /** \brief Opens the given BSA file and reads its header.
      *
      * \param fileName name of the BSA file that shall be opened
+     * \param mode     the way the file data of the archive will be accessed
      * \return Returns true in case of success. Returns false otherwise.
      */
-    bool open(const std::filesystem::path& fileName);
+    bool open(const std::filesystem::path& fileName, const OpenMode mode = OpenMode::Stream);
 
     void close();
 
+    /** \brief Checks whether the archive was opened as memory-mapped file.
+     *
+     * \return Returns true, if the archive is mapped into memory.
+     *         Returns false otherwise.
+     */
+    bool isMemoryMapped() const;
+
     /** \brief Gets the header data. Note that this is only
      *
      * \return Returns the header data.
@@ -133,7 +157,7 @@ struct BSA
      * \return Returns a container containing all virtual sub-directories of a
      *         directory.
      */
-    std::unordered_set<std::string> getVirtualSubDirectories(const std::string& directoryName);
+    std::unordered_set<std::string> getVirtualSubDirectories(const std::string& directoryName) const;
 
 
     /** \brief Gets the index of the given directory in the archive.
@@ -198,7 +222,7 @@ struct BSA
      * \return Returns the extracted file's size in bytes in case of success.
      *         Returns an empty optional, if the size could not be determined.
      */
-    std::optional<uint32_t> getExtractedFileSize(const uint32_t directoryIndex, const uint32_t fileIndex);
+    std::optional<uint32_t> getExtractedFileSize(const uint32_t directoryIndex, const uint32_t fileIndex) const;
 
     /** \brief Reads the directory records.
      *
@@ -215,6 +239,8 @@ struct BSA
     /** \brief Reads the file names.
      *
      * \return Returns true in case of success. Returns false otherwise.
+     * \remarks After the file names have been read, the lookup indexes for
+     *          directories and files are built.
      */
     bool grabFileNames();
 
@@ -235,6 +261,42 @@ struct BSA
      */
     std::vector<std::string> getDirectoryNames() const;
 
+    /** \brief Gets a view of the data block of a file within the memory-mapped
+     *         archive.
+     *
+     * \param directoryIndex  directory index of the wanted file
+     * \param fileIndex       file index of the wanted file
+     * \return Returns a view of the file's data in case of success. Returns an
+     *         empty optional on failure.
+     * \remarks Only works for archives opened with OpenMode::MemoryMapped.
+     *          The embedded file name (if any) is not part of the view. For
+     *          uncompressed files the view is the content of the file, for
+     *          compressed files the view starts with the four byte size of
+     *          the decompressed data, followed by the compressed data.
+     *          The view is only valid as long as the archive is open.
+     */
+    std::optional<MWTP::ByteView> getFileBlock(const uint32_t directoryIndex, const uint32_t fileIndex) const;
+
+    /** \brief Extracts the file with the given indexes into memory.
+     *
+     * \param directoryIndex  directory index of the wanted file
+     * \param fileIndex       file index of the wanted file
+     * \return Returns the (decompressed) content of the file in case of
+     *         success. Returns an empty optional on failure.
+     * \remarks This method does not modify the archive's state, so it can be
+     *          called from several threads at the same time once all
+     *          structure data has been read.
+     */
+    std::optional<std::vector<uint8_t> > extractFileToMemory(const uint32_t directoryIndex, const uint32_t fileIndex) const;
+
+    /** \brief Extracts the file with the given file name into memory.
+     *
+     * \param inArchiveFileName  name of the file in the archive, including full path
+     * \return Returns the (decompressed) content of the file in case of
+     *         success. Returns an empty optional on failure.
+     */
+    std::optional<std::vector<uint8_t> > extractFileToMemory(const std::string& inArchiveFileName) const;
+
     /** \brief Extracts the file with the given indexes and writes it to the
      *         specified destination.
      *
@@ -242,8 +304,11 @@ struct BSA
      * \param fileIndex       file index of the wanted file
      * \param outputFileName  name of the destination file on HDD
      * \return Returns true in case of success, false on failure.
+     * \remarks This method does not modify the archive's state, so it can be
+     *          called from several threads at the same time once all
+     *          structure data has been read.
      */
-    bool extractFile(const uint32_t directoryIndex, const uint32_t fileIndex, const std::string& outputFileName);
+    bool extractFile(const uint32_t directoryIndex, const uint32_t fileIndex, const std::string& outputFileName) const;
 
     /** \brief Extracts the file with the given file name and writes it to the
      * specified destination.
@@ -301,17 +366,85 @@ struct BSA
      */
     bool isValidIndexPair(const uint32_t directoryIndex, const uint32_t fileIndex) const;
 
-    /** \brief Handles the embedded file name (if present) during file extraction.
+    /** \brief Reads data of the archive at the given offset.
+     *
+     * \param offset  offset of the data within the archive
+     * \param buffer  buffer that will hold the data, at least count bytes
+     * \param count   number of bytes to read
+     * \return Returns true in case of success. Returns false otherwise.
+     * \remarks Does not use the internal stream, so it can be called from
+     *          several threads at the same time.
+     */
+    bool readData(const uint64_t offset, uint8_t* buffer, const uint32_t count) const;
+
+    /** \brief Gets the location of a file's data within the archive.
      *
-     * \param file_block_size  the size of the file block in bytes
-     * \remarks When called, the internal stream offset must be directly at the
-     *          size byte of the embedded file name, i. e. the beginning of the
-     *          file block.
-     * \return Returns the number of bytes that were skipped due to the embedded
-     *         file name in case of success. Returns an empty optional, if an
-     *         error occurred.
+     * \param directoryIndex  index of the directory
+     * \param fileIndex       index of the file within the directory, must
+     *                        be a valid index pair
+     * \return Returns a pair of offset and size of the file's data, i. e. the
+     *         file block without the embedded file name (if any), in case of
+     *         success. Returns an empty optional, if an error occurred.
      */
-    std::optional<uint32_t> handleEmbeddedFileName(const uint32_t file_block_size);
+    std::optional<std::pair<uint64_t, uint32_t> > locateFileData(const uint32_t directoryIndex, const uint32_t fileIndex) const;
+
+    /** \brief Decompresses a compressed file block.
+     *
+     * \param compressed      pointer to the compressed data
+     * \param compressedSize  size of the compressed data in bytes
+     * \param decompSize      size of the decompressed data in bytes
+     * \return Returns the decompressed data in case of success. Returns an
+     *         empty optional, if an error occurred.
+     */
+    std::optional<std::vector<uint8_t> > decompress(const uint8_t* compressed, const uint32_t compressedSize, const uint32_t decompSize) const;
+
+    /** \brief Extracts a compressed file and writes it to the specified
+     *         destination.
+     *
+     * \param directoryIndex  directory index of the wanted file
+     * \param fileIndex       file index of the wanted file
+     * \param outputFileName  name of the destination file on HDD
+     * \return Returns true in case of success, false on failure.
+     * \remarks The data is decompressed in chunks, so the whole file is never
+     *          held in memory. The destination is removed, if an error occurs.
+     */
+    bool extractCompressedFile(const uint32_t directoryIndex, const uint32_t fileIndex, const std::string& outputFileName) const;
+
+    /** \brief Decompresses a compressed file block in chunks and writes the
+     *         decompressed data to a stream.
+     *
+     * \param offset          offset of the compressed data within the archive
+     * \param compressedSize  size of the compressed data in bytes
+     * \param decompSize      size of the decompressed data in bytes
+     * \param output          stream that receives the decompressed data
+     * \return Returns true in case of success. Returns false, if an error
+     *         occurred.
+     */
+    bool decompressToStream(const uint64_t offset, const uint32_t compressedSize, const uint32_t decompSize, std::ostream& output) const;
+
+    /// type for lookup index: pairs of name hash and index, sorted by hash
+    using HashIndex = std::vector<std::pair<BSAHash, uint32_t> >;
+
+    /** \brief Builds the lookup indexes for directories and files.
+     *
+     * \remarks The indexes use the name hashes stored in the archive. Entries
+     *          where the stored hash does not match the hash calculated from
+     *          the name are additionally indexed by the calculated hash, so
+     *          lookups still work for archives created by sloppy tools.
+     */
+    void buildIndexes();
+
+    /** \brief Finds the index of an entry by name hash.
+     *
+     * \param index  the hash index to search
+     * \param hash   hash of the name
+     * \param matches  function that checks whether the name at a given index
+     *                 matches the wanted name
+     * \return Returns the index of the entry, if it was found.
+     *         Returns an empty optional otherwise.
+     */
+    template<typename Predicate>
+    static std::optional<uint32_t> findInIndex(const HashIndex& index, const BSAHash hash, Predicate matches);
 
     /// enumeration type for internal status
     enum class Status { Fresh, Open, OpenDirectoryData, OpenDirectoryBlocks,
@@ -319,12 +452,19 @@ struct BSA
 
     Status m_Status; /**< internal status */
 
-    std::ifstream m_Stream; /**< file stream associated with the archive after open() was called */
+    std::ifstream m_Stream; /**< file stream associated with the archive after open() was called, only used to read the structure data */
+    MWTP::MappedFile m_Mapping; /**< memory mapping of the archive, if opened with OpenMode::MemoryMapped */
+    MWTP::PositionalFile m_File; /**< archive file for reading file data, if opened with OpenMode::Stream */
 
     // data read from the stream...
     BSAHeader m_Header;
     std::vector<BSADirectoryRecord> m_Directories;
     std::vector<BSADirectoryBlock> m_DirectoryBlocks;
+
+    // lookup indexes, built after all structure data was read
+    HashIndex m_DirectoryIndex; /**< index of directory blocks */
+    std::vector<HashIndex> m_FileIndexes; /**< index of files for each directory block */
+    std::unordered_set<std::string> m_IntermediateDirectories; /**< all intermediate directories */
 }; // struct
 
 } // namespace
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2022, 2024  Dirk Stolle
+    Copyright (C) 2022, 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,83 +19,156 @@
 */
 
 #include "BSAHash.hpp"
-#include <algorithm>
-#include <cctype>
-#include <string>
-#include <vector>
+#include <array>
 
 namespace SRTP
 {
 
-BSAHash calculateHash(const std::filesystem::path& path)
+namespace
+{
+
+using CharTable = std::array<uint8_t, 256>;
+
+/* Creates a table that maps every character to its lower case variant (ASCII
+   only, like std::tolower() in the "C" locale). If flipSlashes is true, then
+   slashes are mapped to backslashes, too. */
+constexpr CharTable makeTable(const bool flipSlashes)
+{
+  CharTable table{};
+  for (std::size_t i = 0; i < table.size(); ++i)
+  {
+    table[i] = static_cast<uint8_t>(((i >= 'A') && (i <= 'Z')) ? i + ('a' - 'A') : i);
+  }
+  if (flipSlashes)
+  {
+    table['/'] = '\\';
+  }
+  return table;
+}
+
+constexpr CharTable file_table = makeTable(false);
+constexpr CharTable directory_table = makeTable(true);
+
+/* Gets the position where the extension of name starts, or the size of name,
+   if there is no extension. This follows the rules of
+   std::filesystem::path::extension(), but always treats slashes and
+   backslashes as separators. */
+std::size_t extensionStart(const std::string_view name)
 {
-  std::string ext = path.extension().string();
-  std::string stem = path.string();
-  // Remove the extension from "stem".
-  stem.erase(stem.size() - ext.size());
+  const auto separator = name.find_last_of("/\\");
+  const std::size_t file_start = (separator == std::string_view::npos) ? 0 : separator + 1;
+  const std::string_view file_name = name.substr(file_start);
+  if ((file_name == ".") || (file_name == ".."))
+    return name.size();
+  const auto dot = file_name.rfind('.');
+  if ((dot == std::string_view::npos) || (dot == 0))
+    return name.size();
+  return file_start + dot;
+}
 
-  auto lower_case = [](unsigned char c)
+/* Checks whether the given extension matches the lower case extension
+   expected. */
+bool extensionIs(const std::string_view extension, const std::string_view expected, const CharTable& table)
+{
+  if (extension.size() != expected.size())
+    return false;
+  for (std::size_t i = 0; i < extension.size(); ++i)
   {
-    return std::tolower(c);
+    if (table[static_cast<uint8_t>(extension[i])] != static_cast<uint8_t>(expected[i]))
+      return false;
+  }
+  return true;
+}
+
+BSAHash hashName(const std::string_view name, const CharTable& table)
+{
+  const auto lower = [&table](const char c)
+  {
+    return table[static_cast<uint8_t>(c)];
   };
-  std::transform(stem.cbegin(), stem.cend(), stem.begin(), lower_case);
-  std::transform(ext.cbegin(), ext.cend(), ext.begin(), lower_case);
-
-  std::vector<std::uint8_t> ordinal_values;
-  std::transform(stem.cbegin(), stem.cend(), std::back_inserter(ordinal_values),
-                 [](unsigned char c)
-                 {
-                   return c;
-                 });
-
-  const auto ord_size = ordinal_values.size();
-  const std::uint8_t c1 = ord_size >= 1 ? ordinal_values[ord_size - 1] : 0;
-  const std::uint8_t c2 = ord_size >= 2 ? ordinal_values[ord_size - 2] : 0;
-  const std::uint8_t c0 = ord_size > 0 ? ordinal_values[0] : 0;
-  std::uint32_t first_hash = static_cast<std::uint32_t>(c1)
-                           | (static_cast<std::uint32_t>(c2) << 8)
-                           | (static_cast<std::uint32_t>(ord_size) << 16)
-                           | (static_cast<std::uint32_t>(c0) << 24);
-  if (ext == ".kf")
-    first_hash |= static_cast<std::uint32_t>(0x80);
-  else if (ext == ".nif")
-    first_hash |= static_cast<std::uint32_t>(0x8000);
-  else if (ext == ".dds")
-    first_hash |= static_cast<std::uint32_t>(0x8080);
-  else if (ext == ".wav")
-    first_hash |= static_cast<std::uint32_t>(0x80000000UL);
-
-  std::uint32_t second_hash = 0;
-  decltype(ord_size) limit = ord_size >= 2 ? ord_size - 2 : 0;
-  for (decltype(ordinal_values)::size_type i = 1; i < limit; ++i)
+
+  const std::size_t stem_size = extensionStart(name);
+  const std::string_view extension = name.substr(stem_size);
+
+  const uint8_t c1 = stem_size >= 1 ? lower(name[stem_size - 1]) : 0;
+  const uint8_t c2 = stem_size >= 2 ? lower(name[stem_size - 2]) : 0;
+  const uint8_t c0 = stem_size >= 1 ? lower(name[0]) : 0;
+  uint32_t first_hash = static_cast<uint32_t>(c1)
+                      | (static_cast<uint32_t>(c2) << 8)
+                      | (static_cast<uint32_t>(stem_size) << 16)
+                      | (static_cast<uint32_t>(c0) << 24);
+  if (extensionIs(extension, ".kf", table))
+    first_hash |= static_cast<uint32_t>(0x80);
+  else if (extensionIs(extension, ".nif", table))
+    first_hash |= static_cast<uint32_t>(0x8000);
+  else if (extensionIs(extension, ".dds", table))
+    first_hash |= static_cast<uint32_t>(0x8080);
+  else if (extensionIs(extension, ".wav", table))
+    first_hash |= static_cast<uint32_t>(0x80000000UL);
+
+  uint32_t second_hash = 0;
+  const std::size_t limit = stem_size >= 2 ? stem_size - 2 : 0;
+  for (std::size_t i = 1; i < limit; ++i)
   {
-    second_hash = (second_hash * 0x1003f) + ordinal_values[i];
+    second_hash = (second_hash * 0x1003f) + lower(name[i]);
   }
 
-  ordinal_values.clear();
-  std::transform(ext.cbegin(), ext.cend(), std::back_inserter(ordinal_values),
-                 [](unsigned char c)
-                 {
-                   return c;
-                 });
-  std::uint32_t third_hash = 0;
-  for (decltype(ordinal_values)::size_type i = 0; i < ordinal_values.size(); ++i)
+  uint32_t third_hash = 0;
+  for (const char c: extension)
   {
-    third_hash = (third_hash * 0x1003f) + ordinal_values[i];
+    third_hash = (third_hash * 0x1003f) + lower(c);
   }
   second_hash += third_hash;
   return (static_cast<BSAHash>(second_hash) << 32) + first_hash;
 }
 
-BSAHash calculateDirectoryHash(std::string directoryName)
+std::size_t hashNames(const std::string_view names, BSAHash* hashes, const std::size_t count, const CharTable& table)
 {
-  // Replace slashes by backslashes. That's what BSA archives use and expect.
-  for (auto pos = directoryName.find('/'); pos != std::string::npos; pos = directoryName.find('/', pos))
+  std::size_t hashed = 0;
+  std::size_t start = 0;
+  while ((hashed < count) && (start < names.size()))
   {
-     directoryName.replace(pos, 1, 1, '\\');
+    auto end = names.find('\0', start);
+    if (end == std::string_view::npos)
+      end = names.size();
+    hashes[hashed] = hashName(names.substr(start, end - start), table);
+    ++hashed;
+    start = end + 1;
   }
-  // Use normal hash for the rest.
-  return calculateHash(directoryName);
+  return hashed;
+}
+
+} // namespace
+
+BSAHash calculateHash(const std::filesystem::path& path)
+{
+  return calculateFileNameHash(path.string());
 }
 
+BSAHash calculateDirectoryHash(std::string directoryName)
+{
+  return calculateDirectoryNameHash(directoryName);
+}
+
+BSAHash calculateFileNameHash(const std::string_view name)
+{
+  return hashName(name, file_table);
 }
+
+BSAHash calculateDirectoryNameHash(const std::string_view name)
+{
+  // Slashes are hashed as backslashes. That's what BSA archives use and expect.
+  return hashName(name, directory_table);
+}
+
+std::size_t calculateFileNameHashes(const std::string_view names, BSAHash* hashes, const std::size_t count)
+{
+  return hashNames(names, hashes, count, file_table);
+}
+
+std::size_t calculateDirectoryNameHashes(const std::string_view names, BSAHash* hashes, const std::size_t count)
+{
+  return hashNames(names, hashes, count, directory_table);
+}
+
+} // namespace
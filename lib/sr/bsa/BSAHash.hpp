@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2011, 2021, 2022  Dirk Stolle
+    Copyright (C) 2011, 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,8 +21,10 @@
 #ifndef SR_BSAHASH_HPP
 #define SR_BSAHASH_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <string_view>
 
 namespace SRTP
 {
@@ -48,6 +50,48 @@ BSAHash calculateHash(const std::filesystem::path& path);
  */
 BSAHash calculateDirectoryHash(std::string directoryName);
 
+/** \brief Calculates the hash value for a file name without any allocations.
+ *
+ * \param name   the file name, e. g. "foo.dds"
+ * \return Returns the corresponding hash value.
+ * \remarks Both slash and backslash are treated as path separators when the
+ *          extension is determined, independent of the platform.
+ */
+BSAHash calculateFileNameHash(const std::string_view name);
+
+/** \brief Calculates the hash value for a directory name without any
+ *         allocations.
+ *
+ * \param name   the directory name, e. g. "foo\\bar\\baz"
+ * \return Returns the corresponding hash value. Slashes are hashed like
+ *         backslashes.
+ */
+BSAHash calculateDirectoryNameHash(const std::string_view name);
+
+/** \brief Calculates the hash values for several file names at once.
+ *
+ * \param names   buffer that contains the file names, each one terminated by
+ *                a NUL character, like the file name block of a BSA file;
+ *                the terminator of the last name may be omitted
+ * \param hashes  array that receives the hash values, one per name
+ * \param count   maximum number of names to hash, i. e. the size of hashes
+ * \return Returns the number of names that were hashed.
+ * \remarks This does not allocate any memory.
+ */
+std::size_t calculateFileNameHashes(const std::string_view names, BSAHash* hashes, const std::size_t count);
+
+/** \brief Calculates the hash values for several directory names at once.
+ *
+ * \param names   buffer that contains the directory names, each one
+ *                terminated by a NUL character; the terminator of the last
+ *                name may be omitted
+ * \param hashes  array that receives the hash values, one per name
+ * \param count   maximum number of names to hash, i. e. the size of hashes
+ * \return Returns the number of names that were hashed.
+ * \remarks This does not allocate any memory.
+ */
+std::size_t calculateDirectoryNameHashes(const std::string_view names, BSAHash* hashes, const std::size_t count);
+
 } // namespace
 
 #endif // SR_BSAHASH_HPP
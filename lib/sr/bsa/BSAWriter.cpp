@@ -0,0 +1,438 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "BSAWriter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include "BSAFileRecord.hpp"
+#include "BSAHeader.hpp"
+#include "../../base/CompressionFunctions.hpp"
+#include "../../base/lz4Compression.hpp"
+
+namespace SRTP
+{
+
+/// maximum size of a file block, higher bits are used as flags
+const uint32_t cMaximumBlockSize = (1 << 30) - 1;
+
+/// flag bit in the file block size that toggles the compression
+const uint32_t cCompressionToggle = 1 << 30;
+
+BSAWriter::BSAWriter(const uint32_t version, const bool compressed, const unsigned int threadCount)
+: m_Version(version),
+  m_Compressed(compressed),
+  m_ThreadCount(std::max(1u, threadCount)),
+  m_Directories(std::map<std::string, std::vector<Entry> >())
+{
+}
+
+bool BSAWriter::addFile(const std::filesystem::path& source, const std::string& archivePath)
+{
+  std::string path = archivePath;
+  std::replace(path.begin(), path.end(), '/', '\\');
+  std::transform(path.begin(), path.end(), path.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  const auto pos = path.rfind('\\');
+  const std::string directory = pos == std::string::npos ? "." : path.substr(0, pos);
+  const std::string name = pos == std::string::npos ? path : path.substr(pos + 1);
+  if (name.empty() || directory.empty())
+  {
+    std::cerr << "BSAWriter::addFile: Error: \"" << archivePath
+              << "\" is not a valid path for a file!\n";
+    return false;
+  }
+  // Length of the directory name plus NUL has to fit into a single byte.
+  if (directory.size() > 254)
+  {
+    std::cerr << "BSAWriter::addFile: Error: Directory name of \"" << archivePath
+              << "\" is too long!\n";
+    return false;
+  }
+
+  const BSAHash hash = calculateFileNameHash(name);
+  const auto iter = m_Directories.find(directory);
+  if (iter != m_Directories.end())
+  {
+    for (const auto& entry: iter->second)
+    {
+      if (entry.hash == hash)
+      {
+        if (entry.name == name)
+          std::cerr << "BSAWriter::addFile: Error: File \"" << archivePath
+                    << "\" was already added!\n";
+        else
+          std::cerr << "BSAWriter::addFile: Error: Files \"" << entry.name
+                    << "\" and \"" << name << "\" in directory \"" << directory
+                    << "\" have the same hash!\n";
+        return false;
+      }
+    }
+  }
+  m_Directories[directory].push_back(Entry{ source, name, hash });
+  return true;
+}
+
+bool BSAWriter::addDirectoryTree(const std::filesystem::path& root)
+{
+  std::error_code error;
+  std::filesystem::recursive_directory_iterator iter(root, error);
+  if (error)
+  {
+    std::cerr << "BSAWriter::addDirectoryTree: Error: Could not list files in "
+              << root.string() << ": " << error.message() << "\n";
+    return false;
+  }
+  for (const auto& item: iter)
+  {
+    if (!item.is_regular_file())
+      continue;
+    const auto relative = item.path().lexically_relative(root);
+    if (!addFile(item.path(), relative.generic_string()))
+      return false;
+  }
+  return true;
+}
+
+uint32_t BSAWriter::fileCount() const
+{
+  std::size_t count = 0;
+  for (const auto& [name, files]: m_Directories)
+  {
+    count += files.size();
+  }
+  return static_cast<uint32_t>(count);
+}
+
+BSAWriter::Block BSAWriter::prepareBlock(const Entry& entry) const
+{
+  Block block{ {}, false, false };
+  std::ifstream stream(entry.source, std::ios::in | std::ios::binary);
+  if (!stream.good())
+  {
+    std::cerr << "BSAWriter: Error: Could not open file " << entry.source.string() << "!\n";
+    return block;
+  }
+  stream.seekg(0, std::ios::end);
+  const auto size = static_cast<uint64_t>(stream.tellg());
+  stream.seekg(0, std::ios::beg);
+  if (size > cMaximumBlockSize)
+  {
+    std::cerr << "BSAWriter: Error: File " << entry.source.string()
+              << " is too large for a BSA archive!\n";
+    return block;
+  }
+  std::vector<uint8_t> raw(size);
+  stream.read(reinterpret_cast<char*>(raw.data()), size);
+  if (!stream.good())
+  {
+    std::cerr << "BSAWriter: Error: Could not read file " << entry.source.string() << "!\n";
+    return block;
+  }
+  stream.close();
+
+  if (m_Compressed && (size > 0))
+  {
+    uint32_t compSize = static_cast<uint32_t>(size);
+    uint8_t * compBuffer = new uint8_t[compSize];
+    uint32_t usedSize = 0;
+    const bool success = m_Version >= 105
+        ? MWTP::lz4Compress(raw.data(), compSize, compBuffer, compSize, usedSize)
+        : MWTP::zlibCompress(raw.data(), compSize, compBuffer, compSize, usedSize, 9);
+    if (!success)
+    {
+      std::cerr << "BSAWriter: Error: Could not compress file " << entry.source.string() << "!\n";
+      delete[] compBuffer;
+      return block;
+    }
+    // Only keep the compressed data, if it actually saves some space.
+    if (usedSize + 4 < size)
+    {
+      const uint32_t rawSize = static_cast<uint32_t>(size);
+      block.data.resize(4 + usedSize);
+      memcpy(block.data.data(), &rawSize, 4);
+      memcpy(block.data.data() + 4, compBuffer, usedSize);
+      delete[] compBuffer;
+      block.ok = true;
+      return block;
+    }
+    delete[] compBuffer;
+  }
+
+  block.toggled = m_Compressed;
+  block.data = std::move(raw);
+  block.ok = true;
+  return block;
+}
+
+uint32_t BSAWriter::contentFlags() const
+{
+  uint32_t flags = 0;
+  for (const auto& [directory, files]: m_Directories)
+  {
+    for (const auto& entry: files)
+    {
+      const auto ext = std::filesystem::path(entry.name).extension().string();
+      ContentType type = ContentType::Misc;
+      if ((ext == ".nif") || (ext == ".kf") || (ext == ".hkx") || (ext == ".tri") || (ext == ".btr"))
+        type = ContentType::Meshes;
+      else if (ext == ".dds")
+        type = ContentType::Textures;
+      else if ((ext == ".swf") || (ext == ".xml"))
+        type = ContentType::Menus;
+      else if ((ext == ".fuz") || (ext == ".lip"))
+        type = ContentType::Voices;
+      else if ((ext == ".wav") || (ext == ".xwm"))
+        type = ContentType::Sounds;
+      else if (ext == ".fxp")
+        type = ContentType::Shaders;
+      else if (ext == ".spt")
+        type = ContentType::Trees;
+      else if ((ext == ".fnt") || (ext == ".tex"))
+        type = ContentType::Fonts;
+      flags |= static_cast<uint32_t>(type);
+    }
+  }
+  return flags;
+}
+
+bool BSAWriter::write(const std::filesystem::path& fileName) const
+{
+  if ((m_Version != 104) && (m_Version != 105))
+  {
+    std::cerr << "BSAWriter::write: Error: Only archives of version 104 or 105"
+              << " can be written, but version " << m_Version << " was requested!\n";
+    return false;
+  }
+  #if defined(MWTP_NO_LZ4)
+  if (m_Compressed && (m_Version >= 105))
+  {
+    std::cerr << "BSAWriter::write: Error: This build has no lz4 support, so "
+              << "compressed archives of version 105 cannot be written!\n";
+    return false;
+  }
+  #endif
+  if (m_Directories.empty())
+  {
+    std::cerr << "BSAWriter::write: Error: There are no files to write!\n";
+    return false;
+  }
+
+  // Directories and the files in each directory are sorted by their hashes.
+  struct SortedDirectory
+  {
+    std::string name;
+    BSAHash hash;
+    std::vector<const Entry*> files;
+  };
+  std::vector<SortedDirectory> directories;
+  for (const auto& [name, files]: m_Directories)
+  {
+    SortedDirectory dir{ name, calculateDirectoryNameHash(name), {} };
+    for (const auto& entry: files)
+    {
+      dir.files.push_back(&entry);
+    }
+    std::sort(dir.files.begin(), dir.files.end(),
+              [](const Entry* a, const Entry* b) { return a->hash < b->hash; });
+    directories.push_back(std::move(dir));
+  }
+  std::sort(directories.begin(), directories.end(),
+            [](const SortedDirectory& a, const SortedDirectory& b) { return a.hash < b.hash; });
+  for (std::size_t i = 1; i < directories.size(); ++i)
+  {
+    if (directories[i - 1].hash == directories[i].hash)
+    {
+      std::cerr << "BSAWriter::write: Error: Directories \"" << directories[i - 1].name
+                << "\" and \"" << directories[i].name << "\" have the same hash!\n";
+      return false;
+    }
+  }
+
+  BSAHeader header;
+  header.fileID = 0x00415342; // "BSA\0"
+  header.version = m_Version;
+  header.offset = 36;
+  // names for directories and files, plus compression, if requested
+  header.archiveFlags = 1 | 2 | (m_Compressed ? 4 : 0);
+  header.directoryCount = static_cast<uint32_t>(directories.size());
+  header.fileCount = fileCount();
+  header.fileFlags = contentFlags();
+  uint64_t fileRecordBlocksSize = 0;
+  for (const auto& dir: directories)
+  {
+    header.totalDirectoryNameLength += static_cast<uint32_t>(dir.name.size() + 1);
+    fileRecordBlocksSize += 1 + dir.name.size() + 1 + 16 * dir.files.size();
+    for (const auto entry: dir.files)
+    {
+      header.totalFileNameLength += static_cast<uint32_t>(entry->name.size() + 1);
+    }
+  }
+  const uint32_t directoryRecordSize = m_Version >= 105 ? 24 : 16;
+  const uint64_t dataStart = 36 + uint64_t(directoryRecordSize) * header.directoryCount
+                           + fileRecordBlocksSize + header.totalFileNameLength;
+  if (dataStart > std::numeric_limits<uint32_t>::max())
+  {
+    std::cerr << "BSAWriter::write: Error: Too many files for a single archive!\n";
+    return false;
+  }
+
+  std::ofstream output(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!output.good())
+  {
+    std::cerr << "BSAWriter::write: Error: Could not create file " << fileName.string() << "!\n";
+    return false;
+  }
+  // Skip the records for now, they are written once the data offsets are known.
+  output.seekp(dataStart, std::ios::beg);
+
+  std::vector<std::pair<const Entry*, BSAFileRecord*> > order;
+  std::vector<std::vector<BSAFileRecord> > records(directories.size());
+  for (std::size_t i = 0; i < directories.size(); ++i)
+  {
+    records[i].resize(directories[i].files.size());
+    for (std::size_t j = 0; j < directories[i].files.size(); ++j)
+    {
+      records[i][j].nameHash = directories[i].files[j]->hash;
+      order.emplace_back(directories[i].files[j], &records[i][j]);
+    }
+  }
+
+  // Files are compressed in batches, so that memory usage stays limited while
+  // the data is still written in the same order as the file records.
+  uint64_t offset = dataStart;
+  const std::size_t batchSize = 4 * m_ThreadCount;
+  std::vector<Block> blocks;
+  for (std::size_t first = 0; first < order.size(); first += batchSize)
+  {
+    const std::size_t count = std::min(batchSize, order.size() - first);
+    blocks.assign(count, Block{ {}, false, false });
+    std::atomic<std::size_t> next = 0;
+    const auto worker = [&]()
+    {
+      for (std::size_t idx = next++; idx < count; idx = next++)
+      {
+        blocks[idx] = prepareBlock(*order[first + idx].first);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; (t < m_ThreadCount) && (t < count); ++t)
+    {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread: threads)
+    {
+      thread.join();
+    }
+
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+      const auto& block = blocks[idx];
+      if (!block.ok)
+        return false;
+      if (offset + block.data.size() > std::numeric_limits<uint32_t>::max())
+      {
+        std::cerr << "BSAWriter::write: Error: Archive would exceed the maximum size of 4 GB!\n";
+        return false;
+      }
+      auto& record = *order[first + idx].second;
+      record.offset = static_cast<uint32_t>(offset);
+      record.fileBlockSize = static_cast<uint32_t>(block.data.size())
+                           | (block.toggled ? cCompressionToggle : 0);
+      output.write(reinterpret_cast<const char*>(block.data.data()), block.data.size());
+      offset += block.data.size();
+    }
+    if (!output.good())
+    {
+      std::cerr << "BSAWriter::write: Error while writing file data!\n";
+      return false;
+    }
+  }
+
+  // header
+  output.seekp(0, std::ios::beg);
+  output.write(reinterpret_cast<const char*>(&header.fileID), 4);
+  output.write(reinterpret_cast<const char*>(&header.version), 4);
+  output.write(reinterpret_cast<const char*>(&header.offset), 4);
+  output.write(reinterpret_cast<const char*>(&header.archiveFlags), 4);
+  output.write(reinterpret_cast<const char*>(&header.directoryCount), 4);
+  output.write(reinterpret_cast<const char*>(&header.fileCount), 4);
+  output.write(reinterpret_cast<const char*>(&header.totalDirectoryNameLength), 4);
+  output.write(reinterpret_cast<const char*>(&header.totalFileNameLength), 4);
+  output.write(reinterpret_cast<const char*>(&header.fileFlags), 4);
+
+  // directory records
+  const uint32_t padding = 0;
+  // The offset of a directory points to its file record block, plus the
+  // total length of all file names. That's how the format is defined.
+  uint32_t blockOffset = 36 + directoryRecordSize * header.directoryCount
+                       + header.totalFileNameLength;
+  for (const auto& dir: directories)
+  {
+    const uint32_t count = static_cast<uint32_t>(dir.files.size());
+    output.write(reinterpret_cast<const char*>(&dir.hash), sizeof(BSAHash));
+    output.write(reinterpret_cast<const char*>(&count), 4);
+    if (m_Version >= 105)
+      output.write(reinterpret_cast<const char*>(&padding), 4);
+    output.write(reinterpret_cast<const char*>(&blockOffset), 4);
+    if (m_Version >= 105)
+      output.write(reinterpret_cast<const char*>(&padding), 4);
+    blockOffset += static_cast<uint32_t>(1 + dir.name.size() + 1 + 16 * count);
+  }
+
+  // file record blocks
+  for (std::size_t i = 0; i < directories.size(); ++i)
+  {
+    const uint8_t length = static_cast<uint8_t>(directories[i].name.size() + 1);
+    output.write(reinterpret_cast<const char*>(&length), 1);
+    output.write(directories[i].name.c_str(), length);
+    for (const auto& record: records[i])
+    {
+      output.write(reinterpret_cast<const char*>(&record.nameHash), sizeof(BSAHash));
+      output.write(reinterpret_cast<const char*>(&record.fileBlockSize), 4);
+      output.write(reinterpret_cast<const char*>(&record.offset), 4);
+    }
+  }
+
+  // file names
+  for (const auto& dir: directories)
+  {
+    for (const auto entry: dir.files)
+    {
+      output.write(entry->name.c_str(), entry->name.size() + 1);
+    }
+  }
+
+  if (!output.good())
+  {
+    std::cerr << "BSAWriter::write: Error while writing archive structure!\n";
+    return false;
+  }
+  output.close();
+  return true;
+}
+
+} // namespace
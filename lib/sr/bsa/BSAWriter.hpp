@@ -0,0 +1,122 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SR_BSAWRITER_HPP
+#define SR_BSAWRITER_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+#include "BSAHash.hpp"
+
+namespace SRTP
+{
+
+/** Creates BSA archives of version 104 or 105 from files on disk. */
+class BSAWriter
+{
+  public:
+    /** \brief Constructor.
+     *
+     * \param version      BSA version of the archive, must be 104 or 105
+     * \param compressed   whether files shall be compressed (zlib for version
+     *                     104, lz4 for version 105)
+     * \param threadCount  number of threads used for compression
+     */
+    BSAWriter(const uint32_t version = 104, const bool compressed = true, const unsigned int threadCount = 1);
+
+    /** \brief Adds a single file to the archive.
+     *
+     * \param source       path of the file on disk
+     * \param archivePath  path of the file inside the archive, e.g.
+     *                     "textures\foo\bar.dds"
+     * \return Returns true, if the file was added.
+     *         Returns false, if the path is invalid or already present.
+     * \remarks The file is not read until write() is called. Files placed
+     *          directly in the root of the archive get the directory name ".".
+     */
+    bool addFile(const std::filesystem::path& source, const std::string& archivePath);
+
+    /** \brief Adds all regular files below a directory to the archive.
+     *
+     * \param root  path of the directory on disk; paths of the files inside
+     *              the archive are relative to that directory
+     * \return Returns true, if all files were added.
+     *         Returns false, if an error occurred.
+     */
+    bool addDirectoryTree(const std::filesystem::path& root);
+
+    /** \brief Gets the number of files that have been added so far.
+     *
+     * \return Returns the number of files.
+     */
+    uint32_t fileCount() const;
+
+    /** \brief Writes the archive with all added files.
+     *
+     * \param fileName  path of the archive that shall be created
+     * \return Returns true in case of success. Returns false otherwise.
+     * \remarks Only a limited number of files is held in memory at any time.
+     *          The file data is written first, while the records that point
+     *          to it are filled in at the start of the archive at the end.
+     */
+    bool write(const std::filesystem::path& fileName) const;
+  private:
+    /// file that will be written to the archive
+    struct Entry
+    {
+      std::filesystem::path source; /**< path of the file on disk */
+      std::string name;             /**< file name inside the archive */
+      BSAHash hash;                 /**< hash of the file name */
+    };
+
+    /// data block of a file, ready to be written to the archive
+    struct Block
+    {
+      std::vector<uint8_t> data; /**< data as it will be written */
+      bool toggled;              /**< whether compression deviates from default */
+      bool ok;                   /**< whether the block could be created */
+    };
+
+    /** \brief Reads and - if requested - compresses a file.
+     *
+     * \param entry  the file to process
+     * \return Returns the data block for the file.
+     */
+    Block prepareBlock(const Entry& entry) const;
+
+    /** \brief Gets the content type flags of the archive based on the file
+     *         extensions.
+     *
+     * \return Returns the flags for BSAHeader::fileFlags.
+     */
+    uint32_t contentFlags() const;
+
+    uint32_t m_Version;          /**< BSA version of the archive */
+    bool m_Compressed;           /**< whether files are compressed by default */
+    unsigned int m_ThreadCount;  /**< number of compression threads */
+    std::map<std::string, std::vector<Entry> > m_Directories; /**< files per directory */
+}; // class
+
+} // namespace
+
+#endif // SR_BSAWRITER_HPP
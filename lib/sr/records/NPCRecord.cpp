@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2012, 2013, 2021  Dirk Stolle
+    Copyright (C) 2012, 2013, 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -22,8 +22,8 @@
 #include <iostream>
 #include "../SR_Constants.hpp"
 #include "../../mw/HelperIO.hpp"
-#include "../../base/CompressionFunctions.hpp"
-#include "../../base/BufferStream.hpp"
+#include "../../base/ViewStream.hpp"
+#include "RecordDecompression.hpp"
 
 namespace SRTP
 {
@@ -821,52 +821,11 @@ bool NPCRecord::loadFromStream(std::istream& in_File, const bool localized, cons
   uint16_t subLength = 0;
   uint32_t bytesRead = 0;
 
-  MWTP::BufferStream decompStream(nullptr, 0);
-  std::basic_istream<char>* actual_in = &in_File;
-
-  if (isCompressed())
-  {
-    uint32_t decompressedSize = 0;
-    // read size of decompressed data
-    in_File.read(reinterpret_cast<char*>(&decompressedSize), 4);
-    if (!in_File.good())
-    {
-      std::cerr << "Error while reading decompression size of NPC_!\n";
-      return false;
-    }
-    if (readSize <= 4)
-    {
-      std::cerr << "Error: Size of compressed NPC_ record is too small to contain any compressed data!\n";
-      return false;
-    }
-    // buffer to read compressed data
-    uint8_t * stream_buffer = new uint8_t[readSize - 4];
-    in_File.read(reinterpret_cast<char*>(stream_buffer), readSize - 4);
-    if (!in_File.good())
-    {
-      std::cerr << "Error while reading compressed data of NPC_!\n";
-      delete[] stream_buffer;
-      return false;
-    }
-    // now decompress here
-    uint8_t * decompBuffer = new uint8_t [decompressedSize];
-    if (!MWTP::zlibDecompress(stream_buffer, readSize - 4, decompBuffer, decompressedSize))
-    {
-      std::cerr << "Error while executing decompression function!\n";
-      delete[] stream_buffer;
-      stream_buffer = nullptr;
-      delete[] decompBuffer;
-      decompBuffer = nullptr;
-      return false;
-    }
-    delete[] stream_buffer;
-    stream_buffer = nullptr;
-    // set underlying buffer for decompressed stream
-    decompStream.buffer(reinterpret_cast<char*>(decompBuffer), decompressedSize);
-    actual_in = &decompStream;
-    // update read size
-    readSize = decompressedSize;
-  }
+  MWTP::ByteView decompressed;
+  if (isCompressed() && !decompressRecord(in_File, readSize, cNPC_, decompressed))
+    return false;
+  MWTP::ViewStream decompStream(decompressed);
+  std::istream* actual_in = isCompressed() ? &decompStream : &in_File;
 
   // read EDID
   char buffer[512];
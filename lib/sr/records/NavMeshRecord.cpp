@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2013  Dirk Stolle
+    Copyright (C) 2013, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,9 +21,9 @@
 #include "NavMeshRecord.hpp"
 #include <iostream>
 #include "../SR_Constants.hpp"
-#include "../../base/BufferStream.hpp"
-#include "../../base/CompressionFunctions.hpp"
+#include "../../base/ViewStream.hpp"
 #include "../../mw/HelperIO.hpp"
+#include "RecordDecompression.hpp"
 
 namespace SRTP
 {
@@ -148,52 +148,11 @@ bool NavMeshRecord::loadFromStream(std::istream& in_File, const bool localized,
   subRecName = subLength = 0;
   uint32_t bytesRead = 0;
 
-  MWTP::BufferStream decompStream(NULL, 0);
-  std::basic_istream<char>* actual_in = &in_File;
-
-  if (isCompressed())
-  {
-    uint32_t decompressedSize = 0;
-    //read size of decompressed data
-    in_File.read((char*) &decompressedSize, 4);
-    if (!in_File.good())
-    {
-      std::cerr << "Error while reading decompression size of NAVM!\n";
-      return false;
-    }
-    if (readSize<=4)
-    {
-      std::cerr << "Error: size of compressed NAVM record is too small to contain any compressed data!\n";
-      return false;
-    }
-    //buffer to read compressed data
-    uint8_t * stream_buffer = new uint8_t[readSize-4];
-    in_File.read((char*) stream_buffer, readSize-4);
-    if (!in_File.good())
-    {
-      std::cerr << "Error while reading compressed data of NAVM!\n";
-      delete[] stream_buffer;
-      return false;
-    }
-    //now decompress here
-    uint8_t * decompBuffer = new uint8_t [decompressedSize];
-    if (!MWTP::zlibDecompress(stream_buffer, readSize-4, decompBuffer, decompressedSize))
-    {
-      std::cerr << "Error while executing decompression function!\n";
-      delete[] stream_buffer;
-      stream_buffer = NULL;
-      delete[] decompBuffer;
-      decompBuffer = NULL;
-      return false;
-    }
-    delete[] stream_buffer;
-    stream_buffer = NULL;
-    //set underlying buffer for decompressed stream
-    decompStream.buffer((char*) decompBuffer, decompressedSize);
-    actual_in = &decompStream;
-    //update read size
-    readSize = decompressedSize;
-  }//if is compressed record
+  MWTP::ByteView decompressed;
+  if (isCompressed() && !decompressRecord(in_File, readSize, cNAVM, decompressed))
+    return false;
+  MWTP::ViewStream decompStream(decompressed);
+  std::istream* actual_in = isCompressed() ? &decompStream : &in_File;
 
   unknownNVNM.setPresence(false);
   uint32_t sizeXXXX = 0;
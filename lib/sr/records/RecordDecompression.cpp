@@ -0,0 +1,84 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "RecordDecompression.hpp"
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "../../base/CompressionFunctions.hpp"
+#include "../../mw/HelperIO.hpp"
+
+namespace SRTP
+{
+
+namespace
+{
+
+// Buffers are kept per thread and only grow, so that decompressing the many
+// compressed records of a plugin does not allocate memory for each record.
+thread_local std::vector<uint8_t> compressedBuffer;
+thread_local std::vector<uint8_t> decompressedBuffer;
+
+} // namespace
+
+bool decompressRecordData(const uint8_t* data, const uint32_t size, const uint32_t recName, MWTP::ByteView& result)
+{
+  if (size <= 4)
+  {
+    std::cerr << "Error: Size of compressed " << IntTo4Char(recName)
+              << " record is too small to contain any compressed data!\n";
+    return false;
+  }
+  uint32_t decompressedSize = 0;
+  std::memcpy(&decompressedSize, data, 4);
+  if (decompressedBuffer.size() < decompressedSize)
+    decompressedBuffer.resize(decompressedSize);
+  if (!MWTP::zlibDecompress(data + 4, size - 4, decompressedBuffer.data(), decompressedSize))
+  {
+    std::cerr << "Error while decompressing data of " << IntTo4Char(recName) << "!\n";
+    return false;
+  }
+  result = MWTP::ByteView(decompressedBuffer.data(), decompressedSize);
+  return true;
+}
+
+bool decompressRecord(std::istream& input, uint32_t& readSize, const uint32_t recName, MWTP::ByteView& result)
+{
+  if (readSize <= 4)
+  {
+    std::cerr << "Error: Size of compressed " << IntTo4Char(recName)
+              << " record is too small to contain any compressed data!\n";
+    return false;
+  }
+  if (compressedBuffer.size() < readSize)
+    compressedBuffer.resize(readSize);
+  input.read(reinterpret_cast<char*>(compressedBuffer.data()), readSize);
+  if (!input.good())
+  {
+    std::cerr << "Error while reading compressed data of " << IntTo4Char(recName) << "!\n";
+    return false;
+  }
+  if (!decompressRecordData(compressedBuffer.data(), readSize, recName, result))
+    return false;
+  readSize = result.size();
+  return true;
+}
+
+} // namespace
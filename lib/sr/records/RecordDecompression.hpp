@@ -0,0 +1,64 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef SR_RECORDDECOMPRESSION_HPP
+#define SR_RECORDDECOMPRESSION_HPP
+
+#include <cstdint>
+#include <istream>
+#include "../../base/ByteView.hpp"
+
+namespace SRTP
+{
+
+/** \brief Decompresses the data of a compressed record that is already in memory.
+ *
+ * \param data     the record data, starting with the size of the decompressed data
+ * \param size     size of the record data in bytes
+ * \param recName  type of the record, e.g. cNPC_, only used for error messages
+ * \param result   the view that will be set to the decompressed data
+ * \return Returns true, if the data was decompressed successfully.
+ *         Returns false, if an error occurred.
+ * \remarks The decompressed data is stored in a buffer of the calling thread,
+ *          which is reused by every call on that thread. So the data is only
+ *          valid until the next call of decompressRecordData() or
+ *          decompressRecord() on the same thread.
+ */
+bool decompressRecordData(const uint8_t* data, const uint32_t size, const uint32_t recName, MWTP::ByteView& result);
+
+/** \brief Reads and decompresses the data of a compressed record.
+ *
+ * \param input     the input stream, positioned after the record header
+ * \param readSize  size of the record data as given in the record header;
+ *                  will be set to the size of the decompressed data on success
+ * \param recName   type of the record, e.g. cNPC_, only used for error messages
+ * \param result    the view that will be set to the decompressed data, e.g.
+ *                  to read it with MWTP::ViewStream
+ * \return Returns true, if the data was decompressed successfully.
+ *         Returns false, if an error occurred.
+ * \remarks Both the compressed and the decompressed data are stored in buffers
+ *          of the calling thread, see decompressRecordData(). The view must
+ *          not be used after the next call on the same thread.
+ */
+bool decompressRecord(std::istream& input, uint32_t& readSize, const uint32_t recName, MWTP::ByteView& result);
+
+} // namespace
+
+#endif // SR_RECORDDECOMPRESSION_HPP
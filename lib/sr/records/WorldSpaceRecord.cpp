@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project.
-    Copyright (C) 2012, 2013, 2021, 2024  Dirk Stolle
+    Copyright (C) 2012, 2013, 2021, 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -22,6 +22,8 @@
 #include <iostream>
 #include "../SR_Constants.hpp"
 #include "../../mw/HelperIO.hpp"
+#include "../../base/ViewStream.hpp"
+#include "RecordDecompression.hpp"
 
 namespace SRTP
 {
@@ -482,10 +484,10 @@ bool WorldSpaceRecord::saveToStream(std::ostream& output) const
 }
 #endif
 
-bool WorldSpaceRecord::loadFromStream(std::istream& input, const bool localized, const StringTable& table)
+bool WorldSpaceRecord::loadFromStream(std::istream& in_File, const bool localized, const StringTable& table)
 {
   uint32_t readSize = 0;
-  if (!loadSizeAndUnknownValues(input, readSize))
+  if (!loadSizeAndUnknownValues(in_File, readSize))
     return false;
   if (isDeleted())
     return true;
@@ -493,6 +495,12 @@ bool WorldSpaceRecord::loadFromStream(std::istream& input, const bool localized,
   uint16_t subLength = 0;
   uint32_t bytesRead = 0;
 
+  MWTP::ByteView decompressed;
+  if (isCompressed() && !decompressRecord(in_File, readSize, cWRLD, decompressed))
+    return false;
+  MWTP::ViewStream decompStream(decompressed);
+  std::istream& input = isCompressed() ? decompStream : in_File;
+
   // read editor ID (EDID)
   char buffer[512];
   if (!loadString512FromStream(input, editorID, buffer, cEDID, true, bytesRead))
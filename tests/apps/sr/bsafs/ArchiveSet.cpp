@@ -0,0 +1,251 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../../../lib/locate_catch.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include "../../../../apps/sr/bsafs/ArchiveSet.hpp"
+#include "../../../../lib/sr/bsa/BSAWriter.hpp"
+
+namespace
+{
+
+bool writeFile(const std::filesystem::path& path, const std::string& content)
+{
+  std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  stream.write(content.data(), content.size());
+  return stream.good();
+}
+
+std::string extract(const SRTP::bsafs::ArchiveSet& archives, const SRTP::bsafs::FileLocation& location)
+{
+  const auto data = archives.archive(location.archive).extractFileToMemory(location.directory, location.file);
+  if (!data.has_value())
+    return std::string();
+  return std::string(data.value().begin(), data.value().end());
+}
+
+} // namespace
+
+TEST_CASE("SRTP::bsafs::ArchiveSet")
+{
+  using namespace SRTP::bsafs;
+
+  SECTION("empty set")
+  {
+    ArchiveSet archives;
+    REQUIRE( archives.empty() );
+    REQUIRE( archives.size() == 0 );
+    REQUIRE( archives.isDirectory("") );
+    REQUIRE_FALSE( archives.isDirectory("textures") );
+    REQUIRE( archives.findFile("textures\\foo.dds") == nullptr );
+    const auto root = archives.findDirectory("");
+    REQUIRE( root != nullptr );
+    REQUIRE( root->directories.empty() );
+    REQUIRE( root->files.empty() );
+    REQUIRE( archives.findDirectory("textures") == nullptr );
+  }
+
+  SECTION("adding invalid archives fails")
+  {
+    ArchiveSet archives;
+    REQUIRE_FALSE( archives.add("this-file-does-not-exist.bsa") );
+    REQUIRE_FALSE( archives.add(std::unique_ptr<SRTP::BSA>()) );
+    // archive without structure data
+    REQUIRE_FALSE( archives.add(std::make_unique<SRTP::BSA>()) );
+    REQUIRE( archives.empty() );
+  }
+
+  SECTION("directory names keep their case")
+  {
+    const std::filesystem::path directory{"test_sr_bsafs_archive_set_case"};
+    std::filesystem::remove_all(directory);
+    REQUIRE( std::filesystem::create_directory(directory) );
+    const auto first_path = directory / "first.bsa";
+    const auto second_path = directory / "second.bsa";
+    {
+      REQUIRE( writeFile(directory / "a.dds", "texture") );
+      SRTP::BSAWriter writer(104, false);
+      REQUIRE( writer.addFile(directory / "a.dds", "textures\\armor\\a.dds") );
+      REQUIRE( writer.write(first_path) );
+      // BSAWriter stores lower-case names, but other tools keep the case, so
+      // the name is changed directly in the file. Hashes are based on the
+      // lower-case name, so they stay valid.
+      std::fstream stream(first_path, std::ios::in | std::ios::out | std::ios::binary);
+      std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+      const auto pos = content.find("textures\\armor");
+      REQUIRE( pos != std::string::npos );
+      stream.seekp(pos);
+      stream.write("Textures\\Armor", 14);
+      REQUIRE( stream.good() );
+    }
+    {
+      SRTP::BSAWriter writer(104, false);
+      REQUIRE( writer.addFile(directory / "a.dds", "textures\\armor\\b.dds") );
+      REQUIRE( writer.write(second_path) );
+    }
+
+    ArchiveSet archives;
+    REQUIRE( archives.add(first_path) );
+    REQUIRE( archives.add(second_path) );
+
+    const auto root = archives.findDirectory("");
+    REQUIRE( root != nullptr );
+    REQUIRE( root->directories == std::vector<std::string>{ "Textures" } );
+    // lookups ignore the case, listings use the first archive's spelling
+    const auto textures = archives.findDirectory("textures");
+    REQUIRE( textures != nullptr );
+    REQUIRE( textures->directories == std::vector<std::string>{ "Armor" } );
+    const auto armor = archives.findDirectory("TEXTURES\\ARMOR");
+    REQUIRE( armor != nullptr );
+    REQUIRE( armor->files.size() == 2 );
+
+    archives.clear();
+    std::filesystem::remove_all(directory);
+  }
+
+  SECTION("archives in load order")
+  {
+    const std::filesystem::path directory{"test_sr_bsafs_archive_set"};
+    std::filesystem::remove_all(directory);
+    REQUIRE( std::filesystem::create_directory(directory) );
+    const auto first_path = directory / "first.bsa";
+    const auto second_path = directory / "second.bsa";
+    {
+      REQUIRE( writeFile(directory / "a.dds", "texture of first archive") );
+      REQUIRE( writeFile(directory / "shared_1.txt", "from first archive") );
+      REQUIRE( writeFile(directory / "y.nif", "mesh") );
+      SRTP::BSAWriter writer(104, false);
+      REQUIRE( writer.addFile(directory / "a.dds", "textures\\a.dds") );
+      REQUIRE( writer.addFile(directory / "shared_1.txt", "textures\\shared.txt") );
+      REQUIRE( writer.addFile(directory / "y.nif", "meshes\\x\\y.nif") );
+      REQUIRE( writer.write(first_path) );
+    }
+    {
+      REQUIRE( writeFile(directory / "shared_2.txt", "from second archive") );
+      REQUIRE( writeFile(directory / "s.wav", "sound") );
+      SRTP::BSAWriter writer(104, true);
+      REQUIRE( writer.addFile(directory / "shared_2.txt", "textures\\shared.txt") );
+      REQUIRE( writer.addFile(directory / "s.wav", "sound\\s.wav") );
+      REQUIRE( writer.write(second_path) );
+    }
+
+    ArchiveSet archives;
+    REQUIRE( archives.add(first_path) );
+    REQUIRE( archives.add(second_path) );
+    REQUIRE( archives.size() == 2 );
+    REQUIRE( archives.archive(0).hasFile("textures\\a.dds") );
+
+    SECTION("directories of all archives exist")
+    {
+      REQUIRE( archives.isDirectory("") );
+      REQUIRE( archives.isDirectory("textures") );
+      REQUIRE( archives.isDirectory("meshes") );
+      REQUIRE( archives.isDirectory("meshes\\x") );
+      REQUIRE( archives.isDirectory("sound") );
+      REQUIRE( archives.isDirectory("Meshes\\X") );
+      REQUIRE_FALSE( archives.isDirectory("meshes\\x\\y.nif") );
+      REQUIRE_FALSE( archives.isDirectory("music") );
+
+      const auto root = archives.findDirectory("");
+      REQUIRE( root != nullptr );
+      auto names = root->directories;
+      std::sort(names.begin(), names.end());
+      REQUIRE( names == std::vector<std::string>{ "meshes", "sound", "textures" } );
+      REQUIRE( root->files.empty() );
+
+      const auto meshes = archives.findDirectory("Meshes");
+      REQUIRE( meshes != nullptr );
+      REQUIRE( meshes->directories == std::vector<std::string>{ "x" } );
+      REQUIRE( meshes->files.empty() );
+
+      const auto x = archives.findDirectory("meshes\\x");
+      REQUIRE( x != nullptr );
+      REQUIRE( x->directories.empty() );
+      REQUIRE( x->files.size() == 1 );
+      REQUIRE( x->files[0]->name == "y.nif" );
+    }
+
+    SECTION("later archives override files of earlier ones")
+    {
+      const auto shared = archives.findFile("textures\\shared.txt");
+      REQUIRE( shared != nullptr );
+      REQUIRE( shared->location.archive == 1 );
+      REQUIRE( extract(archives, shared->location) == "from second archive" );
+
+      const auto texture = archives.findFile("textures\\A.dds");
+      REQUIRE( texture != nullptr );
+      REQUIRE( texture->location.archive == 0 );
+      REQUIRE( extract(archives, texture->location) == "texture of first archive" );
+
+      const auto sound = archives.findFile("sound\\s.wav");
+      REQUIRE( sound != nullptr );
+      REQUIRE( sound->location.archive == 1 );
+      REQUIRE( extract(archives, sound->location) == "sound" );
+
+      REQUIRE( archives.findFile("textures\\b.dds") == nullptr );
+      REQUIRE( archives.findFile("textures") == nullptr );
+    }
+
+    SECTION("overridden files are listed only once")
+    {
+      const auto textures = archives.findDirectory("textures");
+      REQUIRE( textures != nullptr );
+      const auto& files = textures->files;
+      REQUIRE( files.size() == 2 );
+      REQUIRE( files[0]->name == "a.dds" );
+      REQUIRE( files[0]->location.archive == 0 );
+      REQUIRE( files[1]->name == "shared.txt" );
+      REQUIRE( files[1]->location.archive == 1 );
+      REQUIRE( files[1] == archives.findFile("textures\\shared.txt") );
+    }
+
+    SECTION("sizes of extracted files are known")
+    {
+      // uncompressed archive
+      const auto texture = archives.findFile("textures\\a.dds");
+      REQUIRE( texture != nullptr );
+      REQUIRE( texture->size == 24 );
+      const auto mesh = archives.findFile("meshes\\x\\y.nif");
+      REQUIRE( mesh != nullptr );
+      REQUIRE( mesh->size == 4 );
+      // compressed archive
+      const auto shared = archives.findFile("textures\\shared.txt");
+      REQUIRE( shared != nullptr );
+      REQUIRE( shared->size == 19 );
+      const auto sound = archives.findFile("sound\\s.wav");
+      REQUIRE( sound != nullptr );
+      REQUIRE( sound->size == 5 );
+    }
+
+    SECTION("clear")
+    {
+      archives.clear();
+      REQUIRE( archives.empty() );
+      REQUIRE_FALSE( archives.isDirectory("textures") );
+      REQUIRE( archives.findFile("sound\\s.wav") == nullptr );
+      REQUIRE( archives.isDirectory("") );
+    }
+
+    archives.clear();
+    std::filesystem::remove_all(directory);
+  }
+}
@@ -0,0 +1,218 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../../../lib/locate_catch.hpp"
+#include "../../../../apps/sr/bsafs/FileCache.hpp"
+
+SRTP::bsafs::FileData makeData(const std::size_t size)
+{
+  return std::make_shared<const std::vector<uint8_t> >(size, static_cast<uint8_t>(size));
+}
+
+TEST_CASE("SRTP::bsafs::FileCache")
+{
+  using namespace SRTP::bsafs;
+
+  SECTION("constructor")
+  {
+    FileCache cache(1234);
+
+    REQUIRE( cache.capacity() == 1234 );
+    REQUIRE( cache.size() == 0 );
+    REQUIRE( cache.hits() == 0 );
+    REQUIRE( cache.misses() == 0 );
+    REQUIRE( cache.evictions() == 0 );
+  }
+
+  SECTION("get from empty cache is a miss")
+  {
+    FileCache cache(100);
+
+    REQUIRE( cache.get({ 0, 0, 0 }) == nullptr );
+    REQUIRE( cache.hits() == 0 );
+    REQUIRE( cache.misses() == 1 );
+  }
+
+  SECTION("put and get")
+  {
+    FileCache cache(100);
+    const auto data = makeData(10);
+    cache.put({ 0, 1, 2 }, data);
+    REQUIRE( cache.size() == 10 );
+
+    const auto found = cache.get({ 0, 1, 2 });
+    REQUIRE( found == data );
+    REQUIRE( cache.hits() == 1 );
+    REQUIRE( cache.misses() == 0 );
+
+    // Indexes are not interchangeable.
+    REQUIRE( cache.get({ 0, 2, 1 }) == nullptr );
+    REQUIRE( cache.misses() == 1 );
+    // Same indexes in another archive are another file.
+    REQUIRE( cache.get({ 1, 1, 2 }) == nullptr );
+    REQUIRE( cache.misses() == 2 );
+  }
+
+  SECTION("putting the same entry twice does not count twice")
+  {
+    FileCache cache(100);
+    cache.put({ 0, 1, 2 }, makeData(10));
+    cache.put({ 0, 1, 2 }, makeData(20));
+
+    REQUIRE( cache.size() == 20 );
+    REQUIRE( cache.get({ 0, 1, 2 })->size() == 20 );
+    REQUIRE( cache.evictions() == 0 );
+  }
+
+  SECTION("null data is ignored")
+  {
+    FileCache cache(100);
+    cache.put({ 0, 0, 0 }, nullptr);
+
+    REQUIRE( cache.size() == 0 );
+    REQUIRE( cache.get({ 0, 0, 0 }) == nullptr );
+  }
+
+  SECTION("files larger than the capacity are not cached")
+  {
+    FileCache cache(100);
+    cache.put({ 0, 0, 0 }, makeData(101));
+
+    REQUIRE( cache.size() == 0 );
+    REQUIRE( cache.get({ 0, 0, 0 }) == nullptr );
+    REQUIRE( cache.evictions() == 0 );
+  }
+
+  SECTION("zero capacity disables caching")
+  {
+    FileCache cache(0);
+    cache.put({ 0, 0, 0 }, makeData(1));
+
+    REQUIRE( cache.size() == 0 );
+    REQUIRE( cache.get({ 0, 0, 0 }) == nullptr );
+  }
+
+  SECTION("least recently used entry gets evicted")
+  {
+    FileCache cache(30);
+    cache.put({ 0, 0, 0 }, makeData(10));
+    cache.put({ 0, 0, 1 }, makeData(10));
+    cache.put({ 0, 0, 2 }, makeData(10));
+    REQUIRE( cache.size() == 30 );
+
+    // Access first entry, so that the second one is the oldest one.
+    REQUIRE_FALSE( cache.get({ 0, 0, 0 }) == nullptr );
+
+    cache.put({ 0, 0, 3 }, makeData(10));
+    REQUIRE( cache.size() == 30 );
+    REQUIRE( cache.evictions() == 1 );
+
+    REQUIRE( cache.get({ 0, 0, 1 }) == nullptr );
+    REQUIRE_FALSE( cache.get({ 0, 0, 0 }) == nullptr );
+    REQUIRE_FALSE( cache.get({ 0, 0, 2 }) == nullptr );
+    REQUIRE_FALSE( cache.get({ 0, 0, 3 }) == nullptr );
+  }
+
+  SECTION("large entry evicts several smaller ones")
+  {
+    FileCache cache(30);
+    cache.put({ 0, 0, 0 }, makeData(10));
+    cache.put({ 0, 0, 1 }, makeData(10));
+    cache.put({ 0, 0, 2 }, makeData(10));
+
+    cache.put({ 0, 1, 0 }, makeData(25));
+    REQUIRE( cache.size() == 25 );
+    REQUIRE( cache.evictions() == 3 );
+  }
+
+  SECTION("evicted data stays valid for current users")
+  {
+    FileCache cache(10);
+    cache.put({ 0, 0, 0 }, makeData(10));
+    const auto data = cache.get({ 0, 0, 0 });
+
+    cache.put({ 0, 0, 1 }, makeData(10));
+    REQUIRE( cache.get({ 0, 0, 0 }) == nullptr );
+    REQUIRE( data->size() == 10 );
+    REQUIRE( data->at(9) == 10 );
+  }
+
+  SECTION("setCapacity")
+  {
+    FileCache cache(30);
+    cache.put({ 0, 0, 0 }, makeData(10));
+    cache.put({ 0, 0, 1 }, makeData(10));
+    cache.put({ 0, 0, 2 }, makeData(10));
+
+    cache.setCapacity(15);
+    REQUIRE( cache.capacity() == 15 );
+    REQUIRE( cache.size() == 10 );
+    REQUIRE( cache.evictions() == 2 );
+    REQUIRE_FALSE( cache.get({ 0, 0, 2 }) == nullptr );
+  }
+
+  SECTION("clear")
+  {
+    FileCache cache(30);
+    cache.put({ 0, 0, 0 }, makeData(10));
+    REQUIRE_FALSE( cache.get({ 0, 0, 0 }) == nullptr );
+    REQUIRE( cache.get({ 0, 0, 1 }) == nullptr );
+
+    cache.clear();
+    REQUIRE( cache.size() == 0 );
+    REQUIRE( cache.hits() == 0 );
+    REQUIRE( cache.misses() == 0 );
+    REQUIRE( cache.evictions() == 0 );
+    REQUIRE( cache.capacity() == 30 );
+  }
+}
+
+TEST_CASE("SRTP::bsafs::parseSize")
+{
+  using namespace SRTP::bsafs;
+
+  SECTION("invalid values")
+  {
+    REQUIRE_FALSE( parseSize("").has_value() );
+    REQUIRE_FALSE( parseSize("M").has_value() );
+    REQUIRE_FALSE( parseSize("-1").has_value() );
+    REQUIRE_FALSE( parseSize("12T").has_value() );
+    REQUIRE_FALSE( parseSize("1.5G").has_value() );
+    REQUIRE_FALSE( parseSize("abc").has_value() );
+    REQUIRE_FALSE( parseSize("99999999999999999999999").has_value() );
+  }
+
+  SECTION("plain numbers")
+  {
+    REQUIRE( parseSize("0").value() == 0 );
+    REQUIRE( parseSize("1").value() == 1 );
+    REQUIRE( parseSize("123456").value() == 123456 );
+  }
+
+  SECTION("numbers with suffix")
+  {
+    REQUIRE( parseSize("1K").value() == 1024 );
+    REQUIRE( parseSize("2k").value() == 2048 );
+    REQUIRE( parseSize("512M").value() == 512 * 1024 * 1024 );
+    REQUIRE( parseSize("3m").value() == 3 * 1024 * 1024 );
+    REQUIRE( parseSize("1G").value() == 1024 * 1024 * 1024 );
+    REQUIRE( parseSize("0G").value() == 0 );
+  }
+}
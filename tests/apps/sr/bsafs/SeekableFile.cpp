@@ -0,0 +1,247 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../../../lib/locate_catch.hpp"
+#include <algorithm>
+#include "../../../../apps/sr/bsafs/SeekableFile.hpp"
+#include "../../../../lib/base/CompressionFunctions.hpp"
+
+namespace
+{
+
+std::vector<uint8_t> makeContent(const std::size_t size)
+{
+  std::vector<uint8_t> content(size);
+  uint32_t value = 12345;
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    // simple linear congruential generator, limited to a few letters so that
+    // the data is still compressible
+    value = value * 1103515245 + 12345;
+    content[i] = static_cast<uint8_t>('a' + ((value >> 16) % 8));
+  }
+  return content;
+}
+
+std::vector<uint8_t> compress(std::vector<uint8_t>& content)
+{
+  uint32_t compressedSize = 256;
+  uint8_t* compressed = new uint8_t[compressedSize];
+  uint32_t usedSize = 0;
+  const bool success = MWTP::zlibCompress(content.data(), content.size(), compressed, compressedSize, usedSize);
+  std::vector<uint8_t> result;
+  if (success)
+    result.assign(compressed, compressed + usedSize);
+  delete[] compressed;
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("SRTP::bsafs::SeekableFile")
+{
+  using namespace SRTP::bsafs;
+
+  auto content = makeContent(100000);
+  const auto compressed = compress(content);
+  REQUIRE_FALSE( compressed.empty() );
+
+  const auto makeFile = [&compressed](const uint64_t size, const uint64_t interval)
+  {
+    auto start = std::make_unique<MWTP::ZlibStreamDecompressor>();
+    start->feed(compressed.data(), compressed.size());
+    return std::make_shared<SeekableFile>(std::move(start), size, interval, 100);
+  };
+
+  SECTION("sequential reads return the whole content")
+  {
+    auto file = makeFile(content.size(), 8192);
+    REQUIRE( file->size() == 100000 );
+    REQUIRE( file->checkpoints() == 1 );
+
+    std::vector<uint8_t> result;
+    std::vector<uint8_t> buffer(3000);
+    uint64_t offset = 0;
+    while (offset < content.size())
+    {
+      const auto bytes_read = file->read(buffer.data(), buffer.size(), offset);
+      REQUIRE( bytes_read.has_value() );
+      REQUIRE( bytes_read.value() > 0 );
+      result.insert(result.end(), buffer.begin(), buffer.begin() + bytes_read.value());
+      offset += bytes_read.value();
+    }
+    REQUIRE( result == content );
+    // one checkpoint at the start and one after each full interval
+    REQUIRE( file->checkpoints() == 13 );
+  }
+
+  SECTION("random access reads")
+  {
+    auto file = makeFile(content.size(), 8192);
+    std::vector<uint8_t> buffer(500);
+
+    // Read near the end first, which creates the checkpoints before it.
+    auto bytes_read = file->read(buffer.data(), buffer.size(), 90000);
+    REQUIRE( bytes_read == 500 );
+    REQUIRE( std::equal(buffer.begin(), buffer.end(), content.begin() + 90000) );
+    REQUIRE( file->checkpoints() == 12 );
+
+    // Jump back and forth.
+    for (const uint64_t offset: { 100, 50000, 49999, 8192, 99800 })
+    {
+      bytes_read = file->read(buffer.data(), buffer.size(), offset);
+      REQUIRE( bytes_read.has_value() );
+      const std::size_t expected = std::min<std::size_t>(500, content.size() - offset);
+      REQUIRE( bytes_read.value() == expected );
+      REQUIRE( std::equal(buffer.begin(), buffer.begin() + expected, content.begin() + offset) );
+    }
+    // Reads passed all multiples of the interval up to offset 100000.
+    REQUIRE( file->checkpoints() == 13 );
+  }
+
+  SECTION("number of checkpoints is limited")
+  {
+    auto start = std::make_unique<MWTP::ZlibStreamDecompressor>();
+    start->feed(compressed.data(), compressed.size());
+    SeekableFile file(std::move(start), content.size(), 8192, 4);
+    // Interval is increased, so that four checkpoints cover the whole file.
+    REQUIRE( file.interval() == 25000 );
+
+    std::vector<uint8_t> result;
+    std::vector<uint8_t> buffer(3000);
+    uint64_t offset = 0;
+    while (offset < content.size())
+    {
+      const auto bytes_read = file.read(buffer.data(), buffer.size(), offset);
+      REQUIRE( bytes_read.has_value() );
+      REQUIRE( bytes_read.value() > 0 );
+      result.insert(result.end(), buffer.begin(), buffer.begin() + bytes_read.value());
+      offset += bytes_read.value();
+    }
+    REQUIRE( result == content );
+    REQUIRE( file.checkpoints() == 4 );
+
+    // Reads still return the right data after jumping back.
+    const auto bytes_read = file.read(buffer.data(), 500, 60000);
+    REQUIRE( bytes_read == 500 );
+    REQUIRE( std::equal(buffer.begin(), buffer.begin() + 500, content.begin() + 60000) );
+  }
+
+  SECTION("small files keep the interval")
+  {
+    auto file = makeFile(content.size(), 8192);
+    REQUIRE( file->interval() == 8192 );
+  }
+
+  SECTION("read at or beyond the end returns zero bytes")
+  {
+    auto file = makeFile(content.size(), 8192);
+    uint8_t buffer[10];
+    REQUIRE( file->read(buffer, 10, 100000) == 0 );
+    REQUIRE( file->read(buffer, 10, 200000) == 0 );
+    REQUIRE( file->read(buffer, 0, 10) == 0 );
+  }
+
+  SECTION("truncated data fails")
+  {
+    auto start = std::make_unique<MWTP::ZlibStreamDecompressor>();
+    start->feed(compressed.data(), compressed.size() / 2);
+    SeekableFile file(std::move(start), content.size(), 8192, 100);
+
+    std::vector<uint8_t> buffer(1000);
+    REQUIRE( file.read(buffer.data(), buffer.size(), 0).has_value() );
+    REQUIRE_FALSE( file.read(buffer.data(), buffer.size(), 99000).has_value() );
+  }
+
+  SECTION("missing decompressor fails")
+  {
+    SeekableFile file(nullptr, 100, 10, 100);
+    uint8_t buffer[10];
+    REQUIRE_FALSE( file.read(buffer, 10, 0).has_value() );
+    REQUIRE( file.checkpoints() == 0 );
+  }
+}
+
+TEST_CASE("SRTP::bsafs::SeekableFileCache")
+{
+  using namespace SRTP::bsafs;
+
+  const auto makeFile = []()
+  {
+    return std::make_shared<SeekableFile>(std::make_unique<MWTP::ZlibStreamDecompressor>(), 100, 10, 10);
+  };
+
+  SECTION("put and get")
+  {
+    SeekableFileCache cache(4);
+    REQUIRE( cache.get({ 0, 1, 2 }) == nullptr );
+
+    const auto file = makeFile();
+    REQUIRE( cache.put({ 0, 1, 2 }, file) == file );
+    REQUIRE( cache.size() == 1 );
+    REQUIRE( cache.get({ 0, 1, 2 }) == file );
+    // Indexes are not interchangeable.
+    REQUIRE( cache.get({ 0, 2, 1 }) == nullptr );
+    REQUIRE( cache.get({ 1, 1, 2 }) == nullptr );
+  }
+
+  SECTION("existing entry is kept")
+  {
+    SeekableFileCache cache(4);
+    const auto first = makeFile();
+    const auto second = makeFile();
+    REQUIRE( cache.put({ 0, 1, 2 }, first) == first );
+    REQUIRE( cache.put({ 0, 1, 2 }, second) == first );
+    REQUIRE( cache.size() == 1 );
+  }
+
+  SECTION("least recently used entry is evicted")
+  {
+    SeekableFileCache cache(2);
+    cache.put({ 0, 0, 1 }, makeFile());
+    cache.put({ 0, 0, 2 }, makeFile());
+    // use first entry, so that the second one is the oldest
+    REQUIRE( cache.get({ 0, 0, 1 }) != nullptr );
+    cache.put({ 0, 0, 3 }, makeFile());
+
+    REQUIRE( cache.size() == 2 );
+    REQUIRE( cache.get({ 0, 0, 1 }) != nullptr );
+    REQUIRE( cache.get({ 0, 0, 2 }) == nullptr );
+    REQUIRE( cache.get({ 0, 0, 3 }) != nullptr );
+  }
+
+  SECTION("zero capacity keeps nothing")
+  {
+    SeekableFileCache cache(0);
+    const auto file = makeFile();
+    REQUIRE( cache.put({ 0, 0, 1 }, file) == file );
+    REQUIRE( cache.size() == 0 );
+    REQUIRE( cache.get({ 0, 0, 1 }) == nullptr );
+  }
+
+  SECTION("clear")
+  {
+    SeekableFileCache cache(2);
+    cache.put({ 0, 0, 1 }, makeFile());
+    cache.clear();
+    REQUIRE( cache.size() == 0 );
+    REQUIRE( cache.get({ 0, 0, 1 }) == nullptr );
+  }
+}
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for Skyrim Tools Project.
-    Copyright (C) 2024  Dirk Stolle
+    Copyright (C) 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -38,6 +38,22 @@ TEST_CASE("SRTP::bsafs")
     REQUIRE( version.substr(0, 2) == "3." );
   }
 
+  SECTION("runs_in_foreground")
+  {
+    REQUIRE_FALSE( runs_in_foreground({ }) );
+    REQUIRE_FALSE( runs_in_foreground({ "/mnt/bsa" }) );
+    REQUIRE_FALSE( runs_in_foreground({ "-s", "/mnt/bsa" }) );
+    REQUIRE_FALSE( runs_in_foreground({ "-o", "allow_other", "/mnt/bsa" }) );
+    REQUIRE_FALSE( runs_in_foreground({ "-o", "debugging", "/mnt/bsa" }) );
+    REQUIRE_FALSE( runs_in_foreground({ "-o" }) );
+
+    REQUIRE( runs_in_foreground({ "-f", "/mnt/bsa" }) );
+    REQUIRE( runs_in_foreground({ "/mnt/bsa", "-d" }) );
+    REQUIRE( runs_in_foreground({ "-o", "debug", "/mnt/bsa" }) );
+    REQUIRE( runs_in_foreground({ "-o", "allow_other,debug", "/mnt/bsa" }) );
+    REQUIRE( runs_in_foreground({ "-odebug,ro", "/mnt/bsa" }) );
+  }
+
   SECTION("file operations")
   {
     SECTION("bsa_chmod")
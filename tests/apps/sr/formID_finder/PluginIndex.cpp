@@ -0,0 +1,205 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../../../lib/locate_catch.hpp"
+#include <filesystem>
+#include <fstream>
+#include "../../../../apps/sr/formID_finder/PluginIndex.hpp"
+#include "../../../../lib/base/FileGuard.hpp"
+#include "../../../../lib/sr/SR_Constants.hpp"
+
+TEST_CASE("PluginIndex")
+{
+  using namespace SRTP;
+
+  SECTION("IndexKey")
+  {
+    const std::string plugin = "test_formID_finder_index_key.esp";
+    MWTP::FileGuard guard{plugin};
+    {
+      std::ofstream stream(plugin, std::ios::out | std::ios::binary);
+      stream.write("TES4", 4);
+    }
+
+    SECTION("forFile")
+    {
+      const auto key = IndexKey::forFile(plugin, Localization::German);
+      REQUIRE( key.has_value() );
+      REQUIRE( key.value().path == plugin );
+      REQUIRE( key.value().size == 4 );
+      REQUIRE( key.value().language == "german" );
+      REQUIRE( key.value() == IndexKey::forFile(plugin, Localization::German).value() );
+      REQUIRE_FALSE( key.value() == IndexKey::forFile(plugin, Localization::English).value() );
+      REQUIRE( IndexKey::forFile(plugin, std::nullopt).value().language == "default" );
+    }
+
+    SECTION("forFile: file does not exist")
+    {
+      REQUIRE_FALSE( IndexKey::forFile("does-not-exist.esp", std::nullopt).has_value() );
+    }
+
+    SECTION("cacheFileName")
+    {
+      const auto key = IndexKey::forFile(plugin, Localization::German).value();
+      const auto name = key.cacheFileName();
+      REQUIRE( name.find(plugin) == 0 );
+      REQUIRE( name != IndexKey::forFile(plugin, Localization::English).value().cacheFileName() );
+      REQUIRE( name == IndexKey::forFile(plugin, Localization::German).value().cacheFileName() );
+    }
+  }
+
+  SECTION("save and load")
+  {
+    const std::filesystem::path cacheFile = "test_formID_finder_index.fidx";
+    MWTP::FileGuard guard{cacheFile};
+
+    const IndexKey key{ "Data/Foo.esp", 1234, 5678, "english" };
+    const std::vector<std::string> loadOrder = { "Skyrim.esm", "Update.esm", "Foo.esp" };
+
+    PluginIndex index(true);
+    PluginIndex::Record faction;
+    faction.recName = cFACT;
+    faction.formID = 0x02000D62;
+    faction.editorID = "FooFaction";
+    faction.name = "Foo";
+    faction.ranks.push_back(PluginIndex::Rank{ 0, "Squire", std::nullopt });
+    index.addRecord(faction);
+    PluginIndex::Record quest;
+    quest.recName = cQUST;
+    quest.formID = 0x00012345;
+    quest.editorID = "FooQuest";
+    quest.stages.push_back(PluginIndex::Stage{ 10, { PluginIndex::LogEntry{ true, "Done." } } });
+    quest.objectives.push_back(PluginIndex::Objective{ 10, "Do it" });
+    index.addRecord(quest);
+    CellRecord cell;
+    cell.headerFormID = 0x02001000;
+    cell.gridLocation.presence = true;
+    cell.gridLocation.locationX = -3;
+    cell.gridLocation.locationY = 7;
+    index.addCell(cell);
+    index.addReference(0x00012345, 0x02001000, 0x02001001);
+
+    REQUIRE( index.save(cacheFile, key, loadOrder) );
+    REQUIRE_FALSE( std::filesystem::exists(cacheFile.string() + ".tmp") );
+
+    SECTION("load with same load order")
+    {
+      PluginIndex loaded;
+      REQUIRE( loaded.load(cacheFile, key, loadOrder, true) );
+      REQUIRE( loaded.hasReferences() );
+
+      REQUIRE( loaded.records().size() == 2 );
+      const auto& f = loaded.records()[0];
+      REQUIRE( f.recName == cFACT );
+      REQUIRE( f.formID == 0x02000D62 );
+      REQUIRE( f.editorID == "FooFaction" );
+      REQUIRE( f.name == "Foo" );
+      REQUIRE( f.ranks.size() == 1 );
+      REQUIRE( f.ranks[0].maleName == "Squire" );
+      REQUIRE_FALSE( f.ranks[0].femaleName.has_value() );
+      const auto& q = loaded.records()[1];
+      REQUIRE( q.recName == cQUST );
+      REQUIRE_FALSE( q.name.has_value() );
+      REQUIRE( q.stages.size() == 1 );
+      REQUIRE( q.stages[0].index == 10 );
+      REQUIRE( q.stages[0].logEntries.size() == 1 );
+      REQUIRE( q.stages[0].logEntries[0].finishes );
+      REQUIRE( q.stages[0].logEntries[0].text == "Done." );
+      REQUIRE( q.objectives.size() == 1 );
+      REQUIRE( q.objectives[0].text == "Do it" );
+
+      REQUIRE( loaded.cells().size() == 1 );
+      REQUIRE( loaded.cells()[0].formID == 0x02001000 );
+      REQUIRE_FALSE( loaded.cells()[0].name.has_value() );
+      REQUIRE( loaded.cells()[0].grid == std::make_pair(-3, 7) );
+
+      REQUIRE( loaded.references().size() == 1 );
+      REQUIRE( loaded.references()[0].baseID == 0x00012345 );
+      REQUIRE( loaded.references()[0].cellID == 0x02001000 );
+      REQUIRE( loaded.references()[0].refID == 0x02001001 );
+    }
+
+    SECTION("form IDs follow changes of the load order")
+    {
+      const std::vector<std::string> newOrder = { "Skyrim.esm", "Update.esm", "Bar.esp", "Foo.esp" };
+      PluginIndex loaded;
+      REQUIRE( loaded.load(cacheFile, key, newOrder, true) );
+      REQUIRE( loaded.records()[0].formID == 0x03000D62 );
+      REQUIRE( loaded.records()[1].formID == 0x00012345 );
+      REQUIRE( loaded.cells()[0].formID == 0x03001000 );
+      REQUIRE( loaded.references()[0].refID == 0x03001001 );
+    }
+
+    SECTION("fails when a file is not in the load order anymore")
+    {
+      PluginIndex loaded;
+      REQUIRE_FALSE( loaded.load(cacheFile, key, { "Update.esm", "Foo.esp" }, true) );
+    }
+
+    SECTION("fails when key does not match")
+    {
+      PluginIndex loaded;
+      IndexKey other = key;
+      other.modified = 5679;
+      REQUIRE_FALSE( loaded.load(cacheFile, other, loadOrder, true) );
+      other = key;
+      other.size = 1235;
+      REQUIRE_FALSE( loaded.load(cacheFile, other, loadOrder, true) );
+      other = key;
+      other.language = "german";
+      REQUIRE_FALSE( loaded.load(cacheFile, other, loadOrder, true) );
+    }
+
+    SECTION("fails when references are required but missing")
+    {
+      PluginIndex noRefs(false);
+      REQUIRE( noRefs.save(cacheFile, key, loadOrder) );
+      PluginIndex loaded;
+      REQUIRE( loaded.load(cacheFile, key, loadOrder, false) );
+      REQUIRE_FALSE( loaded.load(cacheFile, key, loadOrder, true) );
+    }
+
+    SECTION("fails for truncated file")
+    {
+      std::filesystem::resize_file(cacheFile, std::filesystem::file_size(cacheFile) - 5);
+      PluginIndex loaded;
+      REQUIRE_FALSE( loaded.load(cacheFile, key, loadOrder, true) );
+      REQUIRE( loaded.records().empty() );
+    }
+
+    SECTION("fails for missing file")
+    {
+      PluginIndex loaded;
+      REQUIRE_FALSE( loaded.load("does-not-exist.fidx", key, loadOrder, false) );
+    }
+  }
+
+  SECTION("save fails when form ID does not match the load order")
+  {
+    PluginIndex index;
+    PluginIndex::Record record;
+    record.recName = cWEAP;
+    record.formID = 0x05000001;
+    index.addRecord(record);
+    const IndexKey key{ "Foo.esp", 1, 2, "english" };
+    REQUIRE_FALSE( index.save("test_formID_finder_index_invalid.fidx", key, { "Skyrim.esm" }) );
+    REQUIRE_FALSE( std::filesystem::exists("test_formID_finder_index_invalid.fidx") );
+  }
+}
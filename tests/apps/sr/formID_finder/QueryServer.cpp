@@ -0,0 +1,131 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../../../lib/locate_catch.hpp"
+#include "../../../../apps/sr/formID_finder/QueryServer.hpp"
+
+TEST_CASE("QueryServer")
+{
+  using namespace SRTP;
+
+  SearchOptions defaults;
+  defaults.withReferences = true;
+
+  SECTION("parseRequest")
+  {
+    SECTION("search with keyword only")
+    {
+      const auto request = QueryServer::parseRequest("search Iron Sword", defaults);
+      REQUIRE( request.has_value() );
+      REQUIRE( request.value().command == QueryServer::Command::Search );
+      // keyword is converted to lower case
+      REQUIRE( request.value().options.keyword == "iron sword" );
+      REQUIRE_FALSE( request.value().options.caseSensitive );
+      REQUIRE_FALSE( request.value().options.allQuestInfo );
+      REQUIRE_FALSE( request.value().options.listFactionRanks );
+      REQUIRE_FALSE( request.value().options.showFiles );
+      // defaults are kept
+      REQUIRE( request.value().options.withReferences );
+    }
+
+    SECTION("search with surrounding white space")
+    {
+      const auto request = QueryServer::parseRequest("  search \t Iron\n", defaults);
+      REQUIRE( request.has_value() );
+      REQUIRE( request.value().command == QueryServer::Command::Search );
+      REQUIRE( request.value().options.keyword == "iron" );
+    }
+
+    SECTION("search with all options")
+    {
+      const auto request = QueryServer::parseRequest("search --all-quest-info --faction-ranks --show-files --case-sensitive Iron Sword", defaults);
+      REQUIRE( request.has_value() );
+      REQUIRE( request.value().command == QueryServer::Command::Search );
+      REQUIRE( request.value().options.caseSensitive );
+      REQUIRE( request.value().options.allQuestInfo );
+      REQUIRE( request.value().options.listFactionRanks );
+      REQUIRE( request.value().options.showFiles );
+      // case-sensitive keyword is not converted
+      REQUIRE( request.value().options.keyword == "Iron Sword" );
+    }
+
+    SECTION("search with --ranks as short form of --faction-ranks")
+    {
+      const auto request = QueryServer::parseRequest("search --ranks Guild", defaults);
+      REQUIRE( request.has_value() );
+      REQUIRE( request.value().options.listFactionRanks );
+      REQUIRE( request.value().options.keyword == "guild" );
+    }
+
+    SECTION("search with unknown option fails")
+    {
+      REQUIRE_FALSE( QueryServer::parseRequest("search --foo Iron", defaults).has_value() );
+    }
+
+    SECTION("search without keyword fails")
+    {
+      REQUIRE_FALSE( QueryServer::parseRequest("search", defaults).has_value() );
+      REQUIRE_FALSE( QueryServer::parseRequest("search   ", defaults).has_value() );
+      REQUIRE_FALSE( QueryServer::parseRequest("search --show-files", defaults).has_value() );
+    }
+
+    SECTION("reload")
+    {
+      const auto request = QueryServer::parseRequest("reload", defaults);
+      REQUIRE( request.has_value() );
+      REQUIRE( request.value().command == QueryServer::Command::Reload );
+
+      REQUIRE( QueryServer::parseRequest(" reload\n", defaults).has_value() );
+    }
+
+    SECTION("shutdown")
+    {
+      const auto request = QueryServer::parseRequest("shutdown", defaults);
+      REQUIRE( request.has_value() );
+      REQUIRE( request.value().command == QueryServer::Command::Shutdown );
+    }
+
+    SECTION("reload and shutdown with trailing text fail")
+    {
+      REQUIRE_FALSE( QueryServer::parseRequest("reload now", defaults).has_value() );
+      REQUIRE_FALSE( QueryServer::parseRequest("shutdown --force", defaults).has_value() );
+    }
+
+    SECTION("unknown or empty request fails")
+    {
+      REQUIRE_FALSE( QueryServer::parseRequest("", defaults).has_value() );
+      REQUIRE_FALSE( QueryServer::parseRequest("find Iron", defaults).has_value() );
+      // commands are case-sensitive
+      REQUIRE_FALSE( QueryServer::parseRequest("SEARCH Iron", defaults).has_value() );
+    }
+  }
+
+  SECTION("answer: invalid requests")
+  {
+    SearchData data({ }, SearchData::Settings());
+    QueryServer server(data, defaults);
+
+    REQUIRE( server.answer("") == "error: invalid request" );
+    REQUIRE( server.answer("search") == "error: invalid request" );
+    REQUIRE( server.answer("search --foo Iron") == "error: invalid request" );
+    REQUIRE( server.answer("reload now") == "error: invalid request" );
+    REQUIRE( server.answer("find Iron") == "error: invalid request" );
+  }
+}
@@ -0,0 +1,257 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../lib/sr/ReturnCodes.hpp"
+#include "../../lib/sr/bsa/BSA.hpp"
+#include "../../lib/sr/bsa/BSAHash.hpp"
+
+namespace
+{
+
+/* Hash calculation as it was done before the batch functions were added. It
+   is kept here as baseline for the comparison. */
+SRTP::BSAHash referenceHash(const std::filesystem::path& path)
+{
+  std::string ext = path.extension().string();
+  std::string stem = path.string();
+  stem.erase(stem.size() - ext.size());
+
+  auto lower_case = [](unsigned char c)
+  {
+    return std::tolower(c);
+  };
+  std::transform(stem.cbegin(), stem.cend(), stem.begin(), lower_case);
+  std::transform(ext.cbegin(), ext.cend(), ext.begin(), lower_case);
+
+  std::vector<std::uint8_t> ordinal_values;
+  std::transform(stem.cbegin(), stem.cend(), std::back_inserter(ordinal_values),
+                 [](unsigned char c)
+                 {
+                   return c;
+                 });
+
+  const auto ord_size = ordinal_values.size();
+  const std::uint8_t c1 = ord_size >= 1 ? ordinal_values[ord_size - 1] : 0;
+  const std::uint8_t c2 = ord_size >= 2 ? ordinal_values[ord_size - 2] : 0;
+  const std::uint8_t c0 = ord_size > 0 ? ordinal_values[0] : 0;
+  std::uint32_t first_hash = static_cast<std::uint32_t>(c1)
+                           | (static_cast<std::uint32_t>(c2) << 8)
+                           | (static_cast<std::uint32_t>(ord_size) << 16)
+                           | (static_cast<std::uint32_t>(c0) << 24);
+  if (ext == ".kf")
+    first_hash |= static_cast<std::uint32_t>(0x80);
+  else if (ext == ".nif")
+    first_hash |= static_cast<std::uint32_t>(0x8000);
+  else if (ext == ".dds")
+    first_hash |= static_cast<std::uint32_t>(0x8080);
+  else if (ext == ".wav")
+    first_hash |= static_cast<std::uint32_t>(0x80000000UL);
+
+  std::uint32_t second_hash = 0;
+  decltype(ord_size) limit = ord_size >= 2 ? ord_size - 2 : 0;
+  for (decltype(ordinal_values)::size_type i = 1; i < limit; ++i)
+  {
+    second_hash = (second_hash * 0x1003f) + ordinal_values[i];
+  }
+
+  ordinal_values.clear();
+  std::transform(ext.cbegin(), ext.cend(), std::back_inserter(ordinal_values),
+                 [](unsigned char c)
+                 {
+                   return c;
+                 });
+  std::uint32_t third_hash = 0;
+  for (decltype(ordinal_values)::size_type i = 0; i < ordinal_values.size(); ++i)
+  {
+    third_hash = (third_hash * 0x1003f) + ordinal_values[i];
+  }
+  second_hash += third_hash;
+  return (static_cast<SRTP::BSAHash>(second_hash) << 32) + first_hash;
+}
+
+SRTP::BSAHash referenceDirectoryHash(std::string directoryName)
+{
+  for (auto pos = directoryName.find('/'); pos != std::string::npos; pos = directoryName.find('/', pos))
+  {
+     directoryName.replace(pos, 1, 1, '\\');
+  }
+  return referenceHash(directoryName);
+}
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(const Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+void showHelp()
+{
+  std::cout << "\nbench_bsa_hash BSA_FILE [ROUNDS]\n"
+            << "\n"
+            << "Calculates the hashes of all file and directory names in the\n"
+            << "archive BSA_FILE with the previous implementation and with the\n"
+            << "batch functions, and shows the time that each of them needs.\n"
+            << "\n"
+            << "options:\n"
+            << "  --help             - displays this help message and quits\n"
+            << "  -?                 - same as --help\n"
+            << "  --version          - displays the version of the programme and quits\n"
+            << "  BSA_FILE           - path of the archive, preferably a large one\n"
+            << "                       that comes with the game\n"
+            << "  ROUNDS             - number of times that all names are hashed,\n"
+            << "                       default is 100\n";
+}
+
+void showVersion()
+{
+  std::cout << "Benchmark for BSA hash calculation, version 0.1.0, 2026-10-17\n";
+}
+
+int main(int argc, char **argv)
+{
+  std::string bsaFileName;
+  unsigned long rounds = 100;
+
+  if ((argc < 2) || (argv == nullptr) || (argv[1] == nullptr))
+  {
+    std::cout << "You have to specify certain parameters for this programme to run properly.\n"
+              << "Use --help to get a list of valid parameters.\n";
+    return SRTP::rcInvalidParameter;
+  }
+  const std::string param = std::string(argv[1]);
+  if ((param == "--help") || (param == "-?") || (param == "/?"))
+  {
+    showHelp();
+    return 0;
+  }
+  if (param == "--version")
+  {
+    showVersion();
+    return 0;
+  }
+  bsaFileName = param;
+  if ((argc > 2) && (argv[2] != nullptr))
+  {
+    try
+    {
+      rounds = std::stoul(argv[2]);
+    }
+    catch (...)
+    {
+      rounds = 0;
+    }
+    if (rounds == 0)
+    {
+      std::cerr << "Error: \"" << argv[2] << "\" is not a valid number of rounds.\n";
+      return SRTP::rcInvalidParameter;
+    }
+  }
+
+  SRTP::BSA bsa;
+  if (!bsa.open(bsaFileName) || !bsa.grabAllStructureData())
+  {
+    std::cerr << "Error: Could not read the archive " << bsaFileName << ".\n";
+    return SRTP::rcFileError;
+  }
+
+  // Collect the names, both as separate strings and as contiguous buffers
+  // like the file name block of an archive.
+  std::vector<std::string> directoryNames;
+  std::vector<std::string> fileNames;
+  std::string directoryBuffer;
+  std::string fileBuffer;
+  std::vector<SRTP::BSAHash> storedFileHashes;
+  for (const auto& block: bsa.getDirectoryBlocks())
+  {
+    directoryNames.push_back(block.name);
+    directoryBuffer.append(block.name).push_back('\0');
+    for (const auto& file: block.files)
+    {
+      fileNames.push_back(file.fileName);
+      fileBuffer.append(file.fileName).push_back('\0');
+      storedFileHashes.push_back(file.nameHash);
+    }
+  }
+  std::cout << "Archive contains " << directoryNames.size() << " directories and "
+            << fileNames.size() << " files.\n";
+  if (fileNames.empty())
+  {
+    std::cout << "Hint: There are no files, nothing to do here!\n";
+    return 0;
+  }
+
+  std::vector<SRTP::BSAHash> referenceFiles(fileNames.size());
+  std::vector<SRTP::BSAHash> referenceDirectories(directoryNames.size());
+  auto start = Clock::now();
+  for (unsigned long round = 0; round < rounds; ++round)
+  {
+    for (std::size_t i = 0; i < fileNames.size(); ++i)
+      referenceFiles[i] = referenceHash(fileNames[i]);
+    for (std::size_t i = 0; i < directoryNames.size(); ++i)
+      referenceDirectories[i] = referenceDirectoryHash(directoryNames[i]);
+  }
+  const double referenceTime = millisecondsSince(start);
+
+  std::vector<SRTP::BSAHash> batchFiles(fileNames.size());
+  std::vector<SRTP::BSAHash> batchDirectories(directoryNames.size());
+  start = Clock::now();
+  for (unsigned long round = 0; round < rounds; ++round)
+  {
+    SRTP::calculateFileNameHashes(fileBuffer, batchFiles.data(), batchFiles.size());
+    SRTP::calculateDirectoryNameHashes(directoryBuffer, batchDirectories.data(), batchDirectories.size());
+  }
+  const double batchTime = millisecondsSince(start);
+
+  if ((batchFiles != referenceFiles) || (batchDirectories != referenceDirectories))
+  {
+    std::cerr << "Error: The batch functions calculated different hashes than the "
+              << "previous implementation!\n";
+    return SRTP::rcDataError;
+  }
+  std::size_t mismatches = 0;
+  for (std::size_t i = 0; i < storedFileHashes.size(); ++i)
+  {
+    if (storedFileHashes[i] != batchFiles[i])
+      ++mismatches;
+  }
+
+  const double names = static_cast<double>(rounds) * (fileNames.size() + directoryNames.size());
+  std::cout << "Hashed all names " << rounds << " times.\n"
+            << "    previous implementation: " << referenceTime << " ms ("
+            << referenceTime * 1000000.0 / names << " ns per name)\n"
+            << "    batch functions:         " << batchTime << " ms ("
+            << batchTime * 1000000.0 / names << " ns per name)\n";
+  if (batchTime > 0.0)
+  {
+    std::cout << "    speed-up:                " << referenceTime / batchTime << "\n";
+  }
+  std::cout << "Files with hashes that differ from the archive: " << mismatches << "\n";
+
+  return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../locate_catch.hpp"
+#include "../../../lib/base/ByteView.hpp"
+
+TEST_CASE("ByteView")
+{
+  using namespace MWTP;
+
+  const uint8_t bytes[] = { 1, 2, 3, 4, 5 };
+
+  SECTION("default constructor creates empty view")
+  {
+    const ByteView view;
+    REQUIRE( view.data() == nullptr );
+    REQUIRE( view.size() == 0 );
+    REQUIRE( view.empty() );
+    REQUIRE( view.begin() == view.end() );
+  }
+
+  SECTION("view of memory")
+  {
+    const ByteView view(bytes, 5);
+    REQUIRE( view.data() == bytes );
+    REQUIRE( view.size() == 5 );
+    REQUIRE_FALSE( view.empty() );
+    REQUIRE( view[0] == 1 );
+    REQUIRE( view[4] == 5 );
+    REQUIRE( view.end() - view.begin() == 5 );
+  }
+
+  SECTION("subView")
+  {
+    const ByteView view(bytes, 5);
+
+    SECTION("range within bounds")
+    {
+      const auto sub = view.subView(1, 3);
+      REQUIRE( sub.data() == bytes + 1 );
+      REQUIRE( sub.size() == 3 );
+      REQUIRE( sub[0] == 2 );
+      REQUIRE( sub[2] == 4 );
+    }
+
+    SECTION("count exceeds the end")
+    {
+      const auto sub = view.subView(3, 10);
+      REQUIRE( sub.data() == bytes + 3 );
+      REQUIRE( sub.size() == 2 );
+    }
+
+    SECTION("offset exceeds the end")
+    {
+      const auto sub = view.subView(7, 1);
+      REQUIRE( sub.data() == bytes + 5 );
+      REQUIRE( sub.empty() );
+    }
+  }
+}
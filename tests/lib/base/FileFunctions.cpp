@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for Morrowind Tools Project.
-    Copyright (C) 2021, 2022  Dirk Stolle
+    Copyright (C) 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -56,6 +56,19 @@ TEST_CASE("FileFunctions")
     }
   }
 
+  SECTION("temporaryFileName")
+  {
+    const std::string fileName = test_directory + "some.cache";
+    const auto first = temporaryFileName(fileName);
+    const auto second = temporaryFileName(fileName);
+    // Name starts with the original file name and ends with ".tmp".
+    REQUIRE( first.find(fileName + ".") == 0 );
+    REQUIRE( first.size() > fileName.size() + 5 );
+    REQUIRE( first.substr(first.size() - 4) == ".tmp" );
+    // Each call gets a different name.
+    REQUIRE( first != second );
+  }
+
   SECTION("FileExists")
   {
     SECTION("known existing files")
@@ -0,0 +1,111 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../locate_catch.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include "../../../lib/base/FileGuard.hpp"
+#include "../../../lib/base/MappedFile.hpp"
+
+TEST_CASE("MappedFile")
+{
+  using namespace MWTP;
+
+  const auto temp = std::filesystem::temp_directory_path();
+
+  SECTION("default constructor")
+  {
+    const MappedFile file;
+    REQUIRE_FALSE( file.isOpen() );
+    REQUIRE( file.data() == nullptr );
+    REQUIRE( file.size() == 0 );
+    REQUIRE( file.view().empty() );
+  }
+
+  SECTION("open non-existing file")
+  {
+    MappedFile file;
+    REQUIRE_FALSE( file.open(temp / "MappedFile_does_not_exist.bin") );
+    REQUIRE_FALSE( file.isOpen() );
+  }
+
+  SECTION("open empty file")
+  {
+    const auto path = temp / "MappedFile_empty.bin";
+    FileGuard guard{path};
+    {
+      std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+      REQUIRE( stream.good() );
+    }
+
+    MappedFile file;
+    REQUIRE( file.open(path) );
+    REQUIRE( file.isOpen() );
+    REQUIRE( file.size() == 0 );
+  }
+
+  SECTION("open file with content")
+  {
+    const auto path = temp / "MappedFile_content.bin";
+    FileGuard guard{path};
+    {
+      std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+      stream.write("This is a test.", 15);
+      REQUIRE( stream.good() );
+    }
+
+    MappedFile file;
+    REQUIRE( file.open(path) );
+    REQUIRE( file.isOpen() );
+    REQUIRE( file.size() == 15 );
+    REQUIRE( file.data() != nullptr );
+    REQUIRE( std::memcmp(file.data(), "This is a test.", 15) == 0 );
+    REQUIRE( file.view().size() == 15 );
+    REQUIRE( file.view()[14] == '.' );
+
+    SECTION("close")
+    {
+      file.close();
+      REQUIRE_FALSE( file.isOpen() );
+      REQUIRE( file.data() == nullptr );
+      REQUIRE( file.size() == 0 );
+    }
+
+    SECTION("move constructor")
+    {
+      MappedFile other(std::move(file));
+      REQUIRE( other.isOpen() );
+      REQUIRE( other.size() == 15 );
+      REQUIRE( std::memcmp(other.data(), "This is a test.", 15) == 0 );
+      REQUIRE_FALSE( file.isOpen() );
+      REQUIRE( file.data() == nullptr );
+    }
+
+    SECTION("move assignment")
+    {
+      MappedFile other;
+      other = std::move(file);
+      REQUIRE( other.isOpen() );
+      REQUIRE( other.size() == 15 );
+      REQUIRE_FALSE( file.isOpen() );
+    }
+  }
+}
@@ -0,0 +1,144 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../locate_catch.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "../../../lib/base/FileGuard.hpp"
+#include "../../../lib/base/PositionalFile.hpp"
+
+TEST_CASE("PositionalFile")
+{
+  using namespace MWTP;
+
+  const auto temp = std::filesystem::temp_directory_path();
+
+  SECTION("default constructor")
+  {
+    const PositionalFile file;
+    REQUIRE_FALSE( file.isOpen() );
+    REQUIRE( file.size() == 0 );
+    uint8_t buffer[4];
+    REQUIRE_FALSE( file.readAt(0, buffer, 4) );
+  }
+
+  SECTION("open non-existing file")
+  {
+    PositionalFile file;
+    REQUIRE_FALSE( file.open(temp / "PositionalFile_does_not_exist.bin") );
+    REQUIRE_FALSE( file.isOpen() );
+  }
+
+  SECTION("open file with content")
+  {
+    const auto path = temp / "PositionalFile_content.bin";
+    FileGuard guard{path};
+    {
+      std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+      stream.write("This is a test.", 15);
+      REQUIRE( stream.good() );
+    }
+
+    PositionalFile file;
+    REQUIRE( file.open(path) );
+    REQUIRE( file.isOpen() );
+    REQUIRE( file.size() == 15 );
+
+    SECTION("read at various offsets")
+    {
+      char buffer[16] = { 0 };
+      REQUIRE( file.readAt(10, reinterpret_cast<uint8_t*>(buffer), 5) );
+      REQUIRE( std::memcmp(buffer, "test.", 5) == 0 );
+      REQUIRE( file.readAt(0, reinterpret_cast<uint8_t*>(buffer), 4) );
+      REQUIRE( std::memcmp(buffer, "This", 4) == 0 );
+      REQUIRE( file.readAt(0, reinterpret_cast<uint8_t*>(buffer), 15) );
+      REQUIRE( std::memcmp(buffer, "This is a test.", 15) == 0 );
+      // reading nothing at the end is fine
+      REQUIRE( file.readAt(15, reinterpret_cast<uint8_t*>(buffer), 0) );
+    }
+
+    SECTION("read beyond the end fails")
+    {
+      uint8_t buffer[16];
+      REQUIRE_FALSE( file.readAt(10, buffer, 6) );
+      REQUIRE_FALSE( file.readAt(16, buffer, 1) );
+      REQUIRE_FALSE( file.readAt(0, buffer, 16) );
+    }
+
+    SECTION("close")
+    {
+      file.close();
+      REQUIRE_FALSE( file.isOpen() );
+      REQUIRE( file.size() == 0 );
+      uint8_t buffer[4];
+      REQUIRE_FALSE( file.readAt(0, buffer, 4) );
+    }
+  }
+
+  SECTION("concurrent reads from several threads")
+  {
+    const auto path = temp / "PositionalFile_threads.bin";
+    FileGuard guard{path};
+    std::vector<uint8_t> content(100000);
+    for (std::size_t i = 0; i < content.size(); ++i)
+    {
+      content[i] = static_cast<uint8_t>(i % 251);
+    }
+    {
+      std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+      stream.write(reinterpret_cast<const char*>(content.data()), content.size());
+      REQUIRE( stream.good() );
+    }
+
+    PositionalFile file;
+    REQUIRE( file.open(path) );
+
+    constexpr unsigned int thread_count = 4;
+    std::vector<int> success(thread_count, 0);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < thread_count; ++t)
+    {
+      threads.emplace_back([&file, &content, &success, t]()
+      {
+        std::vector<uint8_t> buffer(1000);
+        for (std::size_t offset = t * 7; offset + buffer.size() <= content.size(); offset += 997)
+        {
+          if (!file.readAt(offset, buffer.data(), buffer.size())
+              || (std::memcmp(buffer.data(), content.data() + offset, buffer.size()) != 0))
+          {
+            return;
+          }
+        }
+        success[t] = 1;
+      });
+    }
+    for (auto& thread: threads)
+    {
+      thread.join();
+    }
+    for (const int s: success)
+    {
+      REQUIRE( s == 1 );
+    }
+  }
+}
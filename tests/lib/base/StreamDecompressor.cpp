@@ -0,0 +1,278 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../locate_catch.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "../../../lib/base/StreamDecompressor.hpp"
+#include "../../../lib/base/DirectoryFunctions.hpp"
+
+namespace
+{
+
+std::vector<uint8_t> readTestFile(const std::string& path)
+{
+  std::ifstream stream(path, std::ios_base::in | std::ios_base::binary);
+  return std::vector<uint8_t>(std::istreambuf_iterator<char>(stream),
+                              std::istreambuf_iterator<char>());
+}
+
+/* Decompresses all data by feeding the input in chunks of inChunk bytes and
+   reading the output in chunks of outChunk bytes. */
+std::optional<std::vector<uint8_t>> decompressInChunks(MWTP::StreamDecompressor& decomp,
+    const std::vector<uint8_t>& compressed, const size_t inChunk, const size_t outChunk)
+{
+  std::vector<uint8_t> result;
+  std::vector<uint8_t> buffer(outChunk);
+  size_t offset = 0;
+  while (!decomp.finished())
+  {
+    if (decomp.needsInput())
+    {
+      if (offset >= compressed.size())
+        return std::nullopt;
+      const size_t size = std::min(inChunk, compressed.size() - offset);
+      decomp.feed(compressed.data() + offset, size);
+      offset += size;
+    }
+    const auto produced = decomp.read(buffer.data(), buffer.size());
+    if (!produced.has_value())
+      return std::nullopt;
+    result.insert(result.end(), buffer.begin(), buffer.begin() + produced.value());
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("StreamDecompressor")
+{
+  const std::string delim = std::string(1, MWTP::pathDelimiter);
+  const std::string currentFile = std::string(__FILE__);
+  const std::string test_directory = currentFile.substr(0, currentFile.size() - std::string("StreamDecompressor.cpp").size())
+          .append("test_files").append(delim);
+
+  SECTION("ZlibStreamDecompressor")
+  {
+    const auto compressed = readTestFile(test_directory + "compressed.z");
+    const auto uncompressed = readTestFile(test_directory + "uncompressed.z");
+    REQUIRE( compressed.size() == 98 );
+    REQUIRE( uncompressed.size() == 136 );
+
+    SECTION("whole input at once")
+    {
+      MWTP::ZlibStreamDecompressor decomp;
+      REQUIRE_FALSE( decomp.finished() );
+      REQUIRE( decomp.needsInput() );
+
+      decomp.feed(compressed.data(), compressed.size());
+      REQUIRE_FALSE( decomp.needsInput() );
+      std::vector<uint8_t> buffer(200);
+      const auto produced = decomp.read(buffer.data(), buffer.size());
+      REQUIRE( produced.has_value() );
+      REQUIRE( produced.value() == 136 );
+      REQUIRE( std::equal(uncompressed.begin(), uncompressed.end(), buffer.begin()) );
+      REQUIRE( decomp.finished() );
+      REQUIRE_FALSE( decomp.needsInput() );
+      REQUIRE( decomp.totalOut() == 136 );
+    }
+
+    SECTION("small input and output chunks")
+    {
+      MWTP::ZlibStreamDecompressor decomp;
+      const auto result = decompressInChunks(decomp, compressed, 7, 13);
+      REQUIRE( result.has_value() );
+      REQUIRE( result.value() == uncompressed );
+      REQUIRE( decomp.totalOut() == 136 );
+    }
+
+    SECTION("skip part of the output")
+    {
+      MWTP::ZlibStreamDecompressor decomp;
+      decomp.feed(compressed.data(), compressed.size());
+      const auto skipped = decomp.skip(100);
+      REQUIRE( skipped.has_value() );
+      REQUIRE( skipped.value() == 100 );
+      REQUIRE( decomp.totalOut() == 100 );
+
+      std::vector<uint8_t> buffer(50);
+      const auto produced = decomp.read(buffer.data(), buffer.size());
+      REQUIRE( produced.has_value() );
+      REQUIRE( produced.value() == 36 );
+      REQUIRE( std::equal(uncompressed.begin() + 100, uncompressed.end(), buffer.begin()) );
+      REQUIRE( decomp.finished() );
+    }
+
+    SECTION("skip beyond the end")
+    {
+      MWTP::ZlibStreamDecompressor decomp;
+      decomp.feed(compressed.data(), compressed.size());
+      const auto skipped = decomp.skip(1000);
+      REQUIRE( skipped.has_value() );
+      REQUIRE( skipped.value() == 136 );
+      REQUIRE( decomp.finished() );
+    }
+
+    SECTION("truncated input needs more input")
+    {
+      MWTP::ZlibStreamDecompressor decomp;
+      decomp.feed(compressed.data(), 50);
+      std::vector<uint8_t> buffer(200);
+      const auto produced = decomp.read(buffer.data(), buffer.size());
+      REQUIRE( produced.has_value() );
+      REQUIRE( produced.value() < 136 );
+      REQUIRE( decomp.needsInput() );
+      REQUIRE_FALSE( decomp.finished() );
+      // Without new input no further progress is possible.
+      REQUIRE( decomp.read(buffer.data(), buffer.size()) == 0 );
+    }
+
+    SECTION("corrupted data fails")
+    {
+      std::vector<uint8_t> corrupted = compressed;
+      corrupted[2] = 0xFF;
+      corrupted[3] = 0xFF;
+      corrupted[4] = 0xFF;
+      MWTP::ZlibStreamDecompressor decomp;
+      decomp.feed(corrupted.data(), corrupted.size());
+      std::vector<uint8_t> buffer(200);
+      REQUIRE_FALSE( decomp.read(buffer.data(), buffer.size()).has_value() );
+      // Once failed, it stays failed.
+      REQUIRE_FALSE( decomp.read(buffer.data(), buffer.size()).has_value() );
+      REQUIRE_FALSE( decomp.skip(10).has_value() );
+    }
+
+    SECTION("clone continues at the same position")
+    {
+      MWTP::ZlibStreamDecompressor decomp;
+      decomp.feed(compressed.data(), compressed.size());
+      REQUIRE( decomp.skip(60) == 60 );
+
+      const auto copy = decomp.clone();
+      REQUIRE( copy != nullptr );
+      REQUIRE( copy->totalOut() == 60 );
+
+      // Both instances return the same data independently of each other.
+      std::vector<uint8_t> buffer(200);
+      REQUIRE( decomp.read(buffer.data(), buffer.size()) == 76 );
+      REQUIRE( std::equal(uncompressed.begin() + 60, uncompressed.end(), buffer.begin()) );
+      std::fill(buffer.begin(), buffer.end(), 0);
+      REQUIRE( copy->read(buffer.data(), buffer.size()) == 76 );
+      REQUIRE( std::equal(uncompressed.begin() + 60, uncompressed.end(), buffer.begin()) );
+      REQUIRE( copy->finished() );
+    }
+
+    SECTION("reset allows another stream")
+    {
+      MWTP::ZlibStreamDecompressor decomp;
+      auto result = decompressInChunks(decomp, compressed, 98, 200);
+      REQUIRE( result.has_value() );
+      REQUIRE( decomp.finished() );
+
+      REQUIRE( decomp.reset() );
+      REQUIRE_FALSE( decomp.finished() );
+      REQUIRE( decomp.totalOut() == 0 );
+      result = decompressInChunks(decomp, compressed, 10, 3);
+      REQUIRE( result.has_value() );
+      REQUIRE( result.value() == uncompressed );
+    }
+  }
+
+  SECTION("Lz4StreamDecompressor")
+  {
+    const auto compressed = readTestFile(test_directory + "lorem_ipsum.lz4");
+    const auto uncompressed = readTestFile(test_directory + "lorem_ipsum.txt");
+    REQUIRE( compressed.size() == 475 );
+    REQUIRE( uncompressed.size() == 535 );
+
+    #if !defined(MWTP_NO_LZ4)
+    SECTION("whole input at once")
+    {
+      MWTP::Lz4StreamDecompressor decomp;
+      const auto result = decompressInChunks(decomp, compressed, compressed.size(), 1000);
+      REQUIRE( result.has_value() );
+      REQUIRE( result.value() == uncompressed );
+      REQUIRE( decomp.finished() );
+    }
+
+    SECTION("small input and output chunks")
+    {
+      MWTP::Lz4StreamDecompressor decomp;
+      const auto result = decompressInChunks(decomp, compressed, 11, 17);
+      REQUIRE( result.has_value() );
+      REQUIRE( result.value() == uncompressed );
+      REQUIRE( decomp.totalOut() == 535 );
+    }
+
+    SECTION("skip part of the output")
+    {
+      MWTP::Lz4StreamDecompressor decomp;
+      decomp.feed(compressed.data(), compressed.size());
+      const auto skipped = decomp.skip(500);
+      REQUIRE( skipped.has_value() );
+      REQUIRE( skipped.value() == 500 );
+
+      std::vector<uint8_t> buffer(100);
+      const auto produced = decomp.read(buffer.data(), buffer.size());
+      REQUIRE( produced.has_value() );
+      REQUIRE( produced.value() == 35 );
+      REQUIRE( std::equal(uncompressed.begin() + 500, uncompressed.end(), buffer.begin()) );
+      REQUIRE( decomp.finished() );
+    }
+
+    SECTION("corrupted data fails")
+    {
+      std::vector<uint8_t> corrupted = compressed;
+      // damage the magic number of the frame
+      corrupted[0] = 0x00;
+      MWTP::Lz4StreamDecompressor decomp;
+      decomp.feed(corrupted.data(), corrupted.size());
+      std::vector<uint8_t> buffer(1000);
+      REQUIRE_FALSE( decomp.read(buffer.data(), buffer.size()).has_value() );
+    }
+
+    SECTION("state cannot be cloned")
+    {
+      MWTP::Lz4StreamDecompressor decomp;
+      REQUIRE( decomp.clone() == nullptr );
+    }
+
+    SECTION("reset allows another stream")
+    {
+      MWTP::Lz4StreamDecompressor decomp;
+      REQUIRE( decompressInChunks(decomp, compressed, 100, 100).has_value() );
+      REQUIRE( decomp.reset() );
+      const auto result = decompressInChunks(decomp, compressed, 64, 64);
+      REQUIRE( result.has_value() );
+      REQUIRE( result.value() == uncompressed );
+    }
+    #else
+    SECTION("decompression is not available without liblz4")
+    {
+      MWTP::Lz4StreamDecompressor decomp;
+      decomp.feed(compressed.data(), compressed.size());
+      std::vector<uint8_t> buffer(1000);
+      REQUIRE_FALSE( decomp.read(buffer.data(), buffer.size()).has_value() );
+    }
+    #endif
+  }
+}
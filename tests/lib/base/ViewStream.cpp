@@ -0,0 +1,101 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../locate_catch.hpp"
+#include <cstdint>
+#include <string>
+#include "../../../lib/base/ViewStream.hpp"
+
+TEST_CASE("ViewStream")
+{
+  using namespace MWTP;
+
+  const uint8_t bytes[] = { 'A', 'B', 'C', 'D', 1, 0, 0, 0, 'x' };
+  const ByteView view(bytes, sizeof(bytes));
+
+  SECTION("empty view")
+  {
+    ViewStream stream{ByteView()};
+    REQUIRE( stream.tellg() == 0 );
+    char c = 0;
+    stream.read(&c, 1);
+    REQUIRE_FALSE( stream.good() );
+    REQUIRE( stream.gcount() == 0 );
+  }
+
+  SECTION("read all data")
+  {
+    ViewStream stream(view);
+    char header[4];
+    stream.read(header, 4);
+    REQUIRE( stream.good() );
+    REQUIRE( std::string(header, 4) == "ABCD" );
+    uint32_t value = 0;
+    stream.read(reinterpret_cast<char*>(&value), 4);
+    REQUIRE( stream.good() );
+    REQUIRE( value == 1 );
+    REQUIRE( stream.tellg() == 8 );
+    REQUIRE( stream.get() == 'x' );
+    REQUIRE( stream.peek() == std::char_traits<char>::eof() );
+  }
+
+  SECTION("reading beyond the end fails")
+  {
+    ViewStream stream(view);
+    char buffer[16];
+    stream.read(buffer, sizeof(buffer));
+    REQUIRE_FALSE( stream.good() );
+    REQUIRE( stream.eof() );
+    REQUIRE( stream.gcount() == 9 );
+  }
+
+  SECTION("seeking")
+  {
+    ViewStream stream(view);
+
+    stream.seekg(4, std::ios_base::beg);
+    REQUIRE( stream.good() );
+    REQUIRE( stream.tellg() == 4 );
+    REQUIRE( stream.get() == 1 );
+
+    stream.seekg(3, std::ios_base::cur);
+    REQUIRE( stream.tellg() == 8 );
+    REQUIRE( stream.get() == 'x' );
+
+    stream.seekg(-9, std::ios_base::end);
+    REQUIRE( stream.tellg() == 0 );
+    REQUIRE( stream.get() == 'A' );
+
+    stream.seekg(0, std::ios_base::end);
+    REQUIRE( stream.good() );
+    REQUIRE( stream.tellg() == 9 );
+  }
+
+  SECTION("seeking outside of the view fails")
+  {
+    ViewStream stream(view);
+    stream.seekg(10, std::ios_base::beg);
+    REQUIRE( stream.fail() );
+
+    ViewStream other(view);
+    other.seekg(-1, std::ios_base::beg);
+    REQUIRE( other.fail() );
+  }
+}
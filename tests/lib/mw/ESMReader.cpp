@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for Morrowind Tools Project.
-    Copyright (C) 2021, 2023  Dirk Stolle
+    Copyright (C) 2021, 2023, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,9 +21,37 @@
 #include "../locate_catch.hpp"
 #include <filesystem>
 #include <string_view>
+#include <vector>
 #include "../../../lib/mw/ESMReader.hpp"
 #include "../../../lib/mw/MW_Constants.hpp"
 
+namespace
+{
+
+// reader that only wants STAT records and remembers their positions
+class StaticOnlyReader: public MWTP::ESMReader
+{
+  public:
+    std::vector<std::streampos> positions;
+
+    bool isRelevantRecord(const uint32_t recordName) const override
+    {
+      return recordName == MWTP::cSTAT;
+    }
+
+    int processNextRecord(std::istream& input) override
+    {
+      positions.push_back(input.tellg());
+      uint32_t recordName = 0;
+      input.read(reinterpret_cast<char*>(&recordName), 4);
+      if (recordName != MWTP::cSTAT)
+        return -1;
+      return (skipRecord(input) == 0) ? 1 : -1;
+    }
+}; // class
+
+} // namespace
+
 TEST_CASE("MWTP::ESMReader")
 {
   using namespace MWTP;
@@ -160,6 +188,143 @@ TEST_CASE("MWTP::ESMReader")
 
       REQUIRE( std::filesystem::remove("readESM-tes3-incompleteHeader.esm") );
     }
+    SECTION("only relevant records are processed")
+    {
+      // write "ESM file" with a STAT, an APPA and another STAT record
+      {
+        const std::string_view data = "TES3\x34\x01\0\0\0\0\0\0\0\0\0\0HEDR,\x01\0\0\x9A\x99\x99?\x01\0\0\0Bethesda Softworks\0\0\0\0\0\0\0\0\0\0\0\0\0\0Hauptdatei f\xFCr Morrowind\0rrowind\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xA1\xBC\0\0STAT\x48\0\0\0\0\0\0\0\0\0\0\0NAME\x19\0\0\0in_redoran_hut_bfloor_02\0MODL\x1F\0\0\0i\\In_redoran_hut_Bfloor_02.NIF\0APPA\x0D\0\0\0\0\0\0\0\0\0\0\0NAME\x05\0\0\0tong\0STAT\x0C\0\0\0\0\0\0\0\0\0\0\0NAME\x04\0\0\0rock"sv;
+        std::ofstream file("readESM-relevant-records.esm", std::ios::binary);
+        file.write(data.data(), data.size());
+        file.close();
+      }
+
+      StaticOnlyReader staticReader;
+      REQUIRE( staticReader.readESM("readESM-relevant-records.esm", header) == 2 );
+      REQUIRE( std::filesystem::remove("readESM-relevant-records.esm") );
+
+      REQUIRE( staticReader.positions.size() == 2 );
+      REQUIRE( staticReader.positions[0] == 324 );
+      REQUIRE( staticReader.positions[1] == 324 + 88 + 29 );
+    }
+
+    SECTION("unknown record type is skipped, if not relevant")
+    {
+      // write "ESM" file
+      {
+        const std::string_view data = "TES3\x34\x01\0\0\0\0\0\0\0\0\0\0HEDR,\x01\0\0\x9A\x99\x99?\x01\0\0\0Bethesda Softworks\0\0\0\0\0\0\0\0\0\0\0\0\0\0Hauptdatei f\xFCr Morrowind\0rrowind\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xA1\xBC\0\0FAIL\x0C\0\0\0\0\0\0\0\0\0\0\0NAME\x04\0\0\0rockSTAT\x0C\0\0\0\0\0\0\0\0\0\0\0NAME\x04\0\0\0rock"sv;
+        std::ofstream file("readESM-unknown-record.esm", std::ios::binary);
+        file.write(data.data(), data.size());
+        file.close();
+      }
+
+      StaticOnlyReader staticReader;
+      REQUIRE( staticReader.readESM("readESM-unknown-record.esm", header) == 1 );
+      REQUIRE( staticReader.positions.size() == 1 );
+
+      // The default implementation of processNextRecord() rejects it.
+      REQUIRE( reader.readESM("readESM-unknown-record.esm", header) == -1 );
+
+      REQUIRE( std::filesystem::remove("readESM-unknown-record.esm") );
+    }
+
+    SECTION("failure: file ends before last record is complete")
+    {
+      // write "ESM" file
+      {
+        const std::string_view data = "TES3\x34\x01\0\0\0\0\0\0\0\0\0\0HEDR,\x01\0\0\x9A\x99\x99?\x01\0\0\0Bethesda Softworks\0\0\0\0\0\0\0\0\0\0\0\0\0\0Hauptdatei f\xFCr Morrowind\0rrowind\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\xA1\xBC\0\0STAT\x48\0\0\0\0\0\0\0\0\0\0\0NAME\x19\0\0\0in_redoran"sv;
+        std::ofstream file("readESM-incomplete-record.esm", std::ios::binary);
+        file.write(data.data(), data.size());
+        file.close();
+      }
+
+      REQUIRE( reader.readESM("readESM-incomplete-record.esm", header) == -1 );
+
+      REQUIRE( std::filesystem::remove("readESM-incomplete-record.esm") );
+    }
+  }
+
+  SECTION("buildRecordIndex")
+  {
+    std::vector<RecordIndexEntry> index;
+
+    SECTION("default: index several records")
+    {
+      const auto data = "STAT\x48\0\0\0\0\0\0\0\0\0\0\0NAME\x19\0\0\0in_redoran_hut_bfloor_02\0MODL\x1F\0\0\0i\\In_redoran_hut_Bfloor_02.NIF\0INFO\x0D\0\0\0\0\0\0\0\0\0\0\0INAM\x05\0\0\0info\0LAND\x0C\0\0\0\0\0\0\0\0\0\0\0INTV\x04\0\0\0\x01\0\0\0STAT\x0C\0\0\0\0\0\0\0\0\0\0\0NAME\x04\0\0\0rock"sv;
+      const ByteView view(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+
+      REQUIRE( ESMReader::buildRecordIndex(view, 0, index) );
+      REQUIRE( index.size() == 4 );
+
+      REQUIRE( index[0].recordName == cSTAT );
+      REQUIRE( index[0].offset == 0 );
+      REQUIRE( index[0].size == 72 );
+      REQUIRE( index[0].ID(view) == "in_redoran_hut_bfloor_02" );
+
+      REQUIRE( index[1].recordName == cINFO );
+      REQUIRE( index[1].offset == 88 );
+      REQUIRE( index[1].size == 13 );
+      REQUIRE( index[1].ID(view) == "info" );
+
+      // LAND has no ID.
+      REQUIRE( index[2].recordName == cLAND );
+      REQUIRE( index[2].offset == 117 );
+      REQUIRE( index[2].size == 12 );
+      REQUIRE( index[2].ID(view).empty() );
+
+      // ID without NUL terminator
+      REQUIRE( index[3].recordName == cSTAT );
+      REQUIRE( index[3].offset == 145 );
+      REQUIRE( index[3].size == 12 );
+      REQUIRE( index[3].ID(view) == "rock" );
+    }
+
+    SECTION("start at offset")
+    {
+      const auto data = "skipSTAT\x0C\0\0\0\0\0\0\0\0\0\0\0NAME\x04\0\0\0rock"sv;
+      const ByteView view(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+
+      REQUIRE( ESMReader::buildRecordIndex(view, 4, index) );
+      REQUIRE( index.size() == 1 );
+      REQUIRE( index[0].offset == 4 );
+      REQUIRE( index[0].ID(view) == "rock" );
+    }
+
+    SECTION("empty data")
+    {
+      REQUIRE( ESMReader::buildRecordIndex(ByteView(), 0, index) );
+      REQUIRE( index.empty() );
+    }
+
+    SECTION("failure: record data is incomplete")
+    {
+      const auto data = "STAT\x0C\0\0\0\0\0\0\0\0\0\0\0NAME\x04\0\0\0rockSTAT\x0C\0\0\0\0\0\0\0\0\0\0\0NAME"sv;
+      const ByteView view(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+
+      REQUIRE_FALSE( ESMReader::buildRecordIndex(view, 0, index) );
+      // Complete records are still in the index.
+      REQUIRE( index.size() == 1 );
+      REQUIRE( index[0].ID(view) == "rock" );
+    }
+
+    SECTION("unknown record type is indexed, too")
+    {
+      const auto data = "STAT\x0C\0\0\0\0\0\0\0\0\0\0\0NAME\x04\0\0\0rockFAIL\x0C\0\0\0\0\0\0\0\0\0\0\0NAME\x04\0\0\0rock"sv;
+      const ByteView view(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+
+      REQUIRE( ESMReader::buildRecordIndex(view, 0, index) );
+      REQUIRE( index.size() == 2 );
+      REQUIRE( index[0].recordName == cSTAT );
+      REQUIRE( index[1].recordName == 0x4C494146 ); // "FAIL"
+    }
+
+    SECTION("failure: record header is incomplete")
+    {
+      const auto data = "STAT\x0C\0\0\0\0\0"sv;
+      const ByteView view(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+
+      REQUIRE_FALSE( ESMReader::buildRecordIndex(view, 0, index) );
+      REQUIRE( index.empty() );
+    }
   }
 
   SECTION("skipRecord")
@@ -200,6 +365,14 @@ TEST_CASE("MWTP::ESMReader")
     }
   }
 
+  SECTION("isKnownRecordType")
+  {
+    REQUIRE( ESMReader::isKnownRecordType(cSTAT) );
+    REQUIRE( ESMReader::isKnownRecordType(cNPC_) );
+    REQUIRE_FALSE( ESMReader::isKnownRecordType(cTES3) );
+    REQUIRE_FALSE( ESMReader::isKnownRecordType(0x4C494146) ); // "FAIL"
+  }
+
   SECTION("processNextRecord")
   {
     ESMReader reader;
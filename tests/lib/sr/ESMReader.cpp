@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for Morrowind Tools Project.
-    Copyright (C) 2021  Dirk Stolle
+    Copyright (C) 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -20,6 +20,7 @@
 
 #include "../locate_catch.hpp"
 #include <filesystem>
+#include <fstream>
 #include <string_view>
 #include "../../../lib/sr/ESMReader.hpp"
 #include "../../../lib/sr/SR_Constants.hpp"
@@ -190,6 +191,177 @@ TEST_CASE("SRTP::ESMReader")
     }
   }
 
+  SECTION("readESM with several threads")
+  {
+    using namespace std::string_literals;
+
+    const auto header = "TES4\x2C\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\x28\0\0\0HEDR\x0C\0\xD7\xA3\x70\x3F\x04\0\0\0\x92\x0F\0\0CNAM\x0A\0mcarofano\0INTV\x04\0\xC5\x26\x01\x00"s;
+    const auto groupHeader = "GRUP\x81\0\0\0FACT\0\0\0\0\x16\x6E\x32\0\0\0\0\0"s;
+    // faction 0x01000944 without flags
+    const auto first = "FACT\x51\0\0\0\0\0\0\0\x44\x09\0\x01\x16\x6E\x32\0\x28\0\x01\0EDID\x15\0CR08ExclusionFaction\0DATA\x04\0\0\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0"s;
+    // same faction, but with flags
+    const auto second = "FACT\x51\0\0\0\0\0\0\0\x44\x09\0\x01\x16\x6E\x32\0\x28\0\x01\0EDID\x15\0CR08ExclusionFaction\0DATA\x04\0\x01\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0"s;
+    // another faction with ID 0x01000945
+    const auto third = "FACT\x51\0\0\0\0\0\0\0\x45\x09\0\x01\x16\x6E\x32\0\x28\0\x01\0EDID\x15\0CR08ExclusionFaction\0DATA\x04\0\0\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0"s;
+    // empty group that is not needed by the reader
+    const auto other = "GRUP\x18\0\0\0WEAP\0\0\0\0\x16\x6E\x32\0\0\0\0\0"s;
+
+    const std::string fileName = "readESM-threads-sample.esm";
+    {
+      const auto data = header + groupHeader + first + other + groupHeader + second + groupHeader + third;
+      std::ofstream file(fileName, std::ios_base::out | std::ios_base::binary);
+      file.write(data.data(), data.size());
+      file.close();
+    }
+
+    SECTION("groups are merged in file order")
+    {
+      for (const unsigned int threads: { 1u, 2u, 4u })
+      {
+        Factions::get().clear();
+        TestFactionsReaderConcurrent reader;
+        reader.setThreadCount(threads);
+        REQUIRE( reader.threadCount() == threads );
+
+        Tes4HeaderRecord record;
+        REQUIRE( reader.readESM(fileName, record, std::nullopt) == 3 );
+        REQUIRE( record.authorName == "mcarofano" );
+
+        REQUIRE( Factions::get().getNumberOfRecords() == 2 );
+        // The later group in the file overrides the earlier one.
+        REQUIRE( Factions::get().getRecord(0x01000944).flags == 1 );
+        REQUIRE( Factions::get().getRecord(0x01000945).flags == 0 );
+      }
+    }
+
+    SECTION("reader without group readers reads sequentially")
+    {
+      Factions::get().clear();
+      TestFactionsReader reader;
+      reader.setThreadCount(4);
+
+      Tes4HeaderRecord record;
+      REQUIRE( reader.readESM(fileName, record, std::nullopt) == 3 );
+      REQUIRE( Factions::get().getNumberOfRecords() == 2 );
+      REQUIRE( Factions::get().getRecord(0x01000944).flags == 1 );
+    }
+
+    SECTION("failure: group size is larger than the file")
+    {
+      {
+        auto data = header + groupHeader + first + groupHeader + third;
+        data[data.size() - third.size() - groupHeader.size() + 4] = '\x82';
+        std::ofstream file(fileName, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        file.write(data.data(), data.size());
+        file.close();
+      }
+
+      TestFactionsReaderConcurrent reader;
+      reader.setThreadCount(2);
+      Tes4HeaderRecord record;
+      REQUIRE( reader.readESM(fileName, record, std::nullopt) == -1 );
+    }
+
+    SECTION("failure: group cannot be read")
+    {
+      {
+        auto data = header + groupHeader + first + groupHeader + third;
+        // Change type of last record, so that it cannot be read by the reader.
+        data[data.size() - third.size()] = 'X';
+        std::ofstream file(fileName, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        file.write(data.data(), data.size());
+        file.close();
+      }
+
+      TestFactionsReaderConcurrent reader;
+      reader.setThreadCount(2);
+      Tes4HeaderRecord record;
+      REQUIRE( reader.readESM(fileName, record, std::nullopt) == -1 );
+    }
+
+    REQUIRE( std::filesystem::remove(fileName) );
+  }
+
+  SECTION("readESMsConcurrently")
+  {
+    using namespace std::string_literals;
+
+    const auto header = "TES4\x2C\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\x28\0\0\0HEDR\x0C\0\xD7\xA3\x70\x3F\x04\0\0\0\x92\x0F\0\0CNAM\x0A\0mcarofano\0INTV\x04\0\xC5\x26\x01\x00"s;
+    const auto groupHeader = "GRUP\x81\0\0\0FACT\0\0\0\0\x16\x6E\x32\0\0\0\0\0"s;
+    // faction 0x01000944 without flags
+    const auto first = "FACT\x51\0\0\0\0\0\0\0\x44\x09\0\x01\x16\x6E\x32\0\x28\0\x01\0EDID\x15\0CR08ExclusionFaction\0DATA\x04\0\0\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0"s;
+    // same faction, but with flags
+    const auto second = "FACT\x51\0\0\0\0\0\0\0\x44\x09\0\x01\x16\x6E\x32\0\x28\0\x01\0EDID\x15\0CR08ExclusionFaction\0DATA\x04\0\x01\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0"s;
+    // another faction with ID 0x01000945
+    const auto third = "FACT\x51\0\0\0\0\0\0\0\x45\x09\0\x01\x16\x6E\x32\0\x28\0\x01\0EDID\x15\0CR08ExclusionFaction\0DATA\x04\0\0\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0"s;
+
+    const std::string master = "readESMs-master.esm";
+    const std::string plugin = "readESMs-plugin.esp";
+    {
+      const auto data = header + groupHeader + first + groupHeader + third;
+      std::ofstream file(master, std::ios_base::out | std::ios_base::binary);
+      file.write(data.data(), data.size());
+      file.close();
+    }
+    {
+      const auto data = header + groupHeader + second;
+      std::ofstream file(plugin, std::ios_base::out | std::ios_base::binary);
+      file.write(data.data(), data.size());
+      file.close();
+    }
+
+    SECTION("files are merged in the given order")
+    {
+      for (const unsigned int threads: { 1u, 2u, 4u })
+      {
+        Factions::get().clear();
+        TestFactionsReaderConcurrent reader;
+        auto stagingMaster = reader.createStagingReader();
+        auto stagingPlugin = reader.createStagingReader();
+        REQUIRE( stagingMaster != nullptr );
+        REQUIRE( stagingPlugin != nullptr );
+
+        const std::vector<std::pair<ESMReader*, std::string> > files = {
+          { stagingMaster.get(), master },
+          { stagingPlugin.get(), plugin }
+        };
+        REQUIRE( ESMReader::readESMsConcurrently(files, std::nullopt, threads) );
+        // Nothing is visible before the staging readers are merged.
+        REQUIRE( Factions::get().getNumberOfRecords() == 0 );
+
+        REQUIRE( reader.mergeStagingReader(*stagingMaster) );
+        REQUIRE( reader.mergeStagingReader(*stagingPlugin) );
+
+        REQUIRE( Factions::get().getNumberOfRecords() == 2 );
+        // The plugin overrides the master.
+        REQUIRE( Factions::get().getRecord(0x01000944).flags == 1 );
+        REQUIRE( Factions::get().getRecord(0x01000945).flags == 0 );
+      }
+    }
+
+    SECTION("reader without staging support")
+    {
+      TestFactionsReader reader;
+      REQUIRE( reader.createStagingReader() == nullptr );
+    }
+
+    SECTION("failure: file does not exist")
+    {
+      TestFactionsReaderConcurrent reader;
+      auto stagingMaster = reader.createStagingReader();
+      auto stagingMissing = reader.createStagingReader();
+
+      const std::vector<std::pair<ESMReader*, std::string> > files = {
+        { stagingMaster.get(), master },
+        { stagingMissing.get(), "readESMs-does-not-exist.esp" }
+      };
+      REQUIRE_FALSE( ESMReader::readESMsConcurrently(files, std::nullopt, 2) );
+    }
+
+    REQUIRE( std::filesystem::remove(master) );
+    REQUIRE( std::filesystem::remove(plugin) );
+  }
+
   SECTION("processGroup")
   {
     StringTable dummy_table;
@@ -0,0 +1,145 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../locate_catch.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include "../../../lib/sr/ESMReaderLazy.hpp"
+#include "../../../lib/sr/SR_Constants.hpp"
+#include "../../../lib/sr/records/FactionRecord.hpp"
+
+TEST_CASE("SRTP::ESMReaderLazy")
+{
+  using namespace SRTP;
+  using namespace std::string_view_literals;
+
+  auto& manager = LazyRecordManager<FactionRecord>::get();
+  manager.clear();
+
+  // Another file is first in the load order, so mod index zero in the file
+  // becomes one.
+  ESMReaderLazy reader({ "Skyrim.esm", "readESM-lazy-sample.esm" });
+  reader.indexRecords<FactionRecord>(cFACT);
+
+  SECTION("default: index records and decode them on first access")
+  {
+    // write "ESM file"
+    {
+      const std::string_view data = "TES4\x2C\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\0\x28\0\0\0HEDR\x0C\0\xD7\xA3\x70\x3F\x02\0\0\0\x92\x0F\0\0CNAM\x0A\0mcarofano\0INTV\x04\0\xC5\x26\x01\x00GRUP\x81\0\0\0FACT\0\0\0\0\x16\x6E\x32\0\0\0\0\0FACT\x51\0\0\0\0\0\0\0\x44\x09\0\0\x16\x6E\x32\0\x28\0\x01\0EDID\x15\0CR08ExclusionFaction\0DATA\x04\0\0\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0"sv;
+      std::ofstream file("readESM-lazy-sample.esm", std::ios_base::out | std::ios_base::binary);
+      file.write(data.data(), data.size());
+      file.close();
+    }
+
+    REQUIRE( reader.indexESM("readESM-lazy-sample.esm", std::nullopt) == 1 );
+
+    // Only the location is known after indexing.
+    REQUIRE( manager.getNumberOfRecords() == 1 );
+    REQUIRE( manager.getNumberOfDecodedRecords() == 0 );
+    REQUIRE( manager.hasRecord(0x01000944) );
+    REQUIRE_FALSE( manager.hasRecord(0x01000945) );
+    const auto& location = manager.getLocation(0x01000944);
+    REQUIRE( location.recName == cFACT );
+    REQUIRE( location.formID == 0x01000944 );
+    REQUIRE( location.flags == 0 );
+    REQUIRE( location.offset == 96 );
+    REQUIRE( location.size == 0x51 );
+
+    // First access decodes the record.
+    const auto& record = manager.getRecord(0x01000944);
+    REQUIRE( record.editorID == "CR08ExclusionFaction" );
+    REQUIRE( record.headerFormID == 0x01000944 );
+    REQUIRE( manager.getNumberOfDecodedRecords() == 1 );
+    // Later accesses return the same record.
+    REQUIRE( &manager.getRecord(0x01000944) == &record );
+    REQUIRE( manager.getNumberOfDecodedRecords() == 1 );
+
+    // File is kept open by the manager, so remove it after clearing.
+    manager.clear();
+    REQUIRE( std::filesystem::remove("readESM-lazy-sample.esm") );
+  }
+
+  SECTION("overrides of a plugin replace records of its master")
+  {
+    // write master file with one faction
+    {
+      const std::string_view data = "TES4\x2C\0\0\0\x01\0\0\0\0\0\0\0\x16\x6E\x32\0\x28\0\x01\0HEDR\x0C\0\x9A\x99\xD9\x3F\x01\0\0\0\x92\x0F\0\0CNAM\x0A\0mcarofano\0INTV\x04\0\xC5\x26\x01\0GRUP\x7A\0\0\0FACT\0\0\0\0\x16\x6E\x32\0\0\0\0\0FACT\x4A\0\0\0\0\0\0\0\x44\x09\0\0\x16\x6E\x32\0\x28\0\x01\0EDID\x0E\0MasterFaction\0DATA\x04\0\0\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0"sv;
+      std::ofstream file("readESM-lazy-master.esm", std::ios_base::out | std::ios_base::binary);
+      file.write(data.data(), data.size());
+      file.close();
+    }
+    // write plugin file that overrides the faction and adds another one
+    {
+      const std::string_view data = "TES4\x58\0\0\0\0\0\0\0\0\0\0\0\x16\x6E\x32\0\x28\0\x01\0HEDR\x0C\0\x9A\x99\xD9\x3F\x02\0\0\0\x92\x0F\0\0CNAM\x0A\0mcarofano\0MAST\x18\0readESM-lazy-master.esm\0DATA\x08\0\0\0\0\0\0\0\0\0INTV\x04\0\xC5\x26\x01\0GRUP\xDE\0\0\0FACT\0\0\0\0\x16\x6E\x32\0\0\0\0\0FACT\x4C\0\0\0\0\0\0\0\x44\x09\0\0\x16\x6E\x32\0\x28\0\x01\0EDID\x10\0OverrideFaction\0DATA\x04\0\0\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0FACT\x4A\0\0\0\0\0\0\0\x62\x0D\0\x01\x16\x6E\x32\0\x28\0\x01\0EDID\x0E\0PluginFaction\0DATA\x04\0\0\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0"sv;
+      std::ofstream file("readESM-lazy-plugin.esp", std::ios_base::out | std::ios_base::binary);
+      file.write(data.data(), data.size());
+      file.close();
+    }
+
+    ESMReaderLazy loadOrderReader({ "Skyrim.esm", "readESM-lazy-master.esm", "readESM-lazy-plugin.esp" });
+    loadOrderReader.indexRecords<FactionRecord>(cFACT);
+    REQUIRE( loadOrderReader.indexESM("readESM-lazy-master.esm", std::nullopt) == 1 );
+    REQUIRE( loadOrderReader.indexESM("readESM-lazy-plugin.esp", std::nullopt) == 2 );
+
+    REQUIRE( manager.getNumberOfRecords() == 2 );
+    // override in plugin uses mod index of the master
+    REQUIRE( manager.hasRecord(0x01000944) );
+    REQUIRE( manager.getRecord(0x01000944).editorID == "OverrideFaction" );
+    REQUIRE( manager.getRecord(0x01000944).headerFormID == 0x01000944 );
+    // new record of the plugin uses mod index of the plugin
+    REQUIRE( manager.hasRecord(0x02000D62) );
+    REQUIRE( manager.getRecord(0x02000D62).editorID == "PluginFaction" );
+    REQUIRE( manager.getRecord(0x02000D62).headerFormID == 0x02000D62 );
+
+    manager.clear();
+    REQUIRE( std::filesystem::remove("readESM-lazy-master.esm") );
+    REQUIRE( std::filesystem::remove("readESM-lazy-plugin.esp") );
+  }
+
+  SECTION("failure: file is not in load order")
+  {
+    ESMReaderLazy otherReader({ "Skyrim.esm" });
+    otherReader.indexRecords<FactionRecord>(cFACT);
+    {
+      const std::string_view data = "TES4\x2C\0\0\0\x01\0\0\0\0\0\0\0\x16\x6E\x32\0\x28\0\x01\0HEDR\x0C\0\x9A\x99\xD9\x3F\x01\0\0\0\x92\x0F\0\0CNAM\x0A\0mcarofano\0INTV\x04\0\xC5\x26\x01\0GRUP\x7A\0\0\0FACT\0\0\0\0\x16\x6E\x32\0\0\0\0\0FACT\x4A\0\0\0\0\0\0\0\x44\x09\0\0\x16\x6E\x32\0\x28\0\x01\0EDID\x0E\0MasterFaction\0DATA\x04\0\0\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0"sv;
+      std::ofstream file("readESM-lazy-master.esm", std::ios_base::out | std::ios_base::binary);
+      file.write(data.data(), data.size());
+      file.close();
+    }
+
+    REQUIRE( otherReader.indexESM("readESM-lazy-master.esm", std::nullopt) == -1 );
+
+    manager.clear();
+    REQUIRE( std::filesystem::remove("readESM-lazy-master.esm") );
+  }
+
+  SECTION("access to missing record throws")
+  {
+    REQUIRE_THROWS( manager.getRecord(0x01000944) );
+    REQUIRE_THROWS( manager.getLocation(0x01000944) );
+  }
+
+  SECTION("failure: file does not exist")
+  {
+    REQUIRE( reader.indexESM("does-not-exist.esm", std::nullopt) == -1 );
+    REQUIRE( manager.getNumberOfRecords() == 0 );
+  }
+}
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for Morrowind Tools Project.
-    Copyright (C) 2021, 2023  Dirk Stolle
+    Copyright (C) 2021, 2023, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -215,6 +215,95 @@ TEST_CASE("MapBasedRecordManager")
     REQUIRE( mgr.begin() == mgr.end() );
   }
 
+  SECTION("addRecord replaces record with same ID and keeps order")
+  {
+    auto& mgr = MapBasedRecordManager<ActionRecord>::get();
+    mgr.clear();
+
+    ActionRecord record;
+    record.headerFormID = 0x00000200;
+    record.editorID = "Two";
+    mgr.addRecord(record);
+    record.headerFormID = 0x00000100;
+    record.editorID = "One";
+    mgr.addRecord(record);
+    record.headerFormID = 0x00000300;
+    record.editorID = "Three";
+    mgr.addRecord(std::move(record));
+    ActionRecord replacement;
+    replacement.headerFormID = 0x00000200;
+    replacement.editorID = "NewTwo";
+    mgr.addRecord(replacement);
+
+    REQUIRE( mgr.getNumberOfRecords() == 3 );
+    REQUIRE( mgr.getRecord(0x00000200).editorID == "NewTwo" );
+    auto iter = mgr.begin();
+    REQUIRE( iter->second.editorID == "One" );
+    ++iter;
+    REQUIRE( iter->second.editorID == "NewTwo" );
+    ++iter;
+    REQUIRE( iter->second.editorID == "Three" );
+  }
+
+  SECTION("bulk load")
+  {
+    auto& mgr = MapBasedRecordManager<ActionRecord>::get();
+    mgr.clear();
+
+    ActionRecord record;
+    record.headerFormID = 0x00000200;
+    record.editorID = "Old";
+    mgr.addRecord(record);
+
+    REQUIRE_FALSE( mgr.isBulkLoading() );
+    mgr.startBulkLoad();
+    REQUIRE( mgr.isBulkLoading() );
+
+    const uint32_t ids[] = { 0x00000500, 0x00000200, 0x00000100, 0x00000500, 0x00000000 };
+    const char* names[] = { "First", "New", "One", "Second", "Zero" };
+    for (int i = 0; i < 5; ++i)
+    {
+      ActionRecord added;
+      added.headerFormID = ids[i];
+      added.editorID = names[i];
+      mgr.addRecord(std::move(added));
+    }
+
+    SECTION("records are not visible before the bulk load is finished")
+    {
+      REQUIRE( mgr.getNumberOfRecords() == 1 );
+      REQUIRE_FALSE( mgr.hasRecord(0x00000100) );
+      REQUIRE( mgr.getRecord(0x00000200).editorID == "Old" );
+      mgr.finishBulkLoad();
+    }
+
+    SECTION("finishBulkLoad sorts records and keeps the last one of an ID")
+    {
+      mgr.finishBulkLoad();
+      REQUIRE_FALSE( mgr.isBulkLoading() );
+      REQUIRE( mgr.getNumberOfRecords() == 3 );
+      REQUIRE( mgr.getRecord(0x00000200).editorID == "New" );
+      REQUIRE( mgr.getRecord(0x00000500).editorID == "Second" );
+      REQUIRE_FALSE( mgr.hasRecord(0x00000000) );
+
+      auto iter = mgr.begin();
+      REQUIRE( iter->first == 0x00000100 );
+      ++iter;
+      REQUIRE( iter->first == 0x00000200 );
+      ++iter;
+      REQUIRE( iter->first == 0x00000500 );
+      ++iter;
+      REQUIRE( iter == mgr.end() );
+    }
+
+    SECTION("clear removes pending records")
+    {
+      mgr.clear();
+      mgr.finishBulkLoad();
+      REQUIRE( mgr.getNumberOfRecords() == 0 );
+    }
+  }
+
   SECTION("readNextRecord + saveToStream: basic stuff")
   {
     using namespace std::string_view_literals;
@@ -0,0 +1,141 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Morrowind Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../locate_catch.hpp"
+#include <sstream>
+#include <string_view>
+#include "../../../lib/base/CompressionFunctions.hpp"
+#include "../../../lib/sr/RecordProjection.hpp"
+#include "../../../lib/sr/SR_Constants.hpp"
+
+TEST_CASE("RecordProjection")
+{
+  using namespace SRTP;
+  using namespace std::string_literals;
+
+  StringTable dummy_table;
+  // FACT record without the record name
+  const auto header = "\x51\0\0\0\0\0\0\0\x44\x09\0\x01\x16\x6E\x32\0\x28\0\x01\0"s;
+  const auto data = "EDID\x15\0CR08ExclusionFaction\0DATA\x04\0\0\0\0\0CRVA\x14\0\x01\x01\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0VENV\x0C\0\0\0\0\0\0\0\0\0\0\0\0\0"s;
+
+  RecordProjection projection;
+  projection.add(cFACT, { cEDID, cVENV });
+
+  SECTION("hasRecordType")
+  {
+    REQUIRE( projection.hasRecordType(cFACT) );
+    REQUIRE_FALSE( projection.hasRecordType(cWEAP) );
+  }
+
+  SECTION("default: read only requested subrecords")
+  {
+    std::istringstream stream(header + data + "after"s);
+
+    REQUIRE( projection.read(stream, cFACT) );
+    REQUIRE( projection.formID() == 0x01000944 );
+    REQUIRE( projection.flags() == 0 );
+    const auto& subs = projection.subRecords();
+    REQUIRE( subs.size() == 2 );
+    REQUIRE( subs[0].name == cEDID );
+    std::string editorID;
+    REQUIRE( subs[0].getString(false, dummy_table, editorID) );
+    REQUIRE( editorID == "CR08ExclusionFaction" );
+    REQUIRE( subs[1].name == cVENV );
+    REQUIRE( subs[1].data.size() == 12 );
+    // stream is positioned after the record
+    std::string rest;
+    stream >> rest;
+    REQUIRE( rest == "after" );
+  }
+
+  SECTION("record types without request are skipped")
+  {
+    std::istringstream stream(header + data + "after"s);
+
+    REQUIRE( projection.read(stream, cWEAP) );
+    REQUIRE( projection.subRecords().empty() );
+    std::string rest;
+    stream >> rest;
+    REQUIRE( rest == "after" );
+  }
+
+  SECTION("compressed record")
+  {
+    uint32_t compressedSize = 256;
+    uint8_t* compressed = new uint8_t[compressedSize];
+    uint32_t usedSize = 0;
+    std::string raw = data;
+    REQUIRE( MWTP::zlibCompress(reinterpret_cast<uint8_t*>(raw.data()), raw.size(), compressed, compressedSize, usedSize) );
+    const uint32_t rawSize = raw.size();
+    const uint32_t size = usedSize + 4;
+    const uint32_t flags = 0x00040000;
+    std::string record(header);
+    record.replace(0, 4, reinterpret_cast<const char*>(&size), 4);
+    record.replace(4, 4, reinterpret_cast<const char*>(&flags), 4);
+    record.append(reinterpret_cast<const char*>(&rawSize), 4);
+    record.append(reinterpret_cast<const char*>(compressed), usedSize);
+    delete[] compressed;
+    std::istringstream stream(record);
+
+    REQUIRE( projection.read(stream, cFACT) );
+    REQUIRE( projection.formID() == 0x01000944 );
+    const auto& subs = projection.subRecords();
+    REQUIRE( subs.size() == 2 );
+    REQUIRE( subs[0].data == "CR08ExclusionFaction\0"s );
+  }
+
+  SECTION("localized string")
+  {
+    StringTable table;
+    table.addString(0x00000102, "localized text");
+    RecordProjection names;
+    names.add(cFACT, { cFULL });
+    const auto full = "FULL\x04\0\x02\x01\0\0"s;
+    std::string record(header);
+    const uint32_t size = full.size();
+    record.replace(0, 4, reinterpret_cast<const char*>(&size), 4);
+    std::istringstream stream(record + full);
+
+    REQUIRE( names.read(stream, cFACT) );
+    REQUIRE( names.subRecords().size() == 1 );
+    std::string text;
+    REQUIRE( names.subRecords()[0].getString(true, table, text) );
+    REQUIRE( text == "localized text" );
+    // index not in table
+    REQUIRE_FALSE( names.subRecords()[0].getString(true, dummy_table, text) );
+  }
+
+  SECTION("failure: subrecord exceeds record size")
+  {
+    std::string record(header);
+    const uint32_t size = 20;
+    record.replace(0, 4, reinterpret_cast<const char*>(&size), 4);
+    std::istringstream stream(record + data);
+
+    REQUIRE_FALSE( projection.read(stream, cFACT) );
+  }
+
+  SECTION("failure: stream ends before record data")
+  {
+    std::istringstream stream(header + "EDID"s);
+
+    REQUIRE_FALSE( projection.read(stream, cFACT) );
+  }
+}
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for Morrowind Tools Project.
-    Copyright (C) 2021  Dirk Stolle
+    Copyright (C) 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,6 +21,7 @@
 #include "../locate_catch.hpp"
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <string_view>
 #include "../../../lib/sr/StringTable.hpp"
 
@@ -61,6 +62,38 @@ TEST_CASE("StringTable")
     REQUIRE( table.getNumberOfTableEntries() == 0 );
   }
 
+  SECTION("addString replaces existing string")
+  {
+    StringTable table;
+    table.addString(7, "foo");
+    table.addString(7, "something else");
+    REQUIRE( table.getNumberOfTableEntries() == 1 );
+    REQUIRE( table.getString(7) == "something else" );
+  }
+
+  SECTION("addString with content from the same table")
+  {
+    StringTable table;
+    table.addString(1, "foo");
+    // Adding a string can move the data of the table, so the view becomes
+    // invalid during the call.
+    for (uint32_t id = 2; id < 100; ++id)
+    {
+      table.addString(id, table.getString(id - 1));
+    }
+    REQUIRE( table.getNumberOfTableEntries() == 99 );
+    REQUIRE( table.getString(99) == "foo" );
+  }
+
+  SECTION("getString returns a view into the table")
+  {
+    StringTable table;
+    table.addString(1, "foo");
+    const std::string_view view = table.getString(1);
+    REQUIRE( view.size() == 3 );
+    REQUIRE( view.data() == table.getString(1).data() );
+  }
+
   SECTION("getString throws when index is not present")
   {
     StringTable table;
@@ -330,4 +363,224 @@ TEST_CASE("StringTable")
 
     REQUIRE( std::filesystem::remove("foobar.write.ilstrings") );
   }
+
+  SECTION("readTable: same ID more than once, last string wins")
+  {
+    using namespace std::string_view_literals;
+    const std::string_view data = "\x03\0\0\0\x0F\0\0\0\x2A\0\0\0\0\0\0\0\x05\0\0\0\x04\0\0\0\x2A\0\0\0\x08\0\0\0foo\0bar\0foobar\0"sv;
+
+    {
+      std::ofstream file("foobar.duplicate.strings", std::ios::binary);
+      file.write(data.data(), data.size());
+    }
+
+    StringTable table;
+    REQUIRE( table.readTable("foobar.duplicate.strings", StringTable::DataType::sdUnknown) );
+    REQUIRE( table.getNumberOfTableEntries() == 2 );
+    REQUIRE( table.getString(5) == "bar" );
+    REQUIRE( table.getString(42) == "foobar" );
+
+    REQUIRE( std::filesystem::remove("foobar.duplicate.strings") );
+  }
+
+  SECTION("readTable: merges with existing strings")
+  {
+    using namespace std::string_view_literals;
+    const std::string_view data = "\x02\0\0\0\x08\0\0\0\x01\0\0\0\0\0\0\0\x02\0\0\0\x04\0\0\0foo\0bar\0"sv;
+
+    {
+      std::ofstream file("foobar.merge.strings", std::ios::binary);
+      file.write(data.data(), data.size());
+    }
+
+    StringTable table;
+    table.addString(2, "old");
+    table.addString(3, "baz");
+    REQUIRE( table.readTable("foobar.merge.strings", StringTable::DataType::sdUnknown) );
+    REQUIRE( table.getNumberOfTableEntries() == 3 );
+    REQUIRE( table.getString(1) == "foo" );
+    REQUIRE( table.getString(2) == "bar" );
+    REQUIRE( table.getString(3) == "baz" );
+
+    REQUIRE( std::filesystem::remove("foobar.merge.strings") );
+  }
+
+  SECTION("merge")
+  {
+    StringTable table;
+    table.addString(1, "one");
+    table.addString(3, "three");
+    table.addString(5, "five");
+
+    SECTION("strings of other table are added or replace existing ones")
+    {
+      StringTable other;
+      other.addString(2, "two");
+      other.addString(3, "drei");
+      other.addString(6, "six");
+      table.merge(other);
+
+      REQUIRE( table.getNumberOfTableEntries() == 5 );
+      REQUIRE( table.getString(1) == "one" );
+      REQUIRE( table.getString(2) == "two" );
+      REQUIRE( table.getString(3) == "drei" );
+      REQUIRE( table.getString(5) == "five" );
+      REQUIRE( table.getString(6) == "six" );
+      // other table is unchanged
+      REQUIRE( other.getNumberOfTableEntries() == 3 );
+      REQUIRE( other.getString(3) == "drei" );
+    }
+
+    SECTION("merge into empty table")
+    {
+      StringTable empty;
+      empty.merge(table);
+      REQUIRE( empty.getNumberOfTableEntries() == 3 );
+      REQUIRE( empty.getString(1) == "one" );
+      REQUIRE( empty.getString(3) == "three" );
+      REQUIRE( empty.getString(5) == "five" );
+    }
+
+    SECTION("merge with empty table or itself changes nothing")
+    {
+      table.merge(StringTable());
+      table.merge(table);
+      REQUIRE( table.getNumberOfTableEntries() == 3 );
+      REQUIRE( table.getString(1) == "one" );
+      REQUIRE( table.getString(3) == "three" );
+      REQUIRE( table.getString(5) == "five" );
+    }
+  }
+
+  SECTION("readTable: from memory")
+  {
+    using namespace std::string_view_literals;
+
+    SECTION("NUL-terminated strings")
+    {
+      const std::string_view data = "\x03\0\0\0\x0F\0\0\0\x78\x56\x34\x12\0\0\0\0\xFE\xAF\x00\x00\x04\0\0\0\x2A\x00\x00\x00\x08\0\0\0foo\0bar\0foobar\0"sv;
+      std::vector<uint8_t> buffer(data.begin(), data.end());
+
+      StringTable table;
+      REQUIRE( table.readTable(std::move(buffer), StringTable::DataType::sdNULterminated) );
+      REQUIRE( table.getNumberOfTableEntries() == 3 );
+      REQUIRE( table.getString(0x12345678) == "foo" );
+      REQUIRE( table.getString(0x0000AFFE) == "bar" );
+      REQUIRE( table.getString(42) == "foobar" );
+    }
+
+    SECTION("Pascal style strings are merged into existing strings")
+    {
+      const std::string_view data = "\x02\0\0\0\x10\0\0\0\x01\0\0\0\0\0\0\0\x02\0\0\0\x08\0\0\0\x04\0\0\0foo\0\x04\0\0\0bar\0"sv;
+      std::vector<uint8_t> buffer(data.begin(), data.end());
+
+      StringTable table;
+      table.addString(2, "old");
+      table.addString(3, "baz");
+      REQUIRE( table.readTable(std::move(buffer), StringTable::DataType::sdPascalStyle) );
+      REQUIRE( table.getNumberOfTableEntries() == 3 );
+      REQUIRE( table.getString(1) == "foo" );
+      REQUIRE( table.getString(2) == "bar" );
+      REQUIRE( table.getString(3) == "baz" );
+    }
+
+    SECTION("unknown type fails")
+    {
+      const std::string_view data = "\x01\0\0\0\x04\0\0\0\x2A\0\0\0\0\0\0\0foo\0"sv;
+      std::vector<uint8_t> buffer(data.begin(), data.end());
+
+      StringTable table;
+      REQUIRE_FALSE( table.readTable(std::move(buffer), StringTable::DataType::sdUnknown) );
+      REQUIRE( table.getNumberOfTableEntries() == 0 );
+    }
+
+    SECTION("invalid data fails")
+    {
+      const std::string_view data = "\x01\0\0\0\x03\0\0\0\x2A\0\0\0\0\0\0\0foo"sv;
+      std::vector<uint8_t> buffer(data.begin(), data.end());
+
+      StringTable table;
+      table.addString(1, "foo");
+      REQUIRE_FALSE( table.readTable(std::move(buffer), StringTable::DataType::sdNULterminated) );
+      REQUIRE( table.getNumberOfTableEntries() == 1 );
+      REQUIRE( table.getString(1) == "foo" );
+    }
+  }
+
+  SECTION("readTable: failures leave the table unchanged")
+  {
+    using namespace std::string_view_literals;
+
+    StringTable table;
+    table.addString(1, "foo");
+
+    SECTION("missing file")
+    {
+      REQUIRE_FALSE( table.readTable("does-not-exist.strings", StringTable::DataType::sdUnknown) );
+    }
+
+    SECTION("directory is cut off")
+    {
+      const std::string_view data = "\x03\0\0\0\x0F\0\0\0\x2A\0\0\0\0\0\0\0"sv;
+      {
+        std::ofstream file("foobar.bad.strings", std::ios::binary);
+        file.write(data.data(), data.size());
+      }
+      REQUIRE_FALSE( table.readTable("foobar.bad.strings", StringTable::DataType::sdUnknown) );
+      REQUIRE( std::filesystem::remove("foobar.bad.strings") );
+    }
+
+    SECTION("offset is beyond the end of the file")
+    {
+      const std::string_view data = "\x01\0\0\0\x04\0\0\0\x2A\0\0\0\x10\0\0\0foo\0"sv;
+      {
+        std::ofstream file("foobar.bad.strings", std::ios::binary);
+        file.write(data.data(), data.size());
+      }
+      REQUIRE_FALSE( table.readTable("foobar.bad.strings", StringTable::DataType::sdUnknown) );
+      REQUIRE( std::filesystem::remove("foobar.bad.strings") );
+    }
+
+    SECTION("string is not terminated")
+    {
+      const std::string_view data = "\x01\0\0\0\x03\0\0\0\x2A\0\0\0\0\0\0\0foo"sv;
+      {
+        std::ofstream file("foobar.bad.strings", std::ios::binary);
+        file.write(data.data(), data.size());
+      }
+      REQUIRE_FALSE( table.readTable("foobar.bad.strings", StringTable::DataType::sdUnknown) );
+      REQUIRE( std::filesystem::remove("foobar.bad.strings") );
+    }
+
+    SECTION("length of Pascal style string is too large")
+    {
+      const std::string_view data = "\x01\0\0\0\x08\0\0\0\x2A\0\0\0\0\0\0\0\x40\0\0\0foo\0"sv;
+      {
+        std::ofstream file("foobar.bad.dlstrings", std::ios::binary);
+        file.write(data.data(), data.size());
+      }
+      REQUIRE_FALSE( table.readTable("foobar.bad.dlstrings", StringTable::DataType::sdUnknown) );
+      REQUIRE( std::filesystem::remove("foobar.bad.dlstrings") );
+    }
+
+    REQUIRE( table.getNumberOfTableEntries() == 1 );
+    REQUIRE( table.getString(1) == "foo" );
+  }
+
+  SECTION("writeTable: entries are sorted by ID")
+  {
+    StringTable table;
+    table.addString(42, "foobar");
+    table.addString(0x0000AFFE, "bar");
+    table.addString(0x12345678, "foo");
+    REQUIRE( table.writeTable("foobar.sorted.strings", StringTable::DataType::sdUnknown) );
+
+    std::ifstream file("foobar.sorted.strings", std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    using namespace std::string_view_literals;
+    REQUIRE( content == "\x03\0\0\0\x0F\0\0\0\x2A\0\0\0\0\0\0\0\xFE\xAF\0\0\x07\0\0\0\x78\x56\x34\x12\x0B\0\0\0foobar\0bar\0foo\0"sv );
+
+    REQUIRE( std::filesystem::remove("foobar.sorted.strings") );
+  }
 }
@@ -0,0 +1,153 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../locate_catch.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include "../../../lib/sr/StringTableCache.hpp"
+
+namespace
+{
+
+bool writeTable(const std::filesystem::path& path, const uint32_t stringID, const std::string& content)
+{
+  SRTP::StringTable table;
+  table.addString(stringID, content);
+  return table.writeTable(path.string(), SRTP::StringTable::sdUnknown);
+}
+
+} // namespace
+
+TEST_CASE("StringTableCache")
+{
+  using namespace SRTP;
+  namespace fs = std::filesystem;
+
+  const fs::path directory = fs::temp_directory_path() / "test_sr_string_table_cache";
+  const fs::path strings = directory / "Strings";
+  const fs::path cacheDirectory = directory / "cache";
+  fs::remove_all(directory);
+  REQUIRE( fs::create_directories(strings) );
+  REQUIRE( fs::create_directories(cacheDirectory) );
+
+  const std::string plugin = (directory / "Cached.esp").string();
+  {
+    std::ofstream file(plugin, std::ios::binary);
+    file << "TES4";
+  }
+  REQUIRE( writeTable(strings / "Cached_english.strings", 1, "foo") );
+  REQUIRE( writeTable(strings / "Cached_english.dlstrings", 2, "bar") );
+  REQUIRE( writeTable(strings / "Cached_english.ilstrings", 3, "baz") );
+
+  auto& cache = StringTableCache::get();
+  cache.clear();
+
+  SECTION("tables are only loaded once")
+  {
+    const auto first = cache.load(plugin, std::nullopt);
+    REQUIRE( first != nullptr );
+    REQUIRE( first->getNumberOfTableEntries() == 3 );
+    REQUIRE( first->getString(1) == "foo" );
+    REQUIRE( first->getString(2) == "bar" );
+    REQUIRE( first->getString(3) == "baz" );
+    REQUIRE( cache.size() == 1 );
+
+    const auto second = cache.load(plugin, std::nullopt);
+    REQUIRE( second == first );
+    REQUIRE( cache.size() == 1 );
+
+    // Another language is another entry.
+    const auto english = cache.load(plugin, Localization::English);
+    REQUIRE( english != nullptr );
+    REQUIRE( english != first );
+    REQUIRE( cache.size() == 2 );
+  }
+
+  SECTION("changed string table files are read again")
+  {
+    const auto first = cache.load(plugin, std::nullopt);
+    REQUIRE( first != nullptr );
+
+    const auto time = fs::last_write_time(strings / "Cached_english.strings");
+    REQUIRE( writeTable(strings / "Cached_english.strings", 1, "changed") );
+    fs::last_write_time(strings / "Cached_english.strings", time + std::chrono::hours(1));
+
+    const auto second = cache.load(plugin, std::nullopt);
+    REQUIRE( second != nullptr );
+    REQUIRE( second != first );
+    REQUIRE( second->getString(1) == "changed" );
+    // Old table stays usable.
+    REQUIRE( first->getString(1) == "foo" );
+    REQUIRE( cache.size() == 1 );
+  }
+
+  SECTION("tables are stored in the cache directory")
+  {
+    cache.setDirectory(cacheDirectory);
+    const auto first = cache.load(plugin, std::nullopt);
+    REQUIRE( first != nullptr );
+    REQUIRE_FALSE( fs::is_empty(cacheDirectory) );
+
+    // Change content, but keep size and time of the file, so that only the
+    // stored table can provide the old content.
+    const auto time = fs::last_write_time(strings / "Cached_english.strings");
+    REQUIRE( writeTable(strings / "Cached_english.strings", 1, "new") );
+    fs::last_write_time(strings / "Cached_english.strings", time);
+
+    cache.clear();
+    const auto second = cache.load(plugin, std::nullopt);
+    REQUIRE( second != nullptr );
+    REQUIRE( second != first );
+    REQUIRE( second->getNumberOfTableEntries() == 3 );
+    REQUIRE( second->getString(1) == "foo" );
+    REQUIRE( second->getString(2) == "bar" );
+    REQUIRE( second->getString(3) == "baz" );
+
+    cache.setDirectory(fs::path());
+  }
+
+  SECTION("corrupt file in cache directory is ignored")
+  {
+    cache.setDirectory(cacheDirectory);
+    REQUIRE( cache.load(plugin, std::nullopt) != nullptr );
+    for (const auto& entry: fs::directory_iterator(cacheDirectory))
+    {
+      // cut off the string data
+      fs::resize_file(entry.path(), fs::file_size(entry.path()) - 4);
+    }
+
+    cache.clear();
+    const auto table = cache.load(plugin, std::nullopt);
+    REQUIRE( table != nullptr );
+    REQUIRE( table->getString(1) == "foo" );
+
+    cache.setDirectory(fs::path());
+  }
+
+  SECTION("missing files fail")
+  {
+    REQUIRE( cache.load((directory / "Missing.esp").string(), std::nullopt) == nullptr );
+    REQUIRE( cache.size() == 0 );
+  }
+
+  cache.clear();
+  fs::remove_all(directory);
+}
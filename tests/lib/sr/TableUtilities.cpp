@@ -175,6 +175,47 @@ TEST_CASE("TableUtilities")
     }
   }
 
+  SECTION("loadStringTableFiles")
+  {
+    const auto glcDirectory = test_directory + "getLanguageComponent" + delim;
+
+    SECTION("success: all tables exist")
+    {
+      std::vector<std::string> files;
+      REQUIRE( getAssociatedTableFiles(glcDirectory + "TestTables.esm", files) == 0 );
+      REQUIRE( files.size() == 3 );
+
+      StringTable table;
+      table.addString(1, "present before");
+      REQUIRE( loadStringTableFiles(files, table) );
+      REQUIRE( table.getNumberOfTableEntries() == 10 );
+      REQUIRE( table.getString(1) == "present before" );
+      REQUIRE( table.getString(0x12345678) == "foo" );
+      REQUIRE( table.getString(43) == "string" );
+      REQUIRE( table.getString(44) == "Italia" );
+    }
+
+    SECTION("failure: one file is missing, table is unchanged")
+    {
+      std::vector<std::string> files;
+      REQUIRE( getAssociatedTableFiles(glcDirectory + "TestTables.esm", files) == 0 );
+      files.push_back(glcDirectory + "does-not-exist.strings");
+
+      StringTable table;
+      table.addString(1, "present before");
+      REQUIRE_FALSE( loadStringTableFiles(files, table) );
+      REQUIRE( table.getNumberOfTableEntries() == 1 );
+      REQUIRE( table.getString(1) == "present before" );
+    }
+
+    SECTION("no files")
+    {
+      StringTable table;
+      REQUIRE( loadStringTableFiles({}, table) );
+      REQUIRE( table.getNumberOfTableEntries() == 0 );
+    }
+  }
+
   SECTION("getBsaName")
   {
     // well-known ESM file names
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project test suite.
-    Copyright (C) 2021  Dirk Stolle
+    Copyright (C) 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -45,4 +45,25 @@ bool TestFactionsReaderGroupFinishFails::groupFinished([[maybe_unused]] const Gr
   return false;
 }
 
+
+int TestFactionsReaderConcurrent::readNextRecord(std::istream& input, const uint32_t recName, const bool localized, const StringTable& table)
+{
+  if (recName != cFACT)
+  {
+    return -1;
+  }
+  FactionRecord record;
+  if (!record.loadFromStream(input, localized, table))
+  {
+    return -1;
+  }
+  applyChange([record]() { Factions::get().addRecord(record); });
+  return 1;
+}
+
+std::unique_ptr<ESMReader> TestFactionsReaderConcurrent::createGroupReader() const
+{
+  return std::make_unique<TestFactionsReaderConcurrent>(*this);
+}
+
 } // namespace
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the Skyrim Tools Project test suite.
-    Copyright (C) 2021  Dirk Stolle
+    Copyright (C) 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -54,6 +54,16 @@ class TestFactionsReaderGroupFinishFails: public TestFactionsReader
     virtual bool groupFinished(const GroupData& g_data) override;
 }; // class
 
+class TestFactionsReaderConcurrent: public TestFactionsReader
+{
+  public:
+    TestFactionsReaderConcurrent() = default;
+
+    virtual int readNextRecord(std::istream& input, const uint32_t recName, const bool localized, const StringTable& table) override;
+
+    virtual std::unique_ptr<ESMReader> createGroupReader() const override;
+}; // class
+
 } // namespace
 
 #endif // SR_TEST_FACTIONSREADER_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for Skyrim Tools Project.
-    Copyright (C) 2021, 2022, 2023, 2024  Dirk Stolle
+    Copyright (C) 2021, 2022, 2023, 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -20,6 +20,8 @@
 
 #include "../../locate_catch.hpp"
 #include <filesystem>
+#include <thread>
+#include <vector>
 #include "../../../../lib/base/FileGuard.hpp"
 #include "../../../../lib/sr/bsa/BSA.hpp"
 
@@ -655,6 +657,28 @@ TEST_CASE("BSA")
       REQUIRE( index.has_value() );
       REQUIRE( index.value() == 1 );
     }
+
+    SECTION("matches, even if stored hashes are wrong")
+    {
+      const std::filesystem::path path{"test_sr_bsa_getIndexOfFile_wrong_hashes.bsa"};
+      FileGuard guard{path};
+      // Hashes of "some\\thing" and "test.txt" are zero in this archive.
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x03\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\x01\0\0\0\0\0\0\0\0\0\0\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0\0\0\0\0\0\0\0\0\x10\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0\0\xB9\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x0E\0\0\0\xC0\0\0\0test.txt\0bar.txt\0foo.txt\0"sv;
+      REQUIRE( writeBsa(data, path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path.string()) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      const auto dir_index = bsa.getIndexOfDirectory("some\\thing");
+      REQUIRE( dir_index.has_value() );
+      REQUIRE( dir_index.value() == 0 );
+
+      const auto index = bsa.getIndexOfFile(0, "test.txt");
+      REQUIRE( index.has_value() );
+      REQUIRE( index.value() == 0 );
+      REQUIRE_FALSE( bsa.getIndexOfFile(0, "foo.txt").has_value() );
+    }
   }
 
   SECTION("getIndexPairForFile")
@@ -1152,6 +1176,8 @@ TEST_CASE("BSA")
       const auto destination { std::filesystem::temp_directory_path() / "extract_test_fail.txt" };
       FileGuard guard_destination{destination};
       REQUIRE_FALSE( bsa.extractFile(0, 0, destination.string()) );
+      // Incomplete output shall not be left behind.
+      REQUIRE_FALSE( std::filesystem::exists(destination) );
     }
 
     SECTION("data corruption: cannot read file name length in archive with embedded names")
@@ -1608,6 +1634,339 @@ TEST_CASE("BSA")
     }
   }
 
+  SECTION("extractFileToMemory")
+  {
+    using namespace std::string_view_literals;
+
+    SECTION("no structure data")
+    {
+      BSA bsa;
+      REQUIRE_FALSE( bsa.extractFileToMemory(1, 1).has_value() );
+    }
+
+    SECTION("index is out of range")
+    {
+      const std::filesystem::path path{"test_sr_bsa_extractFileToMemory_idx_out_of_range.bsa"};
+      FileGuard guard{path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x03\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\x01\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x10\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0\0\xB9\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x0E\0\0\0\xC0\0\0\0test.txt\0bar.txt\0foo.txt\0"sv;
+      REQUIRE( writeBsa(data, path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path.string()) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      constexpr uint32_t over9000 = 9001;
+      REQUIRE_FALSE( bsa.extractFileToMemory(over9000, 1).has_value() );
+      REQUIRE_FALSE( bsa.extractFileToMemory(0, over9000).has_value() );
+    }
+
+    SECTION("data corruption: offset is out of range")
+    {
+      const std::filesystem::path path{"test_sr_bsa_extractFileToMemory_offset_out_of_range.bsa"};
+      FileGuard guard{path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x03\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\x01\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x10\0\0\0\xA9\xFF\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0\0\xB9\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x0E\0\0\0\xC0\0\0\0test.txt\0bar.txt\0foo.txt\0This is a test.\x0A\x66oobar\x0A\x66oo was here.\x0A"sv;
+      REQUIRE( writeBsa(data, path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path.string()) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      REQUIRE_FALSE( bsa.extractFileToMemory(0, 0).has_value() );
+    }
+
+    SECTION("extract uncompressed files from v104 archive")
+    {
+      const std::filesystem::path bsa_path{"test_sr_bsa_extractFileToMemory_no_compression.bsa"};
+      FileGuard bsa_guard{bsa_path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x03\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\x01\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x10\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0\0\xB9\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x0E\0\0\0\xC0\0\0\0test.txt\0bar.txt\0foo.txt\0This is a test.\x0A\x66oobar\x0A\x66oo was here.\x0A"sv;
+      REQUIRE( writeBsa(data, bsa_path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(bsa_path.string()) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      const auto test_txt = bsa.extractFileToMemory(0, 0);
+      REQUIRE( test_txt.has_value() );
+      REQUIRE( std::string(test_txt.value().begin(), test_txt.value().end()) == "This is a test.\n" );
+
+      const auto bar_txt = bsa.extractFileToMemory(1, 0);
+      REQUIRE( bar_txt.has_value() );
+      REQUIRE( std::string(bar_txt.value().begin(), bar_txt.value().end()) == "foobar\n" );
+
+      const auto foo_txt = bsa.extractFileToMemory(1, 1);
+      REQUIRE( foo_txt.has_value() );
+      REQUIRE( std::string(foo_txt.value().begin(), foo_txt.value().end()) == "foo was here.\n" );
+    }
+
+    SECTION("extract compressed files from v104 archive")
+    {
+      const std::filesystem::path bsa_path{"test_sr_bsa_extractFileToMemory_with_compression_v104.bsa"};
+      FileGuard bsa_guard{bsa_path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x07\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\0\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x1A\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0@\xC3\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x1A\0\0\0\xCA\0\0\0test.txt\0bar.txt\0foo.txt\0\x10\0\0\0x\x9C\x0B\xC9\xC8,V\0\xA2\x44\x85\x92\xD4\xE2\x12=.\0.\xC5\x05.foobar\x0A\x0E\0\0\0x\x9CK\xCB\xCFW(O,V\xC8H-J\xD5\xE3\x02\0&&\x04\xAC"sv;
+      REQUIRE( writeBsa(data, bsa_path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(bsa_path.string()) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      const auto test_txt = bsa.extractFileToMemory(0, 0);
+      REQUIRE( test_txt.has_value() );
+      REQUIRE( std::string(test_txt.value().begin(), test_txt.value().end()) == "This is a test.\n" );
+
+      const auto bar_txt = bsa.extractFileToMemory(1, 0);
+      REQUIRE( bar_txt.has_value() );
+      REQUIRE( std::string(bar_txt.value().begin(), bar_txt.value().end()) == "foobar\n" );
+
+      const auto foo_txt = bsa.extractFileToMemory(1, 1);
+      REQUIRE( foo_txt.has_value() );
+      REQUIRE( std::string(foo_txt.value().begin(), foo_txt.value().end()) == "foo was here.\n" );
+    }
+
+    SECTION("extract compressed files from several threads at the same time")
+    {
+      const std::filesystem::path bsa_path{"test_sr_bsa_extractFileToMemory_threads.bsa"};
+      FileGuard bsa_guard{bsa_path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x07\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\0\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x1A\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0@\xC3\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x1A\0\0\0\xCA\0\0\0test.txt\0bar.txt\0foo.txt\0\x10\0\0\0x\x9C\x0B\xC9\xC8,V\0\xA2\x44\x85\x92\xD4\xE2\x12=.\0.\xC5\x05.foobar\x0A\x0E\0\0\0x\x9CK\xCB\xCFW(O,V\xC8H-J\xD5\xE3\x02\0&&\x04\xAC"sv;
+      REQUIRE( writeBsa(data, bsa_path) );
+
+      // Archive is opened as stream, file data is read at explicit offsets.
+      BSA bsa;
+      REQUIRE( bsa.open(bsa_path.string()) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      constexpr unsigned int thread_count = 4;
+      std::vector<int> success(thread_count, 0);
+      std::vector<std::thread> threads;
+      for (unsigned int t = 0; t < thread_count; ++t)
+      {
+        threads.emplace_back([&bsa, &success, t]()
+        {
+          for (int i = 0; i < 50; ++i)
+          {
+            const auto test_txt = bsa.extractFileToMemory(0, 0);
+            const auto bar_txt = bsa.extractFileToMemory(1, 0);
+            const auto foo_txt = bsa.extractFileToMemory(1, 1);
+            if (!test_txt.has_value() || !bar_txt.has_value() || !foo_txt.has_value())
+              return;
+            if ((std::string(test_txt.value().begin(), test_txt.value().end()) != "This is a test.\n")
+                || (std::string(bar_txt.value().begin(), bar_txt.value().end()) != "foobar\n")
+                || (std::string(foo_txt.value().begin(), foo_txt.value().end()) != "foo was here.\n"))
+              return;
+          }
+          success[t] = 1;
+        });
+      }
+      for (auto& thread: threads)
+      {
+        thread.join();
+      }
+      for (const int s: success)
+      {
+        REQUIRE( s == 1 );
+      }
+    }
+  }
+
+  SECTION("memory-mapped archive")
+  {
+    using namespace std::string_view_literals;
+
+    SECTION("getFileBlock fails when archive is not memory-mapped")
+    {
+      const std::filesystem::path path{"test_sr_bsa_mapped_not_mapped.bsa"};
+      FileGuard guard{path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x03\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\x01\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x10\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0\0\xB9\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x0E\0\0\0\xC0\0\0\0test.txt\0bar.txt\0foo.txt\0This is a test.\x0A\x66oobar\x0A\x66oo was here.\x0A"sv;
+      REQUIRE( writeBsa(data, path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path.string()) );
+      REQUIRE_FALSE( bsa.isMemoryMapped() );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      REQUIRE_FALSE( bsa.getFileBlock(0, 0).has_value() );
+    }
+
+    SECTION("getFileBlock fails without structure data")
+    {
+      const std::filesystem::path path{"test_sr_bsa_mapped_no_structure.bsa"};
+      FileGuard guard{path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x03\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\x01\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x10\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0\0\xB9\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x0E\0\0\0\xC0\0\0\0test.txt\0bar.txt\0foo.txt\0This is a test.\x0A\x66oobar\x0A\x66oo was here.\x0A"sv;
+      REQUIRE( writeBsa(data, path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path.string(), BSA::OpenMode::MemoryMapped) );
+      REQUIRE( bsa.isMemoryMapped() );
+
+      REQUIRE_FALSE( bsa.getFileBlock(0, 0).has_value() );
+    }
+
+    SECTION("close removes mapping")
+    {
+      const std::filesystem::path path{"test_sr_bsa_mapped_close.bsa"};
+      FileGuard guard{path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x03\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\x01\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x10\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0\0\xB9\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x0E\0\0\0\xC0\0\0\0test.txt\0bar.txt\0foo.txt\0This is a test.\x0A\x66oobar\x0A\x66oo was here.\x0A"sv;
+      REQUIRE( writeBsa(data, path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path.string(), BSA::OpenMode::MemoryMapped) );
+      REQUIRE( bsa.isMemoryMapped() );
+      bsa.close();
+      REQUIRE_FALSE( bsa.isMemoryMapped() );
+    }
+
+    SECTION("data corruption: offset is out of range")
+    {
+      const std::filesystem::path path{"test_sr_bsa_mapped_offset_out_of_range.bsa"};
+      FileGuard guard{path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x03\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\x01\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x10\0\0\0\xA9\xFF\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0\0\xB9\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x0E\0\0\0\xC0\0\0\0test.txt\0bar.txt\0foo.txt\0This is a test.\x0A\x66oobar\x0A\x66oo was here.\x0A"sv;
+      REQUIRE( writeBsa(data, path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path.string(), BSA::OpenMode::MemoryMapped) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      REQUIRE_FALSE( bsa.getFileBlock(0, 0).has_value() );
+      REQUIRE_FALSE( bsa.extractFileToMemory(0, 0).has_value() );
+    }
+
+    SECTION("uncompressed files from v104 archive")
+    {
+      const std::filesystem::path path{"test_sr_bsa_mapped_no_compression.bsa"};
+      FileGuard guard{path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x03\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\x01\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x10\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0\0\xB9\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x0E\0\0\0\xC0\0\0\0test.txt\0bar.txt\0foo.txt\0This is a test.\x0A\x66oobar\x0A\x66oo was here.\x0A"sv;
+      REQUIRE( writeBsa(data, path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path.string(), BSA::OpenMode::MemoryMapped) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      const auto block = bsa.getFileBlock(1, 1);
+      REQUIRE( block.has_value() );
+      REQUIRE( std::string(block.value().begin(), block.value().end()) == "foo was here.\n" );
+
+      const auto test_txt = bsa.extractFileToMemory(0, 0);
+      REQUIRE( test_txt.has_value() );
+      REQUIRE( std::string(test_txt.value().begin(), test_txt.value().end()) == "This is a test.\n" );
+
+      const auto bar_size = bsa.getExtractedFileSize(1, 0);
+      REQUIRE( bar_size.has_value() );
+      REQUIRE( bar_size.value() == 7 );
+
+      const auto path_out { std::filesystem::temp_directory_path() / "extract_mapped_bar.txt" };
+      FileGuard guard_out{path_out};
+      REQUIRE( bsa.extractFile(1, 0, path_out.string()) );
+      std::ifstream stream(path_out, std::ios::in | std::ios::binary);
+      std::string content;
+      std::getline(stream, content, static_cast<char>(std::char_traits<char>::eof()));
+      REQUIRE( content == "foobar\n" );
+    }
+
+    SECTION("compressed files from v104 archive")
+    {
+      const std::filesystem::path path{"test_sr_bsa_mapped_with_compression_v104.bsa"};
+      FileGuard guard{path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x07\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\0\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x1A\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0@\xC3\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x1A\0\0\0\xCA\0\0\0test.txt\0bar.txt\0foo.txt\0\x10\0\0\0x\x9C\x0B\xC9\xC8,V\0\xA2\x44\x85\x92\xD4\xE2\x12=.\0.\xC5\x05.foobar\x0A\x0E\0\0\0x\x9CK\xCB\xCFW(O,V\xC8H-J\xD5\xE3\x02\0&&\x04\xAC"sv;
+      REQUIRE( writeBsa(data, path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path.string(), BSA::OpenMode::MemoryMapped) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      // Block of compressed file starts with size of decompressed data.
+      const auto block = bsa.getFileBlock(0, 0);
+      REQUIRE( block.has_value() );
+      REQUIRE( block.value().size() == 26 );
+      REQUIRE( block.value()[0] == 16 );
+
+      const auto size = bsa.getExtractedFileSize(0, 0);
+      REQUIRE( size.has_value() );
+      REQUIRE( size.value() == 16 );
+
+      const auto test_txt = bsa.extractFileToMemory(0, 0);
+      REQUIRE( test_txt.has_value() );
+      REQUIRE( std::string(test_txt.value().begin(), test_txt.value().end()) == "This is a test.\n" );
+
+      const auto foo_txt = bsa.extractFileToMemory(1, 1);
+      REQUIRE( foo_txt.has_value() );
+      REQUIRE( std::string(foo_txt.value().begin(), foo_txt.value().end()) == "foo was here.\n" );
+    }
+
+    SECTION("uncompressed files from v104 archive with embedded names")
+    {
+      const std::filesystem::path path{"test_sr_bsa_mapped_embedded_names_v104.bsa"};
+      FileGuard guard{path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x03\x01\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\0\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95$\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x1E\0\0\0\xCD\0\0\0oo\x03\x66\xC2\xA6\xD0\x95%\0\0\0\xEB\0\0\0test.txt\0bar.txt\0foo.txt\0\x13some\\thing\\test.txtThis is a test.\x0A\x16something\\\x65lse\\\x62\x61r.txtfoobar\x0A\x16something\\\x65lse\\\x66oo.txtfoo was here.\x0A"sv;
+      REQUIRE( writeBsa(data, path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path.string(), BSA::OpenMode::MemoryMapped) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      const auto block = bsa.getFileBlock(0, 0);
+      REQUIRE( block.has_value() );
+      REQUIRE( std::string(block.value().begin(), block.value().end()) == "This is a test.\n" );
+
+      const auto size = bsa.getExtractedFileSize(1, 0);
+      REQUIRE( size.has_value() );
+      REQUIRE( size.value() == 7 );
+    }
+
+    SECTION("compressed files from v104 archive with embedded names")
+    {
+      const std::filesystem::path path{"test_sr_bsa_mapped_compressed_embedded_names_v104.bsa"};
+      FileGuard guard{path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x07\x01\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\0\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95/\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95+\0\0\0\xD8\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x32\0\0\0\x03\x01\0\0test.txt\0bar.txt\0foo.txt\0\x13some\\thing\\test.txt\x10\0\0\0x\x9C\x0B\xC9\xC8,V\0\xA2\x44\x85\x92\xD4\xE2\x12=.\0.\xC5\x05.\x0A\x16something/else/bar.txt\x07\0\0\0x\x9CK\xCB\xCFOJ,\xE2\x02\0\x0B/\x02\x84\x0A\x16something/else/foo.txt\x0E\0\0\0x\x9CK\xCB\xCFW(O,V\xC8H-J\xD5\xE3\x02\0&&\x04\xAC\x0A"sv;
+      REQUIRE( writeBsa(data, path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path.string(), BSA::OpenMode::MemoryMapped) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      const auto test_txt = bsa.extractFileToMemory(0, 0);
+      REQUIRE( test_txt.has_value() );
+      REQUIRE( std::string(test_txt.value().begin(), test_txt.value().end()) == "This is a test.\n" );
+
+      const auto bar_txt = bsa.extractFileToMemory(1, 0);
+      REQUIRE( bar_txt.has_value() );
+      REQUIRE( std::string(bar_txt.value().begin(), bar_txt.value().end()) == "foobar\n" );
+    }
+  }
+
+  SECTION("extractFileToMemory (with file name parameter)")
+  {
+    using namespace std::string_view_literals;
+
+    SECTION("no structure data")
+    {
+      BSA bsa;
+      REQUIRE_FALSE( bsa.extractFileToMemory("foo\\bar.baz").has_value() );
+    }
+
+    SECTION("extract compressed files from v104 archive")
+    {
+      const std::filesystem::path bsa_path{"test_sr_bsa_extractFileToMemory_by_name.bsa"};
+      FileGuard bsa_guard{bsa_path};
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x07\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\0\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x1A\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0@\xC3\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x1A\0\0\0\xCA\0\0\0test.txt\0bar.txt\0foo.txt\0\x10\0\0\0x\x9C\x0B\xC9\xC8,V\0\xA2\x44\x85\x92\xD4\xE2\x12=.\0.\xC5\x05.foobar\x0A\x0E\0\0\0x\x9CK\xCB\xCFW(O,V\xC8H-J\xD5\xE3\x02\0&&\x04\xAC"sv;
+      REQUIRE( writeBsa(data, bsa_path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(bsa_path.string()) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      const auto test_txt = bsa.extractFileToMemory("some\\thing\\test.txt");
+      REQUIRE( test_txt.has_value() );
+      REQUIRE( std::string(test_txt.value().begin(), test_txt.value().end()) == "This is a test.\n" );
+
+      // Names are not case-sensitive.
+      const auto foo_txt = bsa.extractFileToMemory("Something\\Else\\FOO.txt");
+      REQUIRE( foo_txt.has_value() );
+      REQUIRE( std::string(foo_txt.value().begin(), foo_txt.value().end()) == "foo was here.\n" );
+
+      REQUIRE_FALSE( bsa.extractFileToMemory("something\\else\\baz.txt").has_value() );
+      REQUIRE_FALSE( bsa.extractFileToMemory("nothing\\bar.txt").has_value() );
+    }
+  }
+
   SECTION("extractFile (with file name parameter)")
   {
     using namespace std::string_view_literals;
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for Skyrim Tools Project.
-    Copyright (C) 2022, 2024  Dirk Stolle
+    Copyright (C) 2022, 2024, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -18,7 +18,9 @@
  -------------------------------------------------------------------------------
 */
 
+#include <array>
 #include <filesystem>
+#include <string>
 #include <type_traits>
 #include "../../locate_catch.hpp"
 #include "../../../../lib/sr/bsa/BSAHash.hpp"
@@ -147,4 +149,94 @@ TEST_CASE("BSAHash")
       REQUIRE( calculateDirectoryHash(".") == 0x000000002e01002e );
     }
   }
+
+  SECTION("calculateFileNameHash")
+  {
+    SECTION("same values as calculateHash")
+    {
+      for (const std::string name: { "dog.dds", "hayscatter01.nif", "controlmap.txt",
+                                     "fx_melee_draugr_03.wav", "idle.kf", "Readme",
+                                     "a", "ab", "abc.", ".dds", "x.DDS", "" })
+      {
+        REQUIRE( calculateFileNameHash(name) == calculateHash(name) );
+      }
+    }
+
+    SECTION("test against known values")
+    {
+      REQUIRE( calculateFileNameHash("dog.dds") == 0x8ddba9c56403efe7 );
+      REQUIRE( calculateFileNameHash("DOG.DDS") == 0x8ddba9c56403efe7 );
+      REQUIRE( calculateFileNameHash("thalmorbootsf.nif") == 0x79bfee0c740df366 );
+      REQUIRE( calculateFileNameHash("mouse.txt") == 0x963fc2886d057365 );
+      REQUIRE( calculateFileNameHash("qst_da16_magic_barrier_key_off.wav") == 0x97874854f11e6666 );
+    }
+
+    SECTION("hash of a part of a larger string")
+    {
+      const std::string_view buffer = "xxdog.ddsyy";
+      REQUIRE( calculateFileNameHash(buffer.substr(2, 7)) == 0x8ddba9c56403efe7 );
+    }
+  }
+
+  SECTION("calculateDirectoryNameHash")
+  {
+    REQUIRE( calculateDirectoryNameHash("grass") == 0x00721c6f67057373 );
+    REQUIRE( calculateDirectoryNameHash("textures\\actors\\dlc01\\spriggan") == 0x7b3a1922741e616e );
+    REQUIRE( calculateDirectoryNameHash("Textures/Actors/DLC01/Spriggan") == 0x7b3a1922741e616e );
+    REQUIRE( calculateDirectoryNameHash(".") == 0x000000002e01002e );
+    // Dots in parent directories are no extension.
+    REQUIRE( calculateDirectoryNameHash("meshes\\a.b\\c") == calculateDirectoryNameHash("meshes/a.b/c") );
+    REQUIRE( calculateDirectoryNameHash("meshes\\a.b\\c") == calculateDirectoryHash("meshes/a.b/c") );
+  }
+
+  SECTION("calculateFileNameHashes")
+  {
+    using namespace std::string_view_literals;
+
+    SECTION("names separated by NUL")
+    {
+      const auto names = "dog.dds\0hayscatter01.nif\0mouse.txt\0"sv;
+      std::array<BSAHash, 4> hashes{};
+      REQUIRE( calculateFileNameHashes(names, hashes.data(), hashes.size()) == 3 );
+      REQUIRE( hashes[0] == 0x8ddba9c56403efe7 );
+      REQUIRE( hashes[1] == 0x7688bca3680cb031 );
+      REQUIRE( hashes[2] == 0x963fc2886d057365 );
+      REQUIRE( hashes[3] == 0 );
+    }
+
+    SECTION("last name without terminator")
+    {
+      const auto names = "dog.dds\0mouse.txt"sv;
+      std::array<BSAHash, 2> hashes{};
+      REQUIRE( calculateFileNameHashes(names, hashes.data(), hashes.size()) == 2 );
+      REQUIRE( hashes[0] == 0x8ddba9c56403efe7 );
+      REQUIRE( hashes[1] == 0x963fc2886d057365 );
+    }
+
+    SECTION("stops when the output array is full")
+    {
+      const auto names = "dog.dds\0hayscatter01.nif\0mouse.txt\0"sv;
+      std::array<BSAHash, 2> hashes{};
+      REQUIRE( calculateFileNameHashes(names, hashes.data(), hashes.size()) == 2 );
+      REQUIRE( hashes[1] == 0x7688bca3680cb031 );
+    }
+
+    SECTION("empty buffer")
+    {
+      BSAHash hash = 0;
+      REQUIRE( calculateFileNameHashes(""sv, &hash, 1) == 0 );
+    }
+  }
+
+  SECTION("calculateDirectoryNameHashes")
+  {
+    using namespace std::string_view_literals;
+
+    const auto names = "grass\0interface/exported\0sound\\fx\0"sv;
+    std::array<BSAHash, 3> hashes{};
+    REQUIRE( calculateDirectoryNameHashes(names, hashes.data(), hashes.size()) == 3 );
+    REQUIRE( hashes[0] == 0x00721c6f67057373 );
+    REQUIRE( hashes[1] == 0x4b5abe2069126564 );
+    REQUIRE( hashes[2] == 0xeda95b2073086678 );
+  }
 }
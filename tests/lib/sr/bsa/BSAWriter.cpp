@@ -0,0 +1,228 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../../locate_catch.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "../../../../lib/base/FileGuard.hpp"
+#include "../../../../lib/sr/bsa/BSA.hpp"
+#include "../../../../lib/sr/bsa/BSAWriter.hpp"
+
+namespace
+{
+
+bool writeTestFile(const std::filesystem::path& path, const std::string_view content)
+{
+  std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  stream.write(content.data(), content.size());
+  return stream.good();
+}
+
+std::string readTestFile(const std::filesystem::path& path)
+{
+  std::ifstream stream(path, std::ios::in | std::ios::binary);
+  std::ostringstream content;
+  content << stream.rdbuf();
+  return content.str();
+}
+
+/// Checks that the archive contains the given file with the given content.
+bool hasContent(SRTP::BSA& bsa, const std::string& directory, const std::string& file, const std::string& content)
+{
+  const auto dirIndex = bsa.getIndexOfDirectory(directory);
+  if (!dirIndex.has_value())
+    return false;
+  const auto fileIndex = bsa.getIndexOfFile(dirIndex.value(), file);
+  if (!fileIndex.has_value())
+    return false;
+  const auto data = bsa.extractFileToMemory(dirIndex.value(), fileIndex.value());
+  if (!data.has_value())
+    return false;
+  return std::string(data.value().begin(), data.value().end()) == content;
+}
+
+} // namespace
+
+TEST_CASE("BSAWriter")
+{
+  using namespace SRTP;
+  using namespace std::string_view_literals;
+  using FileGuard = MWTP::FileGuard;
+
+  const std::filesystem::path source{"test_sr_bsa_writer_source"};
+  std::filesystem::remove_all(source);
+  REQUIRE( std::filesystem::create_directories(source / "some" / "thing") );
+  REQUIRE( std::filesystem::create_directories(source / "something" / "else") );
+  REQUIRE( writeTestFile(source / "some" / "thing" / "test.txt", "This is a test.\n") );
+  REQUIRE( writeTestFile(source / "something" / "else" / "bar.txt", "foobar\n") );
+  REQUIRE( writeTestFile(source / "something" / "else" / "foo.txt", "foo was here.\n") );
+  const std::string compressible = std::string(2000, 'a') + std::string(2000, 'b');
+  REQUIRE( writeTestFile(source / "big.txt", compressible) );
+
+  SECTION("addFile")
+  {
+    BSAWriter writer;
+    REQUIRE( writer.fileCount() == 0 );
+
+    SECTION("normalizes path")
+    {
+      REQUIRE( writer.addFile(source / "big.txt", "Foo/Bar/BIG.txt") );
+      REQUIRE( writer.fileCount() == 1 );
+      // same file with backslashes
+      REQUIRE_FALSE( writer.addFile(source / "big.txt", "foo\\bar\\big.txt") );
+      REQUIRE( writer.fileCount() == 1 );
+    }
+
+    SECTION("rejects invalid paths")
+    {
+      REQUIRE_FALSE( writer.addFile(source / "big.txt", "") );
+      REQUIRE_FALSE( writer.addFile(source / "big.txt", "foo/") );
+      REQUIRE_FALSE( writer.addFile(source / "big.txt", "/foo.txt") );
+      REQUIRE_FALSE( writer.addFile(source / "big.txt", std::string(255, 'a') + "/foo.txt") );
+      REQUIRE( writer.fileCount() == 0 );
+    }
+
+    SECTION("file in root directory")
+    {
+      REQUIRE( writer.addFile(source / "big.txt", "big.txt") );
+      REQUIRE( writer.fileCount() == 1 );
+    }
+  }
+
+  SECTION("addDirectoryTree")
+  {
+    BSAWriter writer;
+    REQUIRE( writer.addDirectoryTree(source) );
+    REQUIRE( writer.fileCount() == 4 );
+
+    REQUIRE_FALSE( writer.addDirectoryTree("/does/not/exist/here") );
+  }
+
+  SECTION("write")
+  {
+    SECTION("fails without files")
+    {
+      const std::filesystem::path path{"test_sr_bsa_writer_empty.bsa"};
+      BSAWriter writer;
+      REQUIRE_FALSE( writer.write(path) );
+    }
+
+    SECTION("fails with unsupported version")
+    {
+      const std::filesystem::path path{"test_sr_bsa_writer_version.bsa"};
+      BSAWriter writer(103, false);
+      REQUIRE( writer.addFile(source / "big.txt", "big.txt") );
+      REQUIRE_FALSE( writer.write(path) );
+    }
+
+    SECTION("uncompressed version 104 archive matches known archive")
+    {
+      const std::filesystem::path path{"test_sr_bsa_writer_known.bsa"};
+      FileGuard guard{path};
+
+      BSAWriter writer(104, false);
+      REQUIRE( writer.addFile(source / "some" / "thing" / "test.txt", "some\\thing\\test.txt") );
+      REQUIRE( writer.addFile(source / "something" / "else" / "bar.txt", "something\\else\\bar.txt") );
+      REQUIRE( writer.addFile(source / "something" / "else" / "foo.txt", "something\\else\\foo.txt") );
+      REQUIRE( writer.write(path) );
+
+      const auto expected = "BSA\0\x68\0\0\0\x24\0\0\0\x03\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\x01\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x10\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0\0\xB9\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x0E\0\0\0\xC0\0\0\0test.txt\0bar.txt\0foo.txt\0This is a test.\x0A\x66oobar\x0A\x66oo was here.\x0A"sv;
+      REQUIRE( readTestFile(path) == expected );
+    }
+
+    SECTION("compressed version 104 archive")
+    {
+      const std::filesystem::path path{"test_sr_bsa_writer_104_compressed.bsa"};
+      FileGuard guard{path};
+
+      BSAWriter writer(104, true, 3);
+      REQUIRE( writer.addDirectoryTree(source) );
+      REQUIRE( writer.write(path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path) );
+      REQUIRE( bsa.getHeader().version == 104 );
+      REQUIRE( bsa.getHeader().filesCompressedByDefault() );
+      REQUIRE( bsa.grabAllStructureData() );
+      REQUIRE( bsa.getDirectories().size() == 3 );
+
+      REQUIRE( hasContent(bsa, "some\\thing", "test.txt", "This is a test.\n") );
+      REQUIRE( hasContent(bsa, "something\\else", "bar.txt", "foobar\n") );
+      REQUIRE( hasContent(bsa, "something\\else", "foo.txt", "foo was here.\n") );
+      REQUIRE( hasContent(bsa, ".", "big.txt", compressible) );
+
+      // Small files do not benefit from compression, but the large one does.
+      const auto dirIndex = bsa.getIndexOfDirectory(".");
+      REQUIRE( dirIndex.has_value() );
+      REQUIRE( bsa.isFileCompressed(dirIndex.value(), 0) );
+      REQUIRE( bsa.getDirectoryBlocks()[dirIndex.value()].files[0].getRealFileBlockSize() < compressible.size() );
+      const auto smallIndex = bsa.getIndexOfDirectory("some\\thing");
+      REQUIRE( smallIndex.has_value() );
+      REQUIRE_FALSE( bsa.isFileCompressed(smallIndex.value(), 0) );
+    }
+
+    SECTION("uncompressed version 105 archive")
+    {
+      const std::filesystem::path path{"test_sr_bsa_writer_105_uncompressed.bsa"};
+      FileGuard guard{path};
+
+      BSAWriter writer(105, false, 2);
+      REQUIRE( writer.addDirectoryTree(source) );
+      REQUIRE( writer.write(path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path) );
+      REQUIRE( bsa.getHeader().version == 105 );
+      REQUIRE_FALSE( bsa.getHeader().filesCompressedByDefault() );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      REQUIRE( hasContent(bsa, "some\\thing", "test.txt", "This is a test.\n") );
+      REQUIRE( hasContent(bsa, "something\\else", "bar.txt", "foobar\n") );
+      REQUIRE( hasContent(bsa, "something\\else", "foo.txt", "foo was here.\n") );
+      REQUIRE( hasContent(bsa, ".", "big.txt", compressible) );
+    }
+
+    #if !defined(MWTP_NO_LZ4)
+    SECTION("compressed version 105 archive")
+    {
+      const std::filesystem::path path{"test_sr_bsa_writer_105_compressed.bsa"};
+      FileGuard guard{path};
+
+      BSAWriter writer(105, true, 2);
+      REQUIRE( writer.addDirectoryTree(source) );
+      REQUIRE( writer.write(path) );
+
+      BSA bsa;
+      REQUIRE( bsa.open(path) );
+      REQUIRE( bsa.getHeader().version == 105 );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      REQUIRE( hasContent(bsa, "some\\thing", "test.txt", "This is a test.\n") );
+      REQUIRE( hasContent(bsa, "something\\else", "bar.txt", "foobar\n") );
+      REQUIRE( hasContent(bsa, "something\\else", "foo.txt", "foo was here.\n") );
+      REQUIRE( hasContent(bsa, ".", "big.txt", compressible) );
+    }
+    #endif
+  }
+
+  std::filesystem::remove_all(source);
+}
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for Skyrim Tools Project.
-    Copyright (C) 2021, 2022  Dirk Stolle
+    Copyright (C) 2021, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -41,6 +41,7 @@ TEST_CASE("bsa_cli::Operations")
     REQUIRE( std::find(all.begin(), all.end(), Operation::Help) != all.end() );
     REQUIRE( std::find(all.begin(), all.end(), Operation::Info) != all.end() );
     REQUIRE( std::find(all.begin(), all.end(), Operation::List) != all.end() );
+    REQUIRE( std::find(all.begin(), all.end(), Operation::Pack) != all.end() );
   }
 
   SECTION("operationToString")
@@ -54,7 +55,7 @@ TEST_CASE("bsa_cli::Operations")
 
   SECTION("operationToString - invalid enumeration")
   {
-    const Operation op = static_cast<Operation>(static_cast<int>(Operation::List) + 42);
+    const Operation op = static_cast<Operation>(static_cast<int>(Operation::Pack) + 42);
 
     REQUIRE( operationToString(op).empty() );
   }
@@ -82,6 +83,7 @@ TEST_CASE("bsa_cli::Operations")
     REQUIRE( parseOperation("file-metadata") == Operation::FileMetadata );
     REQUIRE( parseOperation("help") == Operation::Help );
     REQUIRE( parseOperation("list") == Operation::List );
+    REQUIRE( parseOperation("pack") == Operation::Pack );
     REQUIRE( parseOperation("info") == Operation::Info );
 
     REQUIRE( parseOperation("ChEcK-HaShEs") == std::nullopt );
@@ -96,5 +98,6 @@ TEST_CASE("bsa_cli::Operations")
     REQUIRE( parseOperation("hELp") == std::nullopt );
     REQUIRE( parseOperation("LiSt") == std::nullopt );
     REQUIRE( parseOperation("InFo") == std::nullopt );
+    REQUIRE( parseOperation("PaCk") == std::nullopt );
   }
 }
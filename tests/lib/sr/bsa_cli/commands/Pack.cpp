@@ -0,0 +1,134 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../../../locate_catch.hpp"
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include "../../../../../lib/base/FileGuard.hpp"
+#include "../../../../../apps/sr/bsa_cli/commands/Pack.hpp"
+
+TEST_CASE("bsa_cli::Pack")
+{
+  using namespace std::string_view_literals;
+  using namespace std::string_literals;
+  using namespace SRTP::bsa_cli;
+
+  SECTION("parseArguments with nullptr")
+  {
+    Pack command;
+    REQUIRE( command.parseArguments(4, nullptr) != 0 );
+  }
+
+  SECTION("parseArguments")
+  {
+    const auto arguments = std::string("a.out\0pack\0pack_source_dir\0foo_pack.bsa\0fail"sv);
+    std::array<char*, 5> argArr = {
+        const_cast<char*>(&arguments.c_str()[0]),
+        const_cast<char*>(&arguments.c_str()[6]),
+        const_cast<char*>(&arguments.c_str()[11]),
+        const_cast<char*>(&arguments.c_str()[27]),
+        const_cast<char*>(&arguments.c_str()[40])
+    };
+    char ** argv = argArr.data();
+
+    REQUIRE( argv[0] == "a.out"s );
+    REQUIRE( argv[1] == "pack"s );
+    REQUIRE( argv[2] == "pack_source_dir"s );
+    REQUIRE( argv[3] == "foo_pack.bsa"s );
+    REQUIRE( argv[4] == "fail"s );
+
+    Pack command;
+
+    REQUIRE( command.parseArguments(1, argv) != 0 );
+    REQUIRE( command.parseArguments(2, argv) != 0 );
+    REQUIRE( command.parseArguments(3, argv) != 0 );
+    REQUIRE( command.parseArguments(4, argv) != 0 );
+
+    const std::filesystem::path directory{"pack_source_dir"};
+    REQUIRE( std::filesystem::create_directory(directory) );
+
+    Pack other;
+    const int success = other.parseArguments(4, argv);
+    Pack third;
+    const int tooMany = third.parseArguments(5, argv);
+    std::filesystem::remove_all(directory);
+
+    REQUIRE( success == 0 );
+    REQUIRE( tooMany != 0 );
+  }
+
+  SECTION("parseArguments: invalid version")
+  {
+    const auto arguments = std::string("a.out\0pack\0--version\0" "103\0"sv);
+    std::array<char*, 4> argArr = {
+        const_cast<char*>(&arguments.c_str()[0]),
+        const_cast<char*>(&arguments.c_str()[6]),
+        const_cast<char*>(&arguments.c_str()[11]),
+        const_cast<char*>(&arguments.c_str()[21])
+    };
+    char ** argv = argArr.data();
+
+    REQUIRE( argv[2] == "--version"s );
+    REQUIRE( argv[3] == "103"s );
+
+    Pack command;
+    REQUIRE( command.parseArguments(3, argv) != 0 );
+    REQUIRE( command.parseArguments(4, argv) != 0 );
+  }
+
+  SECTION("run: fail with empty directory")
+  {
+    const auto arguments = std::string("a.out\0pack\0pack_source_dir\0foo_pack.bsa\0"sv);
+    std::array<char*, 4> argArr = {
+        const_cast<char*>(&arguments.c_str()[0]),
+        const_cast<char*>(&arguments.c_str()[6]),
+        const_cast<char*>(&arguments.c_str()[11]),
+        const_cast<char*>(&arguments.c_str()[27])
+    };
+    char ** argv = argArr.data();
+
+    const std::filesystem::path directory{"pack_source_dir"};
+    REQUIRE( std::filesystem::create_directory(directory) );
+
+    Pack command;
+    const int parse = command.parseArguments(4, argv);
+    const int run = command.run();
+    const bool archiveExists = std::filesystem::exists("foo_pack.bsa");
+    std::filesystem::remove_all(directory);
+
+    REQUIRE( parse == 0 );
+    // Run should fail, because there are no files to pack.
+    REQUIRE( run != 0 );
+    REQUIRE_FALSE( archiveExists );
+  }
+
+  SECTION("helpShort returns non-empty string")
+  {
+    Pack command;
+    REQUIRE_FALSE( command.helpShort().empty() );
+  }
+
+  SECTION("helpLong returns non-empty string")
+  {
+    Pack command;
+    REQUIRE_FALSE( command.helpLong("foo").empty() );
+  }
+}
@@ -0,0 +1,149 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../../../locate_catch.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "../../../../../lib/base/FileGuard.hpp"
+#include "../../../../../apps/sr/bsa_cli/commands/ParallelExtraction.hpp"
+
+std::string readWholeFile(const std::filesystem::path& path)
+{
+  std::ifstream stream(path, std::ios::in | std::ios::binary);
+  std::ostringstream content;
+  content << stream.rdbuf();
+  return content.str();
+}
+
+TEST_CASE("bsa_cli::ParallelExtraction")
+{
+  using namespace std::string_view_literals;
+  using namespace SRTP::bsa_cli;
+
+  SECTION("parseThreadCount")
+  {
+    SECTION("valid values")
+    {
+      REQUIRE( parseThreadCount("1") == 1u );
+      REQUIRE( parseThreadCount("4") == 4u );
+      REQUIRE( parseThreadCount("16") == 16u );
+      REQUIRE( parseThreadCount("256") == 256u );
+      REQUIRE( parseThreadCount("007") == 7u );
+    }
+
+    SECTION("invalid values")
+    {
+      REQUIRE_FALSE( parseThreadCount("").has_value() );
+      REQUIRE_FALSE( parseThreadCount("0").has_value() );
+      REQUIRE_FALSE( parseThreadCount("000").has_value() );
+      REQUIRE_FALSE( parseThreadCount("-1").has_value() );
+      REQUIRE_FALSE( parseThreadCount("+2").has_value() );
+      REQUIRE_FALSE( parseThreadCount("257").has_value() );
+      REQUIRE_FALSE( parseThreadCount("1000").has_value() );
+      REQUIRE_FALSE( parseThreadCount("abc").has_value() );
+      REQUIRE_FALSE( parseThreadCount("4x").has_value() );
+      REQUIRE_FALSE( parseThreadCount(" 4").has_value() );
+    }
+  }
+
+  SECTION("extractParallel")
+  {
+    const std::filesystem::path path{"test_sr_bsa_cli_parallel_extraction.bsa"};
+    MWTP::FileGuard guard{path};
+    {
+      const auto data = "BSA\0\x68\0\0\0\x24\0\0\0\x03\0\0\0\x02\0\0\0\x03\0\0\0\x1A\0\0\0\x19\0\0\0\0\x01\0\0gn\x0As@r\xBE\x0B\x01\0\0\0]\0\0\0es\x0Es\xDC\x92\x84Z\x02\0\0\0y\0\0\0\x0Bsome\\thing\0ts\x04t'\xA7\xD0\x95\x10\0\0\0\xA9\0\0\0\x0Fsomething\\\x65lse\0ra\x03\x62\xC2\xA6\xD0\x95\x07\0\0\0\xB9\0\0\0oo\x03\x66\xC2\xA6\xD0\x95\x0E\0\0\0\xC0\0\0\0test.txt\0bar.txt\0foo.txt\0This is a test.\x0A\x66oobar\x0A\x66oo was here.\x0A"sv;
+      std::ofstream stream(path, std::ios::out | std::ios::binary);
+      stream.write(data.data(), data.size());
+      REQUIRE( stream.good() );
+    }
+
+    SECTION("extracts all files")
+    {
+      const std::filesystem::path destination{"test_sr_bsa_cli_parallel_extraction_destination"};
+      REQUIRE( std::filesystem::create_directory(destination) );
+
+      SRTP::BSA bsa;
+      REQUIRE( bsa.open(path.string(), SRTP::BSA::OpenMode::MemoryMapped) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      std::vector<ExtractionJob> jobs;
+      for (uint32_t i = 0; i < bsa.getDirectoryBlocks().size(); ++i)
+      {
+        addDirectoryJobs(bsa, i, destination.string(), jobs);
+      }
+      REQUIRE( jobs.size() == 3 );
+
+      uint32_t extracted = 0;
+      const bool success = extractParallel(bsa, jobs, 4, extracted);
+      const auto test = readWholeFile(destination / "test.txt");
+      const auto bar = readWholeFile(destination / "bar.txt");
+      const auto foo = readWholeFile(destination / "foo.txt");
+      std::filesystem::remove_all(destination);
+
+      REQUIRE( success );
+      REQUIRE( extracted == 3 );
+      REQUIRE( test == "This is a test.\n" );
+      REQUIRE( bar == "foobar\n" );
+      REQUIRE( foo == "foo was here.\n" );
+    }
+
+    SECTION("extracts all files of an archive opened as stream")
+    {
+      const std::filesystem::path destination{"test_sr_bsa_cli_parallel_extraction_destination"};
+      REQUIRE( std::filesystem::create_directory(destination) );
+
+      SRTP::BSA bsa;
+      REQUIRE( bsa.open(path.string(), SRTP::BSA::OpenMode::Stream) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      std::vector<ExtractionJob> jobs;
+      for (uint32_t i = 0; i < bsa.getDirectoryBlocks().size(); ++i)
+      {
+        addDirectoryJobs(bsa, i, destination.string(), jobs);
+      }
+      REQUIRE( jobs.size() == 3 );
+
+      uint32_t extracted = 0;
+      const bool success = extractParallel(bsa, jobs, 4, extracted);
+      const auto test = readWholeFile(destination / "test.txt");
+      const auto bar = readWholeFile(destination / "bar.txt");
+      const auto foo = readWholeFile(destination / "foo.txt");
+      std::filesystem::remove_all(destination);
+
+      REQUIRE( success );
+      REQUIRE( extracted == 3 );
+      REQUIRE( test == "This is a test.\n" );
+      REQUIRE( bar == "foobar\n" );
+      REQUIRE( foo == "foo was here.\n" );
+    }
+
+    SECTION("empty job list")
+    {
+      SRTP::BSA bsa;
+      REQUIRE( bsa.open(path.string(), SRTP::BSA::OpenMode::MemoryMapped) );
+      REQUIRE( bsa.grabAllStructureData() );
+
+      uint32_t extracted = 42;
+      REQUIRE( extractParallel(bsa, {}, 8, extracted) );
+      REQUIRE( extracted == 0 );
+    }
+  }
+}
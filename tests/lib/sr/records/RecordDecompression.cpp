@@ -0,0 +1,137 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for Skyrim Tools Project.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../../locate_catch.hpp"
+#include <sstream>
+#include <string>
+#include "../../../../lib/base/ViewStream.hpp"
+#include "../../../../lib/base/CompressionFunctions.hpp"
+#include "../../../../lib/sr/records/RecordDecompression.hpp"
+#include "../../../../lib/sr/SR_Constants.hpp"
+
+namespace
+{
+
+// creates compressed record data: size of decompressed data + zlib stream
+std::string compressedRecordData(std::string raw)
+{
+  uint32_t compressedSize = 256;
+  uint8_t* compressed = new uint8_t[compressedSize];
+  uint32_t usedSize = 0;
+  REQUIRE( MWTP::zlibCompress(reinterpret_cast<uint8_t*>(raw.data()), raw.size(), compressed, compressedSize, usedSize) );
+  const uint32_t rawSize = raw.size();
+  std::string result(reinterpret_cast<const char*>(&rawSize), 4);
+  result.append(reinterpret_cast<const char*>(compressed), usedSize);
+  delete[] compressed;
+  return result;
+}
+
+std::string asString(const MWTP::ByteView view)
+{
+  return std::string(reinterpret_cast<const char*>(view.data()), view.size());
+}
+
+} // namespace
+
+TEST_CASE("RecordDecompression")
+{
+  using namespace SRTP;
+  using namespace std::string_literals;
+
+  const std::string first = "EDID\x0C\0FirstRecord\0"s;
+  const std::string second = "EDID\x1D\0SecondRecordWithALongerName\0"s;
+
+  SECTION("decompressRecordData")
+  {
+    SECTION("default: decompress data")
+    {
+      const auto data = compressedRecordData(first);
+      MWTP::ByteView result;
+      REQUIRE( decompressRecordData(reinterpret_cast<const uint8_t*>(data.data()), data.size(), cNPC_, result) );
+      REQUIRE( asString(result) == first );
+    }
+
+    SECTION("buffer is reused for next record")
+    {
+      const auto dataOne = compressedRecordData(second);
+      const auto dataTwo = compressedRecordData(first);
+      MWTP::ByteView result;
+      REQUIRE( decompressRecordData(reinterpret_cast<const uint8_t*>(dataOne.data()), dataOne.size(), cNPC_, result) );
+      REQUIRE( asString(result) == second );
+      const uint8_t* buffer = result.data();
+      REQUIRE( decompressRecordData(reinterpret_cast<const uint8_t*>(dataTwo.data()), dataTwo.size(), cNPC_, result) );
+      REQUIRE( asString(result) == first );
+      REQUIRE( result.data() == buffer );
+    }
+
+    SECTION("failure: data too small")
+    {
+      const auto data = "\x10\0\0\0"s;
+      MWTP::ByteView result;
+      REQUIRE_FALSE( decompressRecordData(reinterpret_cast<const uint8_t*>(data.data()), data.size(), cNPC_, result) );
+    }
+
+    SECTION("failure: invalid compressed data")
+    {
+      const auto data = "\x10\0\0\0garbage"s;
+      MWTP::ByteView result;
+      REQUIRE_FALSE( decompressRecordData(reinterpret_cast<const uint8_t*>(data.data()), data.size(), cNPC_, result) );
+    }
+  }
+
+  SECTION("decompressRecord")
+  {
+    SECTION("default: decompress data from stream")
+    {
+      const auto data = compressedRecordData(first);
+      std::istringstream input(data + "rest"s);
+      uint32_t readSize = data.size();
+      MWTP::ByteView result;
+      REQUIRE( decompressRecord(input, readSize, cCELL, result) );
+      REQUIRE( readSize == first.size() );
+      MWTP::ViewStream stream(result);
+      std::string content(readSize, '\0');
+      stream.read(content.data(), readSize);
+      REQUIRE( stream.good() );
+      REQUIRE( content == first );
+      // input is positioned after the record
+      std::string rest;
+      input >> rest;
+      REQUIRE( rest == "rest" );
+    }
+
+    SECTION("failure: stream ends before compressed data")
+    {
+      const auto data = compressedRecordData(first);
+      std::istringstream input(data.substr(0, data.size() - 2));
+      uint32_t readSize = data.size();
+      MWTP::ByteView result;
+      REQUIRE_FALSE( decompressRecord(input, readSize, cCELL, result) );
+    }
+
+    SECTION("failure: record size too small")
+    {
+      std::istringstream input("\x10\0\0\0"s);
+      uint32_t readSize = 4;
+      MWTP::ByteView result;
+      REQUIRE_FALSE( decompressRecord(input, readSize, cCELL, result) );
+    }
+  }
+}
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for Skyrim Tools Project.
-    Copyright (C) 2021, 2025  Dirk Stolle
+    Copyright (C) 2021, 2025, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,6 +21,7 @@
 #include "../../locate_catch.hpp"
 #include <sstream>
 #include <string_view>
+#include "../../../../lib/base/CompressionFunctions.hpp"
 #include "../../../../lib/sr/records/WorldSpaceRecord.hpp"
 #include "../../../../lib/sr/SR_Constants.hpp"
 #include "../../../../lib/sr/StringTable.hpp"
@@ -29,6 +30,7 @@ TEST_CASE("WorldSpaceRecord")
 {
   using namespace SRTP;
   using namespace std::string_view_literals;
+  using namespace std::string_literals;
 
   SECTION("constructor")
   {
@@ -978,6 +980,43 @@ TEST_CASE("WorldSpaceRecord")
       REQUIRE( streamOut.str().size() == data.size() );
     }
 
+    SECTION("default: load compressed record")
+    {
+      std::string body = "EDID\x12\0LabyrinthianWorld\0NAMA\x04\0\0\0\x80?OFST\x04\0\x01\0\0\0"s;
+      uint32_t compressedSize = 256;
+      uint8_t* compressed = new uint8_t[compressedSize];
+      uint32_t usedSize = 0;
+      REQUIRE( MWTP::zlibCompress(reinterpret_cast<uint8_t*>(body.data()), body.size(), compressed, compressedSize, usedSize) );
+      const uint32_t dataSize = usedSize + 4;
+      const uint32_t bodySize = body.size();
+      std::string data = "WRLD"s;
+      data.append(reinterpret_cast<const char*>(&dataSize), 4);
+      data.append("\0\0\x04\0\xD3\xCD\x01\0\x1B\x69\x55\0\x28\0\x09\0"s);
+      data.append(reinterpret_cast<const char*>(&bodySize), 4);
+      data.append(reinterpret_cast<const char*>(compressed), usedSize);
+      delete[] compressed;
+      std::istringstream stream;
+      stream.str(data);
+
+      // Skip WRLD, because header is handled before loadFromStream.
+      stream.seekg(4);
+      REQUIRE( stream.good() );
+
+      // Reading should succeed.
+      WorldSpaceRecord record;
+      REQUIRE( record.loadFromStream(stream, true, dummy_table) );
+      // Check data.
+      // -- header
+      REQUIRE( record.headerFlags == 0x00040000 );
+      REQUIRE( record.headerFormID == 0x0001CDD3 );
+      // -- record data
+      REQUIRE( record.editorID == "LabyrinthianWorld" );
+      REQUIRE( record.distantLODMultiplier == 1.0f );
+      REQUIRE( record.unknownOFST.isPresent() );
+      // Stream is at the end of the record.
+      REQUIRE( stream.tellg() == static_cast<std::streampos>(data.size()) );
+    }
+
     SECTION("special: load deleted record")
     {
       const std::string_view data = "WRLD\0\0\0\0\x20\0\0\0\xD3\xCD\x01\0\x1B\x69\x55\0\x28\0\x09\0"sv;
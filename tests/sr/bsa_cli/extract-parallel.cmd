@@ -0,0 +1,80 @@
+:: Script to test parallel extraction of bsa-cli.
+::
+::  Copyright (C) 2026  Dirk Stolle
+::
+::  This program is free software: you can redistribute it and/or modify
+::  it under the terms of the GNU Lesser General Public License as published by
+::  the Free Software Foundation, either version 3 of the License, or
+::  (at your option) any later version.
+::
+::  This program is distributed in the hope that it will be useful,
+::  but WITHOUT ANY WARRANTY; without even the implied warranty of
+::  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+::  GNU Lesser General Public License for more details.
+::
+::  You should have received a copy of the GNU Lesser General Public License
+::  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+@echo off
+
+:: 1st parameter = executable path
+if "%1" EQU "" (
+  echo First parameter must be executable file!
+  exit /B 1
+)
+
+SET EXECUTABLE=%1
+
+:: 2nd parameter = path to test_v104_uncompressed.bsa
+if "%2" EQU "" (
+  echo Second parameter must be path to BSA file!
+  exit /B 1
+)
+
+SET BSA_FILE=%2
+SET TEMP_DIR=%TEMP%\bsa-cli-extract-parallel-%RANDOM%
+
+:: extract-all with one thread as reference
+"%EXECUTABLE%" extract-all "%BSA_FILE%" "%TEMP_DIR%\serial"
+if %ERRORLEVEL% NEQ 0 (
+  echo Executable did not exit with code 0 when extract-all was executed.
+  rmdir /S /Q "%TEMP_DIR%"
+  exit /B 1
+)
+
+:: extract-all with several threads
+"%EXECUTABLE%" extract-all --threads 4 "%BSA_FILE%" "%TEMP_DIR%\parallel"
+if %ERRORLEVEL% NEQ 0 (
+  echo Executable did not exit with code 0 when extract-all was executed with four threads.
+  rmdir /S /Q "%TEMP_DIR%"
+  exit /B 1
+)
+
+FOR %%F IN (some\thing\test.txt something\else\bar.txt something\else\foo.txt) DO (
+  fc /B "%TEMP_DIR%\serial\%%F" "%TEMP_DIR%\parallel\%%F" > NUL
+  if ERRORLEVEL 1 (
+    echo Files extracted with several threads differ from files extracted with one thread.
+    rmdir /S /Q "%TEMP_DIR%"
+    exit /B 1
+  )
+)
+
+:: extract-directory with several threads
+"%EXECUTABLE%" extract-directory --threads 2 "%BSA_FILE%" something\else "%TEMP_DIR%\directory"
+if %ERRORLEVEL% NEQ 0 (
+  echo Executable did not exit with code 0 when extract-directory was executed with two threads.
+  rmdir /S /Q "%TEMP_DIR%"
+  exit /B 1
+)
+
+FOR %%F IN (bar.txt foo.txt) DO (
+  fc /B "%TEMP_DIR%\serial\something\else\%%F" "%TEMP_DIR%\directory\%%F" > NUL
+  if ERRORLEVEL 1 (
+    echo Files extracted by extract-directory with several threads differ from expected files.
+    rmdir /S /Q "%TEMP_DIR%"
+    exit /B 1
+  )
+)
+
+rmdir /S /Q "%TEMP_DIR%"
+exit /B 0
@@ -0,0 +1,89 @@
+#!/bin/sh
+
+# Script to test parallel extraction of bsa-cli.
+#
+#  Copyright (C) 2026  Dirk Stolle
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU Lesser General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU Lesser General Public License for more details.
+#
+#  You should have received a copy of the GNU Lesser General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# 1st parameter = executable path
+if [ -z "$1" ]
+then
+  echo "First parameter must be executable file!"
+  exit 1
+fi
+
+EXECUTABLE="$1"
+
+# 2nd parameter = path to test_v104_uncompressed.bsa
+if [ -z "$2" ]
+then
+  echo "Second parameter must be the path to the BSA file!"
+  exit 1
+fi
+
+BSA_FILE="$2"
+
+TEMP_DIR=$(mktemp -d)
+if [ $? -ne 0 ]
+then
+  echo "Could not create temporary directory."
+  exit 1
+fi
+
+# extract-all with one thread as reference
+"$EXECUTABLE" extract-all "$BSA_FILE" "$TEMP_DIR/serial"
+if [ $? -ne 0 ]
+then
+  echo "Executable did not exit with code 0 when extract-all was executed."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+# extract-all with several threads
+"$EXECUTABLE" extract-all --threads 4 "$BSA_FILE" "$TEMP_DIR/parallel"
+if [ $? -ne 0 ]
+then
+  echo "Executable did not exit with code 0 when extract-all was executed with four threads."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+diff -r "$TEMP_DIR/serial" "$TEMP_DIR/parallel"
+if [ $? -ne 0 ]
+then
+  echo "Files extracted with several threads differ from files extracted with one thread."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+# extract-directory with several threads
+"$EXECUTABLE" extract-directory --threads 2 "$BSA_FILE" 'something\else' "$TEMP_DIR/directory"
+if [ $? -ne 0 ]
+then
+  echo "Executable did not exit with code 0 when extract-directory was executed with two threads."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+diff -r "$TEMP_DIR/serial/something/else" "$TEMP_DIR/directory"
+if [ $? -ne 0 ]
+then
+  echo "Files extracted by extract-directory with several threads differ from expected files."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+rm -rf "$TEMP_DIR"
+exit 0
@@ -0,0 +1,93 @@
+:: Script to test the pack command of bsa-cli.
+::
+::  Copyright (C) 2026  Dirk Stolle
+::
+::  This program is free software: you can redistribute it and/or modify
+::  it under the terms of the GNU Lesser General Public License as published by
+::  the Free Software Foundation, either version 3 of the License, or
+::  (at your option) any later version.
+::
+::  This program is distributed in the hope that it will be useful,
+::  but WITHOUT ANY WARRANTY; without even the implied warranty of
+::  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+::  GNU Lesser General Public License for more details.
+::
+::  You should have received a copy of the GNU Lesser General Public License
+::  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+@echo off
+
+:: 1st parameter = executable path
+if "%1" EQU "" (
+  echo First parameter must be executable file!
+  exit /B 1
+)
+
+SET EXECUTABLE=%1
+
+:: 2nd parameter = path to test_v104_uncompressed.bsa
+if "%2" EQU "" (
+  echo Second parameter must be path to BSA file!
+  exit /B 1
+)
+
+SET BSA_FILE=%2
+SET TEMP_DIR=%TEMP%\bsa-cli-pack-%RANDOM%
+
+:: extract original archive to get the files to pack
+"%EXECUTABLE%" extract-all "%BSA_FILE%" "%TEMP_DIR%\source"
+if %ERRORLEVEL% NEQ 0 (
+  echo Executable did not exit with code 0 when extract-all was executed.
+  rmdir /S /Q "%TEMP_DIR%"
+  exit /B 1
+)
+
+:: packing without compression recreates the original archive
+"%EXECUTABLE%" pack --uncompressed "%TEMP_DIR%\source" "%TEMP_DIR%\uncompressed.bsa"
+if %ERRORLEVEL% NEQ 0 (
+  echo Executable did not exit with code 0 when pack was executed.
+  rmdir /S /Q "%TEMP_DIR%"
+  exit /B 1
+)
+
+fc /B "%BSA_FILE%" "%TEMP_DIR%\uncompressed.bsa" > NUL
+if %ERRORLEVEL% NEQ 0 (
+  echo Packed archive differs from the original archive.
+  rmdir /S /Q "%TEMP_DIR%"
+  exit /B 1
+)
+
+:: packing with compression and several threads
+"%EXECUTABLE%" pack --threads 2 "%TEMP_DIR%\source" "%TEMP_DIR%\compressed.bsa"
+if %ERRORLEVEL% NEQ 0 (
+  echo Executable did not exit with code 0 when pack was executed with two threads.
+  rmdir /S /Q "%TEMP_DIR%"
+  exit /B 1
+)
+
+"%EXECUTABLE%" extract-all "%TEMP_DIR%\compressed.bsa" "%TEMP_DIR%\extracted"
+if %ERRORLEVEL% NEQ 0 (
+  echo Executable did not exit with code 0 when packed archive was extracted.
+  rmdir /S /Q "%TEMP_DIR%"
+  exit /B 1
+)
+
+FOR %%F IN (some\thing\test.txt something\else\bar.txt something\else\foo.txt) DO (
+  fc /B "%TEMP_DIR%\source\%%F" "%TEMP_DIR%\extracted\%%F" > NUL
+  if ERRORLEVEL 1 (
+    echo Files extracted from the packed archive differ from the original files.
+    rmdir /S /Q "%TEMP_DIR%"
+    exit /B 1
+  )
+)
+
+:: destination must not exist
+"%EXECUTABLE%" pack "%TEMP_DIR%\source" "%TEMP_DIR%\compressed.bsa"
+if %ERRORLEVEL% NEQ 1 (
+  echo Executable did not exit with code 1 when destination of pack already existed.
+  rmdir /S /Q "%TEMP_DIR%"
+  exit /B 1
+)
+
+rmdir /S /Q "%TEMP_DIR%"
+exit /B 0
@@ -0,0 +1,106 @@
+#!/bin/sh
+
+# Script to test the pack command of bsa-cli.
+#
+#  Copyright (C) 2026  Dirk Stolle
+#
+#  This program is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU Lesser General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  This program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU Lesser General Public License for more details.
+#
+#  You should have received a copy of the GNU Lesser General Public License
+#  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# 1st parameter = executable path
+if [ -z "$1" ]
+then
+  echo "First parameter must be executable file!"
+  exit 1
+fi
+
+EXECUTABLE="$1"
+
+# 2nd parameter = path to test_v104_uncompressed.bsa
+if [ -z "$2" ]
+then
+  echo "Second parameter must be the path to the BSA file!"
+  exit 1
+fi
+
+BSA_FILE="$2"
+
+TEMP_DIR=$(mktemp -d)
+if [ $? -ne 0 ]
+then
+  echo "Could not create temporary directory."
+  exit 1
+fi
+
+# extract original archive to get the files to pack
+"$EXECUTABLE" extract-all "$BSA_FILE" "$TEMP_DIR/source"
+if [ $? -ne 0 ]
+then
+  echo "Executable did not exit with code 0 when extract-all was executed."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+# packing without compression recreates the original archive
+"$EXECUTABLE" pack --uncompressed "$TEMP_DIR/source" "$TEMP_DIR/uncompressed.bsa"
+if [ $? -ne 0 ]
+then
+  echo "Executable did not exit with code 0 when pack was executed."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+cmp "$BSA_FILE" "$TEMP_DIR/uncompressed.bsa"
+if [ $? -ne 0 ]
+then
+  echo "Packed archive differs from the original archive."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+# packing with compression and several threads
+"$EXECUTABLE" pack --threads 2 "$TEMP_DIR/source" "$TEMP_DIR/compressed.bsa"
+if [ $? -ne 0 ]
+then
+  echo "Executable did not exit with code 0 when pack was executed with two threads."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+"$EXECUTABLE" extract-all "$TEMP_DIR/compressed.bsa" "$TEMP_DIR/extracted"
+if [ $? -ne 0 ]
+then
+  echo "Executable did not exit with code 0 when packed archive was extracted."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+diff -r "$TEMP_DIR/source" "$TEMP_DIR/extracted"
+if [ $? -ne 0 ]
+then
+  echo "Files extracted from the packed archive differ from the original files."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+# destination must not exist
+"$EXECUTABLE" pack "$TEMP_DIR/source" "$TEMP_DIR/compressed.bsa"
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when destination of pack already existed."
+  rm -rf "$TEMP_DIR"
+  exit 1
+fi
+
+rm -rf "$TEMP_DIR"
+exit 0
@@ -1,6 +1,6 @@
 :: Script to test executable when parameters are used in the wrong way.
 ::
-::  Copyright (C) 2023, 2025  Dirk Stolle
+::  Copyright (C) 2023, 2025, 2026  Dirk Stolle
 ::
 ::  This program is free software: you can redistribute it and/or modify
 ::  it under the terms of the GNU Lesser General Public License as published by
@@ -89,6 +89,27 @@ if %ERRORLEVEL% NEQ 1 (
   exit /B 1
 )
 
+:: command extract-all: --threads without value
+"%EXECUTABLE%" extract-all "%BSA_FILE%" bsa-cli-never-created --threads
+if %ERRORLEVEL% NEQ 1 (
+  echo Executable did not exit with code 1 when --threads had no value for extract-all.
+  exit /B 1
+)
+
+:: command extract-all: --threads with invalid value
+"%EXECUTABLE%" extract-all --threads 0 "%BSA_FILE%" bsa-cli-never-created
+if %ERRORLEVEL% NEQ 1 (
+  echo Executable did not exit with code 1 when --threads was 0 for extract-all.
+  exit /B 1
+)
+
+:: command extract-directory: --threads with invalid value
+"%EXECUTABLE%" extract-directory --threads abc "%BSA_FILE%" some\thing bsa-cli-never-created
+if %ERRORLEVEL% NEQ 1 (
+  echo Executable did not exit with code 1 when --threads was abc for extract-directory.
+  exit /B 1
+)
+
 :: command file-metadata: --show-total is given twice
 "%EXECUTABLE%" file-metadata --show-total --show-total file.bsa
 if %ERRORLEVEL% NEQ 1 (
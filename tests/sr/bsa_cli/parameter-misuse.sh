@@ -2,7 +2,7 @@
 
 # Script to test executable when parameters are used in the wrong way.
 #
-#  Copyright (C) 2023, 2025  Dirk Stolle
+#  Copyright (C) 2023, 2025, 2026  Dirk Stolle
 #
 #  This program is free software: you can redistribute it and/or modify
 #  it under the terms of the GNU Lesser General Public License as published by
@@ -132,6 +132,41 @@ then
 fi
 unlink "$TEMP_DEST_FILE"
 
+# command extract-all: --threads without value
+"$EXECUTABLE" extract-all "$BSA_FILE" /tmp/bsa-cli-never-created --threads
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when --threads had no value for extract-all."
+  exit 1
+fi
+
+# command extract-all: --threads with invalid value
+for VALUE in 0 -1 abc 257
+do
+  "$EXECUTABLE" extract-all --threads $VALUE "$BSA_FILE" /tmp/bsa-cli-never-created
+  if [ $? -ne 1 ]
+  then
+    echo "Executable did not exit with code 1 when --threads was $VALUE for extract-all."
+    exit 1
+  fi
+done
+
+# command extract-all: --threads is given twice
+"$EXECUTABLE" extract-all --threads 2 --threads 2 "$BSA_FILE" /tmp/bsa-cli-never-created
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when --threads was given twice for extract-all."
+  exit 1
+fi
+
+# command extract-directory: --threads with invalid value
+"$EXECUTABLE" extract-directory --threads 0 "$BSA_FILE" 'some\thing' /tmp/bsa-cli-never-created
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when --threads was 0 for extract-directory."
+  exit 1
+fi
+
 # command file-metadata: --show-total is given twice
 "$EXECUTABLE" file-metadata --show-total --show-total file.bsa
 if [ $? -ne 1 ]
@@ -2,7 +2,7 @@
 
 # Script to test executable when parameters are used in the wrong way.
 #
-#  Copyright (C) 2024  Dirk Stolle
+#  Copyright (C) 2024, 2026  Dirk Stolle
 #
 #  This program is free software: you can redistribute it and/or modify
 #  it under the terms of the GNU Lesser General Public License as published by
@@ -34,8 +34,8 @@ then
   exit 1
 fi
 
-# Archive path is given twice.
-"$EXECUTABLE" --archive foo.bsa --archive bar.bsa some_mount_point
+# Same archive path is given twice.
+"$EXECUTABLE" --archive foo.bsa --archive foo.bsa some_mount_point
 if [ $? -ne 1 ]
 then
   echo "Executable did not exit with code 1 when archive was specified twice."
@@ -50,6 +50,22 @@ then
   exit 1
 fi
 
+# Cache size parameter is present without size.
+"$EXECUTABLE" --archive foo.bsa some_mount_point --cache-size
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when --cache-size was given without size."
+  exit 1
+fi
+
+# Cache size is invalid.
+"$EXECUTABLE" --archive foo.bsa --cache-size 12X some_mount_point
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when cache size was invalid."
+  exit 1
+fi
+
 # no archive path
 "$EXECUTABLE" --pseudo-parameter-to-pass-to-fuse some_mount_point
 if [ $? -ne 1 ]
@@ -66,4 +82,12 @@ then
   exit 1
 fi
 
+# One of several BSA files does not exist / fails to load.
+"$EXECUTABLE" --archive this-file-is-missing.bsa --archive this-one-too.bsa some_mount_point
+if [ $? -ne 2 ]
+then
+  echo "Executable did not exit with code 2 when one of several BSA files was missing."
+  exit 1
+fi
+
 exit 0
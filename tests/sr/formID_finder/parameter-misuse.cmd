@@ -1,6 +1,6 @@
 :: Script to test executable when parameters are used in the wrong way.
 ::
-::  Copyright (C) 2023  Dirk Stolle
+::  Copyright (C) 2023, 2026  Dirk Stolle
 ::
 ::  This program is free software: you can redistribute it and/or modify
 ::  it under the terms of the GNU Lesser General Public License as published by
@@ -158,6 +158,55 @@ if %ERRORLEVEL% NEQ 1 (
   exit /B 1
 )
 
+:: thread count was given twice
+"%EXECUTABLE%" --threads 2 --threads 2 -d blah\foo\data
+if %ERRORLEVEL% NEQ 1 (
+  echo Executable did not exit with code 1 when thread count was given twice.
+  exit /B 1
+)
+
+:: --threads was given without a number
+"%EXECUTABLE%" -d blah\foo\data --threads
+if %ERRORLEVEL% NEQ 1 (
+  echo Executable did not exit with code 1 when --threads was given without a number.
+  exit /B 1
+)
+
+:: thread count was zero
+"%EXECUTABLE%" --threads 0 -d blah\foo\data
+if %ERRORLEVEL% NEQ 1 (
+  echo Executable did not exit with code 1 when thread count was zero.
+  exit /B 1
+)
+
+:: thread count was too large
+"%EXECUTABLE%" --threads 257 -d blah\foo\data
+if %ERRORLEVEL% NEQ 1 (
+  echo Executable did not exit with code 1 when thread count was too large.
+  exit /B 1
+)
+
+:: thread count was not a number
+"%EXECUTABLE%" --threads abc -d blah\foo\data
+if %ERRORLEVEL% NEQ 1 (
+  echo Executable did not exit with code 1 when thread count was not a number.
+  exit /B 1
+)
+
+:: cache directory was given twice
+"%EXECUTABLE%" --cache blah\foo --cache blah\bar -d blah\foo\data
+if %ERRORLEVEL% NEQ 1 (
+  echo Executable did not exit with code 1 when cache directory was given twice.
+  exit /B 1
+)
+
+:: --cache was given without a directory
+"%EXECUTABLE%" -d blah\foo\data --cache
+if %ERRORLEVEL% NEQ 1 (
+  echo Executable did not exit with code 1 when --cache was given without a directory.
+  exit /B 1
+)
+
 :: no arguments given
 "%EXECUTABLE%"
 if %ERRORLEVEL% NEQ 1 (
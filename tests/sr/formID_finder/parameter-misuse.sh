@@ -2,7 +2,7 @@
 
 # Script to test executable when parameters are used in the wrong way.
 #
-#  Copyright (C) 2023  Dirk Stolle
+#  Copyright (C) 2023, 2026  Dirk Stolle
 #
 #  This program is free software: you can redistribute it and/or modify
 #  it under the terms of the GNU Lesser General Public License as published by
@@ -178,6 +178,86 @@ then
   exit 1
 fi
 
+# thread count was given twice
+"$EXECUTABLE" --threads 2 --threads 2 -d /opt/foo/data
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when thread count was given twice."
+  exit 1
+fi
+
+# --threads was given without a number
+"$EXECUTABLE" -d /opt/foo/data --threads
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when --threads was given without a number."
+  exit 1
+fi
+
+# thread count was zero
+"$EXECUTABLE" --threads 0 -d /opt/foo/data
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when thread count was zero."
+  exit 1
+fi
+
+# thread count was too large
+"$EXECUTABLE" --threads 257 -d /opt/foo/data
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when thread count was too large."
+  exit 1
+fi
+
+# thread count was not a number
+"$EXECUTABLE" --threads abc -d /opt/foo/data
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when thread count was not a number."
+  exit 1
+fi
+
+# cache directory was given twice
+"$EXECUTABLE" --cache /tmp/foo --cache /tmp/bar -d /opt/foo/data
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when cache directory was given twice."
+  exit 1
+fi
+
+# --cache was given without a directory
+"$EXECUTABLE" -d /opt/foo/data --cache
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when --cache was given without a directory."
+  exit 1
+fi
+
+# socket for server mode was given twice
+"$EXECUTABLE" --serve /tmp/foo.sock --serve /tmp/bar.sock -d /opt/foo/data
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when --serve was given twice."
+  exit 1
+fi
+
+# --serve was given without a socket file
+"$EXECUTABLE" -d /opt/foo/data --serve
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when --serve was given without a socket."
+  exit 1
+fi
+
+# --serve was combined with a search keyword
+"$EXECUTABLE" -d /opt/foo/data --serve /tmp/foo.sock -p foo
+if [ $? -ne 1 ]
+then
+  echo "Executable did not exit with code 1 when --serve was combined with a keyword."
+  exit 1
+fi
+
 # no arguments given
 "$EXECUTABLE"
 if [ $? -ne 1 ]